@@ -1,6 +1,28 @@
-﻿#include <stdio.h>
+﻿#define _POSIX_C_SOURCE 200809L // localtime_r 사용
+
+#include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
+#include <stddef.h>
+#include <limits.h>
 #include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#include <sched.h>
+#include <signal.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
+#include <dirent.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define SIMD_X86 // x86 벡터 명령(SSE4.2, AVX2)을 이용하는 함수를 함께 컴파일한다.
+#endif
 
 /* 열람실 좌석관리 시스템
 *
@@ -12,25 +34,665 @@
 */
 
 
-#define SEATS 10 // 좌석 수 설정
+#define DEFAULT_SEATS 10 // 설정 파일이 없는 경우의 기본 좌석 수
+#define MAX_SEATS 1000000 // 설정 파일로 지정 가능한 최대 좌석 수
 #define MAX_NAME_LENGTH 20 // 이용자명의 최대 길이 설정
-
-// 좌석 정보를 저장하는 구조체 생성
-typedef struct seatsData
+#define MAX_ROOMS 32 // 설정 파일로 지정 가능한 최대 열람실 수
+#define MAX_ROOM_NAME 16 // 열람실 이름의 최대 길이
+#define CACHE_LINE_SIZE 64 // 좌석 정보 열(column)의 정렬 단위(바이트)
+#define CACHE_ALIGN(size) ((((size) + CACHE_LINE_SIZE - 1) / CACHE_LINE_SIZE) * CACHE_LINE_SIZE) // 크기를 캐시 라인 단위로 올림
+#define INDEX_EMPTY -1 // 이용자명 색인의 빈 칸
+#define NO_USER 0 // 좌석 이용자 번호 열에서 이용자가 없음을 나타내는 값. 이용자 번호는 1부터 시작한다.
+#define END_TIME_EPOCH 946684800LL // 이용종료시각 열의 기준 시각(2000/1/1 0시 UTC, Unix 초). 열에는 이 시각부터의 초를 32비트로 저장하며, 2136년까지 표현할 수 있다.
+#define BITMAP_WORD_BITS 64 // 좌석 비트맵의 한 워드에 담기는 좌석 수
+#define DEFAULT_CONFIG_FILE "library.conf" // 기본 설정 파일명
+#define MAX_PATH_LENGTH 256 // 설정 파일에 적을 수 있는 경로의 최대 길이
+#define SHARED_MAGIC "LSSSHM01" // 공유 좌석 파일 표시
+#define SHARED_VERSION 13 // 공유 좌석 파일의 저장 형식 번호. 머리 부분이나 열의 배치가 바뀌면 증가시킨다.
+#define SPIN_LIMIT 64 // 잠금을 기다리며 확인하는 횟수. 이를 넘으면 CPU를 양보한다.
+
+// 좌석 예약 관련 상수
+#define DEFAULT_RESERVATIONS 4 // 좌석마다 저장할 수 있는 기본 예약 수
+#define MAX_RESERVATIONS 64 // 설정 파일로 지정 가능한 좌석당 최대 예약 수
+#define MAX_RESERVATION_DAYS 14 // 며칠 뒤까지 예약할 수 있는지
+
+// 이용 한도 관련 상수
+#define DEFAULT_QUOTA_USERS 131072 // 하루 이용 한도를 기록할 수 있는 기본 이용자 수. 하루 동안 이용한 이용자 수가 이를 넘으면 넘은 이용자에게는 한도를 적용하지 않는다.
+#define MAX_QUOTA_USERS 4194304 // 설정 파일로 지정 가능한 최대 이용자 수
+#define QUOTA_UNLIMITED 0x7FFFFFFF // 하루 이용 한도가 없는 경우의 남은 한도(초)
+#define QUOTA_LOCK_STRIPES 64 // 이용 한도 표를 나누는 구역(잠금) 수. 표가 작으면 구역 하나만 쓴다.
+#define QUOTA_SEGMENT_MIN 64 // 표를 여러 구역으로 나누는 경우 구역 하나의 최소 칸 수
+#define QUOTA_SNAPSHOT_CHUNK 256 // 스냅샷을 쓸 때 구역 잠금을 한 번 가진 동안 읽는 최대 칸 수
+
+// 대기열 관련 상수
+#define WAITLIST_SIZE 256 // 우선순위마다 대기열에 등록할 수 있는 최대 인원. 좌석을 맡겨 둔 이용자 목록의 크기이기도 하다.
+#define WAIT_CLASSES 2 // 대기열 우선순위 수 (0 : 일반, 1 : 우선). 높은 우선순위의 이용자가 먼저 좌석을 넘겨받는다.
+#define WAIT_CLAIM_TIME 5 // 차례가 된 이용자에게 좌석을 맡겨 두는 시간(분). 이 시간 안에 배정받지 않으면 다음 이용자에게 넘어간다.
+#define WAIT_NOTIFY_BATCH 16 // 좌석 서비스가 한 번에 알리는 대기 연결 수
+#define WAIT_PARKED_FDS (WAIT_CLASSES * WAITLIST_SIZE + WAITLIST_SIZE) // 좌석 서비스 하나가 응답을 미뤄 둘 수 있는 대기 연결 수
+
+// 좌석 일괄 설정 관련 상수
+#define MAX_BLACKOUTS 256 // 예약해 둘 수 있는 이용불가 시간대 수. 선택한 좌석이 여러 구간으로 나뉘면 구간마다 하나씩 차지한다.
+#define SELECTION_LENGTH 256 // 관리자 모드에서 입력하는 좌석 선택 문자열의 최대 길이
+#define BLACKOUT_ADDED 0 // 이용불가 시간대 기록(WAL_BLACKOUT) : 예약 추가
+#define BLACKOUT_STARTED 1 // 이용불가 시간대 기록 : 시작하여 좌석을 이용불가로 바꿈
+#define BLACKOUT_ENDED 2 // 이용불가 시간대 기록 : 끝나서 좌석을 되돌리고 삭제함
+
+// 좌석 배치(좌석 추천) 관련 상수
+#define SEAT_POWER 1 // 콘센트가 있는 좌석
+#define SEAT_WINDOW 2 // 창가 좌석
+#define SEAT_QUIET 4 // 조용한 구역의 좌석
+#define SEAT_PLACED 128 // 배치 파일에 좌표가 적힌 좌석 (좌석 특징 열에서만 이용)
+#define MAX_LAYOUT_COORD 1000000 // 배치 파일에 적을 수 있는 좌표의 절댓값의 최댓값
+#define LAYOUT_CELL_SEATS 8 // 좌석 배치 격자의 한 칸에 평균적으로 들어가는 좌석 수
+#define MAX_SUGGESTIONS 5 // 좌석 추천에서 보여주는 최대 좌석 수
+
+// 운영 달력 관련 상수
+#define CALENDAR_DAYS 400 // 운영 구간을 미리 계산해 두는 기간(오늘부터의 일수). 이 기간과 날짜 예외 밖의 날은 요일별 운영시간으로 그때 계산한다.
+#define MAX_CALENDAR_SPAN 3660 // 미리 계산하는 기간의 최대 일수. 날짜 예외는 이 기간 안에 있어야 한다.
+#define MAX_CALENDAR_EXCEPTIONS 1024 // 달력 파일에 적을 수 있는 날짜 예외 수
+#define CALENDAR_CLOSED -1 // 휴관일의 개장시각
+
+// 이용 기록(history) 관련 상수
+#define HISTORY_MAGIC "LSH1" // 이용 기록 묶음 표시
+#define HISTORY_BLOCK_SESSIONS 4096 // 이용 기록 묶음 하나에 담는 최대 이용 수. 프로세스마다 이만큼 모은 후 한 번에 파일 끝에 쓴다.
+#define HISTORY_SESSION_SPACE 64 // 이용 하나가 묶음에서 차지하는 최대 크기(바이트). 열별 가변 길이 정수와 사전의 이용자명 하나를 포함한다.
+#define HISTORY_DICT_SIZE (HISTORY_BLOCK_SESSIONS * 2) // 묶음의 이용자명 사전을 만들 때 이용하는 해시 테이블 크기 (2의 거듭제곱)
+#define HISTORY_COLUMNS 6 // 묶음의 열 수 (시작시각, 이용 시간, 좌석번호, 이용자, 연장 횟수, 종료 사유)
+#define HISTORY_CHECKOUT 0 // 종료 사유 : 이용자 퇴실
+#define HISTORY_EXPIRED 1 // 종료 사유 : 이용종료시각 만료
+#define HISTORY_CLOSED 2 // 종료 사유 : 폐장 후 초기화
+#define HISTORY_UNAVAILABLE 3 // 종료 사유 : 이용불가 설정
+#define HISTORY_RESET 4 // 종료 사유 : 관리자의 좌석 초기화
+
+// 벡터 연산(SIMD) 수준. 실행할 때 CPU를 확인하여 이용 가능한 가장 높은 수준을 고른다.
+#define SIMD_SCALAR 0 // 벡터 명령을 이용하지 않음
+#define SIMD_SSE42 1 // SSE4.2 (한 번에 128비트)
+#define SIMD_AVX2 2 // AVX2 (한 번에 256비트)
+
+// 운영 지표(metrics) 관련 상수
+#define DEFAULT_METRICS_INTERVAL 10 // 지표 파일을 다시 쓰는 기본 간격(초)
+#define METRIC_THREADS (MAX_WORKERS + 1) // 지표를 따로 모으는 최대 스레드 수 (주 스레드 + 작업 스레드)
+#define METRIC_BUCKETS 12 // 지연시간 히스토그램의 칸 수 (마지막 칸은 상한 없음)
+
+// 운영 지표 카운터 종류
+#define METRIC_ASSIGN 0 // 좌석 배정
+#define METRIC_RENEW 1 // 좌석 연장
+#define METRIC_CHECKOUT 2 // 이용자의 퇴실
+#define METRIC_EXPIRE 3 // 이용종료시각이 지난 좌석의 자동 퇴실
+#define METRIC_CLOSING_RESET 4 // 폐장 후 좌석 초기화 횟수
+#define METRIC_CLOSING_SEATS 5 // 폐장 후 좌석 초기화로 비운 좌석 수
+#define METRIC_FULL 6 // 만석으로 배정하지 못한 요청
+#define METRIC_CLOSED 7 // 운영시간이 아니어서 거절한 요청
+#define METRIC_COUNTERS 8 // 카운터 수
+
+// 지연시간을 측정하는 작업 종류. 좌석 서비스 요청은 요청 종류(REQUEST_ASSIGN 등) - 1과 같다.
+#define METRIC_OP_ASSIGN 0 // 좌석 배정 요청
+#define METRIC_OP_RENEW 1 // 좌석 연장 요청
+#define METRIC_OP_CHECKOUT 2 // 퇴실 요청
+#define METRIC_OP_STATUS 3 // 상태 확인 요청
+#define METRIC_OP_ADMIN 4 // 관리자 명령
+#define METRIC_OP_EXPIRE 5 // 만료 좌석 및 폐장 후 좌석 처리 (expireSeats)
+#define METRIC_OPERATIONS 6 // 작업 종류 수
+
+// 시뮬레이션 관련 상수
+#define SIMULATION_START_YEAR 2026 // 시뮬레이션의 가상 시계가 시작하는 해 (1월 1일 0시)
+
+// 좌석 상태 값
+#define SEAT_EMPTY 0 // 빈 좌석
+#define SEAT_USED 1 // 이용중인 좌석
+#define SEAT_UNAVAILABLE 2 // 이용불가 좌석
+
+// 기록(WAL) 관련 상수
+#define WAL_BUFFER_RECORDS 1024 // 한 번에 모아서 파일에 쓰는 기록 수
+#define SNAPSHOT_RECORDS 100000 // 스냅샷 사이에 쌓이는 최대 기록 수
+#define WAL_FILE_NAME "seats.wal" // 기록 파일명
+#define SNAPSHOT_FILE_NAME "seats.snap" // 스냅샷 파일명
+#define WAL_MAGIC "LSSWAL02" // 기록 파일 표시. 마지막 글자는 형식 번호로, 기록의 크기나 필드의 뜻이 바뀌면 증가시킨다.
+#define SNAPSHOT_MAGIC "LSSSNAP2" // 스냅샷 파일 표시. 형식 번호는 기록 파일과 함께 증가시킨다.
+#define CHECKPOINT_INTERVAL 3600 // 기록이 있는 경우 스냅샷(체크포인트)을 만드는 최대 간격(초). 지난 시각의 복원은 이 시간 안의 기록만 적용한다.
+#define DEFAULT_ARCHIVE_DAYS 7 // 지난 세대의 스냅샷과 기록 파일을 보관하는 기본 일수 (0이면 보관하지 않음)
+
+// 기록 종류
+#define WAL_ASSIGN 1 // 좌석 배정
+#define WAL_RENEW 2 // 좌석 연장
+#define WAL_CHECKOUT 3 // 퇴실 (자동 퇴실 포함)
+#define WAL_SEAT_STATE 4 // 좌석 이용불가 설정 변경
+#define WAL_RESET 5 // 열람실의 모든 좌석 초기화
+#define WAL_CLAMP 6 // 폐장시각 변경에 따른 열람실의 이용종료시각 조정
+#define WAL_LIBRARY 7 // 열람실 운영정보 변경
+#define WAL_RESERVE 8 // 좌석 예약
+#define WAL_CANCEL 9 // 예약 취소 (예약한 이용자의 입실 포함)
+#define WAL_MARK 10 // 시각 표시. 이후의 기록이 일어난 시각이며, 좌석 정보에는 적용하지 않는다.
+#define WAL_BLACKOUT 11 // 이용불가 시간대의 추가, 시작 또는 끝 (BLACKOUT_ADDED 등)
+#define WAL_QUOTA 12 // 이용자의 오늘 사용량 (바뀐 후의 값)
+
+// 좌석 서비스(데몬) 관련 상수
+#define DEFAULT_WORKERS 4 // 기본 작업 스레드 수
+#define MAX_WORKERS 64 // 설정 파일로 지정 가능한 최대 작업 스레드 수
+#define SERVICE_BATCH 16 // 작업 스레드가 한 연결에서 이어서 처리하는 최대 요청 수
+
+// 자동 정리 관련 상수
+#define HOUSEKEEPING_MAX_SLEEP 60 // 자동 정리 스레드가 한 번에 쉬는 최대 시간(초). 다른 단말기(공유 좌석 파일)에서 바꾼 좌석도 이 시간 안에 다시 확인한다.
+
+// 일괄 처리 관련 상수
+#define BATCH_INPUT_SIZE 65536 // 명령을 한 번에 읽는 입력 버퍼 크기(바이트). 이보다 긴 줄은 잘못된 명령으로 처리한다.
+#define BATCH_OUTPUT_SIZE (1 << 20) // 결과를 모아서 한 번에 쓰는 출력 버퍼 크기(바이트)
+#define BATCH_LINE_SPACE 128 // 결과 한 줄이 차지하는 최대 크기(바이트). 출력 버퍼의 남은 공간이 이보다 작으면 버퍼를 비운다.
+
+// 좌석 배치도 출력 관련 상수
+#define SEATMAP_LIST 0 // 이용자용 목록 (한 줄에 좌석 하나)
+#define SEATMAP_MASTER 1 // 관리자용 목록 (이용중인 좌석에 이용자명 표시)
+#define SEATMAP_GRID 2 // 격자 (좌석 하나를 문자 하나로 표시)
+#define SEATMAP_LINE_SIZE 48 // 목록 한 줄이 차지하는 최대 크기(바이트). 좌석번호(7자리)와 이용자명(19바이트)을 포함한 가장 긴 줄이 들어간다.
+#define SEATMAP_GRID_COLUMNS 50 // 격자 한 줄의 좌석 수. 10개마다 한 칸을 띄운다.
+#define SEATMAP_GRID_LABEL 8 // 격자 줄 맨 앞의 좌석번호 칸 크기(바이트)
+#define SEATMAP_GRID_ROW (SEATMAP_GRID_LABEL + SEATMAP_GRID_COLUMNS + (SEATMAP_GRID_COLUMNS - 1) / 10 + 1) // 격자 한 줄의 크기(바이트, 줄바꿈 포함)
+#define SEATMAP_GRID_LEGEND "[.] 빈 좌석  [#] 이용중  [X] 이용불가\n" // 격자 맨 위의 범례
+#define SEATMAP_OUTPUT_SIZE (1 << 20) // 목록을 모아서 한 번에 쓰는 출력 버퍼 크기(바이트)
+
+// 성능 측정(벤치마크) 관련 상수
+#define BENCH_OPERATIONS 7 // 측정하는 함수의 수
+#define BENCH_SUB_BITS 4 // 지연시간 히스토그램에서 2의 거듭제곱 구간 하나를 나누는 칸 수의 비트 수
+#define BENCH_SUB_BUCKETS (1 << BENCH_SUB_BITS) // 지연시간 히스토그램에서 2의 거듭제곱 구간 하나를 나누는 칸 수
+#define BENCH_BUCKETS 640 // 지연시간 히스토그램의 칸 수 (약 1조 ns까지)
+#define BENCH_MIN_EVENTS 2000 // 좌석 수가 적어도 구간마다 발생시키는 최소 요청 수
+
+// 성능 측정 대상 함수 (측정 결과 배열의 위치)
+#define BENCH_SET_SEAT 0 // setSeat
+#define BENCH_RENEW_SEAT 1 // renewSeat
+#define BENCH_CHECK_OUT 2 // checkOut
+#define BENCH_FIND_USER 3 // findUser
+#define BENCH_IS_FULL 4 // isFull
+#define BENCH_INVALID_CHECK 5 // seatInvalidCheck
+#define BENCH_RESET 6 // resetSeats
+
+// 성능 측정 구간의 이용 형태
+#define BENCH_RUSH 0 // 아침 입실 (대부분 좌석 배정)
+#define BENCH_CHURN 1 // 평상시 (배정, 퇴실, 조회가 섞임)
+#define BENCH_LUNCH 2 // 점심시간 (퇴실 후 재입실)
+#define BENCH_RENEWAL 3 // 연장 (이용종료시각이 가까운 이용자의 연장)
+
+// 좌석 서비스 요청 종류
+#define REQUEST_ASSIGN 1 // 좌석 배정 (location이 -1이면 자동 배정)
+#define REQUEST_RENEW 2 // 좌석 연장
+#define REQUEST_CHECKOUT 3 // 퇴실
+#define REQUEST_STATUS 4 // 이용자(name) 또는 좌석(location)의 상태 확인
+#define REQUEST_ADMIN 5 // 관리자 명령. command에 관리자 모드의 메뉴 번호(1~5, 7)를 넣는다. 1~5는 room의 열람실(0이면 모든 열람실)에 적용한다.
+#define REQUEST_RESERVE 6 // 좌석(location) 예약. time부터 value분 동안 예약한다.
+#define REQUEST_CANCEL 7 // 좌석(location)의 예약 취소. time이 0이면 가장 이른 예약을 취소한다.
+#define REQUEST_WAIT 8 // 자동 배정, 배정할 좌석이 없으면 대기열(value : 우선순위) 등록. 좌석 서비스는 좌석을 넘겨받을 때 응답한다.
+
+// 좌석 서비스 응답 결과
+#define RESULT_OK 0 // 성공
+#define RESULT_BAD_REQUEST 1 // 잘못된 요청
+#define RESULT_NO_SEAT 2 // 좌석을 배정받지 않은 이용자
+#define RESULT_SEAT_TAKEN 3 // 이용중이거나 이용불가인 좌석
+#define RESULT_ALREADY_SEATED 4 // 이미 좌석을 배정받은 이용자
+#define RESULT_FULL 5 // 만석
+#define RESULT_CLOSED 6 // 운영시간이 아님
+#define RESULT_NOT_RENEWABLE 7 // 연장 가능 시각이 아님
+#define RESULT_WAITING 8 // 대기열에서 기다리는 중 (position : 대기 순번)
+#define RESULT_QUOTA 9 // 오늘의 이용 한도를 모두 쓴 이용자
+
+// 좌석 서비스 요청 구조체 생성 (40바이트 고정 크기)
+// 같은 컴퓨터 안의 Unix 도메인 소켓으로만 주고받으므로, 정수는 컴퓨터의 바이트 순서를 그대로 이용한다.
+// 예약 시작시각(time)이 없는 이전 형식의 요청(32바이트)도 time이 0인 요청으로 받는다.
+typedef struct seatRequest
 {
-    char seatsName[MAX_NAME_LENGTH]; // 좌석 이용자명 기록, ""(strlen=0)이면 빈 좌석
-    long long int endTime; // 이용 종료시각 기록(Unix 시간) - 초 단위, 해당 값이 0인 경우 빈 좌석, -1인 경우 이용불가 좌석
-} SeatsData;
+    unsigned char type; // 요청 종류 (REQUEST_ASSIGN 등)
+    unsigned char command; // 관리자 명령 종류 (REQUEST_ADMIN)
+    unsigned short room; // 1번부터 시작하는 열람실 번호, 지정하지 않는 경우 0 (자동 배정은 운영시간인 모든 열람실, 관리자 명령은 모든 열람실)
+    int location; // 0번부터 시작하는 좌석번호, 자동 배정 또는 지정하지 않는 경우 -1
+    int value; // 관리자 명령의 값 (분 단위 시간 또는 0시 기준 분) 또는 예약 시간(분, REQUEST_RESERVE)
+    char name[MAX_NAME_LENGTH]; // 이용자명
+    long long int time; // 예약 시작시각(Unix 시간, REQUEST_RESERVE, REQUEST_CANCEL) - 초 단위
+} SeatRequest;
+
+// 좌석 서비스 응답 구조체 생성 (24바이트 고정 크기)
+typedef struct seatResponse
+{
+    unsigned char result; // 응답 결과 (RESULT_OK 등)
+    unsigned char state; // 좌석 상태 (SEAT_EMPTY 등)
+    unsigned char renewable; // 연장 가능한 경우 1
+    unsigned char room; // 좌석이 속한 열람실 번호(1번부터 시작), 해당 좌석이 없는 경우 0
+    int location; // 0번부터 시작하는 좌석번호, 해당 좌석이 없는 경우 -1
+    int freeCount; // 응답 시점의 빈 좌석 수
+    int position; // 대기 순번 (RESULT_WAITING), 그 외에는 0
+    long long int endTime; // 이용종료시각(Unix 시간) - 초 단위, 이용중인 좌석이 아닌 경우 0. 예약에 성공한 경우 예약 종료시각
+} SeatResponse;
+
+// 좌석 상태 변경 하나를 나타내는 기록 구조체 생성 (40바이트 고정 크기)
+// 기록에는 변경 후의 값을 저장하므로, 같은 기록을 다시 적용해도 결과가 같다.
+typedef struct walRecord
+{
+    unsigned int checksum; // 나머지 필드의 검사합. 파일 끝이 잘린 경우를 찾는 데 이용한다.
+    unsigned char type; // 기록 종류 (WAL_ASSIGN 등)
+    unsigned char state; // 좌석 상태(WAL_SEAT_STATE), 최초 실행 여부(WAL_RESET), 연장 횟수(WAL_ASSIGN) 또는 이용불가 시간대의 변경(WAL_BLACKOUT)
+    unsigned short minutes; // 예약 시간(분, WAL_RESERVE), 배정부터 이용종료시각까지의 시간(분, WAL_ASSIGN), 오늘의 연장 횟수(WAL_QUOTA)
+                            // 또는 이용불가 시간대가 이용불가로 바꾼 좌석인 경우 1(WAL_SEAT_STATE)
+    int location; // 0번부터 시작하는 좌석번호, 열람실에 대한 기록(WAL_RESET, WAL_CLAMP, WAL_LIBRARY)은 0번부터 시작하는 열람실 번호
+    long long int time; // 이용종료시각(WAL_ASSIGN, WAL_RENEW), 폐장시각(WAL_CLAMP), 예약 시작시각(WAL_RESERVE, WAL_CANCEL), 기록 시각(WAL_MARK) 또는 시작시각(WAL_BLACKOUT) - Unix 초
+                        // 오늘의 사용량(WAL_QUOTA)은 위 32비트에 날짜 번호(quotaDay), 아래 32비트에 이용 시간(초)을 저장한다.
+    char name[MAX_NAME_LENGTH]; // 이용자명(WAL_ASSIGN, WAL_RESERVE, WAL_QUOTA), 운영정보 4개(WAL_LIBRARY) 또는 좌석 구간과 종료시각(WAL_BLACKOUT)
+} WalRecord;
+
+// 기록 파일과 스냅샷 파일의 머리 부분 구조체 생성
+typedef struct walHeader
+{
+    char magic[8]; // 파일 종류 표시 (WAL_MAGIC 또는 SNAPSHOT_MAGIC)
+    unsigned int generation; // 세대 번호. 스냅샷을 만들 때마다 1씩 증가하며, 스냅샷 이후의 기록 파일은 같은 세대 번호를 가진다.
+    int seatCount; // 좌석 수 (스냅샷 파일), 기록 파일은 0
+} WalHeader;
+
+// 이용 기록 파일의 묶음 머리 부분 구조체 생성 (64바이트 고정 크기)
+// 이용 기록 파일은 묶음을 이어 붙인 것이며, 묶음 하나는 머리 부분 뒤에 열(HISTORY_COLUMNS개)과 이용자명 사전을 차례로 담는다.
+// 시작시각 열은 앞 이용과의 차이(지그재그 부호화), 이용 시간, 좌석번호, 이용자(사전 번호) 열은 가변 길이 정수로, 연장 횟수와 종료 사유 열은 1바이트씩 저장한다.
+// 열마다 크기를 저장하므로, 집계에 필요한 열만 읽을 수 있다.
+typedef struct historyHeader
+{
+    char magic[4]; // 묶음 표시 (HISTORY_MAGIC)
+    unsigned int sessionCount; // 묶음의 이용 수
+    unsigned int nameCount; // 이용자명 사전의 이름 수
+    unsigned int columnSize[HISTORY_COLUMNS]; // 열별 크기(바이트)
+    unsigned int dictionarySize; // 이용자명 사전의 크기(바이트). 이름마다 길이(1바이트)와 이름을 저장한다.
+    long long int minStart; // 가장 이른 시작시각(Unix 초). 시작시각 열의 첫 값은 이 시각과의 차이이다.
+    long long int maxEnd; // 가장 늦은 종료시각(Unix 초)
+    int maxLocation; // 가장 큰 좌석번호(0부터 시작)
+    unsigned int checksum; // 머리 부분 뒤의 자료 전체의 검사합
+} HistoryHeader;
+
+// 파일에 쓰기 전의 이용 하나를 저장하는 구조체 생성
+typedef struct historySession
+{
+    long long int start; // 배정 시각(Unix 초)
+    long long int end; // 이용을 마친 시각(Unix 초)
+    int location; // 0번부터 시작하는 좌석번호
+    unsigned char renewCount; // 연장 횟수
+    unsigned char reason; // 종료 사유 (HISTORY_CHECKOUT 등)
+    char name[MAX_NAME_LENGTH]; // 이용자명
+} HistorySession;
+
+// 이용 기록 정보를 저장하는 구조체 생성 (프로세스마다 따로 가짐)
+// 끝난 이용을 버퍼에 모으고, HISTORY_BLOCK_SESSIONS개가 되거나 프로그램이 끝날 때 열 단위의 묶음으로 바꾸어 파일 끝에 한 번에 쓴다.
+// 이용은 좌석 잠금을 가진 채 버퍼에 모으기만 하고, 파일에는 요청 처리가 끝나 잠금을 모두 푼 후(historyCommit) 쓴다.
+// 파일은 O_APPEND로 열어, 같은 파일에 쓰는 여러 단말기의 묶음이 섞이지 않게 한다.
+typedef struct historyData
+{
+    pthread_mutex_t lock; // 여러 스레드가 함께 버퍼에 모으는 경우의 잠금. 이 잠금을 가진 동안에는 파일에 쓰지 않는다.
+    pthread_mutex_t writeLock; // 파일에 쓰는 스레드를 하나로 하는 잠금. 묶음을 만드는 버퍼(output, dictSession, dictIndex)도 보호한다.
+    int fd; // 이용 기록 파일
+    int count; // 버퍼에 모인 이용 수
+    int capacity; // 버퍼의 크기(이용 수). 한 번에 많은 이용이 끝나는 경우(열람실 초기화) 늘어난다.
+    int spareCapacity; // 예비 버퍼의 크기(이용 수)
+    HistorySession* sessions; // 파일에 쓰기 전의 이용
+    HistorySession* spare; // 예비 버퍼. 파일에 쓰는 동안 다른 스레드가 모을 수 있도록, 쓸 때 버퍼와 맞바꾼다.
+    unsigned char* output; // 묶음을 만드는 버퍼 (머리 부분 + HISTORY_BLOCK_SESSIONS * HISTORY_SESSION_SPACE)
+    unsigned short dictSession[HISTORY_DICT_SIZE]; // 사전 해시 테이블의 칸별로, 이름이 처음 나온 이용 번호 + 1 (0이면 빈 칸)
+    unsigned short dictIndex[HISTORY_DICT_SIZE]; // 사전 해시 테이블의 칸별 사전 번호
+    char path[MAX_PATH_LENGTH]; // 이용 기록 파일 경로
+} HistoryData;
+
+// 기록 파일 정보를 저장하는 구조체 생성
+typedef struct walData
+{
+    int fd; // 기록 파일
+    unsigned int generation; // 현재 기록 파일의 세대 번호
+    int bufferCount; // 버퍼에 모인 기록 수
+    int sinceSnapshot; // 마지막 스냅샷 이후의 기록 수
+    int needSync; // 파일에 썼으나 아직 디스크에 확정하지 않은 기록이 있으면 1
+    int archiveDays; // 지난 세대의 스냅샷과 기록 파일을 보관하는 일수, 0이면 보관하지 않음
+    long long int lastMark; // 마지막 시각 표시(WAL_MARK)의 시각. 시각이 바뀐 후의 첫 기록 앞에 시각 표시를 남긴다.
+    long long int snapshotTime; // 마지막 스냅샷을 만든 시각
+    pthread_mutex_t lock; // 여러 작업 스레드가 함께 기록하는 경우의 잠금. 스냅샷 작성 중 다시 얻을 수 있도록 재진입 가능한 잠금을 이용한다.
+    char walPath[MAX_PATH_LENGTH + 16]; // 기록 파일 경로
+    char snapshotPath[MAX_PATH_LENGTH + 16]; // 스냅샷 파일 경로
+    char dataDir[MAX_PATH_LENGTH]; // 기록 디렉터리
+    WalRecord buffer[WAL_BUFFER_RECORDS]; // 파일에 쓰기 전의 기록을 모아두는 버퍼
+} WalData;
 
 // 열람실 운영정보를 저장하는 구조체 생성
 typedef struct libraryData
 {
     int MAX_TIME; // 최대 이용 시간(분)
-    int MAX_RENEWABLE_TIME; // 좌석 연장 가능 시간(분) (횟수제한 없음. 반납 직후 재발급받으면 그만이라.)
+    int MAX_RENEWABLE_TIME; // 좌석 연장 가능 시간(분) (횟수는 설정 파일의 MAX_RENEWALS, DAILY_RENEWALS로 제한하며, 기본값은 제한 없음)
     int OPEN_TIME; // 열람실 개장 시간(시, 분)-분으로 환산
     int CLOSE_TIME; // 열람실 폐장 시간(시, 분)-분으로 환산
 } LibraryData;
 
+// 열람실 하나를 저장하는 구조체 생성
+// 열람실은 좌석 저장소 안의 연속된 좌석 범위(firstSeat번부터 seatCount개)이며, 운영정보와 이용종료시각 힙을 따로 가진다.
+// 따라서 만료된 좌석의 퇴실 처리, 폐장 후 좌석 초기화, 폐장시각 조정은 해당 열람실의 좌석만 순회한다.
+typedef struct roomData
+{
+    char name[MAX_ROOM_NAME]; // 열람실 이름
+    int firstSeat; // 열람실의 첫 좌석번호(0부터 시작)
+    int seatCount; // 열람실의 좌석 수
+    LibraryData libData; // 열람실 운영정보
+    int heapSize; // 열람실의 이용종료시각 힙에 들어있는 좌석 수
+    unsigned char heapLock; // 이용종료시각 힙 잠금. 열람실 좌석의 이용종료시각 열, 힙, 힙 위치 열을 보호한다.
+    unsigned char configLock; // 운영정보 잠금. 운영정보를 바꾸는 쪽끼리만 이용하며, 읽는 쪽은 잠금 없이 읽는다.
+} RoomData;
+
+// 대기열의 한 칸(기다리는 이용자 또는 좌석을 맡겨 둔 이용자)을 저장하는 구조체 생성
+typedef struct waitEntry
+{
+    char name[MAX_NAME_LENGTH]; // 이용자명, 차례가 되기 전에 대기열에서 빠진 칸은 빈 문자열
+    int room; // 기다리는 열람실 번호(1번부터 시작), 모든 열람실이면 0
+    int location; // 맡겨 둔 좌석번호 (맡긴 좌석 목록만 이용)
+    int notifyFd; // 차례가 되면 응답을 보낼 좌석 서비스 연결, 없으면 -1
+    int notifyPid; // 연결을 가진 좌석 서비스 프로세스
+    long long int deadline; // 맡겨 둔 좌석을 배정받아야 하는 시각(Unix 시간, 맡긴 좌석 목록만 이용), 배정받은 경우 0
+} WaitEntry;
+
+// 만석일 때 좌석을 기다리는 이용자의 대기열과, 차례가 되어 좌석을 맡겨 둔 이용자 목록을 저장하는 구조체 생성
+// 대기열은 우선순위마다 원형 큐(FIFO)이며, 좌석 저장소의 머리 부분에 있으므로 공유 좌석 파일을 이용하는 모든 단말기가 함께 이용한다.
+typedef struct waitList
+{
+    unsigned char lock; // 대기열 잠금. 좌석 잠금을 가진 채 얻을 수 있으며, 대기열 잠금을 가진 채 다른 잠금을 얻지 않는다.
+    int head[WAIT_CLASSES]; // 우선순위별 대기열의 맨 앞 위치
+    int count[WAIT_CLASSES]; // 우선순위별 대기열의 칸 수 (빠진 칸 포함)
+    int waiting; // 기다리는 이용자 수 (빠진 칸 제외)
+    int claimHead; // 맡긴 좌석 목록의 맨 앞 위치
+    int claimCount; // 맡긴 좌석 목록의 칸 수
+    int notifyCount; // 아직 좌석 서비스 연결에 알리지 않은 맡긴 좌석 수
+    unsigned int orphanCount; // 다른 프로세스의 대기 연결을 알리지 않은 채 빼거나 바꾼 횟수. 바뀌면 각 좌석 서비스가 남은 연결에 마지막 응답을 보낸다.
+    WaitEntry entries[WAIT_CLASSES][WAITLIST_SIZE]; // 우선순위별 대기열
+    WaitEntry claims[WAITLIST_SIZE]; // 맡긴 좌석 목록. 배정받아야 하는 시각 순이며, 배정받은 칸(시각 0)은 맨 앞에 올 때 지운다.
+} WaitList;
+
+// 이용불가 시간대 하나를 저장하는 구조체 생성
+// 선택한 좌석은 이어진 좌석 구간으로 나누어 구간마다 하나씩 저장하므로, 좌석 수와 관계없이 크기가 일정하다.
+typedef struct blackout
+{
+    int firstSeat; // 구간의 첫 좌석번호(0부터 시작)
+    int lastSeat; // 구간의 마지막 좌석번호(0부터 시작, 구간에 포함)
+    long long int start; // 시작시각(Unix 초)
+    long long int end; // 종료시각(Unix 초)
+    int isActive; // 시작하여 구간의 좌석을 이용불가로 바꾼 경우 1. 바꾼 좌석은 좌석 정보 구조체의 blackoutMap에 표시한다.
+} Blackout;
+
+// 이용 한도 표의 한 칸에 저장하는 이용자의 오늘 사용량 구조체 생성 (8바이트)
+// 날짜 번호가 오늘이 아닌 칸은 사용량이 0인 것으로 보므로, 날짜가 바뀌어도 표 전체를 비우지 않는다.
+typedef struct quotaCounter
+{
+    unsigned short day; // 사용량을 센 날짜 번호 (quotaDay, 1970/1/1부터의 일수), 빈 칸은 0
+    unsigned short renewals; // 오늘의 연장 횟수 (65535에서 멈춤)
+    unsigned int usedSeconds; // 오늘 끝난 이용의 시간 합(초)
+} QuotaCounter;
+
+// 좌석 저장소의 머리 부분 구조체 생성
+// 좌석 저장소 블록의 맨 앞에 위치하며, 공유 파일을 이용하는 경우 파일의 맨 앞에 그대로 저장된다.
+// 여러 단말기(프로세스)가 함께 바꾸는 값은 모두 이곳에 두고, 각 프로세스의 SeatsData에는 블록 안의 위치만 저장한다.
+typedef struct seatsHeader
+{
+    char magic[8]; // 공유 좌석 파일 표시 (SHARED_MAGIC)
+    unsigned int version; // 저장 형식 번호 (SHARED_VERSION)
+    int seatCount; // 좌석 수
+    unsigned long long int blockSize; // 머리 부분을 포함한 블록 전체의 크기(바이트)
+    int freeCount; // 빈 좌석 수
+    unsigned int resetCount; // 좌석 초기화 횟수. 좌석 배치도가 모든 좌석을 다시 그려야 하는지 판단한다.
+    int freeUserCount; // 쓰이지 않는 이용자 번호 수
+    unsigned char indexLock; // 이용자명 색인 잠금. 이용자명 표, 이용자 번호 열, 색인을 보호한다. 모든 열람실이 함께 이용한다.
+    int roomCount; // 열람실 수
+    RoomData rooms[MAX_ROOMS]; // 열람실별 좌석 범위, 운영정보와 이용종료시각 힙. 첫 좌석번호 순으로 빈틈없이 이어진다.
+    int reserveSlots; // 좌석마다 저장할 수 있는 예약 수
+    WaitList waitList; // 좌석 대기열
+    unsigned char blackoutLock; // 이용불가 시간대 잠금. 이 잠금을 가진 채로 다른 잠금을 얻지 않는다.
+    int blackoutCount; // 예약된 이용불가 시간대 수
+    Blackout blackouts[MAX_BLACKOUTS]; // 예약된 이용불가 시간대 (순서 없음)
+    int quotaUsers; // 이용 한도 표에 기록할 수 있는 이용자 수, 0이면 표가 없음
+    unsigned char quotaLocks[QUOTA_LOCK_STRIPES]; // 이용 한도 표의 구역별 잠금. 이 잠금을 가진 채로 다른 잠금을 얻지 않는다.
+} SeatsHeader;
+
+// 현재 시각을 읽는 방법(시계)을 저장하는 구조체 생성
+// 평소에는 시스템 시계를 이용하며, 시뮬레이션에서는 명령으로만 흐르는 가상 시계로 바꾸어 끼운다.
+typedef struct clockSource
+{
+    long long int (*read)(struct clockSource* source); // 현재 시각(Unix 시간)을 읽는 함수
+    long long int now; // 가상 시계의 현재 시각(Unix 시간) - 초 단위, 시스템 시계는 이용하지 않음
+} ClockSource;
+
+// 스레드 하나가 모으는 운영 지표를 저장하는 구조체 생성
+// 각 스레드는 자신의 구조체만 바꾸므로 잠금이나 원자적 연산 없이 더하며, 다른 스레드의 값과 캐시 라인을 나누지 않도록 정렬한다.
+typedef struct metricsData
+{
+    _Alignas(CACHE_LINE_SIZE) unsigned long long int counters[METRIC_COUNTERS]; // 카운터 (METRIC_ASSIGN 등)
+    unsigned long long int buckets[METRIC_OPERATIONS][METRIC_BUCKETS]; // 작업별 지연시간 히스토그램 (칸별 횟수)
+    unsigned long long int latencySum[METRIC_OPERATIONS]; // 작업별 지연시간의 합(ns)
+} MetricsData;
+
+// 프로세스의 운영 지표 전체를 저장하는 구조체 생성
+typedef struct metricsRegistry
+{
+    MetricsData* threads; // 스레드별 운영 지표 (METRIC_THREADS개)
+    int nextThread; // 다음 스레드에 나누어 줄 운영 지표 번호
+    int interval; // 지표 파일을 다시 쓰는 간격(초)
+    long long int lastExport; // 마지막으로 지표 파일을 쓴 시각(Unix 시간)
+    unsigned char exportLock; // 지표 파일을 쓰는 동안 잠금
+    char path[MAX_PATH_LENGTH]; // 지표 파일 경로
+} MetricsRegistry;
+
+// 출력한 좌석 배치도를 저장하는 구조체 생성 (프로세스마다 따로 가짐)
+// 좌석마다 마지막으로 그릴 때의 변경 번호를 저장해 두고, 변경 번호가 바뀐 좌석의 줄(격자의 경우 문자)만 다시 만든다.
+// 좌석의 변경 번호는 좌석 저장소에 있으므로, 다른 단말기(프로세스)에서 바꾼 좌석도 다시 그린다.
+typedef struct seatMap
+{
+    int view; // 마지막으로 그린 보기 방식 (SEATMAP_LIST 등), 아직 그리지 않은 경우 -1
+    int useGrid; // 설정에서 격자 보기를 고른 경우 1
+    unsigned int resetCount; // 마지막으로 그릴 때의 좌석 초기화 횟수
+    unsigned int* version; // 좌석별 마지막으로 그릴 때의 변경 번호
+    unsigned char* length; // 좌석별 목록 줄의 길이(바이트)
+    char (*lines)[SEATMAP_LINE_SIZE]; // 좌석별 목록 줄
+    char* grid; // 격자 전체 문자열 (범례 포함)
+    size_t gridLength; // 격자 전체 문자열의 길이(바이트)
+    char* output; // 목록을 모아서 쓰는 출력 버퍼 (SEATMAP_OUTPUT_SIZE)
+} SeatMap;
+
+// 좌석의 위치와 특징을 저장하는 구조체 생성 (프로세스마다 따로 가짐)
+// 좌석 배치 평면을 같은 크기의 정사각형 칸(격자)으로 나누고, 칸마다 들어 있는 좌석번호를 칸 순서대로 하나의 배열에 모아 둔다.
+// 가까운 좌석은 기준 위치의 칸부터 바깥쪽 테두리로 한 겹씩 넓혀 가며 찾으므로, 좌석 수와 관계없이 주변 칸의 좌석만 확인한다.
+typedef struct seatLayout
+{
+    int* x; // 좌석별 x좌표
+    int* y; // 좌석별 y좌표
+    unsigned char* attributes; // 좌석별 특징 (SEAT_POWER, SEAT_WINDOW, SEAT_QUIET의 합), 좌표가 적힌 좌석은 SEAT_PLACED를 포함한다.
+    int placedCount; // 좌표가 적힌 좌석 수
+    int minX; // 격자 왼쪽 아래 꼭짓점의 x좌표
+    int minY; // 격자 왼쪽 아래 꼭짓점의 y좌표
+    int cellSize; // 격자 한 칸의 한 변의 길이
+    int columns; // 격자의 가로 칸 수
+    int rows; // 격자의 세로 칸 수
+    int* cellStart; // 칸별 좌석 목록의 시작 위치 (칸 수 + 1개). 칸 c의 좌석은 cellSeats[cellStart[c]]부터 cellSeats[cellStart[c + 1]] 전까지이다.
+    int* cellSeats; // 칸 순서로 모은 좌석번호 (칸 안에서는 좌석번호 순)
+} SeatLayout;
+
+// 하루의 운영시간을 저장하는 구조체 생성. 개장시각과 폐장시각이 같으면 24시간, 폐장시각이 개장시각보다 앞서면 다음날 폐장한다.
+typedef struct dayHours
+{
+    short open; // 개장시각(0시 기준 분), 휴관일은 CALENDAR_CLOSED
+    short close; // 폐장시각(0시 기준 분)
+} DayHours;
+
+// 달력 파일의 날짜 예외를 저장하는 구조체 생성
+typedef struct calendarException
+{
+    int firstDay; // 첫날 (1970/1/1부터의 일수)
+    int lastDay; // 마지막 날 (1970/1/1부터의 일수)
+    unsigned int roomMask; // 적용할 열람실 (열람실 번호 i의 비트 1 << i)
+    DayHours hours; // 그 기간의 운영시간
+} CalendarException;
+
+// 열람실 하나의 운영 달력을 저장하는 구조체 생성 (프로세스마다 따로 가짐)
+// 요일별 운영시간과 날짜 예외를 날마다 풀어 [개장, 폐장) 운영 구간으로 만든 후, 이어지거나 겹치는 구간을 합쳐 시작시각 순으로 저장한다.
+// 현재 시각의 운영 구간은 마지막으로 찾은 구간부터 확인하고, 아닌 경우 이진 탐색으로 찾는다.
+typedef struct roomCalendar
+{
+    DayHours week[7]; // 요일별 운영시간 (0 : 일요일)
+    long long int from; // 운영 구간을 미리 계산한 기간의 시작 (첫날 0시, Unix 초)
+    long long int until; // 운영 구간을 미리 계산한 기간의 끝 (마지막 날 다음날 0시, Unix 초)
+    long long int* openAt; // 운영 구간의 개장시각 (Unix 초)
+    long long int* closeAt; // 운영 구간의 폐장시각 (Unix 초)
+    int count; // 운영 구간 수
+    int hint; // 마지막으로 찾은 운영 구간 번호
+    int isAllDay; // 기간 안의 모든 날이 24시간 운영인 경우 1
+} RoomCalendar;
+
+// 운영 달력을 저장하는 구조체 생성 (프로세스마다 따로 가짐)
+typedef struct operatingCalendar
+{
+    int roomCount; // 열람실 수
+    RoomCalendar rooms[MAX_ROOMS]; // 열람실별 운영 달력
+} OperatingCalendar;
+
+// 좌석 정보를 저장하는 구조체 생성
+// 좌석 정보는 열(column) 단위로 분리된 배열에 저장되며, 각 배열은 하나의 메모리 블록 안에서 캐시 라인 단위로 정렬된다.
+// 따라서 모든 좌석을 순회하는 함수는 자신이 필요로 하는 열만 읽는다.
+// 좌석 하나의 상태는 좌석별 잠금을 얻은 후 바꾸며, 잠금 순서는 좌석 -> 색인 또는 힙이다. 색인과 힙의 잠금은 함께 얻지 않는다. (resetSeats 제외)
+// 이용종료시각 힙은 열람실마다 따로 있으며, 열람실의 힙은 힙 열에서 열람실의 좌석 범위와 같은 위치를 이용한다.
+typedef struct seatsData
+{
+    SeatsHeader* header; // 블록 맨 앞의 머리 부분
+    int seatCount; // 좌석 수
+    unsigned int* endTime; // 이용 종료시각 열 - END_TIME_EPOCH부터의 초(packEndTime), 이용중인 좌석이 아닌 경우 0
+    unsigned int* seatUser; // 좌석 이용자 번호 열, NO_USER(0)이면 빈 좌석. 이용자명은 출력할 때만 이용자명 표에서 찾는다.
+    unsigned char* seatState; // 좌석 상태 열, SEAT_EMPTY(빈 좌석), SEAT_USED(이용중), SEAT_UNAVAILABLE(이용불가) 중 하나
+    unsigned char* seatLock; // 좌석별 잠금 열, 잠긴 경우 1
+    unsigned int* seatVersion; // 좌석별 변경 번호 열, 좌석 상태가 바뀔 때마다 1씩 증가한다.
+    char (*userName)[MAX_NAME_LENGTH]; // 이용자명 표, 이용자 번호로 찾는다. 0번(NO_USER)은 항상 ""이다.
+    unsigned int* userHash; // 이용자 번호별 이용자명 해시값
+    int* userSeat; // 이용자 번호별 좌석번호(0부터 시작)
+    unsigned int* freeUsers; // 쓰이지 않는 이용자 번호 스택, 위에서부터 freeUserCount개
+    int* userIndex; // 이용자명 -> 이용자 번호 색인(개방 주소법 해시 테이블), 빈 칸은 INDEX_EMPTY
+    unsigned int indexMask; // 색인 크기 - 1 (색인 크기는 좌석 수의 2배 이상인 2의 거듭제곱)
+    unsigned long long int* freeMap; // 빈 좌석 비트맵, 좌석 하나당 1비트이며 빈 좌석이면 1
+    unsigned long long int* unavailableMap; // 이용불가 좌석 비트맵, 이용불가 좌석이면 1 (두 비트맵 모두 0이면 이용중인 좌석)
+    unsigned long long int* blackoutMap; // 이용불가 시간대가 이용불가로 바꾼 좌석 비트맵. 시간대가 끝나면 이 좌석만 되돌리며, 관리자가 이용불가를 바꾸면 지운다.
+    int wordCount; // 비트맵의 워드 수
+    int* expiryHeap; // 열람실별로 이용중인 좌석을 이용종료시각 순으로 정렬한 최소 힙, 열람실의 첫 좌석번호 위치가 루트(가장 먼저 끝나는 좌석)
+    int* heapPos; // 좌석별 열람실의 최소 힙 안에서의 위치 열, 힙에 없는 좌석은 -1
+    int reserveSlots; // 좌석마다 저장할 수 있는 예약 수. 좌석 location의 예약은 location * reserveSlots번 칸부터 시작한다.
+    unsigned char* reserveCount; // 좌석별 예약 수 열
+    unsigned int* reserveStart; // 예약 시작시각 열(packEndTime). 좌석마다 시작시각 순으로 정렬되며, 예약끼리 겹치지 않으므로 종료시각 순서도 같다.
+    unsigned int* reserveEnd; // 예약 종료시각 열(packEndTime)
+    char (*reserveName)[MAX_NAME_LENGTH]; // 예약한 이용자명 열. 예약한 이용자가 입실할 때만 읽는다.
+    unsigned long long int* reservedMap; // 예약이 있는 좌석 비트맵, 예약이 하나 이상 있으면 1
+    unsigned int* sessionStart; // 배정 시각 열(packEndTime), 이용중인 좌석만 의미가 있다. 이용 기록에 이용한다.
+    unsigned char* renewCount; // 연장 횟수 열(255에서 멈춤), 이용중인 좌석만 의미가 있다.
+    unsigned int* quotaHash; // 이용 한도 표(이용자명 -> 오늘의 사용량, 개방 주소법 해시 테이블)의 칸별 이용자명 해시값
+    QuotaCounter* quotaCounter; // 이용 한도 표의 칸별 오늘의 사용량
+    char (*quotaName)[MAX_NAME_LENGTH]; // 이용 한도 표의 칸별 이용자명, 빈 칸은 "". 해시값이 같은 경우에만 읽는다.
+    unsigned int quotaMask; // 이용 한도 표 크기 - 1 (표 크기는 이용자 수의 2배 이상인 2의 거듭제곱), 표가 없으면 0
+    unsigned int quotaSegmentMask; // 이용 한도 표 구역 크기 - 1. 이용자의 칸은 이용자명 해시값의 위 비트로 정한 구역 안에서만 찾는다.
+    int dailyQuota; // 이용자별 하루 이용 한도(초), 0이면 제한 없음
+    int maxRenewals; // 이용 한 번의 최대 연장 횟수, 0이면 제한 없음
+    int dailyRenewals; // 이용자별 하루 최대 연장 횟수, 0이면 제한 없음
+    void* block; // 머리 부분과 모든 열을 담고 있는 메모리 블록
+    int isShared; // 블록이 공유 파일에 대응(mmap)된 경우 1, 프로세스 전용 메모리인 경우 0
+    WalData* wal; // 기록 파일 정보, 기록하지 않는 경우 NULL
+    int simdLevel; // 모든 좌석을 순회하는 함수가 이용하는 벡터 연산 수준 (SIMD_SCALAR 등)
+    ClockSource* clockSource; // 현재 시각을 읽는 시계, NULL이면 시스템 시계
+    MetricsRegistry* metrics; // 운영 지표, 모으지 않는 경우 NULL
+    SeatMap* seatMap; // 좌석 배치도, 대화형 모드가 아닌 경우 NULL
+    SeatLayout* layout; // 좌석의 위치와 특징, 배치 파일이 없거나 대화형 모드가 아닌 경우 NULL
+    OperatingCalendar* calendar; // 열람실별 운영 달력, 달력 파일이 없는 경우 NULL (열람실 운영정보의 개장, 폐장시각을 따름)
+    HistoryData* history; // 이용 기록, 기록하지 않는 경우(기록 복구 중 포함) NULL
+    struct serviceData* service; // 대기열의 차례를 알릴 좌석 서비스, 좌석 서비스가 아닌 경우 NULL
+} SeatsData;
+
+// 프로그램 설정을 저장하는 구조체 생성
+typedef struct systemConfig
+{
+    int seatCount; // 좌석 수
+    char dataDir[MAX_PATH_LENGTH]; // 좌석 상태를 기록할 디렉터리, ""이면 기록하지 않음
+    char sharedFile[MAX_PATH_LENGTH]; // 여러 단말기가 함께 이용하는 공유 좌석 파일, ""이면 공유하지 않음
+    int workerCount; // 좌석 서비스의 작업 스레드 수
+    char metricsFile[MAX_PATH_LENGTH]; // 운영 지표를 쓰는 파일, ""이면 모으지 않음
+    int metricsInterval; // 운영 지표 파일을 다시 쓰는 간격(초)
+    int seatMapGrid; // 좌석 선택과 이용불가 설정 화면에서 격자 보기를 이용하는 경우 1
+    char layoutFile[MAX_PATH_LENGTH]; // 좌석의 위치와 특징을 적은 배치 파일, ""이면 좌석을 추천하지 않음
+    char historyFile[MAX_PATH_LENGTH]; // 끝난 이용을 남기는 이용 기록 파일, ""이면 남기지 않음
+    char calendarFile[MAX_PATH_LENGTH]; // 요일별 운영시간과 날짜 예외를 적은 달력 파일, ""이면 열람실 운영정보의 개장, 폐장시각을 따름
+    int reserveSlots; // 좌석마다 저장할 수 있는 예약 수
+    int archiveDays; // 지난 세대의 스냅샷과 기록 파일을 보관하는 일수, 0이면 보관하지 않음
+    int dailyQuota; // 이용자별 하루 이용 한도(분), 0이면 제한 없음
+    int maxRenewals; // 이용 한 번의 최대 연장 횟수, 0이면 제한 없음
+    int dailyRenewals; // 이용자별 하루 최대 연장 횟수, 0이면 제한 없음
+    int quotaUsers; // 하루 이용 한도를 기록할 수 있는 이용자 수
+    int roomCount; // 설정 파일의 열람실(ROOM) 수, 없으면 0
+    RoomData rooms[MAX_ROOMS]; // 열람실 구성. 정하지 않은 운영정보는 -1이며, layoutRooms에서 전체 운영정보로 채운다.
+} SystemConfig;
+
+// 좌석 서비스의 작업 스레드가 함께 이용하는 정보를 저장하는 구조체 생성
+typedef struct serviceData
+{
+    int epollFd; // 대기 소켓, 연결, 종료 신호를 감시하는 epoll
+    int listenFd; // 대기 소켓
+    int stopFd; // 종료 신호를 받는 파이프
+    SeatsData* libSeats; // 좌석 정보 (운영정보는 좌석 저장소의 열람실별로 있다)
+    int waitFds[WAIT_PARKED_FDS]; // 좌석을 넘겨받을 때까지 응답을 미뤄 둔 대기 연결. 대기열 잠금을 가진 상태에서만 바꾸며, 여기서 뺀 스레드만 연결에 응답하거나 연결을 닫는다.
+    int waitFdCount; // 응답을 미뤄 둔 대기 연결 수
+    unsigned int orphanSeen; // 마지막으로 남은 연결을 확인했을 때의 대기열 orphanCount
+} ServiceData;
+
+// 대화형 모드의 자동 정리 스레드가 이용하는 정보를 저장하는 구조체 생성
+// 자동 정리 스레드는 다음으로 정리할 일이 생기는 시각에 맞춘 timerfd로 깨어나므로, 이용자의 입력이 없어도 제시각에 좌석을 회수한다.
+typedef struct housekeeper
+{
+    int epollFd; // timerfd와 깨우기 파이프를 감시하는 epoll
+    int timerFd; // 다음 정리 시각에 울리는 timerfd (시스템 시계 기준 절대 시각)
+    int wakePipe[2]; // 주 스레드가 요청을 처리한 후, 다음 정리 시각을 다시 계산하도록 깨우는 파이프
+    int isStopping; // 종료를 알린 경우 1
+    pthread_t thread; // 자동 정리 스레드
+    SeatsData* libSeats; // 좌석 정보
+} Housekeeper;
+
+// 일괄 처리의 진행 상황과 출력 버퍼를 저장하는 구조체 생성
+// 출력 버퍼가 크므로 스택이 아닌 정적 변수로 선언해 이용한다.
+typedef struct batchOutput
+{
+    int lineNumber; // 지금까지 읽은 줄 수
+    int commandCount; // 처리한 명령 수
+    int failCount; // 성공하지 못한 명령 수
+    int length; // 출력 버퍼에 쌓인 크기(바이트)
+    MetricsData* metrics; // 일괄 처리 스레드의 운영 지표, 모으지 않는 경우 NULL
+    char data[BATCH_OUTPUT_SIZE]; // 출력 버퍼
+} BatchOutput;
+
+// 성능 측정에서 함수 하나의 측정 결과를 저장하는 구조체 생성
+// 지연시간은 2의 거듭제곱 구간을 BENCH_SUB_BUCKETS칸으로 나눈 히스토그램에 모으므로, 측정 횟수와 관계없이 크기가 일정하다.
+typedef struct benchStat
+{
+    const char* name; // 함수 이름
+    long long int count; // 호출 횟수
+    long long int totalTime; // 지연시간의 합(ns)
+    long long int maxTime; // 가장 긴 지연시간(ns)
+    long long int buckets[BENCH_BUCKETS]; // 지연시간 히스토그램
+} BenchStat;
+
+// 성능 측정에서 하루를 나눈 구간 하나를 저장하는 구조체 생성
+typedef struct benchPhase
+{
+    int startMinute; // 구간 시작시각(0시 기준 분)
+    int endMinute; // 구간 종료시각(0시 기준 분)
+    int eventsPercent; // 좌석 수 대비 구간의 요청 수(%)
+    int kind; // 이용 형태 (BENCH_RUSH 등)
+} BenchPhase;
+
+// 한 번의 요청 동안 이용하는 현재 시각 정보를 저장하는 구조체 생성
+// 요청마다 한 번만 현재 시각을 읽고, 현재 운영일의 개장, 폐장시각을 미리 계산해 둔다.
+// 개장, 폐장시각은 열람실마다 다르므로, 다른 열람실의 시각이 필요한 경우 복사본에 setRoomClock으로 다시 계산한다.
+typedef struct clockContext
+{
+    long long int now; // 현재 시각(Unix 시간) - 초 단위
+    long long int midnight; // 오늘 0시(Unix 시간) - 초 단위
+    long long int openTime; // 현재 운영 구간의 개장시각, 운영시간이 아닌 경우 다음 운영 구간의 개장시각(Unix 시간) - 초 단위
+    long long int closeTime; // 현재 운영 구간의 폐장시각, 운영시간이 아닌 경우 지난 운영 구간의 폐장시각(Unix 시간) - 초 단위
+    int daySecond; // 0시 기준 현재 시각(초)
+    int weekDay; // 오늘의 요일 (0 : 일요일)
+    int isAllDay; // 24시간 운영인 경우 1, 아닌 경우 0
+} ClockContext;
+
 
 
 // 함수 목록
@@ -38,36 +700,268 @@ typedef struct libraryData
 // 초기화 함수
 void init(SeatsData* libSeats);
 
+// 좌석 저장소 생성 및 해제 함수
+int loadConfig(const char* path, SystemConfig* config, LibraryData* libData); // 설정 파일 읽기
+int parseRoomLine(const char* line, RoomData* room); // 설정 파일의 열람실(ROOM) 항목 읽기
+int layoutRooms(SystemConfig* config, LibraryData* libData); // 열람실의 좌석 범위와 운영정보 확정
+size_t layoutSeats(SeatsData* libSeats, int seatCount, int reserveSlots, int quotaUsers, char* block); // 좌석 저장소 블록의 열 배치
+int createSeats(SeatsData* libSeats, const RoomData* rooms, int roomCount, int reserveSlots, int quotaUsers); // 좌석 저장소 생성
+int mapSeats(const char* path, SeatsData* libSeats, const RoomData* rooms, int roomCount, int reserveSlots, int quotaUsers); // 공유 좌석 파일을 좌석 저장소로 이용
+void destroySeats(SeatsData* libSeats); // 좌석 저장소 해제
+
+// 잠금 함수
+void spinLock(unsigned char* lock); // 잠금 얻기
+void spinUnlock(unsigned char* lock); // 잠금 풀기
+
+// 시각 함수
+void captureClock(ClockContext* clock, SeatsData* libSeats, RoomData* room); // 현재 시각 정보 생성
+long long int readClock(SeatsData* libSeats); // 좌석 저장소의 시계로 현재 시각 읽기
+long long int readSystemClock(ClockSource* source); // 시스템 시계의 현재 시각
+long long int readVirtualClock(ClockSource* source); // 가상 시계의 현재 시각
+void initVirtualClock(ClockSource* source); // 가상 시계 생성
+void setClock(ClockContext* clock, SeatsData* libSeats, RoomData* room, long long int now); // 주어진 시각의 시각 정보 생성
+void setRoomClock(ClockContext* clock, SeatsData* libSeats, RoomData* room); // 시각 정보의 개장, 폐장시각을 다른 열람실의 것으로 다시 계산
+int appendHours(long long int* openAt, long long int* closeAt, int count, DayHours hours, long long int midnight, long long int nextMidnight); // 하루의 운영 구간 추가
+void findHours(ClockContext* clock, const long long int* openAt, const long long int* closeAt, int count, int* hint); // 현재 시각의 운영 구간 찾기
+
+// 열람실 함수
+RoomData* roomOf(SeatsData* libSeats, int location); // 좌석이 속한 열람실 찾기
+int isAnyRoomOpen(SeatsData* libSeats, ClockContext* clock); // 운영시간인 열람실이 있는지 확인
+void printRooms(SeatsData* libSeats, ClockContext* clock); // 열람실 목록 출력
+
 // 관리자 모드
-void adminMode(SeatsData* libSeats, LibraryData* libData);
+void adminMode(SeatsData* libSeats);
+void updateLibraryData(SeatsData* libSeats, RoomData* room, LibraryData* newData); // 운영정보 변경 반영
+void toggleSeatState(int location, SeatsData* libSeats); // 좌석 이용불가 설정 변경
+void bulkSeatMenu(SeatsData* libSeats); // 좌석 일괄 이용불가 설정 메뉴
 
 // 메뉴 선택 함수
-void menuSelect(char* tmp);
+int menuSelect(char* tmp);
 
 // 좌석 배정 시스템 함수
-void seatSelector(char* tmpName, SeatsData* libSeats, LibraryData* libData);
+void seatSelector(char* tmpName, SeatsData* libSeats, ClockContext* clock, MetricsData* metrics);
 
 // 좌석 배정, 연장 및 퇴실 함수
-void setSeat(char* tmpName, int location, SeatsData* libSeats, LibraryData* libData); // 좌석 배정
-void renewSeat(int location, SeatsData* libSeats, LibraryData* libData); // 좌석 연장
-void checkOut(int location, SeatsData* libSeats); // 퇴실
+int setSeat(char* tmpName, int location, SeatsData* libSeats, LibraryData* libData, ClockContext* clock); // 좌석 배정
+void renewSeat(int location, SeatsData* libSeats, LibraryData* libData, ClockContext* clock); // 좌석 연장
+void checkOut(int location, int reason, SeatsData* libSeats); // 퇴실
+int occupySeat(const char* name, int location, long long int startTime, long long int endTime, SeatsData* libSeats); // 이용종료시각을 정해 좌석 배정
+int autoAssign(char* name, SeatsData* libSeats, RoomData* room, ClockContext* clock); // 빈 좌석 자동 배정
 
 // 좌석 정보 출력 함수
-void printSeatInfo(SeatsData* libSeats, int isMaster); // 좌석 정보 출력
-void printRenewTime(int location, SeatsData* libSeats, LibraryData* libData); // 연장가능시각 출력
-void printEndTime(int location, SeatsData* libSeats); // 이용종료시각 출력
+void printSeatInfo(SeatsData* libSeats, int isMaster); // 좌석 정보 목록 출력
+void printSeatGrid(SeatsData* libSeats); // 좌석 정보 격자 출력
+void printSeatMap(SeatsData* libSeats, int isMaster); // 설정된 보기 방식으로 좌석 정보 출력
+void printRenewTime(int location, SeatsData* libSeats, LibraryData* libData, ClockContext* clock); // 연장가능시각 출력
+void printEndTime(int location, SeatsData* libSeats, ClockContext* clock); // 이용종료시각 출력
 
 // 관리 함수
-void seatInvalidCheck(SeatsData* libSeats); // 이용종료시간이 지난 좌석 자동 회수
-void resetSeats(SeatsData* libSeats, int isFirst); // 모든좌석 초기화
-void renewSeatEndTime(SeatsData* libSeats, LibraryData* libData); // 폐장시각 변경 시 이용종료시각 조정
+int seatInvalidCheck(SeatsData* libSeats, RoomData* room, ClockContext* clock); // 이용종료시간이 지난 좌석 자동 회수
+void expireSeats(SeatsData* libSeats, ClockContext* clock, MetricsData* metrics); // 만료된 좌석 및 폐장 후 좌석 자동 회수
+int resetSeats(SeatsData* libSeats, RoomData* room, int isFirst, int reason); // 열람실의 모든좌석 초기화
+void renewSeatEndTime(SeatsData* libSeats, RoomData* room, ClockContext* clock); // 폐장시각 변경 시 이용종료시각 조정
+void clampSeatEndTime(SeatsData* libSeats, RoomData* room, long long int closeTime); // 이용종료시각을 주어진 시각 이전으로 조정
+
+// 좌석 배치도 함수
+int seatMapOpen(SeatsData* libSeats, int useGrid); // 좌석 배치도 생성
+void seatMapClose(SeatsData* libSeats); // 좌석 배치도 해제
+int seatMapBegin(SeatsData* libSeats, int view); // 그리기 시작, 모든 좌석을 다시 그려야 하는지 확인
+int formatSeatLine(int location, int isMaster, char* line, SeatsData* libSeats); // 좌석 목록 한 줄 만들기
+size_t gridOffset(int location); // 격자 문자열 안에서 좌석의 위치
+int seatMapWrite(const char* data, size_t length); // 표준 출력에 한 번에 쓰기
+
+// 좌석 배치(좌석 추천) 함수
+int layoutOpen(const char* path, SeatsData* libSeats); // 배치 파일을 읽어 좌석 배치 생성
+void layoutClose(SeatsData* libSeats); // 좌석 배치 해제
+int parseLayoutLine(const char* line, SeatLayout* layout, int seatCount); // 배치 파일 한 줄 해석
+int buildLayoutGrid(SeatLayout* layout, int seatCount); // 좌석을 격자의 칸별로 모으기
+int suggestSeats(int reference, int attributes, int* result, SeatsData* libSeats, ClockContext* clock); // 조건에 맞는 가장 가까운 빈 좌석 찾기
+void printSuggestions(SeatsData* libSeats, ClockContext* clock); // 좌석 추천 조건을 입력받아 추천 좌석 출력
+
+// 운영 달력 함수
+int calendarOpen(const char* path, SeatsData* libSeats); // 달력 파일을 읽어 운영 달력 생성
+void calendarClose(SeatsData* libSeats); // 운영 달력 해제
+int parseCalendarLine(const char* line, DayHours (*week)[7], CalendarException* exceptions, int* exceptionCount, int roomCount); // 달력 파일 한 줄 해석
+int compileCalendar(RoomCalendar* calendar, const CalendarException* exceptions, int exceptionCount, int roomIndex, int firstDay, int lastDay); // 열람실의 운영 구간 계산
+int parseCalendarDate(const char* token, int length, int* day); // YYYY-MM-DD 형식의 날짜 읽기
+int civilDay(int year, int month, int day); // 날짜를 1970/1/1부터의 일수로 변환
+long long int dayMidnight(int day); // 1970/1/1부터의 일수인 날의 0시
+
+// 기록(WAL) 및 스냅샷 함수
+unsigned int recordChecksum(const WalRecord* record); // 기록의 검사합 계산
+void walLog(SeatsData* libSeats, unsigned char type, unsigned char state, int location, long long int time, const char* name); // 기록 추가
+void walAppend(SeatsData* libSeats, unsigned char type, unsigned char state, unsigned short minutes, int location, long long int time, const char* name); // 예약 시간을 포함한 기록 추가
+void walLogLibrary(SeatsData* libSeats, RoomData* room); // 운영정보 변경 기록 추가
+int walFlush(WalData* wal); // 버퍼의 기록을 파일에 쓰기
+void walCommit(SeatsData* libSeats); // 기록을 디스크에 확정하고, 필요한 경우 스냅샷 생성
+void walApply(const WalRecord* record, SeatsData* libSeats); // 기록을 좌석 정보에 적용
+long long int walReplay(const char* path, const char* magic, unsigned int generation, WalHeader* header, SeatsData* libSeats); // 파일의 기록을 모두 적용
+int writeSnapshot(SeatsData* libSeats); // 스냅샷 생성
+int walOpen(const char* dataDir, int archiveDays, SeatsData* libSeats); // 저장된 상태 복구 및 기록 시작
+void walInitLock(WalData* wal); // 기록 잠금 초기화
+void walClose(SeatsData* libSeats); // 마지막 스냅샷 생성 및 기록 종료
+void walArchive(WalData* wal, const char* path, const char* name, unsigned int generation); // 지난 세대 파일 보관
+void walPruneArchive(WalData* wal, long long int now); // 보관 기간이 지난 세대 파일 삭제
+
+// 지난 시각의 좌석 정보 복원 함수
+long long int checkpointTime(const char* path, unsigned int* generation); // 스냅샷을 만든 시각 읽기
+int replayUntil(const char* path, unsigned int generation, long long int target, ClockSource* clock, SeatsData* libSeats, long long int* applied); // 주어진 시각까지의 기록 적용
+long long int rebuildSeatsAt(const char* dataDir, long long int target, SeatsData* libSeats, unsigned int* checkpoint, long long int* checkpointAt); // 주어진 시각의 좌석 정보 복원
+int runPointInTime(const char* dataDir, const char* when, SeatsData* libSeats); // 지난 시각의 좌석 정보 출력
+void formatDateTime(long long int time, char* buffer, size_t size); // 시각을 YYYY-MM-DD HH:MM:SS 형식으로 쓰기
+
+// 좌석 서비스(데몬) 함수
+int runService(const char* socketPath, int workerCount, SeatsData* libSeats); // 좌석 서비스 실행
+void* serviceWorker(void* arg); // 작업 스레드
+void serveConnection(int fd, ServiceData* service, MetricsData* metrics); // 연결의 요청 처리
+void notifyWaiters(SeatsData* libSeats); // 좌석을 넘겨받은 대기 연결에 응답 보내기
+int parkWaiter(int fd, SeatsData* libSeats); // 응답을 미룰 대기 연결 등록
+int releaseWaiter(const WaitEntry* entry, SeatsData* libSeats); // 대기열에서 빠지는 칸의 대기 연결 넘겨받기
+void finishWait(int fd, unsigned char result, SeatsData* libSeats); // 대기 연결에 마지막 응답 보내기
+void replyWaiter(int fd, const SeatResponse* response, SeatsData* libSeats); // 대기 연결에 응답을 보내고 다시 감시 대상으로 등록
+int hangUpWaiter(int fd, SeatsData* libSeats); // 끊어진 대기 연결을 대기열에서 빼고 닫기
+void sweepWaiters(SeatsData* libSeats); // 다른 프로세스가 대기열에서 뺀 대기 연결에 마지막 응답 보내기
+void handleRequest(const SeatRequest* request, SeatResponse* response, SeatsData* libSeats, MetricsData* metrics, int fd); // 요청 하나 처리
+int adminCommand(const SeatRequest* request, SeatsData* libSeats); // 관리자 명령 실행
+int roomCommand(int command, int value, SeatsData* libSeats, RoomData* room); // 열람실 하나의 운영정보를 바꾸는 관리자 명령 실행
+void fillSeatResponse(int location, SeatResponse* response, SeatsData* libSeats, ClockContext* clock); // 좌석 정보를 응답에 저장
+
+// 자동 정리 함수
+int housekeeperStart(Housekeeper* keeper, SeatsData* libSeats); // 자동 정리 스레드 시작
+void housekeeperWake(Housekeeper* keeper); // 자동 정리 스레드를 깨워 다음 정리 시각 다시 계산
+void housekeeperStop(Housekeeper* keeper); // 자동 정리 스레드 종료
+void* housekeeperThread(void* arg); // 자동 정리 스레드
+long long int nextHousekeeping(SeatsData* libSeats, ClockContext* clock); // 다음으로 정리할 일이 생기는 시각 계산
+
+// 운영 지표(metrics) 함수
+int metricsOpen(const char* path, int interval, SeatsData* libSeats); // 운영 지표 모으기 시작
+MetricsData* metricsThread(SeatsData* libSeats); // 스레드의 운영 지표 얻기
+void metricCount(MetricsData* metrics, int counter, int amount); // 카운터 더하기
+long long int metricsNow(MetricsData* metrics); // 지연시간 측정 시작 시각
+void metricLatency(MetricsData* metrics, int operation, long long int start); // 지연시간 기록
+long long int metricBucketBound(int bucket); // 지연시간 히스토그램 칸의 상한
+int metricsExport(SeatsData* libSeats, int isForced); // 지표 파일 쓰기
+void metricsClose(SeatsData* libSeats); // 마지막 지표 파일을 쓰고 운영 지표 해제
+
+// 이용 기록(history) 함수
+int historyOpen(const char* path, SeatsData* libSeats); // 이용 기록 시작
+void historyClose(SeatsData* libSeats); // 남은 이용 기록을 쓰고 이용 기록 해제
+void historyRecord(int location, int reason, long long int now, SeatsData* libSeats); // 끝나는 이용 하나를 버퍼에 추가
+void historyCommit(SeatsData* libSeats, int isForced); // 버퍼에 모인 이용을 파일에 쓰기
+int historyFlush(HistoryData* history, const HistorySession* sessions, int count); // 이용들을 묶음 하나로 파일에 쓰기
+size_t putVarint(unsigned char* output, unsigned long long int value); // 가변 길이 정수 쓰기
+int getVarint(const unsigned char** cursor, const unsigned char* end, unsigned long long int* value); // 가변 길이 정수 읽기
+unsigned int historyChecksum(const unsigned char* data, size_t length); // 묶음 자료의 검사합 계산
+int runHistoryQuery(const char* path, const char* group, const char* range); // 이용 기록을 시간대, 요일 또는 좌석별로 집계
+
+// 일괄 처리 함수
+int runBatch(const char* path, SeatsData* libSeats); // 명령 파일 일괄 처리
+void batchLine(const char* line, const char* end, BatchOutput* output, SeatsData* libSeats); // 명령 한 줄 처리
+int parseBatchLine(const char* line, const char* end, long long int now, SeatRequest* request); // 명령 한 줄을 요청으로 변환
+int parseClockLine(const char* line, const char* end, long long int now, long long int* newTime); // 가상 시계를 옮기는 명령 읽기
+int parseDateTime(const char** cursor, const char* end, long long int now, long long int* time); // [YYYY-MM-DD] HH:MM 형식의 시각 읽기
+int nextToken(const char** cursor, const char* end, const char** token); // 다음 낱말 찾기
+int isToken(const char* token, int length, const char* word); // 낱말이 주어진 단어인지 확인
+int parseNumber(const char* token, int length, int* value); // 낱말을 정수로 변환
+int parseMinute(const char* token, int length, int* value); // 낱말(HH:MM 또는 분)을 0시 기준 분으로 변환
+void outputText(BatchOutput* output, const char* text, int length); // 출력 버퍼에 문자열 추가
+void outputNumber(BatchOutput* output, long long int value); // 출력 버퍼에 정수 추가
+void outputFlush(BatchOutput* output); // 출력 버퍼 비우기
+
+// 성능 측정(벤치마크) 함수
+int runBenchmark(const char* seatList); // 좌석 수별 성능 측정 및 결과 출력
+long long int benchDay(SeatsData* libSeats, LibraryData* libData, BenchStat* stats, char (*names)[MAX_NAME_LENGTH], int userCount); // 하루 동안의 요청 발생
+long long int benchNow(void); // 측정용 시각(ns)
+void benchRecord(BenchStat* stat, long long int elapsed); // 지연시간 기록
+long long int benchPercentile(BenchStat* stat, double fraction); // 지연시간 백분위수 계산
+unsigned int benchRandom(unsigned long long int* state); // 측정용 난수 생성
+
+// 이용자명 색인 함수
+unsigned int hashName(const char* name); // 이용자명 해시값 계산
+void indexInsert(unsigned int user, SeatsData* libSeats); // 색인에 이용자 추가
+void indexRemove(unsigned int user, SeatsData* libSeats); // 색인에서 이용자 삭제
+unsigned int indexFind(const char* name, SeatsData* libSeats); // 색인에서 이용자 번호 찾기
+unsigned int internUser(const char* name, int location, SeatsData* libSeats); // 이용자명 표에 이용자 추가
+void releaseUser(unsigned int user, SeatsData* libSeats); // 이용자명 표에서 이용자 삭제
+void resetUsers(SeatsData* libSeats); // 이용자명 표 비우기
+
+// 이용 한도 함수
+void quotaConfigure(SeatsData* libSeats, int dailyQuota, int maxRenewals, int dailyRenewals); // 이용 한도 적용
+unsigned short quotaDay(long long int midnight); // 주어진 날 0시의 날짜 번호 계산
+unsigned short quotaToday(long long int now); // 주어진 시각의 날짜 번호 계산
+unsigned int quotaSegment(unsigned int hash, SeatsData* libSeats); // 이용자명 해시값의 이용 한도 표 구역 계산
+int quotaFind(const char* name, unsigned int hash, unsigned short day, int isCreate, SeatsData* libSeats); // 이용 한도 표에서 이용자의 칸 찾기
+void quotaUsage(const char* name, unsigned short day, QuotaCounter* usage, SeatsData* libSeats); // 이용자의 오늘 사용량 읽기
+int quotaLeft(const char* name, ClockContext* clock, SeatsData* libSeats); // 이용자의 오늘 남은 이용 한도 계산
+int quotaRenewable(int location, ClockContext* clock, SeatsData* libSeats); // 연장 횟수와 이용 한도로 연장할 수 있는지 확인
+void quotaCharge(const char* name, unsigned short day, long long int seconds, int renewals, SeatsData* libSeats); // 이용자의 오늘 사용량에 더하기
+void quotaSession(int location, long long int now, unsigned short day, SeatsData* libSeats); // 끝나는 이용의 시간을 사용량에 더하기
+void applyQuota(const WalRecord* record, SeatsData* libSeats); // 사용량 기록 적용
+
+// 이용종료시각 힙 함수
+unsigned int packEndTime(long long int time); // Unix 시간을 이용종료시각 열의 값으로 변환
+long long int unpackEndTime(unsigned int packed); // 이용종료시각 열의 값을 Unix 시간으로 변환
+void expirySiftUp(int pos, RoomData* room, SeatsData* libSeats); // 힙 항목을 위로 이동
+void expirySiftDown(int pos, RoomData* room, SeatsData* libSeats); // 힙 항목을 아래로 이동
+void expiryInsert(int location, RoomData* room, SeatsData* libSeats); // 힙에 좌석 추가
+void expiryUpdate(int location, RoomData* room, SeatsData* libSeats); // 이용종료시각이 바뀐 좌석의 힙 위치 조정
+void expiryRemove(int location, RoomData* room, SeatsData* libSeats); // 힙에서 좌석 삭제
+
+// 좌석 일괄 설정 함수
+int parseSeatSelection(const char* cursor, const char* end, unsigned long long int* mask, SeatsData* libSeats); // 좌석 선택 문자열을 비트맵으로 변환
+int setSeatsState(const unsigned long long int* mask, int first, int last, unsigned char state, int isBlackout, SeatsData* libSeats); // 선택한 좌석의 이용불가 설정을 한 번에 변경
+int scheduleBlackout(const unsigned long long int* mask, long long int start, long long int end, SeatsData* libSeats); // 이용불가 시간대 예약
+int runBlackouts(SeatsData* libSeats, long long int now); // 시작하거나 끝난 이용불가 시간대 적용
+int releaseBlackout(const Blackout* ended, const Blackout* active, int activeCount, SeatsData* libSeats); // 끝난 이용불가 시간대의 좌석 되돌리기
+void logBlackout(SeatsData* libSeats, const Blackout* blackout, unsigned char change); // 이용불가 시간대 변경 기록
+void applyBlackout(const WalRecord* record, SeatsData* libSeats); // 이용불가 시간대 기록 적용
+void printBlackouts(SeatsData* libSeats); // 이용불가 시간대 목록 출력
+int batchBulkLine(const char* line, const char* end, SeatsData* libSeats); // 일괄 처리의 좌석 일괄 설정 명령 처리
+
+// 좌석 상태 함수
+void setSeatState(int location, unsigned char state, SeatsData* libSeats); // 좌석 상태 변경
+int findFreeSeat(SeatsData* libSeats, RoomData* room); // 열람실의 빈 좌석 찾기
+unsigned long long int rangeMask(int word, int first, int last); // 비트맵 워드 안에서 좌석 범위에 해당하는 비트
+
+// 좌석 예약 함수
+int reserveSeat(const char* name, int location, long long int start, long long int end, SeatsData* libSeats, ClockContext* clock); // 좌석 예약
+int cancelReservation(const char* name, int location, long long int start, SeatsData* libSeats, ClockContext* clock); // 예약 취소
+int checkReservation(long long int start, long long int end, SeatsData* libSeats, RoomData* room, ClockContext* clock); // 예약 시간이 올바른지 확인
+int findReservation(int location, long long int time, SeatsData* libSeats); // 주어진 시각 이후에 끝나는 첫 예약 찾기
+long long int nextReservation(int location, long long int now, SeatsData* libSeats); // 진행중이거나 다음 예약의 시작시각
+int isReserved(int location, long long int start, long long int end, SeatsData* libSeats); // 주어진 기간에 예약이 있는지 확인
+void insertReservation(const char* name, int location, long long int start, long long int end, SeatsData* libSeats); // 예약 추가
+void removeReservation(int location, int slot, SeatsData* libSeats); // 예약 삭제
+void pruneReservations(int location, long long int now, SeatsData* libSeats); // 끝난 예약 정리
+int findOpenSeat(SeatsData* libSeats, RoomData* room, long long int start, long long int end); // 주어진 기간에 예약이 없는 빈 좌석 찾기
+
+// 대기열 함수
+int joinWaitList(const char* name, int room, int priority, int fd, SeatsData* libSeats); // 대기열 등록
+int waitPosition(const char* name, WaitList* waitList); // 대기 순번 확인
+int takeWaiter(int room, WaitEntry* entry, WaitList* waitList); // 좌석을 넘겨받을 이용자를 대기열에서 꺼내기
+void dropWaiters(int room, SeatsData* libSeats); // 운영시간이 끝난 열람실의 대기열 비우기
+int handOffSeat(int location, SeatsData* libSeats); // 빈 좌석을 대기열의 차례인 이용자에게 맡기기
+int takeClaim(int location, const char* name, SeatsData* libSeats); // 맡긴 좌석을 배정받음으로 표시
+long long int findClaim(const char* name, long long int now, int* location, SeatsData* libSeats); // 이용자에게 맡긴 좌석 찾기
+void serveWaitList(SeatsData* libSeats, ClockContext* clock); // 맡긴 좌석의 시간 만료와 남은 빈 좌석 처리
+
+// 벡터 연산(SIMD) 함수
+int detectSimdLevel(void); // 이용 가능한 벡터 연산 수준 확인
+void clampColumn(unsigned int* column, int count, unsigned int limit, int simdLevel); // 열의 값을 limit 이하로 조정
+int releaseUsedSeats(unsigned char* state, int count, int simdLevel); // 이용중인 좌석을 빈 좌석으로 변경
+#ifdef SIMD_X86
+void clampColumnSse42(unsigned int* column, int count, unsigned int limit); // clampColumn의 SSE4.2 구현
+void clampColumnAvx2(unsigned int* column, int count, unsigned int limit); // clampColumn의 AVX2 구현
+int releaseUsedSse42(unsigned char* state, int count); // releaseUsedSeats의 SSE4.2 구현
+int releaseUsedAvx2(unsigned char* state, int count); // releaseUsedSeats의 AVX2 구현
+#endif
 
 // 보조 함수
 int findUser(char* tmpName, SeatsData* libSeats); // 이용자가 이용중인 좌석번호 찾기
 int isFull(SeatsData* libSeats); // 열람실이 가득찼는지 확인
-int isRenewable(int location, SeatsData* libSeats, LibraryData* libData); // 연장가능시각이 지났는지 확인
-int leftSeconds(LibraryData* libData); // 이용 종료까지 남은 시간(초) 확인
-int isOperationTime(LibraryData* libData); // 운영시간인지 확인
+int isRenewable(int location, SeatsData* libSeats, LibraryData* libData, ClockContext* clock); // 연장가능시각이 지났는지 확인
+int leftSeconds(ClockContext* clock); // 이용 종료까지 남은 시간(초) 확인
+int isOperationTime(ClockContext* clock); // 운영시간인지 확인
 
 // 함수 목록 끝
 
@@ -75,104 +969,155 @@ int isOperationTime(LibraryData* libData); // 운영시간인지 확인
 
 /*
 * resetSeats 함수
-* 기능 : 모든 좌석을 초기화함. 최초 실행시에는 모든 좌석을 초기화하며, 이후에는 이용불가 좌석을 제외한 모든 좌석을 초기화함.
-* 입력값 : 좌석 정보 구조체 포인터 *libSeats, isFirst(최초 실행 여부를 나타내는 변수이며, 1인 경우 최초 실행, 0인 경우 최초 실행이 아님)
-* 반환값 없음.
-* 설명 최종 수정 일자 : 2024/04/30
+* 기능 : 열람실의 모든 좌석을 초기화함. 최초 실행시에는 모든 좌석을 초기화하며, 이후에는 이용불가 좌석을 제외한 모든 좌석을 초기화함.
+*        다른 열람실의 좌석은 잠그거나 순회하지 않는다.
+* 입력값 : 좌석 정보 구조체 포인터 *libSeats, 열람실 구조체 포인터 *room, isFirst(최초 실행 여부를 나타내는 변수이며, 1인 경우 최초 실행, 0인 경우 최초 실행이 아님),
+*          reason(이용중인 좌석의 이용 기록에 남길 종료 사유, HISTORY_CLOSED 또는 HISTORY_RESET)
+* 반환값 : 빈 좌석으로 바꾼 이용중인 좌석 수 (최초 실행인 경우 0)
+* 설명 최종 수정 일자 : 2026/10/17
 */
-void resetSeats(SeatsData* libSeats, int isFirst)
+int resetSeats(SeatsData* libSeats, RoomData* room, int isFirst, int reason)
 {
-    // 모든 좌석에 대해 실행
-    for (int i = 0; i < SEATS; i++)
+    // 열람실의 좌석 범위 (first번부터 last - 1번까지)
+    int first = room->firstSeat, last = room->firstSeat + room->seatCount;
+    int* heap = libSeats->expiryHeap + first;
+    int released = 0, freeDelta = 0;
+    unsigned long long int mask = 0, freeBits = 0;
+
+    // 열람실의 모든 좌석을 바꾸므로, 좌석 번호 순으로 열람실의 모든 좌석의 잠금을 얻은 후 색인과 힙의 잠금을 얻는다.
+    // 다른 함수는 좌석 잠금을 하나만 가지므로, 좌석 번호 순으로 얻으면 서로 기다리며 멈추지 않는다.
+    for (int i = first; i < last; i++)
     {
-        // 좌석 이용자명 초기화
-        strncpy((libSeats + i)->seatsName, "", MAX_NAME_LENGTH);
+        spinLock(&libSeats->seatLock[i]);
+    }
+    spinLock(&libSeats->header->indexLock);
+    spinLock(&room->heapLock);
 
-        if (isFirst)
+    // 이용 기록을 남기는 경우, 이용중인 좌석(힙에 있는 좌석)의 이용을 지우기 전에 남긴다. 잠금을 가진 동안에는 버퍼에 모으기만 하며, 파일에는 호출한 쪽에서 잠금을 푼 후 쓴다.
+    if (libSeats->history != NULL)
+    {
+        long long int now = readClock(libSeats);
+        for (int i = 0; i < room->heapSize; i++)
         {
-            // 첫 실행인 경우에는 이용종료시각을 모두 0, 즉 이용가능상태로 초기화
-            (libSeats + i)->endTime = 0;
+            historyRecord(heap[i], reason, now, libSeats);
+        }
+    }
 
-        }else if ((libSeats + i)->endTime > 0){ // 함수의 최초 실행이 아니며, 이용불가 상태(endTime = -1)의 좌석이 아닌 경우
+    // 하루 이용 한도가 있는 경우, 끝나는 이용의 시간을 이용자의 오늘 사용량에 더한다.
+    if (libSeats->dailyQuota > 0)
+    {
+        long long int now = readClock(libSeats);
+        unsigned short day = quotaToday(now);
+        for (int i = 0; i < room->heapSize; i++)
+        {
+            quotaSession(heap[i], now, day, libSeats);
+        }
+    }
 
-            // 최초 실행이 아닌 경우에는, 이용불가 좌석을 제외한 좌석의 이용종료시각을 모두 0으로 초기화
-            (libSeats + i)->endTime = 0;
+    // 이용중인 좌석이 모두 비워지므로, 이용자명 표와 색인에서 이용자를 삭제한다.
+    // 열람실이 모든 좌석을 차지하는 경우 한번에 비우고, 아닌 경우 이용중인 좌석(힙에 있는 좌석)의 이용자만 삭제한다.
+    if (room->seatCount == libSeats->seatCount)
+    {
+        resetUsers(libSeats);
+    }else{
+        for (int i = 0; i < room->heapSize; i++)
+        {
+            releaseUser(libSeats->seatUser[heap[i]], libSeats);
         }
     }
 
-    return;
+    // 이용중이 아닌 좌석의 이용종료시각과 이용자 번호는 항상 0이므로, 두 열은 한번에 0으로 초기화한다. 이용종료시각 힙도 한번에 비운다.
+    memset(libSeats->endTime + first, 0, sizeof(unsigned int) * room->seatCount);
+    memset(libSeats->seatUser + first, 0, sizeof(unsigned int) * room->seatCount);
+    memset(libSeats->heapPos + first, 0xFF, sizeof(int) * room->seatCount);
+    room->heapSize = 0;
+
+    if (isFirst)
+    {
+        // 첫 실행인 경우에는 모든 좌석을 이용가능상태로 초기화하고, 예약도 모두 지운다.
+        memset(libSeats->seatState + first, SEAT_EMPTY, room->seatCount);
+        memset(libSeats->reserveCount + first, 0, room->seatCount);
+        if (room->seatCount == libSeats->seatCount)
+        {
+            memset(libSeats->userName, 0, sizeof(*libSeats->userName) * (libSeats->seatCount + 1));
+        }
+
+    }else{
+
+        // 최초 실행이 아닌 경우에는, 이용중인 좌석만 빈 좌석으로 되돌린다. 이용불가 좌석은 그대로 둔다.
+        // 이용자명 표에 남은 이름은 어느 좌석에서도 가리키지 않으므로 지우지 않는다.
+        released = releaseUsedSeats(libSeats->seatState + first, room->seatCount, libSeats->simdLevel);
+    }
+
+    // 이용불가 좌석을 제외한 모든 좌석이 빈 좌석이 되므로, 열람실 범위의 빈 좌석 비트맵은 이용불가 좌석 비트맵의 반전이다.
+    // 열람실의 경계에 있는 워드는 다른 열람실과 함께 이용하므로, 범위 안의 비트만 원자적 연산으로 바꾼다.
+    for (int i = first / BITMAP_WORD_BITS; i <= (last - 1) / BITMAP_WORD_BITS; i++)
+    {
+        mask = rangeMask(i, first, last);
+        if (isFirst)
+        {
+            __atomic_fetch_and(&libSeats->unavailableMap[i], ~mask, __ATOMIC_RELAXED);
+            __atomic_fetch_and(&libSeats->blackoutMap[i], ~mask, __ATOMIC_RELAXED);
+            __atomic_fetch_and(&libSeats->reservedMap[i], ~mask, __ATOMIC_RELAXED);
+        }
+        freeBits = ~__atomic_load_n(&libSeats->unavailableMap[i], __ATOMIC_RELAXED) & mask;
+        freeDelta += __builtin_popcountll(freeBits) - __builtin_popcountll(__atomic_load_n(&libSeats->freeMap[i], __ATOMIC_RELAXED) & mask);
+        __atomic_fetch_and(&libSeats->freeMap[i], ~mask | freeBits, __ATOMIC_RELEASE);
+        __atomic_fetch_or(&libSeats->freeMap[i], freeBits, __ATOMIC_RELEASE);
+    }
+    __atomic_add_fetch(&libSeats->header->freeCount, freeDelta, __ATOMIC_RELAXED);
+
+    // 좌석 상태를 한번에 바꾸었으므로, 좌석별 변경 번호 대신 초기화 횟수를 올려 좌석 배치도가 모든 좌석을 다시 그리게 한다.
+    __atomic_add_fetch(&libSeats->header->resetCount, 1, __ATOMIC_RELEASE);
+
+    // 얻은 순서의 반대로 잠금을 푼다.
+    spinUnlock(&room->heapLock);
+    spinUnlock(&libSeats->header->indexLock);
+    for (int i = last - 1; i >= first; i--)
+    {
+        spinUnlock(&libSeats->seatLock[i]);
+    }
+
+    // 열람실의 좌석 초기화를 기록한다.
+    walLog(libSeats, WAL_RESET, (unsigned char)isFirst, (int)(room - libSeats->header->rooms), 0, NULL);
+
+    return released;
 }
 
 
 /*
 * printEndTime 함수
 * 기능 : 주어진 좌석번호의 종료시각을 출력함.
-* 입력값 : location(0번부터 시작하는 좌석번호), 좌석 정보 구조체 포인터 *libSeats
+* 입력값 : location(0번부터 시작하는 좌석번호), 좌석 정보 구조체 포인터 *libSeats, 현재 시각 정보 구조체 포인터 *clock
 * 반환값 없음
-* 설명 최종 수정 일자 : 2024/04/30
+* 설명 최종 수정 일자 : 2026/10/17
 */
-void printEndTime(int location, SeatsData* libSeats)
+void printEndTime(int location, SeatsData* libSeats, ClockContext* clock)
 {
-    // 현재 시각 관련 변수 선언
-    time_t Time;
-    struct tm* pTime;
-    Time = time(NULL);
-    pTime = localtime(&Time);
-
     // 해당 좌석의 이용자가 없는 경우, 즉 빈좌석인 경우 내용을 출력하지 않음.
-    if (!strlen((libSeats + location)->seatsName)) // 빈 좌석의 이용자 이름의 길이는 0이다.
+    if (libSeats->seatState[location] != SEAT_USED) // 이용중인 좌석이 아닌 경우
     {
         return; // 함수 종료
     }
 
-    // 남은 시간 계산
-    // 종료 시각(Unix 초) - 현재 시각(Unix 초)의 방법으로 계산하며, 결괏값은 초 단위이다.
-    int remainSecondOrig = (libSeats + location)->endTime - ((long long int)Time);
-    int remainHour = remainSecondOrig / 3600;
-    int remainMinute = (remainSecondOrig % 3600) / 60;
-    int remainSecond = remainSecondOrig % 60;
-
-    // 현재 시각 가져오기
-    pTime = localtime(&Time);
-    int currHour = pTime->tm_hour;
-    int currMin = pTime->tm_min;
-    int currSecond = pTime->tm_sec;
-
-    // 종료 시각 계산
-    // 현재 시각에 남은 시간을 더한다.
-    int computeSecond = remainSecond + currSecond;
-    int computeMinute = remainMinute + currMin;
-    int computeHour = remainHour + currHour;
-
-
-    // 종료 시각의 초단위 값이 60 이상인 경우, 이를 조절한다.
-    if (computeSecond >= 60)
-    {
-        computeMinute += computeSecond / 60; // 초단위 값 초과분 만큼 분단위 값을 증가시킨다.
-        computeSecond %= 60; // 초단위 값은 60 미만의 값만을 처리한다.
-    }
-
-    // 종료 시각의 분단위 값이 60 이상인 경우, 이를 조절한다.
-    if (computeMinute >= 60)
-    {
-        computeHour += computeMinute / 60; // 분단위 값 초과분 만큼 시단위 값을 증가시킨다.
-        computeMinute %= 60; // 분단위 값은 60 미만의 값만을 처리한다.
-    }
+    // 오늘 0시 기준 종료 시각(초) 계산
+    // 종료 시각(Unix 초) - 오늘 0시(Unix 초)의 방법으로 계산한다.
+    long long int endSecond = unpackEndTime(libSeats->endTime[location]) - clock->midnight;
 
     // 종료 시각 문자 출력
     printf("종료 시각 : ");
 
-    // 종료 시각의 시단위 값이 24 이상인 경우, 이를 조절한다.
-    if (computeHour >= 24)
+    // 종료 시각이 24시 이후인 경우, 이를 조절한다.
+    if (endSecond >= 24 * 60 * 60)
     {
-        computeHour %= 24; // 시단위 값은 24 미만의 값만을 처리한다.
+        endSecond %= 24 * 60 * 60; // 24시간 미만의 값만을 처리한다.
 
         // 이 경우 다음날까지 이용하는 것이므로, 다음날까지 이용하는 것이라고 출력한다.
         printf("익일 "); // 최대 좌석 이용 시간은 24시간이므로, 2일 이후까지 이용하는 경우는 없다.
     }
 
     // 남은 종료 시각 정보 출력
-    printf("%d시 %d분 %d초\n", computeHour, computeMinute, computeSecond);
+    printf("%d시 %d분 %d초\n", (int)(endSecond / 3600), (int)((endSecond % 3600) / 60), (int)(endSecond % 60));
 
     return;
 }
@@ -180,373 +1125,8979 @@ void printEndTime(int location, SeatsData* libSeats)
 
 /*
 * printSeatInfo 함수
-* 기능 : 모든 좌석의 이용정보를 출력한다. 관리자의 경우, 이용중인 좌석에는 이용자명을 출력한다.
+* 기능 : 모든 좌석의 이용정보를 목록으로 출력한다. 관리자의 경우, 이용중인 좌석에는 이용자명을 출력한다.
+*        지난번에 그린 후 바뀐 좌석의 줄만 다시 만들고, 모든 줄을 출력 버퍼에 모아 한 번에 쓴다. seatMapOpen으로 좌석 배치도를 만든 후 호출해야 한다.
 * 입력값 : 좌석 정보 구조체 포인터 *libSeats, isMaster(관리자 모드 여부를 나타내는 변수이며, 1인 경우 관리자 모드, 0인 경우 이용자 모드이다)
 * 반환값 없음
-* 설명 최종 수정 일자 : 2024/04/30
+* 설명 최종 수정 일자 : 2026/10/17
 */
 void printSeatInfo(SeatsData* libSeats, int isMaster)
 {
-    // 출력할 이용 정보를 저장하는 변수
-    char info[30] = "";
-    for (int i = 0; i < SEATS; i++)
+    SeatMap* seatMap = libSeats->seatMap;
+    int redrawAll = seatMapBegin(libSeats, isMaster ? SEATMAP_MASTER : SEATMAP_LIST);
+    unsigned int version = 0;
+    size_t length = 0;
+
+    // 좌석별 변경 번호 열만을 순회하며, 변경 번호가 바뀐 좌석의 줄만 다시 만든다.
+    for (int i = 0; i < libSeats->seatCount; i++)
     {
-        // 좌석의 이용가능여부 판단
-        if ((libSeats + i)->endTime == -1) // 이용불가 좌석의 경우
+        version = __atomic_load_n(&libSeats->seatVersion[i], __ATOMIC_ACQUIRE);
+        if (redrawAll || version != seatMap->version[i])
         {
-            // 이용불가 출력
-            strcpy(info, "Unavailable");
-
-        }else{ // 이용가능 좌석의 경우
+            seatMap->length[i] = (unsigned char)formatSeatLine(i, isMaster, seatMap->lines[i], libSeats);
+            seatMap->version[i] = version;
+        }
 
-            // 빈 좌석 여부 판단
-            if ((libSeats + i)->endTime) // 빈 좌석(endtime == 0)이 아닌 경우
-            {
-                // 관리자 여부 확인
-                if (isMaster) // 관리자인 경우
-                {
-                    // 이용자의 이름 출력
-                    strcpy(info, "User ");
-                    strcat(info, (libSeats + i)->seatsName);
-                }else{
-                    // 이용중인 좌석임을 출력
-                    strcpy(info, "Used");
-                }
-            }else{ // 빈 좌석(endtime == 0)인 경우
-                // 빈 좌석임을 출력
-                strcpy(info, "Empty");
-            }
+        // 출력 버퍼가 가득 찬 경우에만 중간에 쓴다. 좌석이 2만 개 정도까지는 한 번에 쓴다.
+        if (length + SEATMAP_LINE_SIZE > SEATMAP_OUTPUT_SIZE)
+        {
+            seatMapWrite(seatMap->output, length);
+            length = 0;
         }
-        
-        // 좌석 정보 출력
-        printf("%d번 좌석: %s\n", i + 1, info); // 이용자에게 표시되는 좌석정보는 1부터 시작하는 좌석번호이므로, 0부터 시작하는 좌석번호에 1을 더한다.
+        memcpy(seatMap->output + length, seatMap->lines[i], seatMap->length[i]);
+        length += seatMap->length[i];
     }
 
+    seatMapWrite(seatMap->output, length);
+
     return;
 }
 
 
 /*
-* renewSeatEndTime 함수
-* 기능 : 폐장시각이 바뀌어 이용종료시각이 폐장시각 이후가 된 경우 이를 폐장시각으로 조정한다.
-* 입력값 : 좌석 정보 구조체 포인터 *libSeats, 시설 정보 구조체 포인터 *libData
+* printSeatGrid 함수
+* 기능 : 모든 좌석의 상태를 격자로 출력한다. 좌석 하나를 문자 하나로 나타내며, 한 줄에 SEATMAP_GRID_COLUMNS개의 좌석을 출력한다.
+*        격자 문자열은 좌석마다 위치가 정해져 있으므로, 바뀐 좌석의 문자만 고친 후 전체를 한 번에 쓴다. seatMapOpen으로 좌석 배치도를 만든 후 호출해야 한다.
+* 입력값 : 좌석 정보 구조체 포인터 *libSeats
 * 반환값 없음
-* 설명 최종 수정 일자 : 2024/04/30
+* 설명 최종 수정 일자 : 2026/10/17
 */
-void renewSeatEndTime(SeatsData* libSeats, LibraryData* libData)
+void printSeatGrid(SeatsData* libSeats)
 {
-    // 현재 시각 관련 변수 선언
-    time_t Time;
-    struct tm* pTime;
-    Time = time(NULL);
-    pTime = localtime(&Time);
+    static const char stateChars[] = { '.', '#', 'X' }; // SEAT_EMPTY, SEAT_USED, SEAT_UNAVAILABLE 순서
+    SeatMap* seatMap = libSeats->seatMap;
+    int redrawAll = seatMapBegin(libSeats, SEATMAP_GRID);
+    unsigned int version = 0;
 
-    // 임시로 시간 정보를 저장하는 변수 선언. 이 변수의 최댓값은 86400(1일의 초 단위)임.
-    int tmpTime = 0;
-
-    // 24시간제의 경우 해당 함수가 필요 없으므로 함수 종료.
-    if (libData->OPEN_TIME == libData->CLOSE_TIME) { return; }
-
-    // 모든 좌석에 대해 반복
-    for (int i = 0; i < SEATS; i++)
+    for (int i = 0; i < libSeats->seatCount; i++)
     {
-        // 좌석 이용불가 상태 건너뛰기
-        if (((libSeats + i)->endTime) <= 0) // endTime <= 0, 즉 좌석 미배정 혹은 이용불가 상태인 경우
+        version = __atomic_load_n(&libSeats->seatVersion[i], __ATOMIC_ACQUIRE);
+        if (redrawAll || version != seatMap->version[i])
         {
-            i++; // 다음 좌석으로 이동
-            if (i >= SEATS) { return; } // 모든 좌석을 확인한 경우, 함수 종료.
+            seatMap->grid[gridOffset(i)] = stateChars[libSeats->seatState[i] % 3];
+            seatMap->version[i] = version;
         }
+    }
 
-        // 좌석의 남은 시간을 임시로 저장함.
-        tmpTime = (libSeats + i)->endTime - (long long int)(Time);
-
-        // 개장시각과 폐장시각에 따라 구분
-        // 24시간제의 경우, 폐장시각으로 인해 연장 불가능한 경우가 없으으로 해당 조건문에서 구분하지 않음.
-        if (libData->OPEN_TIME < libData->CLOSE_TIME) // 개장시각이 폐장시각보다 앞에 있는 경우
-        {
-            // 개인별 종료 시각(Unix 초) - 현재 시각(Unix 초) = 남은 시간(초) > 폐장 시각(초) - 현재 시각(초) = 남은 시각(초) 인 경우, 이용종료시각 조정이 필요함
+    seatMapWrite(seatMap->grid, seatMap->gridLength);
 
-            // 폐장시각이 변경되어 퇴실시각이 폐장시각 이후가 된 경우
-            if (((libSeats + i)->endTime - ((long long int)Time)) >= ((libData->CLOSE_TIME * 60) - (pTime->tm_hour) * 60 * 60 - (pTime->tm_min) * 60 - (pTime->tm_sec)))
-            {
-                // 개인별 종료 시각(Unix 초)을 현재 시각(Unix 초) + 폐장시각까지 남은 시각(초) 으로 변경
-                (libSeats + i)->endTime = (long long int)Time + (libData->CLOSE_TIME * 60) - (pTime->tm_hour) * 60 * 60 - (pTime->tm_min) * 60 - (pTime->tm_sec);
-            }
+    return;
+}
 
-        }else if (libData->OPEN_TIME > libData->CLOSE_TIME){ // 개장시각이 폐장시각보다 뒤에 있는 경우
 
-            if (((libData->OPEN_TIME * 60) - (pTime->tm_hour) * 60 * 60 - (pTime->tm_min) * 60 - (pTime->tm_sec)) >= 0) // 개장시각이 폐장시각보다 뒤에 있으며, 00시를 지난 경우 (개장 시각 이후)
-            {
-                // 개인별 종료 시각(Unix 초) - 현재 시각(Unix 초) = 남은 시간(초) > 폐장 시각(초) - 현재 시각(초) = 남은 시각(초) 인 경우, 이용종료시각 조정이 필요함
+/*
+* printSeatMap 함수
+* 기능 : 설정된 보기 방식(SEAT_MAP)에 따라 좌석 정보를 격자 또는 목록으로 출력한다.
+* 입력값 : 좌석 정보 구조체 포인터 *libSeats, isMaster(관리자 모드 여부를 나타내는 변수이며, 1인 경우 관리자 모드, 0인 경우 이용자 모드이다)
+* 반환값 없음
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+void printSeatMap(SeatsData* libSeats, int isMaster)
+{
+    if (libSeats->seatMap->useGrid)
+    {
+        printSeatGrid(libSeats);
+    }else{
+        printSeatInfo(libSeats, isMaster);
+    }
 
-                // 폐장시각이 변경되어 퇴실시각이 폐장시각 이후가 된 경우
-                if (((libSeats + i)->endTime - ((long long int)Time)) > ((libData->CLOSE_TIME * 60) - (pTime->tm_hour) * 60 * 60 - (pTime->tm_min) * 60 - (pTime->tm_sec)))
-                {
-                    // 개인별 종료 시각(Unix 초)을 현재 시각(Unix 초) + 폐장시각까지 남은 시각(초) 으로 변경
-                    (libSeats + i)->endTime = (long long int)Time + (libData->CLOSE_TIME * 60) - (pTime->tm_hour) * 60 * 60 - (pTime->tm_min) * 60 - (pTime->tm_sec);
-                }
+    return;
+}
 
-            }else{ // 개장시각이 폐장시각보다 뒤에 있으며, 00시를 지나지 않은 경우 (개장 시각 이전)
 
-                // 개인별 종료 시각(Unix 초) - 현재 시각(Unix 초) = 남은 시간(초) > 폐장 시각(초) + 1일(86400초) - 현재 시각(초) = 남은 시각(초) 인 경우, 이용종료시각 조정이 필요함
+/*
+* seatMapOpen 함수
+* 기능 : 좌석 배치도(출력한 목록과 격자)를 저장할 공간을 만든다. 격자의 좌석번호 칸과 줄바꿈은 이때 한 번만 채운다.
+* 입력값 : 좌석 정보 구조체 포인터 *libSeats, useGrid(격자 보기를 이용하는 경우 1)
+* 반환값 : 성공한 경우 1, 실패한 경우 0을 반환함.
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+int seatMapOpen(SeatsData* libSeats, int useGrid)
+{
+    int seatCount = libSeats->seatCount;
+    int rows = (seatCount + SEATMAP_GRID_COLUMNS - 1) / SEATMAP_GRID_COLUMNS;
+    size_t legendLength = strlen(SEATMAP_GRID_LEGEND);
+    char* row = NULL;
+    char label[16];
+    SeatMap* seatMap = malloc(sizeof(SeatMap));
+    if (seatMap == NULL)
+    {
+        return 0;
+    }
 
-                // 폐장시각이 변경되어 퇴실시각이 폐장시각 이후가 된 경우
-                if (((libSeats + i)->endTime - ((long long int)Time)) > ((libData->CLOSE_TIME * 60) + 24 * 60 * 60 - (pTime->tm_hour) * 60 * 60 - (pTime->tm_min) * 60 - (pTime->tm_sec)))
-                {
-                    // 개인별 종료 시각(Unix 초)을 현재 시각(Unix 초) + 폐장시각까지 남은 시각(초) 으로 변경
-                    (libSeats + i)->endTime = (long long int)Time + (libData->CLOSE_TIME * 60) - (pTime->tm_hour) * 60 * 60 - (pTime->tm_min) * 60 - (pTime->tm_sec);
-                }
-            }
+    seatMap->version = malloc(sizeof(unsigned int) * seatCount);
+    seatMap->length = malloc(sizeof(unsigned char) * seatCount);
+    seatMap->lines = malloc(sizeof(*seatMap->lines) * seatCount);
+    seatMap->grid = malloc(legendLength + (size_t)SEATMAP_GRID_ROW * rows);
+    seatMap->output = malloc(SEATMAP_OUTPUT_SIZE);
+    if (seatMap->version == NULL || seatMap->length == NULL || seatMap->lines == NULL || seatMap->grid == NULL || seatMap->output == NULL)
+    {
+        free(seatMap->version);
+        free(seatMap->length);
+        free(seatMap->lines);
+        free(seatMap->grid);
+        free(seatMap->output);
+        free(seatMap);
+        return 0;
+    }
+    seatMap->view = -1;
+    seatMap->useGrid = useGrid;
+    seatMap->resetCount = 0;
 
-        }
+    // 격자의 각 줄은 좌석번호 칸, 좌석 문자(10개마다 빈칸), 줄바꿈으로 이루어진다. 좌석 문자는 처음 그릴 때 채운다.
+    memcpy(seatMap->grid, SEATMAP_GRID_LEGEND, legendLength);
+    for (int r = 0; r < rows; r++)
+    {
+        row = seatMap->grid + legendLength + (size_t)SEATMAP_GRID_ROW * r;
+        memset(row, ' ', SEATMAP_GRID_ROW - 1);
+        snprintf(label, sizeof(label), "%7d", r * SEATMAP_GRID_COLUMNS + 1); // 좌석 수는 MAX_SEATS 이하이므로 7자리를 넘지 않는다.
+        memcpy(row, label, SEATMAP_GRID_LABEL - 1);
+        row[SEATMAP_GRID_ROW - 1] = '\n';
     }
 
-    return;
+    // 마지막 줄은 마지막 좌석 다음에서 끝낸다.
+    seatMap->gridLength = gridOffset(seatCount - 1) + 2;
+    seatMap->grid[seatMap->gridLength - 1] = '\n';
+
+    libSeats->seatMap = seatMap;
+
+    return 1;
 }
 
 
 /*
-* adminMode 함수
-* 기능 : 관리자 모드 실행
-* 입력값 : 좌석 정보 구조체 포인터 *libSeats, 시설 정보 구조체 포인터 *libData
+* seatMapClose 함수
+* 기능 : 좌석 배치도를 해제한다. 좌석 배치도가 없는 경우 아무것도 하지 않는다.
+* 입력값 : 좌석 정보 구조체 포인터 *libSeats
 * 반환값 없음
-* 설명 최종 수정 일자 : 2024/04/30
+* 설명 최종 수정 일자 : 2026/10/17
 */
-void adminMode(SeatsData* libSeats, LibraryData *libData)
+void seatMapClose(SeatsData* libSeats)
 {
-    /*
-    * 관리자 모드 관련 변수 선언
-    * 
-    * menu_sel : 입력한 메뉴의 번호
-    * tmpTime : 입력한 시간값을 임시로 저장하는 변수
-    * oldData : 잘못 입력할 것을 대비해, 기존 시간값을 임시로 저장하는 변수
-    * tmpSeatNo : 좌석 이용불가 설정에서, 좌석 이용불가 설정을 바꿀 좌석번호를 임시로 저장하는 변수
-    */
-    int menu_sel = -1, tmpTime = 0, oldData = 0, tmpSeatNo = 0;
-
-    // 무한 반복, 관리자 모드 종료(0 입력)시 return으로 함수 종료
-    while (1)
+    SeatMap* seatMap = libSeats->seatMap;
+    if (seatMap == NULL)
     {
-        /*
-        * 관리자 모드의 메뉴
-        * 
-        * 1 : 좌석 초기화
-        * 2 : 최대 이용 가능 시간 수정
-        * 3 : 연장 가능 시간 수정
-        * 4 : 개장시각 수정
-        * 5 : 폐장시각 수정
-        * 6 : 모든 좌석 정보 보기
-        * 7 : 좌석 이용불가 설정
-        * 0 : 관리자 모드 나가기
-        */
-
-        // 관리자 모드의 메뉴 출력 및 입력값 입력
-        printf("1 : 좌석 초기화, 2 : 최대 이용 가능 시간 수정, 3: 연장 가능 시간 수정, 4 : 개장시각 수정, 5: 폐장시각 수정, 6: 모든 좌석 정보 보기, 7: 좌석 이용불가 설정, 0: 나가기 : ");
-        scanf("%d", &menu_sel);
-
-        // 선택한 관리자 모드의 메뉴 실행
-        switch (menu_sel)
-        {
-        case 1: // 좌석 초기화
+        return;
+    }
 
-            // 이용불가좌석을 제외한 모든 좌석을 초기화함.
-            resetSeats(libSeats, 0);
+    free(seatMap->version);
+    free(seatMap->length);
+    free(seatMap->lines);
+    free(seatMap->grid);
+    free(seatMap->output);
+    free(seatMap);
+    libSeats->seatMap = NULL;
 
-            break;
+    return;
+}
 
-        case 2: // 최대 이용 가능 시간 수정
 
-            // 기존 최대이용시간 저장
-            oldData = libData->MAX_TIME;
+/*
+* seatMapBegin 함수
+* 기능 : 좌석 배치도를 그리기 전에 호출한다. 보기 방식이 지난번과 다르거나 그 사이 좌석이 초기화된 경우, 모든 좌석을 다시 그려야 함을 알린다.
+*        printf로 쌓인 출력이 배치도보다 먼저 나오도록 표준 출력 버퍼를 비운다.
+* 입력값 : 좌석 정보 구조체 포인터 *libSeats, view(그릴 보기 방식, SEATMAP_LIST 등)
+* 반환값 : 모든 좌석을 다시 그려야 하는 경우 1, 바뀐 좌석만 그리면 되는 경우 0
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+int seatMapBegin(SeatsData* libSeats, int view)
+{
+    SeatMap* seatMap = libSeats->seatMap;
+    unsigned int resetCount = __atomic_load_n(&libSeats->header->resetCount, __ATOMIC_ACQUIRE);
+    int redrawAll = (seatMap->view != view || seatMap->resetCount != resetCount);
 
-            do {
-                // 기존 최대 이용 가능 시간 복원. 이는 잘못된 값을 입력받았을 때 복원하는 용도로 이용된다.
-                libData->MAX_TIME = oldData;
+    seatMap->view = view;
+    seatMap->resetCount = resetCount;
+    fflush(stdout);
 
-                // 기존값 출력 및 신규값 입력
-                printf("현재 최대 이용 가능 시간 : %d 시간 %d 분\n", libData->MAX_TIME / 60, libData->MAX_TIME % 60);
-                printf("최대 이용 가능 시간 수정. 시간 : ");
-                scanf("%d", &tmpTime); // 시간 단위 입력
-                libData->MAX_TIME = tmpTime * 60; // 시간 단위를 분단위로 환산 후 저장
-                printf("분 : ");
-                scanf("%d", &tmpTime); // 분단위 입력
-                libData->MAX_TIME += tmpTime; // 저장된 시간 단위 입력값에 분단위 입력값 추가
+    return redrawAll;
+}
 
-                // 잘못된 값인지 확인
-                if (libData->MAX_TIME <= 0 || libData->MAX_TIME > 24 * 60)
-                {
-                    printf("최대 이용 가능 시간은 1분 이상 24시간 이하여야 합니다.\n");
-                }
-            } while (libData->MAX_TIME <= 0 || libData->MAX_TIME > 24 * 60); // 옳은 입력값이 입력될때까지 반복
 
-            // 새 최대 이용가능 시간이 최대 연장가능 시간을 초과하는 경우
-            if (libData->MAX_TIME < libData->MAX_RENEWABLE_TIME)
-            {
-                // 최대 연장가능 시간을 새 최대 이용가능 시간으로 수정
-                libData->MAX_RENEWABLE_TIME = libData->MAX_TIME;
+/*
+* formatSeatLine 함수
+* 기능 : 주어진 좌석의 목록 한 줄을 만든다.
+* 입력값 : location(0번부터 시작하는 좌석번호), isMaster(관리자 모드인 경우 1), 줄을 저장할 배열 line(SEATMAP_LINE_SIZE 바이트), 좌석 정보 구조체 포인터 *libSeats
+* 반환값 : 줄의 길이(바이트, 줄바꿈 포함)
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+int formatSeatLine(int location, int isMaster, char* line, SeatsData* libSeats)
+{
+    int length = 0;
 
-                // 최대 연장가능 시간을 새 최대 이용가능 시간으로 수정하였음을 알림
-                printf("최대 이용 가능시간 변경으로 인해 연장 가능 시간이 끝나기 %d 시간 %d 분 전으로 변경되었습니다.\n", libData->MAX_RENEWABLE_TIME / 60, libData->MAX_RENEWABLE_TIME % 60);
-            }
+    // 이용자에게 표시되는 좌석정보는 1부터 시작하는 좌석번호이므로, 0부터 시작하는 좌석번호에 1을 더한다.
+    switch (libSeats->seatState[location])
+    {
+    case SEAT_UNAVAILABLE: // 이용불가 좌석의 경우
+        length = snprintf(line, SEATMAP_LINE_SIZE, "%d번 좌석: Unavailable\n", location + 1);
+        break;
 
-            break;
+    case SEAT_USED: // 이용중인 좌석의 경우
+        if (isMaster) // 관리자인 경우, 이용자명 표에서 이용자의 이름을 찾아 출력
+        {
+            length = snprintf(line, SEATMAP_LINE_SIZE, "%d번 좌석: User %s\n", location + 1, libSeats->userName[libSeats->seatUser[location]]);
+        }else{ // 이용자인 경우, 이용중인 좌석임을 출력
+            length = snprintf(line, SEATMAP_LINE_SIZE, "%d번 좌석: Used\n", location + 1);
+        }
+        break;
 
-        case 3: // 연장 가능 시간 수정
+    default: // 빈 좌석의 경우
+        length = snprintf(line, SEATMAP_LINE_SIZE, "%d번 좌석: Empty\n", location + 1);
+    }
 
-            // 기존 연장 가능 시간 저장
-            oldData = libData->MAX_RENEWABLE_TIME;
+    // 줄이 잘린 경우에도 줄바꿈으로 끝나게 한다. (SEATMAP_LINE_SIZE는 가장 긴 줄보다 크므로 일어나지 않는다.)
+    if (length >= SEATMAP_LINE_SIZE)
+    {
+        length = SEATMAP_LINE_SIZE - 1;
+        line[length - 1] = '\n';
+    }
 
-            do {
-                // 기존 연장 가능 시간 복원. 이는 잘못된 값을 입력받았을 때 복원하는 용도로 이용된다.
-                libData->MAX_RENEWABLE_TIME = oldData;
+    return length;
+}
 
-                // 기존값 출력 및 신규값 입력
-                printf("현재 최대 이용 가능 시간 : %d 시간 %d 분\n", libData->MAX_TIME / 60, libData->MAX_TIME % 60);
-                printf("현재 연장 가능 시간 : 끝나기 %d 시간 %d 분 전\n", libData->MAX_RENEWABLE_TIME / 60, libData->MAX_RENEWABLE_TIME % 60);
-                printf("연장 가능 시간 수정. 시간 : ");
-                scanf("%d", &tmpTime); // 시간 단위 입력
-                libData->MAX_RENEWABLE_TIME = tmpTime * 60; // 시간 단위를 분단위로 환산 후 저장
-                printf("분 : ");
-                scanf("%d", &tmpTime); // 분단위 입력
-                libData->MAX_RENEWABLE_TIME += tmpTime; // 저장된 시간 단위 입력값에 분단위 입력값 추가
 
-                // 잘못된 값인지 확인. 이는 0분 이상 24시간 이하여야 하며, 최대 이용가능 시간을 초과할 수 없음.
-                if ((libData->MAX_RENEWABLE_TIME < 0 || libData->MAX_RENEWABLE_TIME > 24 * 60) || (libData->MAX_TIME < libData->MAX_RENEWABLE_TIME))
-                {
-                    printf("연장 가능 시간은 0분 이상 24시간 이하여야 하며, 최대 이용 가능 시간을 초과할 수 없습니다.\n");
-                }
+/*
+* gridOffset 함수
+* 기능 : 격자 문자열 안에서 주어진 좌석을 나타내는 문자의 위치를 계산한다.
+* 입력값 : location(0번부터 시작하는 좌석번호)
+* 반환값 : 격자 문자열의 맨 앞부터의 위치(바이트)
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+size_t gridOffset(int location)
+{
+    int column = location % SEATMAP_GRID_COLUMNS;
 
-            } while ((libData->MAX_RENEWABLE_TIME < 0 || libData->MAX_RENEWABLE_TIME > 24 * 60) || (libData->MAX_TIME < libData->MAX_RENEWABLE_TIME)); // 옳은 입력값이 입력될때까지 반복
+    return sizeof(SEATMAP_GRID_LEGEND) - 1 + (size_t)SEATMAP_GRID_ROW * (location / SEATMAP_GRID_COLUMNS) + SEATMAP_GRID_LABEL + column + column / 10;
+}
 
-            break;
 
-        case 4: // 개장시각 수정
+/*
+* seatMapWrite 함수
+* 기능 : 주어진 문자열을 표준 출력에 write로 바로 쓴다. 한 번에 모두 쓰지 못한 경우 남은 부분을 이어서 쓴다.
+* 입력값 : 문자열 data, length(길이, 바이트)
+* 반환값 : 성공한 경우 1, 실패한 경우 0을 반환함.
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+int seatMapWrite(const char* data, size_t length)
+{
+    ssize_t written = 0;
+
+    while (length > 0)
+    {
+        written = write(STDOUT_FILENO, data, length);
+        if (written < 0)
+        {
+            if (errno == EINTR) { continue; }
+            return 0;
+        }
+        data += written;
+        length -= written;
+    }
+
+    return 1;
+}
+
+
+/*
+* layoutOpen 함수
+* 기능 : 배치 파일에서 좌석의 좌표와 특징을 읽고, 가까운 좌석을 찾기 위한 격자를 만든다. 대화형 모드와 명령 파일 일괄 처리(시뮬레이션 포함)에서 이용한다.
+* 입력값 : *path(배치 파일 경로), 좌석 정보 구조체 포인터 *libSeats
+* 반환값 : 좌석 배치를 만든 경우 1, 배치 파일을 열 수 없거나 내용이 잘못되었거나 메모리가 부족한 경우 0을 반환함.
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+int layoutOpen(const char* path, SeatsData* libSeats)
+{
+    int seatCount = libSeats->seatCount, lineNo = 0;
+    char line[256];
+    FILE* fp = NULL;
+    SeatLayout* layout = calloc(1, sizeof(SeatLayout));
+    if (layout == NULL)
+    {
+        printf("좌석 배치를 만들 수 없습니다.\n");
+        return 0;
+    }
+
+    // 실패한 경우 layoutClose로 한 번에 해제할 수 있도록 먼저 연결해 둔다.
+    libSeats->layout = layout;
+    layout->x = malloc(sizeof(int) * seatCount);
+    layout->y = malloc(sizeof(int) * seatCount);
+    layout->attributes = calloc(seatCount, sizeof(unsigned char));
+    if (layout->x == NULL || layout->y == NULL || layout->attributes == NULL)
+    {
+        printf("좌석 배치를 만들 수 없습니다.\n");
+        layoutClose(libSeats);
+        return 0;
+    }
+
+    fp = fopen(path, "r");
+    if (fp == NULL)
+    {
+        printf("배치 파일 %s을 열 수 없습니다.\n", path);
+        layoutClose(libSeats);
+        return 0;
+    }
+
+    // 배치 파일을 한 줄씩 읽는다.
+    while (fgets(line, sizeof(line), fp) != NULL)
+    {
+        lineNo++;
+        line[strcspn(line, "\n")] = '\0';
+
+        if (!parseLayoutLine(line, layout, seatCount))
+        {
+            printf("배치 파일 %s의 %d번째 줄이 잘못되었습니다.\n", path, lineNo);
+            fclose(fp);
+            layoutClose(libSeats);
+            return 0;
+        }
+    }
+    fclose(fp);
+
+    if (!buildLayoutGrid(layout, seatCount))
+    {
+        printf("배치 파일 %s에서 좌석 배치를 만들 수 없습니다. (좌표가 적힌 좌석이 없거나 메모리 부족)\n", path);
+        layoutClose(libSeats);
+        return 0;
+    }
+
+    return 1;
+}
+
+
+/*
+* layoutClose 함수
+* 기능 : layoutOpen으로 만든 좌석 배치를 해제한다. 좌석 배치가 없는 경우 아무것도 하지 않는다.
+* 입력값 : 좌석 정보 구조체 포인터 *libSeats
+* 반환값 없음
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+void layoutClose(SeatsData* libSeats)
+{
+    SeatLayout* layout = libSeats->layout;
+    if (layout == NULL)
+    {
+        return;
+    }
+
+    free(layout->x);
+    free(layout->y);
+    free(layout->attributes);
+    free(layout->cellStart);
+    free(layout->cellSeats);
+    free(layout);
+    libSeats->layout = NULL;
+
+    return;
+}
+
+
+/*
+* parseLayoutLine 함수
+* 기능 : 배치 파일의 한 줄을 읽어 좌석의 좌표와 특징을 저장한다. 같은 좌석이 여러 번 적힌 경우 마지막 줄을 따른다.
+* 입력값 : *line(줄바꿈을 뺀 한 줄), 좌석 배치 구조체 포인터 *layout, seatCount(좌석 수)
+* 반환값 : 옳은 줄(빈 줄, 주석 포함)인 경우 1, 잘못된 줄인 경우 0을 반환함.
+* 설명 최종 수정 일자 : 2026/10/17
+*
+* 배치 파일 형식 (좌석번호는 1부터 시작, 좌표는 입구를 (0, 0)으로 하는 정수, #부터 줄 끝까지는 주석)
+* 12 40 15 POWER WINDOW       : 12번 좌석은 (40, 15)에 있으며, 콘센트가 있는 창가 좌석
+* ROW 1 20 10 5 2 0 QUIET     : 1번 좌석부터 20개의 좌석이 (10, 5)부터 x좌표로 2씩 떨어져 한 줄로 놓인 조용한 구역의 좌석
+* 좌석 특징은 POWER(콘센트), WINDOW(창가), QUIET(조용한 구역) 중 필요한 것만 적는다.
+*/
+int parseLayoutLine(const char* line, SeatLayout* layout, int seatCount)
+{
+    const char* cursor = line;
+    const char* end = line + strlen(line);
+    const char* token = NULL;
+    int length = 0, first = 0, count = 1, x = 0, y = 0, dx = 0, dy = 0, fieldCount = 0;
+    int attributes = SEAT_PLACED;
+    int* fields[6] = { &first, &count, &x, &y, &dx, &dy };
+
+    // 빈 줄과 주석은 건너뛴다.
+    length = nextToken(&cursor, end, &token);
+    if (length == 0)
+    {
+        return 1;
+    }
+
+    // 한 줄(ROW)은 첫 좌석번호부터 여섯 값을, 좌석 하나는 좌석번호 뒤의 두 좌표를 읽는다.
+    if (isToken(token, length, "ROW"))
+    {
+        fieldCount = 6;
+    }else if (parseNumber(token, length, &first)){
+        fields[0] = &x;
+        fields[1] = &y;
+        fieldCount = 2;
+    }else{
+        return 0;
+    }
+
+    for (int i = 0; i < fieldCount; i++)
+    {
+        length = nextToken(&cursor, end, &token);
+        if (length == 0 || !parseNumber(token, length, fields[i]))
+        {
+            return 0;
+        }
+    }
+
+    // 남은 낱말은 좌석 특징이다.
+    while ((length = nextToken(&cursor, end, &token)) > 0)
+    {
+        if (isToken(token, length, "POWER"))
+        {
+            attributes |= SEAT_POWER;
+        }else if (isToken(token, length, "WINDOW")){
+            attributes |= SEAT_WINDOW;
+        }else if (isToken(token, length, "QUIET")){
+            attributes |= SEAT_QUIET;
+        }else{
+            return 0;
+        }
+    }
+
+    // 좌석 범위와, 한 줄의 처음과 마지막 좌석의 좌표 범위를 확인한다. 좌표는 좌석마다 같은 간격으로 바뀌므로 양 끝만 확인하면 된다.
+    if (first < 1 || count < 1 || count > seatCount - first + 1
+        || llabs(x) > MAX_LAYOUT_COORD || llabs(y) > MAX_LAYOUT_COORD
+        || llabs(x + (long long int)dx * (count - 1)) > MAX_LAYOUT_COORD || llabs(y + (long long int)dy * (count - 1)) > MAX_LAYOUT_COORD)
+    {
+        return 0;
+    }
+
+    for (int i = 0; i < count; i++)
+    {
+        layout->x[first - 1 + i] = x + dx * i;
+        layout->y[first - 1 + i] = y + dy * i;
+        layout->attributes[first - 1 + i] = (unsigned char)attributes;
+    }
+
+    return 1;
+}
+
+
+/*
+* buildLayoutGrid 함수
+* 기능 : 좌표가 적힌 좌석을 격자의 칸별로 모은다. 칸의 크기는 한 칸에 평균 LAYOUT_CELL_SEATS개의 좌석이 들어가도록 정하며, 격자는 입구(0, 0)를 포함한다.
+*        칸별 좌석 수를 센 후 누적합으로 칸마다의 시작 위치를 정하고, 좌석번호 순으로 채우므로(계수 정렬) 좌석 수에 비례하는 시간이 걸린다.
+* 입력값 : 좌석 배치 구조체 포인터 *layout, seatCount(좌석 수)
+* 반환값 : 격자를 만든 경우 1, 좌표가 적힌 좌석이 없거나 메모리가 부족한 경우 0을 반환함.
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+int buildLayoutGrid(SeatLayout* layout, int seatCount)
+{
+    int minX = 0, minY = 0, maxX = 0, maxY = 0, placedCount = 0, cell = 0, low = 1, high = 2 * MAX_LAYOUT_COORD + 1, middle = 0;
+    long long int area = 0;
+
+    // 좌표가 적힌 좌석과 입구를 모두 포함하는 범위를 구한다.
+    for (int i = 0; i < seatCount; i++)
+    {
+        if (!(layout->attributes[i] & SEAT_PLACED))
+        {
+            continue;
+        }
+        placedCount++;
+        minX = layout->x[i] < minX ? layout->x[i] : minX;
+        maxX = layout->x[i] > maxX ? layout->x[i] : maxX;
+        minY = layout->y[i] < minY ? layout->y[i] : minY;
+        maxY = layout->y[i] > maxY ? layout->y[i] : maxY;
+    }
+    if (placedCount == 0)
+    {
+        return 0;
+    }
+
+    // 칸 수 x LAYOUT_CELL_SEATS가 좌석 수 이상이 되는 가장 작은 칸의 크기를 이진 탐색으로 찾는다.
+    area = (long long int)(maxX - minX + 1) * (maxY - minY + 1);
+    while (low < high)
+    {
+        middle = (low + high) / 2;
+        if ((long long int)middle * middle * placedCount >= area * LAYOUT_CELL_SEATS)
+        {
+            high = middle;
+        }else{
+            low = middle + 1;
+        }
+    }
+
+    layout->placedCount = placedCount;
+    layout->minX = minX;
+    layout->minY = minY;
+    layout->cellSize = low;
+    layout->columns = (maxX - minX) / low + 1;
+    layout->rows = (maxY - minY) / low + 1;
+    layout->cellStart = calloc((size_t)layout->columns * layout->rows + 1, sizeof(int));
+    layout->cellSeats = malloc(sizeof(int) * placedCount);
+    if (layout->cellStart == NULL || layout->cellSeats == NULL)
+    {
+        return 0;
+    }
+
+    // 칸별 좌석 수를 다음 칸의 시작 위치 자리에 세고, 누적합으로 시작 위치를 만든다.
+    for (int i = 0; i < seatCount; i++)
+    {
+        if (layout->attributes[i] & SEAT_PLACED)
+        {
+            cell = (layout->y[i] - minY) / low * layout->columns + (layout->x[i] - minX) / low;
+            layout->cellStart[cell + 1]++;
+        }
+    }
+    for (int c = 0; c < layout->columns * layout->rows; c++)
+    {
+        layout->cellStart[c + 1] += layout->cellStart[c];
+    }
+
+    // 각 칸의 시작 위치를 하나씩 밀면서 좌석번호를 채운 후, 밀린 시작 위치를 한 칸씩 되돌린다.
+    for (int i = 0; i < seatCount; i++)
+    {
+        if (layout->attributes[i] & SEAT_PLACED)
+        {
+            cell = (layout->y[i] - minY) / low * layout->columns + (layout->x[i] - minX) / low;
+            layout->cellSeats[layout->cellStart[cell]++] = i;
+        }
+    }
+    for (int c = layout->columns * layout->rows; c > 0; c--)
+    {
+        layout->cellStart[c] = layout->cellStart[c - 1];
+    }
+    layout->cellStart[0] = 0;
+
+    return 1;
+}
+
+
+/*
+* suggestSeats 함수
+* 기능 : 기준 위치에서 가장 가까운, 조건에 맞는 빈 좌석을 최대 MAX_SUGGESTIONS개 찾는다.
+*        운영시간인 열람실의 빈 좌석 중 지금 예약이 없고 원하는 특징을 모두 가진 좌석만 고르며, 기준 좌석이 있는 경우 그 좌석의 열람실에서만 찾는다.
+*        기준 위치의 칸부터 테두리 한 겹씩 넓혀 가며 찾고, 다음 겹의 칸까지의 거리가 찾은 좌석 중 가장 먼 좌석보다 멀어지면 멈춘다.
+* 입력값 : reference(0번부터 시작하는 기준 좌석번호, -1이면 입구), attributes(원하는 좌석 특징의 합), *result(찾은 좌석번호를 가까운 순으로 저장할 배열, MAX_SUGGESTIONS칸),
+*          좌석 정보 구조체 포인터 *libSeats, 현재 시각 정보 구조체 포인터 *clock
+* 반환값 : 찾은 좌석 수를 반환함. 기준 좌석의 좌표가 없거나 운영시간인 열람실이 없는 경우 0을 반환함.
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+int suggestSeats(int reference, int attributes, int* result, SeatsData* libSeats, ClockContext* clock)
+{
+    SeatLayout* layout = libSeats->layout;
+    RoomData* rooms = libSeats->header->rooms;
+    ClockContext roomClock = *clock;
+    long long int distance[MAX_SUGGESTIONS], seatDistance = 0, ringDistance = 0;
+    unsigned int openRooms = 0;
+    int count = 0, centerX = 0, centerY = 0, originX = 0, originY = 0, maxRadius = 0, step = 0, location = 0, cell = 0, i = 0;
+
+    // 운영시간인 열람실을 비트로 표시한다. 기준 좌석이 있는 경우 그 좌석의 열람실만 남긴다.
+    for (int r = 0; r < libSeats->header->roomCount; r++)
+    {
+        setRoomClock(&roomClock, libSeats, &rooms[r]);
+        if (isOperationTime(&roomClock))
+        {
+            openRooms |= 1u << r;
+        }
+    }
+    if (reference >= 0)
+    {
+        if (!(layout->attributes[reference] & SEAT_PLACED))
+        {
+            return 0;
+        }
+        originX = layout->x[reference];
+        originY = layout->y[reference];
+        openRooms &= 1u << (roomOf(libSeats, reference) - rooms);
+    }
+    if (openRooms == 0)
+    {
+        return 0;
+    }
+
+    // 기준 위치가 들어 있는 칸과, 격자 끝까지의 겹 수를 구한다. 격자는 입구와 모든 좌석을 포함하므로 기준 위치는 항상 격자 안에 있다.
+    centerX = (originX - layout->minX) / layout->cellSize;
+    centerY = (originY - layout->minY) / layout->cellSize;
+    maxRadius = centerX > layout->columns - 1 - centerX ? centerX : layout->columns - 1 - centerX;
+    maxRadius = centerY > maxRadius ? centerY : maxRadius;
+    maxRadius = layout->rows - 1 - centerY > maxRadius ? layout->rows - 1 - centerY : maxRadius;
+
+    for (int radius = 0; radius <= maxRadius; radius++)
+    {
+        // radius번째 겹의 칸을 차례로 확인한다. 맨 위와 맨 아래 줄은 모든 칸, 그 사이의 줄은 양 끝 칸만 겹에 속한다.
+        for (int gridY = centerY - radius; gridY <= centerY + radius; gridY++)
+        {
+            if (gridY < 0 || gridY >= layout->rows)
+            {
+                continue;
+            }
+            step = (gridY == centerY - radius || gridY == centerY + radius) ? 1 : 2 * radius;
+
+            for (int gridX = centerX - radius; gridX <= centerX + radius; gridX += step)
+            {
+                if (gridX < 0 || gridX >= layout->columns)
+                {
+                    continue;
+                }
+                cell = gridY * layout->columns + gridX;
+
+                for (int k = layout->cellStart[cell]; k < layout->cellStart[cell + 1]; k++)
+                {
+                    location = layout->cellSeats[k];
+
+                    // 특징, 빈 좌석 비트맵, 열람실 운영 여부, 지금의 예약 순으로 확인한다.
+                    if ((layout->attributes[location] & attributes) != attributes
+                        || !((__atomic_load_n(&libSeats->freeMap[location / BITMAP_WORD_BITS], __ATOMIC_ACQUIRE) >> (location % BITMAP_WORD_BITS)) & 1)
+                        || !(openRooms & (1u << (roomOf(libSeats, location) - rooms)))
+                        || isReserved(location, clock->now, clock->now + 1, libSeats))
+                    {
+                        continue;
+                    }
+
+                    // 찾은 좌석을 거리(같으면 좌석번호) 순으로 끼워 넣는다. 이미 MAX_SUGGESTIONS개를 찾았고 가장 먼 좌석보다 먼 경우 버린다.
+                    seatDistance = (long long int)(layout->x[location] - originX) * (layout->x[location] - originX)
+                        + (long long int)(layout->y[location] - originY) * (layout->y[location] - originY);
+                    i = count;
+                    while (i > 0 && (distance[i - 1] > seatDistance || (distance[i - 1] == seatDistance && result[i - 1] > location)))
+                    {
+                        if (i < MAX_SUGGESTIONS)
+                        {
+                            distance[i] = distance[i - 1];
+                            result[i] = result[i - 1];
+                        }
+                        i--;
+                    }
+                    if (i < MAX_SUGGESTIONS)
+                    {
+                        distance[i] = seatDistance;
+                        result[i] = location;
+                        count += count < MAX_SUGGESTIONS;
+                    }
+                }
+            }
+        }
+
+        // 다음 겹의 칸은 기준 위치에서 적어도 radius칸 길이만큼 떨어져 있으므로, 찾은 좌석이 모두 그보다 가까우면 멈춘다.
+        ringDistance = (long long int)radius * layout->cellSize;
+        if (count == MAX_SUGGESTIONS && distance[count - 1] <= ringDistance * ringDistance)
+        {
+            break;
+        }
+    }
+
+    return count;
+}
+
+
+/*
+* printSuggestions 함수
+* 기능 : 원하는 좌석 특징과 기준 좌석을 입력받아, 조건에 맞는 가까운 빈 좌석을 가까운 순으로 출력한다.
+* 입력값 : 좌석 정보 구조체 포인터 *libSeats, 현재 시각 정보 구조체 포인터 *clock
+* 반환값 없음
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+void printSuggestions(SeatsData* libSeats, ClockContext* clock)
+{
+    SeatLayout* layout = libSeats->layout;
+    int attributes = 0, reference = 0, count = 0, location = 0;
+    int result[MAX_SUGGESTIONS];
+
+    printf("원하는 좌석 특징 (없음 : 0, 콘센트 : 1, 창가 : 2, 조용한 구역 : 4, 여러 개는 합) : ");
+    if (scanf("%d", &attributes) != 1 || attributes < 0 || attributes > (SEAT_POWER | SEAT_WINDOW | SEAT_QUIET))
+    {
+        printf("잘못된 값을 입력하였습니다.\n");
+        return;
+    }
+
+    printf("기준 좌석 번호 (입구 : 0) : ");
+    if (scanf("%d", &reference) != 1 || reference < 0 || reference > libSeats->seatCount)
+    {
+        printf("잘못된 값을 입력하였습니다.\n");
+        return;
+    }
+
+    // 입력받은 1부터 시작하는 좌석번호를 0부터 시작하는 좌석번호로 바꾼다. 입구는 -1이 된다.
+    reference--;
+    if (reference >= 0 && !(layout->attributes[reference] & SEAT_PLACED))
+    {
+        printf("배치 파일에 위치가 없는 좌석입니다.\n");
+        return;
+    }
+
+    count = suggestSeats(reference, attributes | SEAT_PLACED, result, libSeats, clock);
+    if (count == 0)
+    {
+        printf("조건에 맞는 빈 좌석이 없습니다.\n");
+        return;
+    }
+
+    printf("추천 좌석 (가까운 순)\n");
+    for (int i = 0; i < count; i++)
+    {
+        location = result[i];
+        printf("%d번 좌석 (%d, %d)%s%s%s\n", location + 1, layout->x[location], layout->y[location],
+            (layout->attributes[location] & SEAT_POWER) ? " 콘센트" : "",
+            (layout->attributes[location] & SEAT_WINDOW) ? " 창가" : "",
+            (layout->attributes[location] & SEAT_QUIET) ? " 조용한 구역" : "");
+    }
+
+    return;
+}
+
+
+/*
+* calendarOpen 함수
+* 기능 : 달력 파일에서 요일별 운영시간과 날짜 예외를 읽고, 열람실마다 어제부터 CALENDAR_DAYS일 뒤까지(날짜 예외가 그 밖에 있으면 그 날까지)의 운영 구간을 계산한다.
+*        달력에 적지 않은 요일은 읽을 때의 열람실 운영정보의 개장, 폐장시각을 따른다. 운영 달력은 프로세스마다 따로 만든다.
+* 입력값 : *path(달력 파일 경로), 좌석 정보 구조체 포인터 *libSeats
+* 반환값 : 운영 달력을 만든 경우 1, 달력 파일을 열 수 없거나 내용이 잘못되었거나 메모리가 부족한 경우 0을 반환함.
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+int calendarOpen(const char* path, SeatsData* libSeats)
+{
+    int roomCount = libSeats->header->roomCount, lineNo = 0, exceptionCount = 0, today = 0, firstDay = 0, lastDay = 0;
+    DayHours week[MAX_ROOMS][7];
+    char line[256];
+    time_t Time = (time_t)readClock(libSeats);
+    struct tm tmTime;
+    FILE* fp = NULL;
+    CalendarException* exceptions = malloc(sizeof(CalendarException) * MAX_CALENDAR_EXCEPTIONS);
+    OperatingCalendar* calendar = calloc(1, sizeof(OperatingCalendar));
+    if (exceptions == NULL || calendar == NULL)
+    {
+        printf("운영 달력을 만들 수 없습니다.\n");
+        free(exceptions);
+        free(calendar);
+        return 0;
+    }
+
+    // 실패한 경우 calendarClose로 한 번에 해제할 수 있도록 먼저 연결해 둔다.
+    libSeats->calendar = calendar;
+    calendar->roomCount = roomCount;
+
+    // 달력에 적지 않은 요일은 열람실 운영정보의 개장, 폐장시각을 따른다.
+    for (int r = 0; r < roomCount; r++)
+    {
+        for (int d = 0; d < 7; d++)
+        {
+            week[r][d].open = (short)libSeats->header->rooms[r].libData.OPEN_TIME;
+            week[r][d].close = (short)libSeats->header->rooms[r].libData.CLOSE_TIME;
+        }
+    }
+
+    fp = fopen(path, "r");
+    if (fp == NULL)
+    {
+        printf("달력 파일 %s을 열 수 없습니다.\n", path);
+        free(exceptions);
+        calendarClose(libSeats);
+        return 0;
+    }
+
+    // 달력 파일을 한 줄씩 읽는다.
+    while (fgets(line, sizeof(line), fp) != NULL)
+    {
+        lineNo++;
+        line[strcspn(line, "\n")] = '\0';
+
+        if (!parseCalendarLine(line, week, exceptions, &exceptionCount, roomCount))
+        {
+            printf("달력 파일 %s의 %d번째 줄이 잘못되었습니다.\n", path, lineNo);
+            fclose(fp);
+            free(exceptions);
+            calendarClose(libSeats);
+            return 0;
+        }
+    }
+    fclose(fp);
+
+    // 미리 계산할 기간을 정한다. 어제부터 CALENDAR_DAYS일 뒤까지이며, 날짜 예외가 그 밖에 있는 경우 넓힌다.
+    localtime_r(&Time, &tmTime);
+    today = civilDay(tmTime.tm_year + 1900, tmTime.tm_mon + 1, tmTime.tm_mday);
+    firstDay = today - 1;
+    lastDay = today + CALENDAR_DAYS;
+    for (int i = 0; i < exceptionCount; i++)
+    {
+        firstDay = exceptions[i].firstDay < firstDay ? exceptions[i].firstDay : firstDay;
+        lastDay = exceptions[i].lastDay > lastDay ? exceptions[i].lastDay : lastDay;
+    }
+    if (lastDay - firstDay >= MAX_CALENDAR_SPAN)
+    {
+        printf("달력 파일 %s의 날짜 예외가 너무 넓은 기간에 걸쳐 있습니다. (최대 %d일)\n", path, MAX_CALENDAR_SPAN);
+        free(exceptions);
+        calendarClose(libSeats);
+        return 0;
+    }
+
+    // 열람실마다 운영 구간을 계산한다.
+    for (int r = 0; r < roomCount; r++)
+    {
+        memcpy(calendar->rooms[r].week, week[r], sizeof(week[r]));
+        if (!compileCalendar(&calendar->rooms[r], exceptions, exceptionCount, r, firstDay, lastDay))
+        {
+            printf("운영 달력을 만들 수 없습니다.\n");
+            free(exceptions);
+            calendarClose(libSeats);
+            return 0;
+        }
+    }
+    free(exceptions);
+
+    return 1;
+}
+
+
+/*
+* calendarClose 함수
+* 기능 : calendarOpen으로 만든 운영 달력을 해제한다. 운영 달력이 없는 경우 아무것도 하지 않는다.
+* 입력값 : 좌석 정보 구조체 포인터 *libSeats
+* 반환값 없음
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+void calendarClose(SeatsData* libSeats)
+{
+    OperatingCalendar* calendar = libSeats->calendar;
+    if (calendar == NULL)
+    {
+        return;
+    }
+
+    for (int r = 0; r < calendar->roomCount; r++)
+    {
+        free(calendar->rooms[r].openAt);
+        free(calendar->rooms[r].closeAt);
+    }
+    free(calendar);
+    libSeats->calendar = NULL;
+
+    return;
+}
+
+
+/*
+* parseCalendarLine 함수
+* 기능 : 달력 파일의 한 줄을 읽어 요일별 운영시간을 바꾸거나 날짜 예외를 추가한다. 같은 날에 여러 줄이 적용되는 경우 마지막 줄을 따른다.
+*        날짜 예외는 요일별 운영시간보다 우선한다.
+* 입력값 : *line(줄바꿈을 뺀 한 줄), 열람실별 요일별 운영시간 배열 week, 날짜 예외 배열 exceptions, 날짜 예외 수 포인터 *exceptionCount, roomCount(열람실 수)
+* 반환값 : 옳은 줄(빈 줄, 주석 포함)인 경우 1, 잘못된 줄이거나 날짜 예외가 너무 많은 경우 0을 반환함.
+* 설명 최종 수정 일자 : 2026/10/17
+*
+* 달력 파일 형식 (요일은 SUN, MON, TUE, WED, THU, FRI, SAT, 시각은 HH:MM, #부터 줄 끝까지는 주석)
+* MON-FRI 09:00 22:00           : 월요일부터 금요일까지 9시부터 22시까지 운영 (요일 범위는 토요일에서 일요일로 넘어갈 수 있음)
+* SAT 10:00 02:00 ROOM 2        : 2번 열람실은 토요일 10시부터 다음날 2시까지 운영 (ROOM을 적지 않으면 모든 열람실, 여러 번 적을 수 있음)
+* SUN CLOSED                    : 일요일 휴관
+* 2026-12-01~2026-12-20 00:00 00:00 : 그 기간 동안 24시간 운영 (개장시각과 폐장시각이 같으면 24시간)
+* 2026-12-25 CLOSED             : 그 날 휴관
+*/
+int parseCalendarLine(const char* line, DayHours (*week)[7], CalendarException* exceptions, int* exceptionCount, int roomCount)
+{
+    static const char* const dayNames[7] = { "SUN", "MON", "TUE", "WED", "THU", "FRI", "SAT" };
+    const char* cursor = line;
+    const char* end = line + strlen(line);
+    const char* token = NULL;
+    int length = 0, firstDay = -1, lastDay = -1, room = 0, isWeek = 0, split = -1, open = 0, close = 0;
+    unsigned int roomMask = 0;
+    DayHours hours;
+
+    // 빈 줄과 주석은 건너뛴다.
+    length = nextToken(&cursor, end, &token);
+    if (length == 0)
+    {
+        return 1;
+    }
+
+    // 첫 낱말은 요일(범위) 또는 날짜(범위)이다. 요일 범위는 '-', 날짜 범위는 '~'로 나눈다.
+    for (int i = 0; i < length; i++)
+    {
+        if (token[i] == '~' || (token[i] == '-' && length == 7))
+        {
+            split = i;
+        }
+    }
+    for (int d = 0; d < 7; d++)
+    {
+        if (isToken(token, split >= 0 ? split : length, dayNames[d]))
+        {
+            firstDay = d;
+        }
+        if (split >= 0 && isToken(token + split + 1, length - split - 1, dayNames[d]))
+        {
+            lastDay = d;
+        }
+    }
+    if (firstDay >= 0 && (split < 0 || lastDay >= 0)) // 요일 또는 요일 범위
+    {
+        isWeek = 1;
+        lastDay = split < 0 ? firstDay : lastDay;
+    }else if (split >= 0 && token[split] == '~'){ // 날짜 범위
+        if (!parseCalendarDate(token, split, &firstDay) || !parseCalendarDate(token + split + 1, length - split - 1, &lastDay) || lastDay < firstDay)
+        {
+            return 0;
+        }
+    }else if (!parseCalendarDate(token, length, &firstDay)){ // 날짜
+        return 0;
+    }else{
+        lastDay = firstDay;
+    }
+
+    // 운영시간(개장시각 폐장시각) 또는 휴관(CLOSED)을 읽는다.
+    length = nextToken(&cursor, end, &token);
+    if (isToken(token, length, "CLOSED"))
+    {
+        hours.open = CALENDAR_CLOSED;
+        hours.close = CALENDAR_CLOSED;
+    }else{
+        if (!parseMinute(token, length, &open) || open < 0 || open >= 24 * 60)
+        {
+            return 0;
+        }
+        length = nextToken(&cursor, end, &token);
+        if (!parseMinute(token, length, &close) || close < 0 || close >= 24 * 60)
+        {
+            return 0;
+        }
+        hours.open = (short)open;
+        hours.close = (short)close;
+    }
+
+    // 남은 낱말은 적용할 열람실(ROOM 열람실번호)이다. 적지 않으면 모든 열람실에 적용한다.
+    while ((length = nextToken(&cursor, end, &token)) > 0)
+    {
+        if (!isToken(token, length, "ROOM"))
+        {
+            return 0;
+        }
+        length = nextToken(&cursor, end, &token);
+        if (!parseNumber(token, length, &room) || room < 1 || room > roomCount)
+        {
+            return 0;
+        }
+        roomMask |= 1u << (room - 1);
+    }
+    if (roomMask == 0)
+    {
+        roomMask = roomCount >= 32 ? 0xFFFFFFFFu : (1u << roomCount) - 1;
+    }
+
+    // 요일별 운영시간은 바로 바꾸고, 날짜 예외는 운영 구간을 계산할 때 적용한다.
+    if (isWeek)
+    {
+        for (int r = 0; r < roomCount; r++)
+        {
+            for (int d = firstDay; (roomMask >> r) & 1; d = (d + 1) % 7)
+            {
+                week[r][d] = hours;
+                if (d == lastDay)
+                {
+                    break;
+                }
+            }
+        }
+        return 1;
+    }
+
+    if (*exceptionCount >= MAX_CALENDAR_EXCEPTIONS)
+    {
+        return 0;
+    }
+    exceptions[*exceptionCount].firstDay = firstDay;
+    exceptions[*exceptionCount].lastDay = lastDay;
+    exceptions[*exceptionCount].roomMask = roomMask;
+    exceptions[*exceptionCount].hours = hours;
+    (*exceptionCount)++;
+
+    return 1;
+}
+
+
+/*
+* compileCalendar 함수
+* 기능 : 열람실의 요일별 운영시간(calendar->week)과 날짜 예외로 firstDay부터 lastDay까지의 운영 구간을 계산한다.
+*        전날 시작해 첫날로 이어지는 구간과 마지막 날에 시작해 다음날로 이어지는 구간도 온전히 담기 위해, 앞뒤로 하루씩 더 계산한다.
+*        날마다 0시는 지역 시각으로 계산하므로(mktime), 일광 절약 시간이 바뀌는 날도 올바르다.
+* 입력값 : 열람실 운영 달력 구조체 포인터 *calendar, 날짜 예외 배열 exceptions, exceptionCount(날짜 예외 수), roomIndex(0부터 시작하는 열람실 번호),
+*          firstDay, lastDay(계산할 첫날과 마지막 날 - 1970/1/1부터의 일수)
+* 반환값 : 계산한 경우 1, 메모리가 부족한 경우 0을 반환함.
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+int compileCalendar(RoomCalendar* calendar, const CalendarException* exceptions, int exceptionCount, int roomIndex, int firstDay, int lastDay)
+{
+    long long int midnight = dayMidnight(firstDay - 1), nextMidnight = 0;
+    DayHours hours;
+
+    // 날마다 구간은 많아야 하나이다.
+    calendar->openAt = malloc(sizeof(long long int) * (lastDay - firstDay + 3));
+    calendar->closeAt = malloc(sizeof(long long int) * (lastDay - firstDay + 3));
+    if (calendar->openAt == NULL || calendar->closeAt == NULL)
+    {
+        return 0;
+    }
+    calendar->count = 0;
+    calendar->hint = 0;
+    calendar->isAllDay = 1;
+
+    for (int day = firstDay - 1; day <= lastDay + 1; day++)
+    {
+        // 요일별 운영시간에 그 날을 포함하는 날짜 예외를 차례로 적용한다. 1970/1/1은 목요일이다.
+        hours = calendar->week[((day + 4) % 7 + 7) % 7];
+        for (int i = 0; i < exceptionCount; i++)
+        {
+            if (((exceptions[i].roomMask >> roomIndex) & 1) && exceptions[i].firstDay <= day && day <= exceptions[i].lastDay)
+            {
+                hours = exceptions[i].hours;
+            }
+        }
+
+        if (day >= firstDay && day <= lastDay)
+        {
+            calendar->isAllDay &= (hours.open != CALENDAR_CLOSED && hours.open == hours.close);
+        }
+        nextMidnight = dayMidnight(day + 1);
+        calendar->count = appendHours(calendar->openAt, calendar->closeAt, calendar->count, hours, midnight, nextMidnight);
+        midnight = nextMidnight;
+    }
+
+    calendar->from = dayMidnight(firstDay);
+    calendar->until = dayMidnight(lastDay + 1);
+
+    return 1;
+}
+
+
+/*
+* parseCalendarDate 함수
+* 기능 : YYYY-MM-DD 형식의 날짜를 1970/1/1부터의 일수로 변환한다. 없는 날짜(2월 30일 등)는 받지 않는다.
+* 입력값 : 낱말 token, length(낱말 길이), 변환한 값을 저장할 포인터 *day
+* 반환값 : 올바른 날짜인 경우 1, 아닌 경우 0
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+int parseCalendarDate(const char* token, int length, int* day)
+{
+    int year = 0, month = 0, date = 0;
+
+    if (length != 10 || token[4] != '-' || token[7] != '-'
+        || !parseNumber(token, 4, &year) || !parseNumber(token + 5, 2, &month) || !parseNumber(token + 8, 2, &date)
+        || year < 1970 || month < 1 || month > 12 || date < 1)
+    {
+        return 0;
+    }
+
+    // 다음 달 1일까지의 일수로 그 달의 날 수를 확인한다.
+    *day = civilDay(year, month, date);
+
+    return *day < (month == 12 ? civilDay(year + 1, 1, 1) : civilDay(year, month + 1, 1));
+}
+
+
+/*
+* civilDay 함수
+* 기능 : 그레고리력 날짜를 1970/1/1부터의 일수로 변환한다. 3월을 한 해의 시작으로 보면 윤일이 해의 마지막 날이 되므로, 400년 주기 안에서 바로 계산할 수 있다.
+* 입력값 : year(연), month(월, 1~12), day(일)
+* 반환값 : 1970/1/1부터의 일수
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+int civilDay(int year, int month, int day)
+{
+    int era = 0, yearOfEra = 0, dayOfYear = 0;
+
+    year -= month <= 2;
+    era = (year >= 0 ? year : year - 399) / 400;
+    yearOfEra = year - era * 400;
+    dayOfYear = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+
+    return era * 146097 + yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear - 719468;
+}
+
+
+/*
+* dayMidnight 함수
+* 기능 : 1970/1/1부터의 일수인 날의 0시(지역 시각)를 구한다.
+* 입력값 : day(1970/1/1부터의 일수)
+* 반환값 : 그 날 0시(Unix 초)
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+long long int dayMidnight(int day)
+{
+    struct tm tmTime;
+
+    // 날짜를 바꾸는 일은 mktime에 맡긴다. (1970/1/1에 일수를 더한 날짜를 정규화함)
+    memset(&tmTime, 0, sizeof(tmTime));
+    tmTime.tm_year = 70;
+    tmTime.tm_mday = 1 + day;
+    tmTime.tm_isdst = -1;
+
+    return (long long int)mktime(&tmTime);
+}
+
+
+/*
+* renewSeatEndTime 함수
+* 기능 : 폐장시각이 바뀌어 열람실 좌석의 이용종료시각이 폐장시각 이후가 된 경우 이를 폐장시각으로 조정한다.
+* 입력값 : 좌석 정보 구조체 포인터 *libSeats, 열람실 구조체 포인터 *room, 현재 시각 정보 구조체 포인터 *clock(열람실의 바뀐 운영시간으로 생성된 것이어야 함)
+* 반환값 없음
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+void renewSeatEndTime(SeatsData* libSeats, RoomData* room, ClockContext* clock)
+{
+    // 24시간제의 경우 해당 함수가 필요 없으므로 함수 종료.
+    if (clock->isAllDay) { return; }
+
+    // 현재 운영일의 폐장시각(Unix 초) 이후로 끝나는 좌석의 이용종료시각을 폐장시각으로 조정한다.
+    clampSeatEndTime(libSeats, room, clock->closeTime);
+
+    return;
+}
+
+
+/*
+* clampSeatEndTime 함수
+* 기능 : 열람실에서 이용종료시각이 주어진 시각 이후인 모든 좌석의 이용종료시각을 주어진 시각으로 조정한다. 다른 열람실의 좌석은 순회하지 않는다.
+* 입력값 : 좌석 정보 구조체 포인터 *libSeats, 열람실 구조체 포인터 *room, closeTime(조정할 시각, Unix 초)
+* 반환값 없음
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+void clampSeatEndTime(SeatsData* libSeats, RoomData* room, long long int closeTime)
+{
+    // 열람실 좌석의 이용종료시각 열에 대해 반복
+    // 이용중이 아닌 좌석의 이용종료시각은 0이므로, 좌석 상태 열을 확인하지 않아도 폐장시각 이후가 되지 않는다.
+    // 폐장시각으로 당겨지는 좌석은 모두 폐장시각보다 늦게 끝나던 좌석이고, 그 자식들도 마찬가지이므로 이용종료시각 힙의 순서는 그대로 유지된다.
+    // 열람실의 이용종료시각 열은 열람실의 힙 잠금으로 보호되므로, 힙 잠금만 얻으면 된다.
+    // 폐장시각이 변경되어 퇴실시각이 폐장시각 이후가 된 경우, 개인별 종료 시각(Unix 초)을 폐장시각(Unix 초)으로 변경
+    spinLock(&room->heapLock);
+    clampColumn(libSeats->endTime + room->firstSeat, room->seatCount, packEndTime(closeTime), libSeats->simdLevel);
+    spinUnlock(&room->heapLock);
+
+    // 이용종료시각 조정을 기록한다.
+    walLog(libSeats, WAL_CLAMP, 0, (int)(room - libSeats->header->rooms), closeTime, NULL);
+
+    return;
+}
+
+
+/*
+* captureClock 함수
+* 기능 : 좌석 저장소의 시계에서 현재 시각을 한 번 읽어 현재 시각 정보를 생성한다. 시각에 따라 동작하는 모든 함수는 이 정보만 이용한다.
+* 입력값 : 현재 시각 정보를 저장할 구조체 포인터 *clock, 좌석 정보 구조체 포인터 *libSeats, 열람실 구조체 포인터 *room(개장, 폐장시각을 계산할 열람실)
+* 반환값 없음
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+void captureClock(ClockContext* clock, SeatsData* libSeats, RoomData* room)
+{
+    setClock(clock, libSeats, room, readClock(libSeats));
+
+    return;
+}
+
+
+/*
+* readClock 함수
+* 기능 : 좌석 저장소의 시계에서 현재 시각을 읽는다. 시계가 지정되지 않은 경우 시스템 시계를 이용한다.
+* 입력값 : 좌석 정보 구조체 포인터 *libSeats
+* 반환값 : 현재 시각(Unix 시간) - 초 단위
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+long long int readClock(SeatsData* libSeats)
+{
+    return libSeats->clockSource != NULL ? libSeats->clockSource->read(libSeats->clockSource) : readSystemClock(NULL);
+}
+
+
+/*
+* readSystemClock 함수
+* 기능 : 시스템 시계의 현재 시각을 읽는다.
+* 입력값 : 시계 구조체 포인터 *source(이용하지 않음)
+* 반환값 : 현재 시각(Unix 시간) - 초 단위
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+long long int readSystemClock(ClockSource* source)
+{
+    (void)source;
+
+    return (long long int)time(NULL);
+}
+
+
+/*
+* readVirtualClock 함수
+* 기능 : 가상 시계의 현재 시각을 읽는다. 가상 시계는 시뮬레이션 명령(TIME, WAIT)으로만 흐른다.
+* 입력값 : 시계 구조체 포인터 *source
+* 반환값 : 가상 시계의 현재 시각(Unix 시간) - 초 단위
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+long long int readVirtualClock(ClockSource* source)
+{
+    return source->now;
+}
+
+
+/*
+* initVirtualClock 함수
+* 기능 : SIMULATION_START_YEAR년 1월 1일 0시(지역 시각)에서 시작하는 가상 시계를 만든다. 실행할 때마다 같은 시각에서 시작하므로 결과가 항상 같다.
+* 입력값 : 시계 구조체 포인터 *source
+* 반환값 없음
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+void initVirtualClock(ClockSource* source)
+{
+    struct tm start;
+
+    memset(&start, 0, sizeof(start));
+    start.tm_year = SIMULATION_START_YEAR - 1900;
+    start.tm_mday = 1;
+    start.tm_isdst = -1;
+
+    source->read = readVirtualClock;
+    source->now = (long long int)mktime(&start);
+
+    return;
+}
+
+
+/*
+* setClock 함수
+* 기능 : 주어진 시각을 기준으로, 오늘 0시와 요일, 주어진 열람실의 현재 운영 구간을 미리 계산한다. 성능 측정처럼 실제 시각이 아닌 시각을 이용할 때도 호출한다.
+* 입력값 : 현재 시각 정보를 저장할 구조체 포인터 *clock, 좌석 정보 구조체 포인터 *libSeats, 열람실 구조체 포인터 *room, now(기준 시각, Unix 시간)
+* 반환값 없음
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+void setClock(ClockContext* clock, SeatsData* libSeats, RoomData* room, long long int now)
+{
+    // 현재 시각 관련 변수 선언
+    time_t Time = (time_t)now;
+    struct tm tmTime;
+    localtime_r(&Time, &tmTime);
+
+    // 현재 시각과 오늘 0시, 요일 계산
+    clock->now = (long long int)Time;
+    clock->daySecond = tmTime.tm_hour * 60 * 60 + tmTime.tm_min * 60 + tmTime.tm_sec;
+    clock->midnight = clock->now - clock->daySecond;
+    clock->weekDay = tmTime.tm_wday;
+
+    // 열람실의 현재 운영 구간 계산
+    setRoomClock(clock, libSeats, room);
+
+    return;
+}
+
+
+/*
+* setRoomClock 함수
+* 기능 : 이미 계산된 현재 시각과 오늘 0시를 그대로 두고, 주어진 열람실의 현재 운영 구간(개장, 폐장시각)만 다시 계산한다.
+*        운영 달력이 있는 경우 미리 계산해 둔 운영 구간에서 찾는다. 운영 달력이 없거나 미리 계산한 기간 밖인 경우,
+*        열람실 운영정보(또는 달력의 요일별 운영시간)로 어제부터 내일까지의 운영 구간을 만들어 찾는다.
+*        지역 시각 변환(localtime_r)을 다시 하지 않으므로, 한 요청에서 여러 열람실의 시각 정보가 필요한 경우 이용한다.
+* 입력값 : 현재 시각 정보 구조체 포인터 *clock, 좌석 정보 구조체 포인터 *libSeats, 열람실 구조체 포인터 *room
+* 반환값 없음
+* 설명 최종 수정 일자 : 2026/10/17
+*
+* 자정을 넘겨 운영하는 날(개장시각이 폐장시각보다 뒤)은 다음날 폐장하는 하나의 구간이 되므로, 운영 구간 안에서는 자정을 따로 다루지 않는다.
+*/
+void setRoomClock(ClockContext* clock, SeatsData* libSeats, RoomData* room)
+{
+    RoomCalendar* calendar = libSeats->calendar != NULL ? &libSeats->calendar->rooms[room - libSeats->header->rooms] : NULL;
+    DayHours hours = { (short)room->libData.OPEN_TIME, (short)room->libData.CLOSE_TIME };
+    long long int openAt[3], closeAt[3];
+    int count = 0, hint = 0, isAllDay = 1;
+
+    // 미리 계산한 기간 안인 경우, 저장된 운영 구간에서 찾는다.
+    if (calendar != NULL && calendar->from <= clock->now && clock->now < calendar->until)
+    {
+        findHours(clock, calendar->openAt, calendar->closeAt, calendar->count, &calendar->hint);
+        clock->isAllDay = calendar->isAllDay;
+        return;
+    }
+
+    // 어제, 오늘, 내일의 운영 구간을 만든다. 날짜가 바뀌는 시각은 오늘 0시에서 24시간씩 더하거나 빼서 정한다.
+    for (int day = -1; day <= 1; day++)
+    {
+        if (calendar != NULL)
+        {
+            hours = calendar->week[(clock->weekDay + day + 7) % 7];
+        }
+        isAllDay &= (hours.open != CALENDAR_CLOSED && hours.open == hours.close);
+        count = appendHours(openAt, closeAt, count, hours, clock->midnight + day * 24 * 60 * 60LL, clock->midnight + (day + 1) * 24 * 60 * 60LL);
+    }
+    findHours(clock, openAt, closeAt, count, &hint);
+    clock->isAllDay = isAllDay;
+
+    return;
+}
+
+
+/*
+* appendHours 함수
+* 기능 : 하루의 운영시간을 [개장, 폐장) 운영 구간으로 바꾸어 운영 구간 배열 끝에 추가한다. 앞 구간에 이어지거나 겹치는 경우 앞 구간과 합친다.
+*        폐장시각이 개장시각보다 앞서거나 같은 경우(자정을 넘겨 운영, 24시간 운영) 다음날 폐장한다. 휴관일은 추가하지 않는다.
+* 입력값 : 운영 구간의 개장시각 배열 openAt, 폐장시각 배열 closeAt, count(지금까지의 구간 수), hours(그 날의 운영시간), midnight(그 날 0시), nextMidnight(다음날 0시)
+* 반환값 : 추가한 후의 구간 수
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+int appendHours(long long int* openAt, long long int* closeAt, int count, DayHours hours, long long int midnight, long long int nextMidnight)
+{
+    long long int open = 0, close = 0;
+
+    if (hours.open == CALENDAR_CLOSED)
+    {
+        return count;
+    }
+    open = midnight + hours.open * 60LL;
+    close = (hours.close > hours.open ? midnight : nextMidnight) + hours.close * 60LL;
+
+    // 날마다 개장시각은 그 날 0시 이후이므로, 구간은 항상 개장시각 순으로 추가된다.
+    if (count > 0 && open <= closeAt[count - 1])
+    {
+        closeAt[count - 1] = close > closeAt[count - 1] ? close : closeAt[count - 1];
+        return count;
+    }
+    openAt[count] = open;
+    closeAt[count] = close;
+
+    return count + 1;
+}
+
+
+/*
+* findHours 함수
+* 기능 : 운영 구간 배열에서 현재 시각의 운영 구간을 찾아 시각 정보의 개장, 폐장시각에 저장한다.
+*        마지막으로 찾은 구간을 먼저 확인하고, 아닌 경우 개장시각이 현재 시각 이전인 마지막 구간을 이진 탐색으로 찾는다.
+*        운영시간이 아닌 경우, 폐장시각은 지난 구간의 것(없으면 현재 시각), 개장시각은 다음 구간의 것(없으면 LLONG_MAX)이다.
+* 입력값 : 현재 시각 정보 구조체 포인터 *clock, 운영 구간의 개장시각 배열 openAt, 폐장시각 배열 closeAt, count(구간 수), 마지막으로 찾은 구간 번호 포인터 *hint
+* 반환값 없음
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+void findHours(ClockContext* clock, const long long int* openAt, const long long int* closeAt, int count, int* hint)
+{
+    int index = __atomic_load_n(hint, __ATOMIC_RELAXED), low = 0, high = count - 1, middle = 0;
+
+    // 마지막으로 찾은 구간이 현재 시각의 구간이 아닌 경우 다시 찾는다. 여러 스레드가 함께 이용하므로 구간 번호는 원자적으로 읽고 쓴다.
+    if (index < 0 || index >= count || openAt[index] > clock->now || (index + 1 < count && openAt[index + 1] <= clock->now))
+    {
+        index = -1;
+        while (low <= high)
+        {
+            middle = (low + high) / 2;
+            if (openAt[middle] <= clock->now)
+            {
+                index = middle;
+                low = middle + 1;
+            }else{
+                high = middle - 1;
+            }
+        }
+        if (index >= 0)
+        {
+            __atomic_store_n(hint, index, __ATOMIC_RELAXED);
+        }
+    }
+
+    if (index >= 0 && clock->now < closeAt[index]) // 운영시간인 경우
+    {
+        clock->openTime = openAt[index];
+        clock->closeTime = closeAt[index];
+    }else{ // 운영시간이 아닌 경우
+        clock->closeTime = index >= 0 ? closeAt[index] : clock->now;
+        clock->openTime = index + 1 < count ? openAt[index + 1] : LLONG_MAX;
+    }
+
+    return;
+}
+
+
+/*
+* roomOf 함수
+* 기능 : 주어진 좌석이 속한 열람실을 찾는다. 열람실은 첫 좌석번호 순으로 이어져 있으므로 이진 탐색한다.
+* 입력값 : 좌석 정보 구조체 포인터 *libSeats, location(0번부터 시작하는 좌석번호)
+* 반환값 : 열람실 구조체 포인터
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+RoomData* roomOf(SeatsData* libSeats, int location)
+{
+    RoomData* rooms = libSeats->header->rooms;
+    int low = 0, high = libSeats->header->roomCount - 1, middle = 0;
+
+    // 첫 좌석번호가 location 이하인 마지막 열람실을 찾는다.
+    while (low < high)
+    {
+        middle = (low + high + 1) / 2;
+        if (rooms[middle].firstSeat <= location)
+        {
+            low = middle;
+        }else{
+            high = middle - 1;
+        }
+    }
+
+    return &rooms[low];
+}
+
+
+/*
+* isAnyRoomOpen 함수
+* 기능 : 현재시각이 운영시간 내인 열람실이 하나라도 있는지 확인한다.
+* 입력값 : 좌석 정보 구조체 포인터 *libSeats, 현재 시각 정보 구조체 포인터 *clock
+* 반환값 : 운영시간인 열람실이 있는 경우 1, 없는 경우 0
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+int isAnyRoomOpen(SeatsData* libSeats, ClockContext* clock)
+{
+    ClockContext roomClock = *clock;
+
+    for (int i = 0; i < libSeats->header->roomCount; i++)
+    {
+        setRoomClock(&roomClock, libSeats, &libSeats->header->rooms[i]);
+        if (isOperationTime(&roomClock))
+        {
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+
+/*
+* printRooms 함수
+* 기능 : 열람실 목록(번호, 이름, 좌석 범위, 운영시간, 운영 여부)을 출력한다.
+*        운영 달력을 이용하는 경우, 운영시간 대신 지금의 운영 구간 또는 다음 개장시각을 출력한다.
+* 입력값 : 좌석 정보 구조체 포인터 *libSeats, 현재 시각 정보 구조체 포인터 *clock
+* 반환값 없음
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+void printRooms(SeatsData* libSeats, ClockContext* clock)
+{
+    ClockContext roomClock = *clock;
+    RoomData* room = NULL;
+    char openText[32], closeText[32];
+
+    for (int i = 0; i < libSeats->header->roomCount; i++)
+    {
+        room = &libSeats->header->rooms[i];
+        setRoomClock(&roomClock, libSeats, room);
+
+        // 좌석번호는 1번부터 출력한다.
+        printf("%d. %s : %d~%d번 좌석, ", i + 1, room->name, room->firstSeat + 1, room->firstSeat + room->seatCount);
+        if (roomClock.isAllDay)
+        {
+            printf("24시간 운영\n");
+        }else if (libSeats->calendar != NULL && isOperationTime(&roomClock)){ // 운영 달력을 이용하는 경우, 지금의 운영 구간
+            formatDateTime(roomClock.openTime, openText, sizeof(openText));
+            formatDateTime(roomClock.closeTime, closeText, sizeof(closeText));
+            printf("%s~%s 운영중\n", openText, closeText);
+        }else if (libSeats->calendar != NULL && roomClock.openTime != LLONG_MAX){ // 운영 달력을 이용하는 경우, 다음 개장시각
+            formatDateTime(roomClock.openTime, openText, sizeof(openText));
+            printf("운영시간 아님 (다음 개장 %s)\n", openText);
+        }else if (libSeats->calendar != NULL){
+            printf("운영시간 아님 (개장 예정 없음)\n");
+        }else{
+            printf("%02d:%02d~%02d:%02d %s\n", room->libData.OPEN_TIME / 60, room->libData.OPEN_TIME % 60, room->libData.CLOSE_TIME / 60, room->libData.CLOSE_TIME % 60,
+                isOperationTime(&roomClock) ? "운영중" : "운영시간 아님");
+        }
+    }
+
+    return;
+}
+
+
+/*
+* adminMode 함수
+* 기능 : 관리자 모드 실행. 열람실이 여러 개인 경우 관리할 열람실을 먼저 고르며, 좌석 초기화와 운영정보 수정(1~5번 메뉴)은 고른 열람실에만 적용된다.
+* 입력값 : 좌석 정보 구조체 포인터 *libSeats (운영정보는 모든 단말기가 함께 이용하는 열람실별 운영정보를 수정한다)
+* 반환값 없음
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+void adminMode(SeatsData* libSeats)
+{
+    /*
+    * 관리자 모드 관련 변수 선언
+    * 
+    * menu_sel : 입력한 메뉴의 번호
+    * tmpTime : 입력한 시간값을 임시로 저장하는 변수
+    * oldData : 잘못 입력할 것을 대비해, 기존 시간값을 임시로 저장하는 변수
+    * tmpSeatNo : 좌석 이용불가 설정에서, 좌석 이용불가 설정을 바꿀 좌석번호를 임시로 저장하는 변수
+    * editData : 수정중인 운영정보. 입력 도중의 값이 다른 단말기에 보이지 않도록, 복사본을 수정한 후 한 번에 반영한다.
+    * room : 관리할 열람실
+    */
+    int menu_sel = -1, tmpTime = 0, oldData = 0, tmpSeatNo = 0, tmpRoomNo = 1;
+    LibraryData editData;
+    LibraryData* libData = &editData;
+    RoomData* room = NULL;
+    ClockContext clock;
+
+    // 열람실이 여러 개인 경우, 관리할 열람실을 고른다.
+    if (libSeats->header->roomCount > 1)
+    {
+        captureClock(&clock, libSeats, &libSeats->header->rooms[0]);
+        printRooms(libSeats, &clock);
+
+        do {
+            printf("관리할 열람실을 선택하세요. : ");
+            scanf("%d", &tmpRoomNo);
+
+            if (tmpRoomNo < 1 || tmpRoomNo > libSeats->header->roomCount)
+            {
+                printf("잘못된 값을 입력하였습니다.\n");
+            }
+        } while (tmpRoomNo < 1 || tmpRoomNo > libSeats->header->roomCount); // 옳은 입력값이 입력될때까지 반복
+    }
+    room = &libSeats->header->rooms[tmpRoomNo - 1];
+
+    // 무한 반복, 관리자 모드 종료(0 입력)시 return으로 함수 종료
+    while (1)
+    {
+        /*
+        * 관리자 모드의 메뉴
+        * 
+        * 1 : 좌석 초기화
+        * 2 : 최대 이용 가능 시간 수정
+        * 3 : 연장 가능 시간 수정
+        * 4 : 개장시각 수정
+        * 5 : 폐장시각 수정
+        * 6 : 모든 좌석 정보 보기
+        * 7 : 좌석 이용불가 설정
+        * 8 : 좌석 일괄 이용불가 설정
+        * 0 : 관리자 모드 나가기
+        */
+
+        // 다른 단말기에서 바꾼 운영정보를 반영하여 복사본을 만든다.
+        editData = room->libData;
+
+        // 관리자 모드의 메뉴 출력 및 입력값 입력
+        printf("1 : 좌석 초기화, 2 : 최대 이용 가능 시간 수정, 3: 연장 가능 시간 수정, 4 : 개장시각 수정, 5: 폐장시각 수정, 6: 모든 좌석 정보 보기, 7: 좌석 이용불가 설정, 8: 좌석 일괄 이용불가 설정, 0: 나가기 : ");
+        scanf("%d", &menu_sel);
+
+        // 선택한 관리자 모드의 메뉴 실행
+        switch (menu_sel)
+        {
+        case 1: // 좌석 초기화
+
+            // 열람실의 이용불가좌석을 제외한 모든 좌석을 초기화함.
+            resetSeats(libSeats, room, 0, HISTORY_RESET);
+
+            break;
+
+        case 2: // 최대 이용 가능 시간 수정
+
+            // 기존 최대이용시간 저장
+            oldData = libData->MAX_TIME;
+
+            do {
+                // 기존 최대 이용 가능 시간 복원. 이는 잘못된 값을 입력받았을 때 복원하는 용도로 이용된다.
+                libData->MAX_TIME = oldData;
+
+                // 기존값 출력 및 신규값 입력
+                printf("현재 최대 이용 가능 시간 : %d 시간 %d 분\n", libData->MAX_TIME / 60, libData->MAX_TIME % 60);
+                printf("최대 이용 가능 시간 수정. 시간 : ");
+                scanf("%d", &tmpTime); // 시간 단위 입력
+                libData->MAX_TIME = tmpTime * 60; // 시간 단위를 분단위로 환산 후 저장
+                printf("분 : ");
+                scanf("%d", &tmpTime); // 분단위 입력
+                libData->MAX_TIME += tmpTime; // 저장된 시간 단위 입력값에 분단위 입력값 추가
+
+                // 잘못된 값인지 확인
+                if (libData->MAX_TIME <= 0 || libData->MAX_TIME > 24 * 60)
+                {
+                    printf("최대 이용 가능 시간은 1분 이상 24시간 이하여야 합니다.\n");
+                }
+            } while (libData->MAX_TIME <= 0 || libData->MAX_TIME > 24 * 60); // 옳은 입력값이 입력될때까지 반복
+
+            // 새 최대 이용가능 시간이 최대 연장가능 시간을 초과하는 경우
+            if (libData->MAX_TIME < libData->MAX_RENEWABLE_TIME)
+            {
+                // 최대 연장가능 시간을 새 최대 이용가능 시간으로 수정
+                libData->MAX_RENEWABLE_TIME = libData->MAX_TIME;
+
+                // 최대 연장가능 시간을 새 최대 이용가능 시간으로 수정하였음을 알림
+                printf("최대 이용 가능시간 변경으로 인해 연장 가능 시간이 끝나기 %d 시간 %d 분 전으로 변경되었습니다.\n", libData->MAX_RENEWABLE_TIME / 60, libData->MAX_RENEWABLE_TIME % 60);
+            }
+
+            break;
+
+        case 3: // 연장 가능 시간 수정
+
+            // 기존 연장 가능 시간 저장
+            oldData = libData->MAX_RENEWABLE_TIME;
+
+            do {
+                // 기존 연장 가능 시간 복원. 이는 잘못된 값을 입력받았을 때 복원하는 용도로 이용된다.
+                libData->MAX_RENEWABLE_TIME = oldData;
+
+                // 기존값 출력 및 신규값 입력
+                printf("현재 최대 이용 가능 시간 : %d 시간 %d 분\n", libData->MAX_TIME / 60, libData->MAX_TIME % 60);
+                printf("현재 연장 가능 시간 : 끝나기 %d 시간 %d 분 전\n", libData->MAX_RENEWABLE_TIME / 60, libData->MAX_RENEWABLE_TIME % 60);
+                printf("연장 가능 시간 수정. 시간 : ");
+                scanf("%d", &tmpTime); // 시간 단위 입력
+                libData->MAX_RENEWABLE_TIME = tmpTime * 60; // 시간 단위를 분단위로 환산 후 저장
+                printf("분 : ");
+                scanf("%d", &tmpTime); // 분단위 입력
+                libData->MAX_RENEWABLE_TIME += tmpTime; // 저장된 시간 단위 입력값에 분단위 입력값 추가
+
+                // 잘못된 값인지 확인. 이는 0분 이상 24시간 이하여야 하며, 최대 이용가능 시간을 초과할 수 없음.
+                if ((libData->MAX_RENEWABLE_TIME < 0 || libData->MAX_RENEWABLE_TIME > 24 * 60) || (libData->MAX_TIME < libData->MAX_RENEWABLE_TIME))
+                {
+                    printf("연장 가능 시간은 0분 이상 24시간 이하여야 하며, 최대 이용 가능 시간을 초과할 수 없습니다.\n");
+                }
+
+            } while ((libData->MAX_RENEWABLE_TIME < 0 || libData->MAX_RENEWABLE_TIME > 24 * 60) || (libData->MAX_TIME < libData->MAX_RENEWABLE_TIME)); // 옳은 입력값이 입력될때까지 반복
+
+            break;
+
+        case 4: // 개장시각 수정
+
+            // 운영 달력을 이용하는 경우, 운영시간은 달력 파일을 따른다.
+            if (libSeats->calendar != NULL)
+            {
+                printf("운영 달력을 이용하는 중입니다. 운영시간은 달력 파일(CALENDAR_FILE)에서 바꿔주세요.\n");
+                break;
+            }
 
             // 기존 개장시각 저장
             oldData = libData->OPEN_TIME;
 
-            if (libData->OPEN_TIME == libData->CLOSE_TIME) // 기존 운영방식이 24시간제인 경우
+            if (libData->OPEN_TIME == libData->CLOSE_TIME) // 기존 운영방식이 24시간제인 경우
+            {
+                // 경고문 출력
+                printf("경고 : 개장 시각과 폐장 시각이 달라지는 경우, 폐장 시각 이후로 지정된 모든 이용자의 퇴실 시각은 폐장 시각으로 일괄 변경됩니다.\n");
+            }
+
+            do {
+                // 기존 개장시각 복원. 이는 잘못된 값을 입력받았을 때 복원하는 용도로 이용된다.
+                libData->OPEN_TIME = oldData;
+
+                // 기존값 출력 및 신규값 입력
+                printf("현재 개장 시각 : %d시 %d분, 현재 폐장 시각 : %d시 %d분\n", libData->OPEN_TIME / 60, libData->OPEN_TIME % 60, libData->CLOSE_TIME / 60, libData->CLOSE_TIME % 60);
+                printf("개장 시각 수정(폐장 시각과 동일하면 24시간) 시간 : ");
+                scanf("%d", &tmpTime); // 시간 단위 입력
+                libData->OPEN_TIME = tmpTime * 60; // 시간 단위를 분단위로 환산 후 저장
+                printf("분 : ");
+                scanf("%d", &tmpTime); // 분단위 입력
+                libData->OPEN_TIME += tmpTime; // 저장된 시간 단위 입력값에 분단위 입력값 추가
+
+                // 잘못된 값인지 확인
+                if (libData->OPEN_TIME < 0 || libData->OPEN_TIME >= 24 * 60)
+                {
+                    printf("개장 시각은 0시 0분부터 23시 59분까지로 설정 가능합니다.\n");
+                }
+            } while ((libData->OPEN_TIME < 0 || libData->OPEN_TIME >= 24 * 60)); // 옳은 입력값이 입력될때까지 반복
+
+            break;
+
+        case 5: // 폐장시각 수정
+
+            // 운영 달력을 이용하는 경우, 운영시간은 달력 파일을 따른다.
+            if (libSeats->calendar != NULL)
+            {
+                printf("운영 달력을 이용하는 중입니다. 운영시간은 달력 파일(CALENDAR_FILE)에서 바꿔주세요.\n");
+                break;
+            }
+
+            // 경고문 출력
+            printf("경고 : 폐장 시각 단축 시, 폐장 시각 이후로 지정된 모든 이용자의 퇴실 시각은 폐장 시각으로 일괄 변경됩니다.\n");
+
+            // 기존 폐장시각 저장
+            oldData = libData->CLOSE_TIME;
+
+            do {
+                // 기존 폐장시각 복원. 이는 잘못된 값을 입력받았을 때 복원하는 용도로 이용된다.
+                libData->CLOSE_TIME = oldData;
+
+                // 기존값 출력 및 신규값 입력
+                printf("현재 개장 시각 : %d시 %d분, 현재 폐장 시각 : %d시 %d분\n", libData->OPEN_TIME / 60, libData->OPEN_TIME % 60, libData->CLOSE_TIME / 60, libData->CLOSE_TIME % 60);
+                printf("폐장 시각 수정(개장 시각과 동일하면 24시간) 시간 : ");
+                scanf("%d", &tmpTime); // 시간 단위 입력
+                libData->CLOSE_TIME = tmpTime * 60; // 시간 단위를 분단위로 환산 후 저장
+                printf("분 : ");
+                scanf("%d", &tmpTime); // 분단위 입력
+                libData->CLOSE_TIME += tmpTime; // 저장된 시간 단위 입력값에 분단위 입력값 추가
+
+                // 잘못된 값인지 확인.
+                if (libData->CLOSE_TIME < 0 || libData->CLOSE_TIME >= 24 * 60)
+                {
+                    printf("폐장 시각은 0시 0분부터 23시 59분까지로 설정 가능합니다.\n");
+                }
+            } while ((libData->CLOSE_TIME < 0 || libData->CLOSE_TIME >= 24 * 60)); // 옳은 입력값이 입력될때까지 반복
+
+            break;
+
+        case 6: // 모든 좌석 정보 보기
+
+            // 모든 좌석의 정보를 관리자 모드로 출력함.
+            printSeatInfo(libSeats, 1);
+            break;
+
+        case 7: // 좌석 이용불가 설정
+
+            // 무한 반복, 좌석 이용불가 설정 종료(0 입력)시 break으로 설정 종료
+            while (1)
+            {
+                // 모든 좌석의 정보를 관리자 모드로 출력함. 이전에 출력한 후 바뀐 좌석만 다시 그린다.
+                printSeatMap(libSeats, 1);
+
+                // 이용불가 설정을 수정할 좌석 번호를 입력받을 변수를 -2로 초기화
+                tmpSeatNo = -2;
+
+                do {
+                    // 이용불가 설정을 수정할 좌석 번호를 입력받음.
+                    printf("이용불가 설정을 바꿀 좌석을 선택하세요.(종료 : 0) : ");
+                    scanf("%d", &tmpSeatNo);
+
+                    // 입력받은 1부터 시작하는 좌석 번호를 0으로 시작하는 좌석 번호로 변환 
+                    tmpSeatNo--;
+
+                    // 잘못된 좌석 번호인 경우(1부터 시작하는 좌석번호 입력값 기준 0(종료)부터 좌석 수(마지막 좌석번호)까지의 범위를 벗어난 경우)
+                    if (tmpSeatNo < -1 || tmpSeatNo >= libSeats->seatCount)
+                    {
+                        printf("잘못된 값을 입력하였습니다.\n");
+                    }
+                } while (tmpSeatNo < -1 || tmpSeatNo >= libSeats->seatCount); // 옳은 입력값이 입력될때까지 반복
+
+                // 0을 입력받은 경우 좌석 이용불가 설정을 종료 (0 - 1 = -1)
+                if (tmpSeatNo == -1)
+                {
+                   break;
+                }
+
+                // 이용불가 설정을 바꾸고, 디스크에 확정한다.
+                toggleSeatState(tmpSeatNo, libSeats);
+                walCommit(libSeats);
+                historyCommit(libSeats, 0);
+            }
+
+            break;
+
+        case 8: // 좌석 일괄 이용불가 설정
+
+            // 좌석 구간, 열람실, 좌석 특징으로 고른 좌석을 한 번에 설정하거나, 이용불가 시간대를 예약함.
+            bulkSeatMenu(libSeats);
+            break;
+
+        case 0: // 관리자 모드 나가기
+            return;
+
+        default: // 그 외의 값이 입력된 경우
+            printf("잘못된 값을 입력하였습니다.\n");
+        }
+
+        // 운영정보가 바뀐 경우(2~5번 메뉴) 이를 모든 단말기에 반영하고 기록한다.
+        if (menu_sel >= 2 && menu_sel <= 5)
+        {
+            spinLock(&room->configLock);
+            updateLibraryData(libSeats, room, &editData);
+            spinUnlock(&room->configLock);
+        }
+
+        // 이번 메뉴에서 생긴 기록을 디스크에 확정한다.
+        walCommit(libSeats);
+        historyCommit(libSeats, 0);
+    }
+
+    return;
+}
+
+
+/*
+* updateLibraryData 함수
+* 기능 : 새 운영정보를 모든 단말기가 이용하는 열람실의 운영정보에 반영하고 기록한다. 개장, 폐장시각이 바뀐 경우 열람실에서 폐장시각을 초과하는 퇴실 시각을 조정한다.
+*        열람실의 운영정보 잠금을 얻은 후 호출해야 한다. 관리자 모드와 좌석 서비스의 관리자 명령이 함께 이용한다.
+* 입력값 : 좌석 정보 구조체 포인터 *libSeats, 열람실 구조체 포인터 *room, 시설 정보 구조체 포인터 *newData(새 운영정보)
+* 반환값 없음
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+void updateLibraryData(SeatsData* libSeats, RoomData* room, LibraryData* newData)
+{
+    // 운영시간 변경 시 이용하는 현재 시각 정보
+    ClockContext clock;
+
+    // 개장, 폐장시각이 바뀌었는지 확인한다.
+    int isTimeChanged = room->libData.OPEN_TIME != newData->OPEN_TIME || room->libData.CLOSE_TIME != newData->CLOSE_TIME;
+
+    // 새 운영정보를 반영하고 기록한다. 값 4개를 한 번에 복사하므로, 입력 도중의 값은 다른 단말기에 보이지 않는다.
+    room->libData = *newData;
+    walLogLibrary(libSeats, room);
+
+    // 폐장 시각을 초과하는 퇴실 시각을 조정함. 24시간제인 경우, 해당 함수가 작동하지 않음.
+    // 바뀐 운영시간으로 현재 시각 정보를 다시 생성한다.
+    if (isTimeChanged)
+    {
+        captureClock(&clock, libSeats, room);
+        renewSeatEndTime(libSeats, room, &clock);
+    }
+
+    return;
+}
+
+
+/*
+* toggleSeatState 함수
+* 기능 : 좌석의 이용불가 설정을 바꾼다. 빈 좌석은 이용불가 좌석으로, 이용불가 좌석은 빈 좌석으로 바뀌며, 이용중인 좌석은 퇴실 처리 후 이용불가 좌석이 된다.
+*        빈 좌석으로 바뀐 경우, 대기열의 차례인 이용자에게 맡긴다.
+* 입력값 : location(0번부터 시작하는 좌석번호), 좌석 정보 구조체 포인터 *libSeats
+* 반환값 없음
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+void toggleSeatState(int location, SeatsData* libSeats)
+{
+    // 좌석 잠금을 얻은 후 이용불가 설정을 바꾼다.
+    spinLock(&libSeats->seatLock[location]);
+
+    // 이미 이용중인 좌석의 경우 좌석 초기화를 진행함
+    if (libSeats->seatState[location] == SEAT_USED)
+    {
+        // 해당 좌석을 퇴실 처리함
+        checkOut(location, HISTORY_UNAVAILABLE, libSeats);
+    }
+
+    // 빈 좌석(SEAT_EMPTY)인 경우 이용불가(SEAT_UNAVAILABLE)로, 이용불가인 경우 빈 좌석으로 변경
+    // 관리자가 바꾼 좌석이므로, 이용불가 시간대가 바꾼 좌석이었더라도 시간대의 표시를 지운다.
+    setSeatState(location, (libSeats->seatState[location] == SEAT_UNAVAILABLE) ? SEAT_EMPTY : SEAT_UNAVAILABLE, libSeats);
+    __atomic_fetch_and(&libSeats->blackoutMap[location / BITMAP_WORD_BITS], ~(1ULL << (location % BITMAP_WORD_BITS)), __ATOMIC_RELAXED);
+
+    // 이용불가 설정 변경을 기록한다.
+    walLog(libSeats, WAL_SEAT_STATE, libSeats->seatState[location], location, 0, NULL);
+
+    // 이용불가를 해제한 좌석은 대기열의 차례인 이용자에게 맡긴다.
+    if (libSeats->seatState[location] == SEAT_EMPTY)
+    {
+        handOffSeat(location, libSeats);
+    }
+
+    spinUnlock(&libSeats->seatLock[location]);
+
+    return;
+}
+
+
+/*
+* bulkSeatMenu 함수
+* 기능 : 좌석 선택 문자열(parseSeatSelection 참고)로 고른 좌석을 한 번에 이용불가로 바꾸거나, 이용불가를 해제하거나, 이용불가 시간대를 예약한다.
+*        좌석을 하나씩 바꾸는 7번 메뉴와 달리, 고른 좌석을 한 번의 비트맵 연산으로 바꾼 후 좌석 배치도를 한 번만 출력한다.
+* 입력값 : 좌석 정보 구조체 포인터 *libSeats
+* 반환값 없음
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+void bulkSeatMenu(SeatsData* libSeats)
+{
+    char selection[SELECTION_LENGTH] = "";
+    char timeText[SELECTION_LENGTH] = "";
+    const char* cursor = NULL;
+    unsigned long long int* mask = NULL;
+    long long int now = readClock(libSeats), start = 0, end = 0;
+    int count = 0, action = 0, changed = 0;
+
+    // 예약된 이용불가 시간대를 먼저 보여준다.
+    printBlackouts(libSeats);
+
+    mask = malloc(sizeof(unsigned long long int) * libSeats->wordCount);
+    if (mask == NULL)
+    {
+        printf("메모리를 할당할 수 없습니다.\n");
+        return;
+    }
+
+    // 좌석 선택 문자열을 입력받는다. 잘못 입력한 경우 다시 입력받는다.
+    do {
+        printf("좌석을 선택하세요. 예) 101-400,450 ROOM 2 WINDOW (종료 : 0) : ");
+        if (scanf(" %255[^\n]", selection) != 1 || strcmp(selection, "0") == 0)
+        {
+            free(mask);
+            return;
+        }
+
+        count = parseSeatSelection(selection, selection + strlen(selection), mask, libSeats);
+        if (count <= 0)
+        {
+            printf(count == 0 ? "선택한 좌석이 없습니다.\n" : "잘못된 값을 입력하였습니다. (좌석 특징은 좌석 배치 파일이 있는 경우에만 고를 수 있습니다.)\n");
+        }
+    } while (count <= 0); // 옳은 입력값이 입력될때까지 반복
+
+    printf("%d개 좌석을 선택하였습니다.\n", count);
+    printf("1 : 이용불가로 설정, 2 : 이용불가 해제, 3 : 이용불가 시간대 예약, 0 : 취소 : ");
+    scanf("%d", &action);
+
+    switch (action)
+    {
+    case 1: // 이용불가로 설정. 이용중인 좌석은 퇴실 처리함.
+        changed = setSeatsState(mask, 0, libSeats->seatCount, SEAT_UNAVAILABLE, 0, libSeats);
+        printf("%d개 좌석을 이용불가로 바꾸었습니다.\n", changed);
+        break;
+
+    case 2: // 이용불가 해제
+        changed = setSeatsState(mask, 0, libSeats->seatCount, SEAT_EMPTY, 0, libSeats);
+        printf("%d개 좌석의 이용불가를 해제하였습니다.\n", changed);
+        break;
+
+    case 3: // 이용불가 시간대 예약. 시각의 형식은 [YYYY-MM-DD] HH:MM 이다.
+        printf("시작시각을 입력하세요. ([YYYY-MM-DD] HH:MM) : ");
+        scanf(" %255[^\n]", timeText);
+        cursor = timeText;
+        if (!parseDateTime(&cursor, timeText + strlen(timeText), now, &start))
+        {
+            printf("잘못된 값을 입력하였습니다.\n");
+            break;
+        }
+        printf("종료시각을 입력하세요. ([YYYY-MM-DD] HH:MM) : ");
+        scanf(" %255[^\n]", timeText);
+        cursor = timeText;
+        if (!parseDateTime(&cursor, timeText + strlen(timeText), now, &end) || end <= start)
+        {
+            printf("종료시각은 시작시각보다 뒤여야 합니다.\n");
+            break;
+        }
+
+        count = scheduleBlackout(mask, start, end, libSeats);
+        if (count == 0)
+        {
+            printf("이용불가 시간대는 최대 %d개까지 예약할 수 있습니다.\n", MAX_BLACKOUTS);
+            break;
+        }
+        printf("이용불가 시간대 %d개를 예약하였습니다.\n", count);
+
+        // 이미 시작된 시간대는 바로 처리한다.
+        runBlackouts(libSeats, now);
+        break;
+
+    default: // 취소
+        break;
+    }
+
+    free(mask);
+
+    // 바뀐 좌석을 디스크에 확정한 후, 좌석 배치도를 한 번 출력한다.
+    walCommit(libSeats);
+    historyCommit(libSeats, 0);
+    printSeatMap(libSeats, 1);
+
+    return;
+}
+
+
+/*
+* menuSelect 함수
+* 기능 : 메인 메뉴에서 이용자명 입력값을 받이 반환함
+* 입력값 : 이용자명을 반환할 문자열 포인터 *tmp
+* 반환값 : *tmp으로 입력받은 문자열 반환. 입력을 받은 경우 1, 입력이 끝난 경우(EOF) 0을 반환
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+int menuSelect(char* tmp)
+{
+    // 이용자 정보를 입력받음
+    printf("이용자 정보를 입력하세요.(관리자 모드: 0) : ");
+
+    return scanf("%19s", tmp) == 1;
+}
+
+
+/*
+* init 함수
+* 기능 : 프로그램 최초 실행 시 실행되어 초기화 등을 진행함
+* 입력값 : 좌석 정보 구조체 포인터 *libSeats
+* 반환값 없음
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+void init(SeatsData* libSeats)
+{
+    // 이용자명 표와 색인은 모든 열람실이 함께 이용하므로 먼저 비운다.
+    spinLock(&libSeats->header->indexLock);
+    resetUsers(libSeats);
+    spinUnlock(&libSeats->header->indexLock);
+
+    // 열람실마다 모든 좌석을 빈좌석으로 초기화함.
+    for (int i = 0; i < libSeats->header->roomCount; i++)
+    {
+        resetSeats(libSeats, &libSeats->header->rooms[i], 1, HISTORY_RESET);
+    }
+
+    return;
+}
+
+
+/*
+* loadConfig 함수
+* 기능 : 설정 파일에서 좌석 수와 열람실 운영정보를 읽어온다. 설정 파일이 없는 경우 기본값을 그대로 이용한다.
+* 입력값 : *path(설정 파일 경로), 프로그램 설정 구조체 포인터 *config, 시설 정보 구조체 포인터 *libData
+* 반환값 : 설정을 정상적으로 읽었거나 설정 파일이 없는 경우 1, 설정 파일의 내용이 잘못된 경우 0을 반환함.
+* 설명 최종 수정 일자 : 2026/10/17
+*
+* 설정 파일 형식 (한 줄에 하나의 항목, #으로 시작하는 줄은 주석)
+* SEATS 4000              : 좌석 수
+* MAX_TIME 240            : 최대 이용 시간(분)
+* MAX_RENEWABLE_TIME 30   : 연장 가능 시간(분)
+* OPEN_TIME 09:00         : 개장 시각(시:분)
+* CLOSE_TIME 22:00        : 폐장 시각(시:분)
+* DATA_DIR /var/lib/seats : 좌석 상태를 기록할 디렉터리 (없으면 기록하지 않음)
+* RESERVATIONS 4          : 좌석마다 저장할 수 있는 예약 수 (0이면 예약을 받지 않음)
+* ARCHIVE_DAYS 7          : 지난 시각의 복원에 이용할 지난 세대의 스냅샷과 기록 파일을 보관하는 일수 (0이면 보관하지 않음)
+* LAYOUT_FILE seats.layout : 좌석의 위치와 특징을 적은 배치 파일 (없으면 좌석을 추천하지 않음, 형식은 parseLayoutLine 참고)
+* HISTORY_FILE seats.history : 끝난 이용을 남기는 이용 기록 파일 (없으면 남기지 않음, 집계는 -H 인자로 실행)
+* CALENDAR_FILE hours.calendar : 요일별 운영시간과 날짜 예외를 적은 달력 파일 (없으면 개장, 폐장 시각을 따름, 형식은 parseCalendarLine 참고)
+* ROOM 제1열람실 120 09:00 22:00 240 30 : 열람실 이름, 좌석 수, 개장, 폐장 시각, 최대 이용 시간, 연장 가능 시간 (좌석 수 뒤의 값은 생략 가능하며, 생략한 값은 위의 값을 따름)
+*/
+int loadConfig(const char* path, SystemConfig* config, LibraryData* libData)
+{
+    // 설정 파일 관련 변수 선언
+    FILE* fp = fopen(path, "r");
+    char line[256], key[64], word[16];
+    int value = 0, hour = 0, minute = 0, lineNo = 0;
+
+    // 설정 파일이 없는 경우, 기본값을 이용한다.
+    if (fp == NULL)
+    {
+        return 1;
+    }
+
+    // 설정 파일을 한 줄씩 읽는다.
+    while (fgets(line, sizeof(line), fp) != NULL)
+    {
+        lineNo++;
+
+        // 빈 줄과 주석은 건너뛴다.
+        if (sscanf(line, "%63s", key) != 1 || key[0] == '#')
+        {
+            continue;
+        }
+
+        if (!strcmp(key, "SEATS") && sscanf(line, "%*s %d", &value) == 1 && value > 0 && value <= MAX_SEATS) // 좌석 수
+        {
+            config->seatCount = value;
+
+        }else if (!strcmp(key, "DATA_DIR") && sscanf(line, "%*s %255s", config->dataDir) == 1){ // 기록 디렉터리
+
+        }else if (!strcmp(key, "SHARED_FILE") && sscanf(line, "%*s %255s", config->sharedFile) == 1){ // 공유 좌석 파일
+
+        }else if (!strcmp(key, "WORKERS") && sscanf(line, "%*s %d", &value) == 1 && value > 0 && value <= MAX_WORKERS){ // 좌석 서비스 작업 스레드 수
+            config->workerCount = value;
+
+        }else if (!strcmp(key, "METRICS_FILE") && sscanf(line, "%*s %255s", config->metricsFile) == 1){ // 운영 지표 파일
+
+        }else if (!strcmp(key, "METRICS_INTERVAL") && sscanf(line, "%*s %d", &value) == 1 && value > 0 && value <= 3600){ // 운영 지표 파일을 다시 쓰는 간격(초)
+            config->metricsInterval = value;
+
+        }else if (!strcmp(key, "SEAT_MAP") && sscanf(line, "%*s %15s", word) == 1 && (!strcmp(word, "LIST") || !strcmp(word, "GRID"))){ // 좌석 배치도 보기 방식
+            config->seatMapGrid = !strcmp(word, "GRID");
+
+        }else if (!strcmp(key, "LAYOUT_FILE") && sscanf(line, "%*s %255s", config->layoutFile) == 1){ // 좌석 배치 파일
+        }else if (!strcmp(key, "HISTORY_FILE") && sscanf(line, "%*s %255s", config->historyFile) == 1){ // 이용 기록 파일
+        }else if (!strcmp(key, "CALENDAR_FILE") && sscanf(line, "%*s %255s", config->calendarFile) == 1){ // 운영 달력 파일
+
+        }else if (!strcmp(key, "RESERVATIONS") && sscanf(line, "%*s %d", &value) == 1 && value >= 0 && value <= MAX_RESERVATIONS){ // 좌석당 예약 수
+            config->reserveSlots = value;
+        }else if (!strcmp(key, "ARCHIVE_DAYS") && sscanf(line, "%*s %d", &value) == 1 && value >= 0 && value <= 3650){ // 지난 세대 파일 보관 일수
+            config->archiveDays = value;
+        }else if (!strcmp(key, "DAILY_QUOTA") && sscanf(line, "%*s %d", &value) == 1 && value >= 0 && value <= 24 * 60){ // 이용자별 하루 이용 한도(분)
+            config->dailyQuota = value;
+        }else if (!strcmp(key, "MAX_RENEWALS") && sscanf(line, "%*s %d", &value) == 1 && value >= 0 && value <= 254){ // 이용 한 번의 최대 연장 횟수
+            config->maxRenewals = value;
+        }else if (!strcmp(key, "DAILY_RENEWALS") && sscanf(line, "%*s %d", &value) == 1 && value >= 0 && value <= 65534){ // 이용자별 하루 최대 연장 횟수
+            config->dailyRenewals = value;
+        }else if (!strcmp(key, "QUOTA_USERS") && sscanf(line, "%*s %d", &value) == 1 && value > 0 && value <= MAX_QUOTA_USERS){ // 하루 이용 한도를 기록할 이용자 수
+            config->quotaUsers = value;
+
+        }else if (!strcmp(key, "ROOM") && config->roomCount < MAX_ROOMS && parseRoomLine(line, &config->rooms[config->roomCount])){ // 열람실
+            config->roomCount++;
+
+        }else if (!strcmp(key, "MAX_TIME") && sscanf(line, "%*s %d", &value) == 1 && value > 0 && value <= 24 * 60){ // 최대 이용 시간
+            libData->MAX_TIME = value;
+
+        }else if (!strcmp(key, "MAX_RENEWABLE_TIME") && sscanf(line, "%*s %d", &value) == 1 && value >= 0 && value <= 24 * 60){ // 연장 가능 시간
+            libData->MAX_RENEWABLE_TIME = value;
+
+        }else if ((!strcmp(key, "OPEN_TIME") || !strcmp(key, "CLOSE_TIME")) && sscanf(line, "%*s %d:%d", &hour, &minute) == 2
+            && hour >= 0 && hour < 24 && minute >= 0 && minute < 60){ // 개장, 폐장 시각
+
+            if (key[0] == 'O')
+            {
+                libData->OPEN_TIME = hour * 60 + minute;
+            }else{
+                libData->CLOSE_TIME = hour * 60 + minute;
+            }
+
+        }else{ // 알 수 없는 항목이거나 잘못된 값인 경우
+            printf("설정 파일 %s의 %d번째 줄이 잘못되었습니다.\n", path, lineNo);
+            fclose(fp);
+            return 0;
+        }
+    }
+
+    fclose(fp);
+
+    // 연장 가능 시간은 최대 이용 시간을 초과할 수 없다.
+    if (libData->MAX_RENEWABLE_TIME > libData->MAX_TIME)
+    {
+        printf("설정 파일 %s : 연장 가능 시간은 최대 이용 시간을 초과할 수 없습니다.\n", path);
+        return 0;
+    }
+
+    return 1;
+}
+
+
+/*
+* parseRoomLine 함수
+* 기능 : 설정 파일의 열람실 항목(ROOM 이름 좌석수 [개장시각 [폐장시각 [최대이용시간 [연장가능시간]]]])을 읽는다.
+*        생략한 운영정보는 -1로 두며, layoutRooms에서 설정 파일 전체의 운영정보로 채운다.
+* 입력값 : 설정 파일의 한 줄 line, 열람실 구조체 포인터 *room
+* 반환값 : 올바른 항목인 경우 1, 잘못된 항목인 경우 0
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+int parseRoomLine(const char* line, RoomData* room)
+{
+    char openWord[16] = "", closeWord[16] = "";
+    int seatCount = 0, maxTime = -1, renewTime = -1, hour = 0, minute = 0;
+    int count = sscanf(line, "%*s %15s %d %15s %15s %d %d", room->name, &seatCount, openWord, closeWord, &maxTime, &renewTime);
+
+    memset(&room->libData, 0xFF, sizeof(LibraryData)); // 모든 운영정보를 -1로 둔다.
+    room->firstSeat = 0;
+    room->heapSize = 0;
+    room->heapLock = 0;
+    room->configLock = 0;
+
+    // 이름과 좌석 수는 반드시 있어야 한다.
+    if (count < 2 || seatCount <= 0 || seatCount > MAX_SEATS)
+    {
+        return 0;
+    }
+    room->seatCount = seatCount;
+
+    // 개장, 폐장 시각 (시:분)
+    if (count >= 3)
+    {
+        if (sscanf(openWord, "%d:%d", &hour, &minute) != 2 || hour < 0 || hour >= 24 || minute < 0 || minute >= 60) { return 0; }
+        room->libData.OPEN_TIME = hour * 60 + minute;
+    }
+    if (count >= 4)
+    {
+        if (sscanf(closeWord, "%d:%d", &hour, &minute) != 2 || hour < 0 || hour >= 24 || minute < 0 || minute >= 60) { return 0; }
+        room->libData.CLOSE_TIME = hour * 60 + minute;
+    }
+
+    // 최대 이용 시간, 연장 가능 시간 (분)
+    if (count >= 5)
+    {
+        if (maxTime <= 0 || maxTime > 24 * 60) { return 0; }
+        room->libData.MAX_TIME = maxTime;
+    }
+    if (count >= 6)
+    {
+        if (renewTime < 0 || renewTime > 24 * 60) { return 0; }
+        room->libData.MAX_RENEWABLE_TIME = renewTime;
+    }
+
+    return 1;
+}
+
+
+/*
+* layoutRooms 함수
+* 기능 : 열람실마다 좌석 범위(첫 좌석번호)를 정하고, 생략한 운영정보를 설정 파일 전체의 운영정보로 채운다. 좌석 수는 모든 열람실의 좌석 수의 합이 된다.
+*        설정 파일에 열람실 항목이 없는 경우, 좌석 수(SEATS)와 운영정보로 열람실 하나를 만든다.
+* 입력값 : 프로그램 설정 구조체 포인터 *config, 시설 정보 구조체 포인터 *libData(설정 파일 전체의 운영정보)
+* 반환값 : 성공한 경우 1, 열람실의 운영정보가 잘못되었거나 좌석 수의 합이 너무 큰 경우 0
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+int layoutRooms(SystemConfig* config, LibraryData* libData)
+{
+    long long int seatCount = 0;
+    RoomData* room = NULL;
+
+    if (config->roomCount == 0)
+    {
+        memset(&config->rooms[0], 0, sizeof(RoomData));
+        memset(&config->rooms[0].libData, 0xFF, sizeof(LibraryData));
+        config->rooms[0].seatCount = config->seatCount;
+        config->roomCount = 1;
+    }
+
+    for (int i = 0; i < config->roomCount; i++)
+    {
+        room = &config->rooms[i];
+
+        // 생략한 운영정보를 채운다.
+        if (room->libData.MAX_TIME < 0) { room->libData.MAX_TIME = libData->MAX_TIME; }
+        if (room->libData.MAX_RENEWABLE_TIME < 0) { room->libData.MAX_RENEWABLE_TIME = libData->MAX_RENEWABLE_TIME; }
+        if (room->libData.OPEN_TIME < 0) { room->libData.OPEN_TIME = libData->OPEN_TIME; }
+        if (room->libData.CLOSE_TIME < 0) { room->libData.CLOSE_TIME = libData->CLOSE_TIME; }
+
+        // 연장 가능 시간은 최대 이용 시간을 초과할 수 없다.
+        if (room->libData.MAX_RENEWABLE_TIME > room->libData.MAX_TIME)
+        {
+            printf("%s 열람실의 연장 가능 시간은 최대 이용 시간을 초과할 수 없습니다.\n", room->name);
+            return 0;
+        }
+
+        room->firstSeat = (int)seatCount;
+        seatCount += room->seatCount;
+    }
+
+    if (seatCount > MAX_SEATS)
+    {
+        printf("모든 열람실의 좌석 수의 합은 %d 이하여야 합니다.\n", MAX_SEATS);
+        return 0;
+    }
+    config->seatCount = (int)seatCount;
+
+    return 1;
+}
+
+
+/*
+* layoutSeats 함수
+* 기능 : 좌석 수에 따른 좌석 저장소 블록의 크기를 계산하고, 블록이 주어진 경우 각 열의 위치를 좌석 정보 구조체에 저장한다.
+*        블록의 맨 앞에는 머리 부분이 오고, 그 뒤로 모든 열과 색인이 캐시 라인 단위로 정렬되어 배치된다. 공유 좌석 파일도 같은 배치를 이용한다.
+* 입력값 : 좌석 정보 구조체 포인터 *libSeats, seatCount(좌석 수), reserveSlots(좌석당 예약 수), quotaUsers(이용 한도 표의 이용자 수, 0이면 표를 두지 않음), *block(좌석 저장소 블록, 크기만 계산하는 경우 NULL)
+* 반환값 : 블록 전체의 크기(바이트)
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+size_t layoutSeats(SeatsData* libSeats, int seatCount, int reserveSlots, int quotaUsers, char* block)
+{
+    // 이용자명 색인의 크기를 좌석 수의 2배 이상인 2의 거듭제곱으로 정한다.
+    unsigned int indexSize = 1;
+    while (indexSize < 2u * (unsigned int)seatCount)
+    {
+        indexSize <<= 1;
+    }
+
+    // 이용 한도 표의 크기를 이용자 수의 2배 이상인 2의 거듭제곱으로 정한다. 이용자 수가 0이면 표를 두지 않는다.
+    unsigned int quotaSize = quotaUsers > 0 ? 1 : 0;
+    while (quotaSize > 0 && quotaSize < 2u * (unsigned int)quotaUsers)
+    {
+        quotaSize <<= 1;
+    }
+
+    // 좌석 비트맵의 워드 수
+    int wordCount = (seatCount + BITMAP_WORD_BITS - 1) / BITMAP_WORD_BITS;
+
+    // 각 열의 위치를 캐시 라인 단위로 올림하여 계산한다. 자주 순회하는 열부터 차례대로 배치한다.
+    // 좌석마다 읽는 값은 이용종료시각과 이용자 번호(각 4바이트)뿐이며, 이용자명 표는 이름을 비교하거나 출력할 때만 읽으므로 맨 뒤에 둔다.
+    size_t endTimeOffset = CACHE_ALIGN(sizeof(SeatsHeader));
+    size_t userOffset = endTimeOffset + CACHE_ALIGN(sizeof(unsigned int) * seatCount);
+    size_t stateOffset = userOffset + CACHE_ALIGN(sizeof(unsigned int) * seatCount);
+    size_t lockOffset = stateOffset + CACHE_ALIGN(sizeof(unsigned char) * seatCount);
+    size_t versionOffset = lockOffset + CACHE_ALIGN(sizeof(unsigned char) * seatCount);
+    size_t freeMapOffset = versionOffset + CACHE_ALIGN(sizeof(unsigned int) * seatCount);
+    size_t unavailableMapOffset = freeMapOffset + CACHE_ALIGN(sizeof(unsigned long long int) * wordCount);
+    size_t blackoutMapOffset = unavailableMapOffset + CACHE_ALIGN(sizeof(unsigned long long int) * wordCount);
+    size_t heapOffset = blackoutMapOffset + CACHE_ALIGN(sizeof(unsigned long long int) * wordCount);
+    size_t heapPosOffset = heapOffset + CACHE_ALIGN(sizeof(int) * seatCount);
+    size_t indexOffset = heapPosOffset + CACHE_ALIGN(sizeof(int) * seatCount);
+    size_t hashOffset = indexOffset + CACHE_ALIGN(sizeof(int) * indexSize);
+    size_t userSeatOffset = hashOffset + CACHE_ALIGN(sizeof(unsigned int) * (seatCount + 1));
+    size_t freeUserOffset = userSeatOffset + CACHE_ALIGN(sizeof(int) * (seatCount + 1));
+    size_t reserveCountOffset = freeUserOffset + CACHE_ALIGN(sizeof(unsigned int) * seatCount);
+    size_t reservedMapOffset = reserveCountOffset + CACHE_ALIGN(sizeof(unsigned char) * seatCount);
+    size_t reserveStartOffset = reservedMapOffset + CACHE_ALIGN(sizeof(unsigned long long int) * wordCount);
+    size_t reserveEndOffset = reserveStartOffset + CACHE_ALIGN(sizeof(unsigned int) * seatCount * reserveSlots);
+    size_t sessionStartOffset = reserveEndOffset + CACHE_ALIGN(sizeof(unsigned int) * seatCount * reserveSlots);
+    size_t renewCountOffset = sessionStartOffset + CACHE_ALIGN(sizeof(unsigned int) * seatCount);
+    size_t nameOffset = renewCountOffset + CACHE_ALIGN(sizeof(unsigned char) * seatCount);
+    size_t reserveNameOffset = nameOffset + CACHE_ALIGN(sizeof(*libSeats->userName) * (seatCount + 1));
+    size_t quotaHashOffset = reserveNameOffset + CACHE_ALIGN(sizeof(*libSeats->reserveName) * seatCount * reserveSlots);
+    size_t quotaCounterOffset = quotaHashOffset + CACHE_ALIGN(sizeof(unsigned int) * quotaSize);
+    size_t quotaNameOffset = quotaCounterOffset + CACHE_ALIGN(sizeof(QuotaCounter) * quotaSize);
+    size_t blockSize = quotaNameOffset + CACHE_ALIGN(sizeof(*libSeats->quotaName) * quotaSize);
+
+    // 크기만 계산하는 경우 함수 종료
+    if (block == NULL)
+    {
+        return blockSize;
+    }
+
+    libSeats->seatCount = seatCount;
+    libSeats->block = block;
+    libSeats->header = (SeatsHeader*)block;
+    libSeats->endTime = (unsigned int*)(block + endTimeOffset);
+    libSeats->seatUser = (unsigned int*)(block + userOffset);
+    libSeats->seatState = (unsigned char*)(block + stateOffset);
+    libSeats->seatLock = (unsigned char*)(block + lockOffset);
+    libSeats->seatVersion = (unsigned int*)(block + versionOffset);
+    libSeats->freeMap = (unsigned long long int*)(block + freeMapOffset);
+    libSeats->unavailableMap = (unsigned long long int*)(block + unavailableMapOffset);
+    libSeats->blackoutMap = (unsigned long long int*)(block + blackoutMapOffset);
+    libSeats->wordCount = wordCount;
+    libSeats->expiryHeap = (int*)(block + heapOffset);
+    libSeats->heapPos = (int*)(block + heapPosOffset);
+    libSeats->userIndex = (int*)(block + indexOffset);
+    libSeats->indexMask = indexSize - 1;
+    libSeats->userHash = (unsigned int*)(block + hashOffset);
+    libSeats->userSeat = (int*)(block + userSeatOffset);
+    libSeats->freeUsers = (unsigned int*)(block + freeUserOffset);
+    libSeats->userName = (char (*)[MAX_NAME_LENGTH])(block + nameOffset);
+    libSeats->reserveSlots = reserveSlots;
+    libSeats->reserveCount = (unsigned char*)(block + reserveCountOffset);
+    libSeats->reservedMap = (unsigned long long int*)(block + reservedMapOffset);
+    libSeats->reserveStart = (unsigned int*)(block + reserveStartOffset);
+    libSeats->reserveEnd = (unsigned int*)(block + reserveEndOffset);
+    libSeats->reserveName = (char (*)[MAX_NAME_LENGTH])(block + reserveNameOffset);
+    libSeats->sessionStart = (unsigned int*)(block + sessionStartOffset);
+    libSeats->renewCount = (unsigned char*)(block + renewCountOffset);
+    libSeats->quotaHash = (unsigned int*)(block + quotaHashOffset);
+    libSeats->quotaCounter = (QuotaCounter*)(block + quotaCounterOffset);
+    libSeats->quotaName = (char (*)[MAX_NAME_LENGTH])(block + quotaNameOffset);
+    libSeats->quotaMask = quotaSize > 0 ? quotaSize - 1 : 0;
+    libSeats->quotaSegmentMask = quotaSize >= QUOTA_LOCK_STRIPES * QUOTA_SEGMENT_MIN ? quotaSize / QUOTA_LOCK_STRIPES - 1 : libSeats->quotaMask;
+    libSeats->dailyQuota = 0;
+    libSeats->maxRenewals = 0;
+    libSeats->dailyRenewals = 0;
+    libSeats->wal = NULL;
+    libSeats->clockSource = NULL;
+    libSeats->metrics = NULL;
+    libSeats->seatMap = NULL;
+    libSeats->layout = NULL;
+    libSeats->calendar = NULL;
+    libSeats->history = NULL;
+    libSeats->service = NULL;
+
+    // 모든 좌석을 순회하는 함수가 이용할 벡터 연산 수준을 정한다. 같은 공유 파일을 이용하는 단말기마다 CPU가 다를 수 있으므로 프로세스마다 정한다.
+    libSeats->simdLevel = detectSimdLevel();
+
+    return blockSize;
+}
+
+
+/*
+* createSeats 함수
+* 기능 : 주어진 열람실들의 좌석 수를 합한 만큼의 좌석 저장소를 프로세스 전용 메모리에 생성하고, 열람실 구성과 운영정보를 머리 부분에 복사한다.
+* 입력값 : 좌석 정보 구조체 포인터 *libSeats, 열람실 배열 rooms(첫 좌석번호와 초기 운영정보가 정해져 있어야 함), roomCount(열람실 수), reserveSlots(좌석당 예약 수), quotaUsers(이용 한도 표의 이용자 수)
+* 반환값 : 생성에 성공한 경우 1, 메모리가 부족한 경우 0을 반환함.
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+int createSeats(SeatsData* libSeats, const RoomData* rooms, int roomCount, int reserveSlots, int quotaUsers)
+{
+    // 모든 열을 담을 메모리 블록을 할당한다. 블록의 크기는 캐시 라인 크기의 배수이다.
+    int seatCount = rooms[roomCount - 1].firstSeat + rooms[roomCount - 1].seatCount;
+    size_t blockSize = layoutSeats(libSeats, seatCount, reserveSlots, quotaUsers, NULL);
+    char* block = aligned_alloc(CACHE_LINE_SIZE, blockSize);
+    if (block == NULL)
+    {
+        return 0;
+    }
+
+    // 잠금 열과 머리 부분이 풀린 상태(0)로 시작하도록 블록 전체를 0으로 초기화한 후, 열을 배치한다.
+    memset(block, 0, blockSize);
+    layoutSeats(libSeats, seatCount, reserveSlots, quotaUsers, block);
+    libSeats->isShared = 0;
+
+    libSeats->header->seatCount = seatCount;
+    libSeats->header->blockSize = blockSize;
+    libSeats->header->reserveSlots = reserveSlots;
+    libSeats->header->quotaUsers = quotaUsers;
+    libSeats->header->roomCount = roomCount;
+    memcpy(libSeats->header->rooms, rooms, sizeof(RoomData) * roomCount);
+
+    return 1;
+}
+
+
+/*
+* mapSeats 함수
+* 기능 : 공유 좌석 파일을 mmap(MAP_SHARED)으로 대응하여 좌석 저장소로 이용한다. 같은 파일을 이용하는 모든 단말기는 같은 좌석 정보를 복사 없이 함께 읽고 쓴다.
+*        파일이 없는 경우, 임시 파일에 초기화된 좌석 저장소를 만든 후 link로 한 번에 게시한다. 따라서 다른 단말기는 초기화가 끝난 파일만 보게 된다.
+* 입력값 : *path(공유 좌석 파일 경로), 좌석 정보 구조체 포인터 *libSeats, 열람실 배열 rooms와 roomCount(열람실 수), reserveSlots(좌석당 예약 수), quotaUsers(이용 한도 표의 이용자 수) - 파일을 새로 만드는 경우의 구성
+* 반환값 : 성공한 경우 1, 파일을 열거나 만들 수 없거나 형식이 다른 경우 0을 반환함.
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+int mapSeats(const char* path, SeatsData* libSeats, const RoomData* rooms, int roomCount, int reserveSlots, int quotaUsers)
+{
+    // 공유 좌석 파일 관련 변수 선언
+    int seatCount = rooms[roomCount - 1].firstSeat + rooms[roomCount - 1].seatCount;
+    char tmpPath[MAX_PATH_LENGTH + 32];
+    size_t blockSize = layoutSeats(libSeats, seatCount, reserveSlots, quotaUsers, NULL);
+    char* block = NULL;
+    SeatsHeader* header = NULL;
+    struct stat fileStat;
+    int fd = open(path, O_RDWR), linkError = 0;
+
+    // 공유 좌석 파일이 없는 경우, 임시 파일에 새 좌석 저장소를 만든다.
+    if (fd < 0 && errno == ENOENT)
+    {
+        snprintf(tmpPath, sizeof(tmpPath), "%s.%ld.tmp", path, (long)getpid());
+        fd = open(tmpPath, O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0 || ftruncate(fd, (off_t)blockSize) != 0
+            || (block = mmap(NULL, blockSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0)) == MAP_FAILED)
+        {
+            printf("공유 좌석 파일 %s을 만들 수 없습니다.\n", path);
+            if (fd >= 0) { close(fd); unlink(tmpPath); }
+            return 0;
+        }
+
+        // ftruncate로 늘어난 부분은 0으로 채워지므로, 모든 잠금은 풀린 상태이다. 머리 부분을 기록하고 모든 좌석을 초기화한다.
+        layoutSeats(libSeats, seatCount, reserveSlots, quotaUsers, block);
+        libSeats->isShared = 1;
+        memcpy(libSeats->header->magic, SHARED_MAGIC, sizeof(libSeats->header->magic));
+        libSeats->header->version = SHARED_VERSION;
+        libSeats->header->seatCount = seatCount;
+        libSeats->header->blockSize = blockSize;
+        libSeats->header->reserveSlots = reserveSlots;
+        libSeats->header->quotaUsers = quotaUsers;
+        libSeats->header->roomCount = roomCount;
+        memcpy(libSeats->header->rooms, rooms, sizeof(RoomData) * roomCount);
+        init(libSeats);
+
+        // 초기화가 끝난 파일을 공유 좌석 파일 경로에 게시한다. link는 이미 파일이 있는 경우 실패하므로, 동시에 만든 경우에도 하나만 게시된다.
+        if (link(tmpPath, path) == 0)
+        {
+            unlink(tmpPath);
+            close(fd);
+            return 1;
+        }
+
+        // 다른 단말기가 먼저 게시한 경우, 만든 파일을 버리고 먼저 게시된 파일을 연다.
+        linkError = errno;
+        munmap(block, blockSize);
+        close(fd);
+        unlink(tmpPath);
+        fd = (linkError == EEXIST) ? open(path, O_RDWR) : -1;
+    }
+
+    if (fd < 0)
+    {
+        printf("공유 좌석 파일 %s을 열 수 없습니다.\n", path);
+        return 0;
+    }
+
+    // 기존 공유 좌석 파일 전체를 대응한다.
+    if (fstat(fd, &fileStat) != 0 || fileStat.st_size < (off_t)sizeof(SeatsHeader)
+        || (block = mmap(NULL, (size_t)fileStat.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0)) == MAP_FAILED)
+    {
+        printf("공유 좌석 파일 %s을 열 수 없습니다.\n", path);
+        close(fd);
+        return 0;
+    }
+    close(fd);
+
+    // 파일 종류, 저장 형식 번호와 크기를 확인한다. 다른 형식으로 만든 파일은 열의 위치가 다르므로 이용하지 않는다.
+    header = (SeatsHeader*)block;
+    if (memcmp(header->magic, SHARED_MAGIC, sizeof(header->magic)) || header->version != SHARED_VERSION
+        || header->seatCount <= 0 || header->seatCount > MAX_SEATS || header->roomCount <= 0 || header->roomCount > MAX_ROOMS
+        || header->rooms[header->roomCount - 1].firstSeat + header->rooms[header->roomCount - 1].seatCount != header->seatCount
+        || header->blockSize != (unsigned long long int)fileStat.st_size
+        || header->reserveSlots < 0 || header->reserveSlots > MAX_RESERVATIONS || header->quotaUsers < 0 || header->quotaUsers > MAX_QUOTA_USERS
+        || layoutSeats(libSeats, header->seatCount, header->reserveSlots, header->quotaUsers, NULL) != header->blockSize)
+    {
+        printf("공유 좌석 파일 %s의 형식이 다릅니다.\n", path);
+        munmap(block, (size_t)fileStat.st_size);
+        return 0;
+    }
+
+    // 좌석 수와 열람실 구성, 운영정보, 좌석당 예약 수, 이용 한도 표의 이용자 수는 파일에 저장된 값을 이용한다.
+    if (header->seatCount != seatCount)
+    {
+        printf("공유 좌석 파일의 좌석 수(%d)를 이용합니다.\n", header->seatCount);
+    }
+    if (header->roomCount != roomCount)
+    {
+        printf("공유 좌석 파일의 열람실 구성(%d개)을 이용합니다.\n", header->roomCount);
+    }
+    if (header->reserveSlots != reserveSlots)
+    {
+        printf("공유 좌석 파일의 좌석당 예약 수(%d)를 이용합니다.\n", header->reserveSlots);
+    }
+    if (header->quotaUsers != quotaUsers)
+    {
+        printf("공유 좌석 파일의 이용 한도 표 크기(%d명)를 이용합니다.\n", header->quotaUsers);
+    }
+    layoutSeats(libSeats, header->seatCount, header->reserveSlots, header->quotaUsers, block);
+    libSeats->isShared = 1;
+
+    return 1;
+}
+
+
+/*
+* destroySeats 함수
+* 기능 : 좌석 저장소의 메모리를 해제한다. 공유 좌석 파일을 이용하는 경우 대응만 해제하며, 파일의 좌석 정보는 그대로 남는다.
+* 입력값 : 좌석 정보 구조체 포인터 *libSeats
+* 반환값 없음
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+void destroySeats(SeatsData* libSeats)
+{
+    if (libSeats->isShared)
+    {
+        munmap(libSeats->block, (size_t)libSeats->header->blockSize);
+    }else{
+        free(libSeats->block);
+    }
+    libSeats->block = NULL;
+    libSeats->header = NULL;
+    libSeats->seatCount = 0;
+
+    return;
+}
+
+
+/*
+* spinLock 함수
+* 기능 : 주어진 잠금을 얻는다. 잠금이 풀릴 때까지 기다린다. 잠금은 공유 좌석 파일 안에 있어도 되며, 다른 프로세스와 함께 이용할 수 있다.
+* 입력값 : *lock(잠금)
+* 반환값 없음
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+void spinLock(unsigned char* lock)
+{
+    int spin = 0;
+
+    // 잠금을 얻을 때까지 반복한다. 잠긴 동안에는 읽기만 하여, 캐시 라인을 서로 빼앗지 않게 한다.
+    while (__atomic_test_and_set(lock, __ATOMIC_ACQUIRE))
+    {
+        while (__atomic_load_n(lock, __ATOMIC_RELAXED))
+        {
+            // 잠금을 가진 쪽이 오래 걸리는 경우, CPU를 양보한다.
+            if (++spin >= SPIN_LIMIT)
+            {
+                sched_yield();
+                spin = 0;
+            }
+        }
+    }
+
+    return;
+}
+
+
+/*
+* spinUnlock 함수
+* 기능 : 주어진 잠금을 푼다.
+* 입력값 : *lock(잠금)
+* 반환값 없음
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+void spinUnlock(unsigned char* lock)
+{
+    __atomic_clear(lock, __ATOMIC_RELEASE);
+
+    return;
+}
+
+
+/*
+* printRenewTime 함수
+* 기능 : 주어진 좌석번호의 연장가능시각을 출력함.
+* 입력값 : location(0번부터 시작하는 좌석번호), 좌석 정보 구조체 포인터 *libSeats, 시설 정보 구조체 포인터 *libData, 현재 시각 정보 구조체 포인터 *clock
+* 반환값 없음
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+void printRenewTime(int location, SeatsData* libSeats, LibraryData *libData, ClockContext* clock)
+{
+    // 빈자리의 경우 함수를 종료함.
+    if (libSeats->seatState[location] != SEAT_USED)
+    {
+        return;
+    }
+
+    // 종료시각이 현재 운영일의 폐장시각 이후인 경우, 연장 불가능하다는 내용을 출력한 후, 함수를 종료함.
+    // 24시간제의 경우, 폐장시각으로 인해 연장 불가능한 경우가 없음.
+    if (!clock->isAllDay && unpackEndTime(libSeats->endTime[location]) >= clock->closeTime)
+    {
+        printf("연장 불가\n");
+        return;
+    }
+
+    // 연장 횟수나 이용 한도를 모두 쓴 경우, 연장 불가능하다는 내용을 출력한 후, 함수를 종료함.
+    if (!quotaRenewable(location, clock, libSeats))
+    {
+        printf("연장 불가 (이용 한도)\n");
+        return;
+    }
+
+    // 오늘 0시 기준 연장가능시각(초) 계산
+    // 종료시각에서부터 현재시각의 차이가 연장가능시간보다 작을 때 연장이 가능하므로, 종료시각에서 연장가능시간을 뺀다.
+    long long int renewSecond = unpackEndTime(libSeats->endTime[location]) - libData->MAX_RENEWABLE_TIME * 60 - clock->midnight;
+
+    // 연장가능시각 문자를 출력한다.
+    printf("연장 가능 시각 : ");
+
+    // 연장가능시각이 24시 이후인 경우, 익일임을 출력한다.
+    if (renewSecond >= 24 * 60 * 60)
+    {
+        renewSecond %= 24 * 60 * 60;
+        printf("익일 ");
+
+    }else if (renewSecond < 0){ // 연장가능시각이 0시 이전인 경우, 전날의 시각으로 조절한다.
+        renewSecond += 24 * 60 * 60;
+    }
+
+    // 남은 연장가능시각의 정보를 출력한다.
+    printf("%d시 %d분 %d초\n", (int)(renewSecond / 3600), (int)((renewSecond % 3600) / 60), (int)(renewSecond % 60));
+
+    return;
+}
+
+
+/*
+* packEndTime 함수
+* 기능 : Unix 시간(초)을 이용종료시각 열에 저장하는 32비트 값(END_TIME_EPOCH부터의 초)으로 변환한다.
+*        0은 이용중이 아닌 좌석을 나타내므로, 기준 시각 이전의 시각은 1로 바꾼다.
+* 입력값 : time(Unix 시간)
+* 반환값 : 이용종료시각 열의 값
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+unsigned int packEndTime(long long int time)
+{
+    if (time <= END_TIME_EPOCH) { return 1; }
+    if (time - END_TIME_EPOCH > 0xFFFFFFFFLL) { return 0xFFFFFFFFu; }
+
+    return (unsigned int)(time - END_TIME_EPOCH);
+}
+
+
+/*
+* unpackEndTime 함수
+* 기능 : 이용종료시각 열의 값을 Unix 시간(초)으로 변환한다.
+* 입력값 : packed(이용종료시각 열의 값)
+* 반환값 : Unix 시간, 이용중이 아닌 좌석(0)인 경우 0
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+long long int unpackEndTime(unsigned int packed)
+{
+    return packed ? END_TIME_EPOCH + packed : 0;
+}
+
+
+/*
+* expirySiftUp 함수
+* 기능 : 열람실 힙의 주어진 위치에 있는 좌석을, 부모보다 이용종료시각이 늦어질 때까지 위로 이동시킨다.
+* 입력값 : pos(힙 안에서의 위치), 열람실 구조체 포인터 *room, 좌석 정보 구조체 포인터 *libSeats
+* 반환값 없음
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+void expirySiftUp(int pos, RoomData* room, SeatsData* libSeats)
+{
+    int* heap = libSeats->expiryHeap + room->firstSeat;
+    int location = heap[pos];
+    unsigned int key = libSeats->endTime[location];
+    int parent = 0;
+
+    // 부모의 이용종료시각이 더 늦은 동안, 부모를 아래로 내린다.
+    while (pos > 0)
+    {
+        parent = (pos - 1) / 2;
+        if (libSeats->endTime[heap[parent]] <= key) { break; }
+
+        heap[pos] = heap[parent];
+        libSeats->heapPos[heap[pos]] = pos;
+        pos = parent;
+    }
+
+    heap[pos] = location;
+    libSeats->heapPos[location] = pos;
+
+    return;
+}
+
+
+/*
+* expirySiftDown 함수
+* 기능 : 열람실 힙의 주어진 위치에 있는 좌석을, 자식보다 이용종료시각이 빨라질 때까지 아래로 이동시킨다.
+* 입력값 : pos(힙 안에서의 위치), 열람실 구조체 포인터 *room, 좌석 정보 구조체 포인터 *libSeats
+* 반환값 없음
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+void expirySiftDown(int pos, RoomData* room, SeatsData* libSeats)
+{
+    int* heap = libSeats->expiryHeap + room->firstSeat;
+    int location = heap[pos];
+    unsigned int key = libSeats->endTime[location];
+    int child = 0;
+
+    // 자식 중 이용종료시각이 더 빠른 쪽이 자신보다 빠른 동안, 그 자식을 위로 올린다.
+    while ((child = pos * 2 + 1) < room->heapSize)
+    {
+        if (child + 1 < room->heapSize && libSeats->endTime[heap[child + 1]] < libSeats->endTime[heap[child]])
+        {
+            child++;
+        }
+        if (key <= libSeats->endTime[heap[child]]) { break; }
+
+        heap[pos] = heap[child];
+        libSeats->heapPos[heap[pos]] = pos;
+        pos = child;
+    }
+
+    heap[pos] = location;
+    libSeats->heapPos[location] = pos;
+
+    return;
+}
+
+
+/*
+* expiryInsert 함수
+* 기능 : 이용종료시각이 정해진 좌석을 열람실의 이용종료시각 힙에 추가한다. 열람실의 힙 잠금을 얻은 후 호출해야 한다. (다른 힙 함수도 마찬가지이다.)
+* 입력값 : location(0번부터 시작하는 좌석번호), 열람실 구조체 포인터 *room(좌석이 속한 열람실), 좌석 정보 구조체 포인터 *libSeats
+* 반환값 없음
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+void expiryInsert(int location, RoomData* room, SeatsData* libSeats)
+{
+    // 힙의 마지막에 추가한 후 위로 이동시킨다.
+    libSeats->expiryHeap[room->firstSeat + room->heapSize] = location;
+    libSeats->heapPos[location] = room->heapSize;
+    room->heapSize++;
+    expirySiftUp(libSeats->heapPos[location], room, libSeats);
+
+    return;
+}
+
+
+/*
+* expiryUpdate 함수
+* 기능 : 이용종료시각이 바뀐 좌석의 힙 안에서의 위치를 조정한다.
+* 입력값 : location(0번부터 시작하는 좌석번호), 열람실 구조체 포인터 *room(좌석이 속한 열람실), 좌석 정보 구조체 포인터 *libSeats
+* 반환값 없음
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+void expiryUpdate(int location, RoomData* room, SeatsData* libSeats)
+{
+    // 힙에 없는 좌석인 경우 함수 종료
+    if (libSeats->heapPos[location] < 0) { return; }
+
+    // 이용종료시각이 앞당겨진 경우 위로, 늦춰진 경우 아래로 이동한다. 둘 중 하나만 실제로 이동한다.
+    expirySiftUp(libSeats->heapPos[location], room, libSeats);
+    expirySiftDown(libSeats->heapPos[location], room, libSeats);
+
+    return;
+}
+
+
+/*
+* expiryRemove 함수
+* 기능 : 좌석을 열람실의 이용종료시각 힙에서 삭제한다.
+* 입력값 : location(0번부터 시작하는 좌석번호), 열람실 구조체 포인터 *room(좌석이 속한 열람실), 좌석 정보 구조체 포인터 *libSeats
+* 반환값 없음
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+void expiryRemove(int location, RoomData* room, SeatsData* libSeats)
+{
+    int* heap = libSeats->expiryHeap + room->firstSeat;
+    int pos = libSeats->heapPos[location];
+    int last = 0;
+
+    // 힙에 없는 좌석인 경우 함수 종료
+    if (pos < 0) { return; }
+
+    // 힙의 마지막 항목을 삭제할 위치로 옮긴 후, 위치를 조정한다.
+    room->heapSize--;
+    libSeats->heapPos[location] = -1;
+    if (pos == room->heapSize) { return; }
+
+    last = heap[room->heapSize];
+    heap[pos] = last;
+    libSeats->heapPos[last] = pos;
+    expiryUpdate(last, room, libSeats);
+
+    return;
+}
+
+
+/*
+* setSeatState 함수
+* 기능 : 좌석의 상태를 바꾸고, 빈 좌석 비트맵, 이용불가 좌석 비트맵과 빈 좌석 수를 함께 갱신한다. 좌석 잠금을 얻은 후 호출해야 한다.
+*        비트맵의 한 워드는 여러 좌석이 함께 이용하므로, 비트맵과 빈 좌석 수는 원자적 연산으로 갱신한다.
+* 입력값 : location(0번부터 시작하는 좌석번호), state(새 좌석 상태), 좌석 정보 구조체 포인터 *libSeats
+* 반환값 없음
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+void setSeatState(int location, unsigned char state, SeatsData* libSeats)
+{
+    // 좌석이 속한 워드와, 워드 안에서 좌석에 해당하는 비트
+    int word = location / BITMAP_WORD_BITS;
+    unsigned long long int bit = 1ULL << (location % BITMAP_WORD_BITS);
+
+    // 기존에 빈 좌석이었던 경우 빈 좌석 수를 줄이고, 새로 빈 좌석이 되는 경우 빈 좌석 수를 늘린다.
+    int delta = (state == SEAT_EMPTY) - (libSeats->seatState[location] == SEAT_EMPTY);
+    if (delta)
+    {
+        __atomic_add_fetch(&libSeats->header->freeCount, delta, __ATOMIC_RELAXED);
+    }
+
+    // 좌석 상태 열과 비트맵 갱신
+    libSeats->seatState[location] = state;
+    if (state == SEAT_EMPTY)
+    {
+        __atomic_fetch_or(&libSeats->freeMap[word], bit, __ATOMIC_RELEASE);
+    }else{
+        __atomic_fetch_and(&libSeats->freeMap[word], ~bit, __ATOMIC_RELEASE);
+    }
+    if (state == SEAT_UNAVAILABLE)
+    {
+        __atomic_fetch_or(&libSeats->unavailableMap[word], bit, __ATOMIC_RELAXED);
+    }else{
+        __atomic_fetch_and(&libSeats->unavailableMap[word], ~bit, __ATOMIC_RELAXED);
+    }
+
+    // 좌석 배치도가 이 좌석을 다시 그리도록 변경 번호를 올린다. 상태와 이용자 번호를 모두 바꾼 후에 올려야 한다.
+    __atomic_add_fetch(&libSeats->seatVersion[location], 1, __ATOMIC_RELEASE);
+
+    return;
+}
+
+
+/*
+* findFreeSeat 함수
+* 기능 : 빈 좌석 비트맵에서 열람실의 좌석 중 번호가 가장 작은 빈 좌석을 찾는다. 한 번에 64개의 좌석을 확인한다.
+*        잠금 없이 확인하므로, 찾은 좌석은 배정할 때 좌석 잠금을 얻은 후 다시 확인한다.
+* 입력값 : 좌석 정보 구조체 포인터 *libSeats, 열람실 구조체 포인터 *room
+* 반환값 : 빈 좌석의 좌석번호(0부터 시작). 빈 좌석이 없는 경우 -1을 반환함.
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+int findFreeSeat(SeatsData* libSeats, RoomData* room)
+{
+    int first = room->firstSeat, last = room->firstSeat + room->seatCount;
+    unsigned long long int word = 0;
+
+    // 빈 좌석이 없는 경우 비트맵을 확인하지 않는다.
+    if (__atomic_load_n(&libSeats->header->freeCount, __ATOMIC_RELAXED) == 0) { return -1; }
+
+    // 열람실 범위에서 0이 아닌 첫 워드를 찾은 후, 워드 안에서 가장 낮은 1 비트의 위치를 구한다.
+    // 다른 단말기가 워드를 바꿀 수 있으므로, 워드는 한 번만 읽는다.
+    for (int i = first / BITMAP_WORD_BITS; i <= (last - 1) / BITMAP_WORD_BITS; i++)
+    {
+        word = __atomic_load_n(&libSeats->freeMap[i], __ATOMIC_ACQUIRE) & rangeMask(i, first, last);
+        if (word)
+        {
+            return i * BITMAP_WORD_BITS + __builtin_ctzll(word);
+        }
+    }
+
+    return -1;
+}
+
+
+/*
+* rangeMask 함수
+* 기능 : 비트맵의 주어진 워드에서, 좌석 범위(first번부터 last - 1번까지)에 해당하는 비트를 구한다.
+* 입력값 : word(워드 번호), first(범위의 첫 좌석번호), last(범위의 마지막 좌석번호 + 1)
+* 반환값 : 범위에 해당하는 비트가 1인 마스크
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+unsigned long long int rangeMask(int word, int first, int last)
+{
+    int low = first - word * BITMAP_WORD_BITS, high = last - word * BITMAP_WORD_BITS;
+
+    // 워드 밖으로 벗어난 범위를 워드 안으로 줄인다.
+    if (low < 0) { low = 0; }
+    if (high > BITMAP_WORD_BITS) { high = BITMAP_WORD_BITS; }
+    if (low >= high) { return 0; }
+
+    return (high - low == BITMAP_WORD_BITS) ? ~0ULL : ((1ULL << (high - low)) - 1) << low;
+}
+
+
+/*
+* parseSeatSelection 함수
+* 기능 : 좌석 선택 문자열을 읽어, 선택한 좌석의 비트를 켠 비트맵을 만든다. 낱말은 공백으로, 좌석번호와 구간은 공백이나 ','로 구분한다.
+*        좌석번호와 구간은 합치고, ROOM과 좌석 특징은 걸러낸다. 좌석번호와 구간이 없으면 모든 좌석에서, ROOM이 없으면 모든 열람실에서 고른다.
+* 입력값 : 문자열 시작 cursor, 문자열 끝 end, *mask(좌석 수만큼의 비트맵, libSeats->wordCount개의 워드), 좌석 정보 구조체 포인터 *libSeats
+* 반환값 : 선택한 좌석 수. 잘못된 낱말이 있거나, 좌석 배치 파일 없이 좌석 특징을 적은 경우 -1을 반환함.
+* 설명 최종 수정 일자 : 2026/10/17
+*
+* 좌석 선택 문자열 형식 (좌석번호는 1번부터)
+* 101-400,450 : 101번부터 400번까지와 450번 좌석
+* ROOM 2      : 2번 열람실의 좌석 (여러 번 적으면 적은 열람실을 모두 포함)
+* POWER, WINDOW, QUIET : 해당 특징을 모두 가진 좌석 (좌석 배치 파일이 있는 경우)
+* 예) 1-200 ROOM 1 WINDOW : 1번 열람실의 1~200번 좌석 중 창가 좌석
+*/
+int parseSeatSelection(const char* cursor, const char* end, unsigned long long int* mask, SeatsData* libSeats)
+{
+    const char* token = NULL;
+    int length = 0, itemStart = 0, dash = 0, first = 0, last = 0, count = 0, isRanged = 0, attributes = 0;
+    unsigned int roomBits = 0;
+    RoomData* room = NULL;
+
+    memset(mask, 0, sizeof(unsigned long long int) * libSeats->wordCount);
+
+    while ((length = nextToken(&cursor, end, &token)) > 0)
+    {
+        if (isToken(token, length, "ROOM")) // 열람실
+        {
+            length = nextToken(&cursor, end, &token);
+            if (!parseNumber(token, length, &first) || first < 1 || first > libSeats->header->roomCount)
+            {
+                return -1;
+            }
+            roomBits |= 1U << (first - 1);
+            continue;
+        }else if (isToken(token, length, "POWER")){ // 좌석 특징
+            attributes |= SEAT_POWER;
+            continue;
+        }else if (isToken(token, length, "WINDOW")){
+            attributes |= SEAT_WINDOW;
+            continue;
+        }else if (isToken(token, length, "QUIET")){
+            attributes |= SEAT_QUIET;
+            continue;
+        }
+
+        // 좌석번호 목록 : ','로 나눈 항목마다 좌석번호 하나(N) 또는 구간(N-M)이다.
+        for (itemStart = 0; itemStart < length; itemStart = dash + 1)
+        {
+            for (dash = itemStart; dash < length && token[dash] != ','; dash++) { }
+            last = dash;
+            for (int i = itemStart + 1; i < last; i++)
+            {
+                if (token[i] == '-')
+                {
+                    if (!parseNumber(token + itemStart, i - itemStart, &first) || !parseNumber(token + i + 1, last - i - 1, &last))
+                    {
+                        return -1;
+                    }
+                    itemStart = -1;
+                    break;
+                }
+            }
+            if (itemStart >= 0) // 구간이 아닌 좌석번호 하나
+            {
+                if (!parseNumber(token + itemStart, last - itemStart, &first))
+                {
+                    return -1;
+                }
+                last = first;
+            }
+            if (first < 1 || last < first || last > libSeats->seatCount)
+            {
+                return -1;
+            }
+
+            // 구간의 비트를 워드 단위로 켠다.
+            for (int w = (first - 1) / BITMAP_WORD_BITS; w <= (last - 1) / BITMAP_WORD_BITS; w++)
+            {
+                mask[w] |= rangeMask(w, first - 1, last);
+            }
+            isRanged = 1;
+        }
+    }
+
+    // 좌석번호를 적지 않은 경우 모든 좌석에서 고른다.
+    if (!isRanged)
+    {
+        for (int w = 0; w < libSeats->wordCount; w++)
+        {
+            mask[w] = rangeMask(w, 0, libSeats->seatCount);
+        }
+    }
+
+    // 고르지 않은 열람실의 좌석을 뺀다.
+    for (int r = 0; roomBits != 0 && r < libSeats->header->roomCount; r++)
+    {
+        room = &libSeats->header->rooms[r];
+        for (int w = room->firstSeat / BITMAP_WORD_BITS; !(roomBits & (1U << r)) && room->seatCount > 0 && w <= (room->firstSeat + room->seatCount - 1) / BITMAP_WORD_BITS; w++)
+        {
+            mask[w] &= ~rangeMask(w, room->firstSeat, room->firstSeat + room->seatCount);
+        }
+    }
+
+    // 좌석 특징을 모두 가지지 않은 좌석을 빼고, 선택한 좌석 수를 센다.
+    if (attributes != 0 && libSeats->layout == NULL)
+    {
+        return -1;
+    }
+    for (int w = 0; w < libSeats->wordCount; w++)
+    {
+        for (unsigned long long int bits = attributes != 0 ? mask[w] : 0; bits != 0; bits &= bits - 1)
+        {
+            int location = w * BITMAP_WORD_BITS + __builtin_ctzll(bits);
+            if ((libSeats->layout->attributes[location] & attributes) != attributes)
+            {
+                mask[w] &= ~(1ULL << (location % BITMAP_WORD_BITS));
+            }
+        }
+        count += __builtin_popcountll(mask[w]);
+    }
+
+    return count;
+}
+
+
+/*
+* setSeatsState 함수
+* 기능 : 선택한 좌석을 한 번에 이용불가로 바꾸거나(SEAT_UNAVAILABLE) 이용불가를 해제한다(SEAT_EMPTY). 이용중인 좌석은 먼저 퇴실 처리한다.
+*        좌석 상태 비트맵을 워드 단위로 바꾸고 빈 좌석 수는 마지막에 한 번만 더하므로, 좌석을 하나씩 바꾸는 toggleSeatState를 반복하는 것보다 빠르다.
+*        바뀐 좌석은 좌석마다 이용불가 설정 변경(WAL_SEAT_STATE)으로 기록하고 변경 번호를 올리므로, 좌석 배치도는 바뀐 좌석만 다시 그린다.
+*        이용불가 시간대가 바꾸는 경우, 이용불가로 바꾼 좌석만 시간대 비트맵에 표시하고, 되돌릴 때는 표시된 좌석만 되돌린다.
+*        관리자가 바꾸는 경우에는 선택한 좌석의 표시를 지우므로, 관리자가 이용불가로 설정한 좌석은 시간대가 끝나도 되돌리지 않는다.
+* 입력값 : *mask(선택한 좌석의 비트맵, NULL이면 범위 안의 모든 좌석), first(범위의 첫 좌석번호), last(범위의 마지막 좌석번호 + 1), state(바꿀 상태),
+*          isBlackout(이용불가 시간대가 바꾸는 경우 1, 관리자가 바꾸는 경우 0), 좌석 정보 구조체 포인터 *libSeats
+* 반환값 : 상태가 바뀐 좌석 수
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+int setSeatsState(const unsigned long long int* mask, int first, int last, unsigned char state, int isBlackout, SeatsData* libSeats)
+{
+    int firstWord = first / BITMAP_WORD_BITS, lastWord = (last - 1) / BITMAP_WORD_BITS;
+    int changed = 0, freeDelta = 0, location = 0;
+    unsigned long long int selected = 0, bits = 0, taken = 0;
+
+    if (first >= last)
+    {
+        return 0;
+    }
+
+    // 선택한 좌석의 잠금을 좌석 번호 순으로 얻는다. (resetSeats와 같은 순서)
+    for (int w = firstWord; w <= lastWord; w++)
+    {
+        for (bits = rangeMask(w, first, last) & (mask != NULL ? mask[w] : ~0ULL); bits != 0; bits &= bits - 1)
+        {
+            spinLock(&libSeats->seatLock[w * BITMAP_WORD_BITS + __builtin_ctzll(bits)]);
+        }
+    }
+
+    for (int w = firstWord; w <= lastWord; w++)
+    {
+        selected = rangeMask(w, first, last) & (mask != NULL ? mask[w] : ~0ULL);
+        if (selected == 0)
+        {
+            continue;
+        }
+
+        if (state == SEAT_UNAVAILABLE)
+        {
+            // 빈 좌석도 이용불가도 아닌 좌석은 이용중이므로, 먼저 퇴실 처리하여 빈 좌석으로 만든다.
+            for (bits = selected & ~(__atomic_load_n(&libSeats->freeMap[w], __ATOMIC_ACQUIRE) | __atomic_load_n(&libSeats->unavailableMap[w], __ATOMIC_RELAXED)); bits != 0; bits &= bits - 1)
+            {
+                checkOut(w * BITMAP_WORD_BITS + __builtin_ctzll(bits), HISTORY_UNAVAILABLE, libSeats);
+            }
+
+            // 이제 이용불가가 아닌 선택한 좌석은 모두 빈 좌석이므로, 워드 단위로 빈 좌석에서 빼고 이용불가로 표시한다.
+            bits = selected & ~__atomic_load_n(&libSeats->unavailableMap[w], __ATOMIC_RELAXED);
+            freeDelta -= __builtin_popcountll(__atomic_fetch_and(&libSeats->freeMap[w], ~bits, __ATOMIC_RELEASE) & bits);
+            __atomic_fetch_or(&libSeats->unavailableMap[w], bits, __ATOMIC_RELAXED);
+
+            // 시간대는 자신이 바꾼 좌석만 표시한다. 관리자는 시간대가 바꾼 좌석도 넘겨받으므로 표시를 지우고, 상태는 그대로이지만 기록은 남긴다.
+            if (isBlackout)
+            {
+                __atomic_fetch_or(&libSeats->blackoutMap[w], bits, __ATOMIC_RELAXED);
+            }else{
+                taken = __atomic_fetch_and(&libSeats->blackoutMap[w], ~selected, __ATOMIC_RELAXED) & selected & ~bits;
+                for (; taken != 0; taken &= taken - 1)
+                {
+                    walLog(libSeats, WAL_SEAT_STATE, SEAT_UNAVAILABLE, w * BITMAP_WORD_BITS + __builtin_ctzll(taken), 0, NULL);
+                }
+            }
+        }else{
+            // 이용불가 좌석만 빈 좌석으로 되돌린다. 시간대는 자신이 표시한 좌석만 되돌린다. 좌석 상태를 먼저 바꾼 후 빈 좌석 비트맵에 올린다.
+            bits = selected & __atomic_load_n(&libSeats->unavailableMap[w], __ATOMIC_RELAXED);
+            if (isBlackout)
+            {
+                bits &= __atomic_load_n(&libSeats->blackoutMap[w], __ATOMIC_RELAXED);
+            }
+            __atomic_fetch_and(&libSeats->unavailableMap[w], ~bits, __ATOMIC_RELAXED);
+            __atomic_fetch_and(&libSeats->blackoutMap[w], ~bits, __ATOMIC_RELAXED);
+        }
+
+        // 바뀐 좌석의 상태 열과 변경 번호를 바꾸고 기록한다. 시간대가 이용불가로 바꾼 좌석은 기록에도 표시한다.
+        changed += __builtin_popcountll(bits);
+        for (unsigned long long int rest = bits; rest != 0; rest &= rest - 1)
+        {
+            location = w * BITMAP_WORD_BITS + __builtin_ctzll(rest);
+            libSeats->seatState[location] = state;
+            __atomic_add_fetch(&libSeats->seatVersion[location], 1, __ATOMIC_RELEASE);
+            walAppend(libSeats, WAL_SEAT_STATE, state, (unsigned short)(isBlackout && state == SEAT_UNAVAILABLE), location, 0, NULL);
+        }
+        if (state == SEAT_EMPTY)
+        {
+            __atomic_fetch_or(&libSeats->freeMap[w], bits, __ATOMIC_RELEASE);
+            freeDelta += __builtin_popcountll(bits);
+        }
+    }
+    __atomic_add_fetch(&libSeats->header->freeCount, freeDelta, __ATOMIC_RELAXED);
+
+    // 이용불가를 해제한 좌석은 대기열의 차례인 이용자에게 맡긴다. 기다리는 이용자가 없으면 handOffSeat가 바로 끝난다.
+    // 얻은 순서의 반대로 잠금을 푼다.
+    for (int w = lastWord; w >= firstWord; w--)
+    {
+        selected = rangeMask(w, first, last) & (mask != NULL ? mask[w] : ~0ULL);
+        for (int bit = BITMAP_WORD_BITS - 1; bit >= 0; bit--)
+        {
+            if (selected & (1ULL << bit))
+            {
+                location = w * BITMAP_WORD_BITS + bit;
+                if (state == SEAT_EMPTY)
+                {
+                    handOffSeat(location, libSeats);
+                }
+                spinUnlock(&libSeats->seatLock[location]);
+            }
+        }
+    }
+
+    return changed;
+}
+
+
+/*
+* scheduleBlackout 함수
+* 기능 : 선택한 좌석을 주어진 시간대에 이용불가로 바꾸도록 예약한다. 선택한 좌석은 이어진 구간으로 나누어 구간마다 하나의 이용불가 시간대로 저장한다.
+*        시작시각이 되면 runBlackouts가 구간의 좌석을 이용불가로 바꾸고(이용중인 좌석은 퇴실 처리), 종료시각이 되면 시간대가 바꾼 좌석 중 진행중인 다른 시간대에 없는 좌석을 되돌린다.
+* 입력값 : *mask(선택한 좌석의 비트맵), start(시작시각, Unix 초), end(종료시각, Unix 초), 좌석 정보 구조체 포인터 *libSeats
+* 반환값 : 저장한 이용불가 시간대 수. 선택한 좌석이 없거나 빈 칸이 모자란 경우 0을 반환하며, 이때는 하나도 저장하지 않는다.
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+int scheduleBlackout(const unsigned long long int* mask, long long int start, long long int end, SeatsData* libSeats)
+{
+    SeatsHeader* header = libSeats->header;
+    Blackout added[MAX_BLACKOUTS];
+    int count = 0, location = 0, runEnd = 0;
+
+    // 비트맵에서 이어진 좌석 구간을 찾는다. 구간의 끝은 켜진 비트 다음의 첫 꺼진 비트이다.
+    while (location < libSeats->seatCount && count <= MAX_BLACKOUTS)
+    {
+        int w = location / BITMAP_WORD_BITS;
+        unsigned long long int bits = mask[w] & (~0ULL << (location % BITMAP_WORD_BITS));
+        if (bits == 0)
+        {
+            location = (w + 1) * BITMAP_WORD_BITS;
+            continue;
+        }
+        location = w * BITMAP_WORD_BITS + __builtin_ctzll(bits);
+
+        for (runEnd = location + 1; runEnd < libSeats->seatCount && (mask[runEnd / BITMAP_WORD_BITS] >> (runEnd % BITMAP_WORD_BITS) & 1); runEnd++) { }
+        if (count < MAX_BLACKOUTS)
+        {
+            added[count].firstSeat = location;
+            added[count].lastSeat = runEnd - 1;
+            added[count].start = start;
+            added[count].end = end;
+            added[count].isActive = 0;
+        }
+        count++;
+        location = runEnd;
+    }
+
+    // 빈 칸이 모자란 경우 하나도 저장하지 않는다.
+    spinLock(&header->blackoutLock);
+    if (count == 0 || header->blackoutCount + count > MAX_BLACKOUTS)
+    {
+        spinUnlock(&header->blackoutLock);
+        return 0;
+    }
+    memcpy(&header->blackouts[header->blackoutCount], added, sizeof(Blackout) * count);
+    header->blackoutCount += count;
+    spinUnlock(&header->blackoutLock);
+
+    // 이용불가 시간대 잠금을 푼 후 기록한다. (기록 잠금을 가진 스냅샷 작성이 이용불가 시간대 잠금을 얻기 때문)
+    for (int i = 0; i < count; i++)
+    {
+        logBlackout(libSeats, &added[i], BLACKOUT_ADDED);
+    }
+
+    return count;
+}
+
+
+/*
+* runBlackouts 함수
+* 기능 : 시작시각이 된 이용불가 시간대의 좌석을 이용불가로 바꾸고, 종료시각이 된 시간대를 삭제한 후 좌석을 되돌린다.
+*        끝난 시간대는 진행중인 다른 시간대와 겹칠 수 있으므로, 삭제한 후 남은 진행중인 시간대를 함께 복사해 두고 그 좌석은 되돌리지 않는다.
+*        만료된 좌석을 처리할 때(expireSeats) 함께 호출되며, 예약된 시간대가 없으면 바로 끝난다.
+*        처리할 시간대는 잠금 안에서 표시만 하고, 좌석은 잠금을 푼 후 바꾸므로, 여러 단말기가 동시에 호출해도 한 단말기만 처리한다.
+* 입력값 : 좌석 정보 구조체 포인터 *libSeats, now(현재 시각, Unix 초)
+* 반환값 : 상태가 바뀐 좌석 수
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+int runBlackouts(SeatsData* libSeats, long long int now)
+{
+    SeatsHeader* header = libSeats->header;
+    Blackout due[MAX_BLACKOUTS], active[MAX_BLACKOUTS];
+    unsigned char change[MAX_BLACKOUTS];
+    int count = 0, activeCount = 0, changed = 0;
+
+    if (__atomic_load_n(&header->blackoutCount, __ATOMIC_RELAXED) == 0)
+    {
+        return 0;
+    }
+
+    spinLock(&header->blackoutLock);
+    for (int i = 0; i < header->blackoutCount; i++)
+    {
+        Blackout* blackout = &header->blackouts[i];
+        if (now >= blackout->end) // 끝난 시간대는 삭제한다. 시작하지 못한 채 끝난 시간대(프로그램이 꺼져 있던 경우)는 좌석을 되돌리지 않는다.
+        {
+            due[count] = *blackout;
+            change[count++] = BLACKOUT_ENDED;
+            header->blackouts[i--] = header->blackouts[--header->blackoutCount];
+        }else if (!blackout->isActive && now >= blackout->start){ // 시작시각이 된 시간대
+            blackout->isActive = 1;
+            due[count] = *blackout;
+            change[count++] = BLACKOUT_STARTED;
+        }
+    }
+    for (int i = 0; i < header->blackoutCount; i++)
+    {
+        if (header->blackouts[i].isActive)
+        {
+            active[activeCount++] = header->blackouts[i];
+        }
+    }
+    spinUnlock(&header->blackoutLock);
+
+    for (int i = 0; i < count; i++)
+    {
+        logBlackout(libSeats, &due[i], change[i]);
+        if (change[i] == BLACKOUT_STARTED)
+        {
+            changed += setSeatsState(NULL, due[i].firstSeat, due[i].lastSeat + 1, SEAT_UNAVAILABLE, 1, libSeats);
+        }else if (due[i].isActive){
+            changed += releaseBlackout(&due[i], active, activeCount, libSeats);
+        }
+    }
+
+    return changed;
+}
+
+
+/*
+* releaseBlackout 함수
+* 기능 : 끝난 이용불가 시간대의 구간에서 진행중인 다른 시간대가 덮지 않은 좌석 구간을 찾아, 시간대가 이용불가로 바꾼 좌석만 되돌린다.
+*        시작 전부터 이용불가였던 좌석과 시간대 도중 관리자가 바꾼 좌석은 시간대 비트맵에 표시가 없으므로 그대로 둔다.
+* 입력값 : 끝난 시간대 구조체 포인터 *ended, 진행중인 시간대 배열 active, activeCount(진행중인 시간대 수), 좌석 정보 구조체 포인터 *libSeats
+* 반환값 : 상태가 바뀐 좌석 수
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+int releaseBlackout(const Blackout* ended, const Blackout* active, int activeCount, SeatsData* libSeats)
+{
+    int location = ended->firstSeat, runEnd = 0, changed = 0, isCovered = 0;
+
+    // 구간의 앞에서부터, 진행중인 시간대가 덮은 좌석은 건너뛰고 덮지 않은 좌석 구간을 되돌린다.
+    while (location <= ended->lastSeat)
+    {
+        runEnd = ended->lastSeat + 1;
+        isCovered = 0;
+        for (int i = 0; i < activeCount; i++)
+        {
+            if (active[i].firstSeat <= location && location <= active[i].lastSeat)
+            {
+                isCovered = 1;
+                location = active[i].lastSeat + 1;
+                break;
+            }
+            if (active[i].firstSeat > location && active[i].firstSeat < runEnd)
+            {
+                runEnd = active[i].firstSeat;
+            }
+        }
+
+        if (!isCovered)
+        {
+            changed += setSeatsState(NULL, location, runEnd, SEAT_EMPTY, 1, libSeats);
+            location = runEnd;
+        }
+    }
+
+    return changed;
+}
+
+
+/*
+* logBlackout 함수
+* 기능 : 이용불가 시간대의 추가, 시작 또는 끝을 기록한다. 좌석 구간과 종료시각은 이용자명 영역에 저장한다.
+* 입력값 : 좌석 정보 구조체 포인터 *libSeats, 이용불가 시간대 구조체 포인터 *blackout, change(BLACKOUT_ADDED, BLACKOUT_STARTED, BLACKOUT_ENDED)
+* 반환값 없음
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+void logBlackout(SeatsData* libSeats, const Blackout* blackout, unsigned char change)
+{
+    char data[MAX_NAME_LENGTH] = "";
+
+    memcpy(data, &blackout->firstSeat, sizeof(int));
+    memcpy(data + sizeof(int), &blackout->lastSeat, sizeof(int));
+    memcpy(data + 2 * sizeof(int), &blackout->end, sizeof(long long int));
+    walLog(libSeats, WAL_BLACKOUT, change, 0, blackout->start, data);
+
+    return;
+}
+
+
+/*
+* applyBlackout 함수
+* 기능 : 이용불가 시간대 기록을 적용한다. 추가는 같은 시간대가 없는 경우에만 추가하고, 시작과 끝은 같은 시간대를 찾아 표시하거나 삭제한다.
+*        좌석 상태는 따로 기록된 이용불가 설정 변경(WAL_SEAT_STATE)으로 복구되므로, 여기서는 좌석을 바꾸지 않는다.
+* 입력값 : 기록 구조체 포인터 *record, 좌석 정보 구조체 포인터 *libSeats
+* 반환값 없음
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+void applyBlackout(const WalRecord* record, SeatsData* libSeats)
+{
+    SeatsHeader* header = libSeats->header;
+    Blackout blackout;
+    int found = -1;
+
+    memcpy(&blackout.firstSeat, record->name, sizeof(int));
+    memcpy(&blackout.lastSeat, record->name + sizeof(int), sizeof(int));
+    memcpy(&blackout.end, record->name + 2 * sizeof(int), sizeof(long long int));
+    blackout.start = record->time;
+    blackout.isActive = record->state == BLACKOUT_STARTED;
+
+    // 좌석 수가 줄어든 경우, 없는 좌석의 구간은 건너뛴다.
+    if (blackout.firstSeat < 0 || blackout.lastSeat < blackout.firstSeat || blackout.lastSeat >= libSeats->seatCount)
+    {
+        return;
+    }
+
+    spinLock(&header->blackoutLock);
+    for (int i = 0; i < header->blackoutCount && found < 0; i++)
+    {
+        if (header->blackouts[i].firstSeat == blackout.firstSeat && header->blackouts[i].lastSeat == blackout.lastSeat
+            && header->blackouts[i].start == blackout.start && header->blackouts[i].end == blackout.end)
+        {
+            found = i;
+        }
+    }
+
+    if (record->state == BLACKOUT_ENDED && found >= 0)
+    {
+        header->blackouts[found] = header->blackouts[--header->blackoutCount];
+    }else if (record->state != BLACKOUT_ENDED && found >= 0){
+        header->blackouts[found].isActive |= blackout.isActive;
+    }else if (record->state != BLACKOUT_ENDED && header->blackoutCount < MAX_BLACKOUTS){
+        header->blackouts[header->blackoutCount++] = blackout;
+    }
+    spinUnlock(&header->blackoutLock);
+
+    return;
+}
+
+
+/*
+* printBlackouts 함수
+* 기능 : 예약된 이용불가 시간대를 시작시각, 종료시각, 좌석 구간 순으로 출력한다.
+* 입력값 : 좌석 정보 구조체 포인터 *libSeats
+* 반환값 없음
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+void printBlackouts(SeatsData* libSeats)
+{
+    SeatsHeader* header = libSeats->header;
+    Blackout blackouts[MAX_BLACKOUTS];
+    char startText[32], endText[32];
+    int count = 0;
+
+    spinLock(&header->blackoutLock);
+    count = header->blackoutCount;
+    memcpy(blackouts, header->blackouts, sizeof(Blackout) * count);
+    spinUnlock(&header->blackoutLock);
+
+    if (count == 0)
+    {
+        printf("예약된 이용불가 시간대가 없습니다.\n");
+        return;
+    }
+
+    printf("예약된 이용불가 시간대 (%d개)\n", count);
+    for (int i = 0; i < count; i++)
+    {
+        formatDateTime(blackouts[i].start, startText, sizeof(startText));
+        formatDateTime(blackouts[i].end, endText, sizeof(endText));
+        printf("%s ~ %s : %d", startText, endText, blackouts[i].firstSeat + 1);
+        if (blackouts[i].lastSeat > blackouts[i].firstSeat)
+        {
+            printf("-%d", blackouts[i].lastSeat + 1);
+        }
+        printf("번 좌석%s\n", blackouts[i].isActive ? " (진행중)" : "");
+    }
+
+    return;
+}
+
+
+/*
+* reserveSeat 함수
+* 기능 : 좌석을 start부터 end까지 예약한다. 이용불가 좌석이거나, 이용중인 좌석의 이용종료시각 또는 다른 예약과 겹치는 경우 예약하지 않는다.
+*        예약 칸이 가득 찬 경우, 이미 끝난 예약을 정리한 후 다시 확인한다. 예약 시간이 운영시간 안인지는 호출한 쪽에서 checkReservation으로 확인한다.
+* 입력값 : *name(이용자명), location(0번부터 시작하는 좌석번호), start, end(예약 시작, 종료시각 - Unix 초), 좌석 정보 구조체 포인터 *libSeats, 현재 시각 정보 구조체 포인터 *clock
+* 반환값 : 응답 결과 (RESULT_OK, 겹치는 경우 RESULT_SEAT_TAKEN, 예약 칸이 없는 경우 RESULT_FULL)
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+int reserveSeat(const char* name, int location, long long int start, long long int end, SeatsData* libSeats, ClockContext* clock)
+{
+    int result = RESULT_OK;
+
+    // 좌석 잠금을 얻는다. 같은 좌석의 예약과 배정은 모두 좌석 잠금 안에서 확인하고 바꾼다.
+    spinLock(&libSeats->seatLock[location]);
+
+    if (libSeats->seatState[location] == SEAT_UNAVAILABLE
+        || (libSeats->seatState[location] == SEAT_USED && unpackEndTime(libSeats->endTime[location]) > start)
+        || isReserved(location, start, end, libSeats))
+    {
+        result = RESULT_SEAT_TAKEN;
+
+    }else{
+        if (libSeats->reserveCount[location] == libSeats->reserveSlots)
+        {
+            pruneReservations(location, clock->now, libSeats);
+        }
+
+        if (libSeats->reserveCount[location] == libSeats->reserveSlots)
+        {
+            result = RESULT_FULL;
+        }else{
+            insertReservation(name, location, start, end, libSeats);
+        }
+    }
+
+    spinUnlock(&libSeats->seatLock[location]);
+
+    return result;
+}
+
+
+/*
+* cancelReservation 함수
+* 기능 : 이용자가 좌석에 한 예약을 취소한다. 시작시각이 0이면 아직 끝나지 않은 예약 중 가장 이른 예약을 취소한다.
+* 입력값 : *name(이용자명), location(0번부터 시작하는 좌석번호), start(취소할 예약의 시작시각, 0이면 가장 이른 예약), 좌석 정보 구조체 포인터 *libSeats, 현재 시각 정보 구조체 포인터 *clock
+* 반환값 : 취소한 경우 1, 해당하는 예약이 없는 경우 0을 반환함.
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+int cancelReservation(const char* name, int location, long long int start, SeatsData* libSeats, ClockContext* clock)
+{
+    size_t base = (size_t)location * libSeats->reserveSlots;
+    int slot = 0, result = 0;
+
+    spinLock(&libSeats->seatLock[location]);
+
+    // 이용자의 예약을 찾는다. 시작시각을 지정한 경우 해당 예약 하나만 확인한다.
+    for (slot = findReservation(location, start ? start : clock->now, libSeats); slot < libSeats->reserveCount[location]; slot++)
+    {
+        if (start && libSeats->reserveStart[base + slot] != packEndTime(start))
+        {
+            break;
+        }
+        if (!strcmp(libSeats->reserveName[base + slot], name))
+        {
+            removeReservation(location, slot, libSeats);
+            result = 1;
+            break;
+        }
+    }
+
+    spinUnlock(&libSeats->seatLock[location]);
+
+    return result;
+}
+
+
+/*
+* checkReservation 함수
+* 기능 : 예약 시간이 올바른지 확인한다. 예약은 분 단위이며, 지금부터 MAX_RESERVATION_DAYS일 안에 시작하고, 최대 이용 가능 시간 이내여야 한다.
+*        또한 예약 시작시각이 운영시간이어야 하고, 해당 운영일의 폐장시각 전에 끝나야 한다.
+* 입력값 : start, end(예약 시작, 종료시각 - Unix 초), 좌석 정보 구조체 포인터 *libSeats, 열람실 구조체 포인터 *room(좌석이 속한 열람실), 현재 시각 정보 구조체 포인터 *clock
+* 반환값 : 응답 결과 (RESULT_OK, 잘못된 시간인 경우 RESULT_BAD_REQUEST, 운영시간이 아닌 경우 RESULT_CLOSED)
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+int checkReservation(long long int start, long long int end, SeatsData* libSeats, RoomData* room, ClockContext* clock)
+{
+    LibraryData* libData = &room->libData;
+    ClockContext startClock;
+
+    // 현재 분(分)에 시작하는 예약은 받으며, 그 이전에 시작하는 예약은 받지 않는다.
+    if (end <= start || (end - start) % 60 || end - start > libData->MAX_TIME * 60LL
+        || start < clock->now - clock->now % 60 || start > clock->now + MAX_RESERVATION_DAYS * 24 * 60 * 60LL)
+    {
+        return RESULT_BAD_REQUEST;
+    }
+
+    // 예약 시작시각의 운영 구간을 계산한다.
+    setClock(&startClock, libSeats, room, start);
+    if (!isOperationTime(&startClock) || (!startClock.isAllDay && end > startClock.closeTime))
+    {
+        return RESULT_CLOSED;
+    }
+
+    return RESULT_OK;
+}
+
+
+/*
+* findReservation 함수
+* 기능 : 좌석의 예약 중 종료시각이 주어진 시각보다 늦은 첫 예약을 찾는다.
+*        좌석의 예약은 시작시각 순이며 서로 겹치지 않으므로 종료시각도 같은 순서이고, 따라서 이진 탐색으로 찾는다.
+* 입력값 : location(0번부터 시작하는 좌석번호), time(Unix 초), 좌석 정보 구조체 포인터 *libSeats
+* 반환값 : 좌석의 예약 중 몇 번째 예약인지(0부터 시작). 해당하는 예약이 없는 경우 좌석의 예약 수를 반환함.
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+int findReservation(int location, long long int time, SeatsData* libSeats)
+{
+    unsigned int* end = libSeats->reserveEnd + (size_t)location * libSeats->reserveSlots;
+    unsigned int packed = packEndTime(time);
+    int low = 0, high = libSeats->reserveCount[location], middle = 0;
+
+    while (low < high)
+    {
+        middle = (low + high) / 2;
+        if (end[middle] <= packed)
+        {
+            low = middle + 1;
+        }else{
+            high = middle;
+        }
+    }
+
+    return low;
+}
+
+
+/*
+* nextReservation 함수
+* 기능 : 좌석의 예약 중 지금 진행중이거나 다음에 시작하는 예약의 시작시각을 구한다.
+* 입력값 : location(0번부터 시작하는 좌석번호), now(현재 시각 - Unix 초), 좌석 정보 구조체 포인터 *libSeats
+* 반환값 : 예약 시작시각(Unix 초), 남은 예약이 없는 경우 -1을 반환함.
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+long long int nextReservation(int location, long long int now, SeatsData* libSeats)
+{
+    int slot = 0;
+
+    // 예약이 없는 좌석은 예약 열을 읽지 않는다.
+    if (libSeats->reserveCount[location] == 0) { return -1; }
+
+    slot = findReservation(location, now, libSeats);
+    if (slot == libSeats->reserveCount[location]) { return -1; }
+
+    return unpackEndTime(libSeats->reserveStart[(size_t)location * libSeats->reserveSlots + slot]);
+}
+
+
+/*
+* isReserved 함수
+* 기능 : 좌석에 start부터 end까지의 기간과 겹치는 예약이 있는지 확인한다. start 이후에 끝나는 첫 예약이 end 전에 시작하는지만 보면 된다.
+* 입력값 : location(0번부터 시작하는 좌석번호), start, end(기간의 시작, 끝 - Unix 초), 좌석 정보 구조체 포인터 *libSeats
+* 반환값 : 겹치는 예약이 있는 경우 1, 없는 경우 0을 반환함.
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+int isReserved(int location, long long int start, long long int end, SeatsData* libSeats)
+{
+    long long int reserveStart = nextReservation(location, start, libSeats);
+
+    return reserveStart != -1 && reserveStart < end;
+}
+
+
+/*
+* insertReservation 함수
+* 기능 : 좌석의 예약 열에 예약을 시작시각 순서에 맞게 추가하고 기록한다. 좌석 잠금을 가진 상태에서 호출하며, 겹치는 예약이 없고 빈 칸이 있어야 한다.
+* 입력값 : *name(이용자명), location(0번부터 시작하는 좌석번호), start, end(예약 시작, 종료시각 - Unix 초), 좌석 정보 구조체 포인터 *libSeats
+* 반환값 없음
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+void insertReservation(const char* name, int location, long long int start, long long int end, SeatsData* libSeats)
+{
+    size_t base = (size_t)location * libSeats->reserveSlots;
+    int slot = findReservation(location, start, libSeats);
+    int moved = libSeats->reserveCount[location] - slot;
+
+    // 뒤의 예약을 한 칸씩 민 후, 빈 칸에 예약을 쓴다.
+    memmove(&libSeats->reserveStart[base + slot + 1], &libSeats->reserveStart[base + slot], sizeof(unsigned int) * moved);
+    memmove(&libSeats->reserveEnd[base + slot + 1], &libSeats->reserveEnd[base + slot], sizeof(unsigned int) * moved);
+    memmove(&libSeats->reserveName[base + slot + 1], &libSeats->reserveName[base + slot], sizeof(*libSeats->reserveName) * moved);
+    libSeats->reserveStart[base + slot] = packEndTime(start);
+    libSeats->reserveEnd[base + slot] = packEndTime(end);
+    memset(libSeats->reserveName[base + slot], 0, MAX_NAME_LENGTH);
+    strncpy(libSeats->reserveName[base + slot], name, MAX_NAME_LENGTH - 1);
+
+    libSeats->reserveCount[location]++;
+    __atomic_fetch_or(&libSeats->reservedMap[location / BITMAP_WORD_BITS], 1ULL << (location % BITMAP_WORD_BITS), __ATOMIC_RELEASE);
+
+    // 좌석 예약을 기록한다. 예약 시간은 분 단위이다.
+    walAppend(libSeats, WAL_RESERVE, 0, (unsigned short)((end - start) / 60), location, start, libSeats->reserveName[base + slot]);
+
+    return;
+}
+
+
+/*
+* removeReservation 함수
+* 기능 : 좌석의 예약 하나를 삭제하고 기록한다. 좌석 잠금을 가진 상태에서 호출한다.
+* 입력값 : location(0번부터 시작하는 좌석번호), slot(좌석의 예약 중 몇 번째 예약인지), 좌석 정보 구조체 포인터 *libSeats
+* 반환값 없음
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+void removeReservation(int location, int slot, SeatsData* libSeats)
+{
+    size_t base = (size_t)location * libSeats->reserveSlots;
+    int moved = libSeats->reserveCount[location] - slot - 1;
+
+    // 예약 취소를 기록한다. 좌석의 예약은 겹치지 않으므로 시작시각으로 구분한다.
+    walLog(libSeats, WAL_CANCEL, 0, location, unpackEndTime(libSeats->reserveStart[base + slot]), NULL);
+
+    memmove(&libSeats->reserveStart[base + slot], &libSeats->reserveStart[base + slot + 1], sizeof(unsigned int) * moved);
+    memmove(&libSeats->reserveEnd[base + slot], &libSeats->reserveEnd[base + slot + 1], sizeof(unsigned int) * moved);
+    memmove(&libSeats->reserveName[base + slot], &libSeats->reserveName[base + slot + 1], sizeof(*libSeats->reserveName) * moved);
+
+    if (--libSeats->reserveCount[location] == 0)
+    {
+        __atomic_fetch_and(&libSeats->reservedMap[location / BITMAP_WORD_BITS], ~(1ULL << (location % BITMAP_WORD_BITS)), __ATOMIC_RELEASE);
+    }
+
+    return;
+}
+
+
+/*
+* pruneReservations 함수
+* 기능 : 좌석의 예약 중 이미 끝난 예약을 삭제한다. 좌석 잠금을 가진 상태에서 호출한다.
+*        끝난 예약은 이후의 배정과 예약에 영향을 주지 않으므로, 기록하지 않는다. 복구 후 다시 남더라도 다음에 정리된다.
+* 입력값 : location(0번부터 시작하는 좌석번호), now(현재 시각 - Unix 초), 좌석 정보 구조체 포인터 *libSeats
+* 반환값 없음
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+void pruneReservations(int location, long long int now, SeatsData* libSeats)
+{
+    size_t base = (size_t)location * libSeats->reserveSlots;
+    int ended = findReservation(location, now, libSeats);
+    int moved = libSeats->reserveCount[location] - ended;
+
+    if (ended == 0) { return; }
+
+    memmove(&libSeats->reserveStart[base], &libSeats->reserveStart[base + ended], sizeof(unsigned int) * moved);
+    memmove(&libSeats->reserveEnd[base], &libSeats->reserveEnd[base + ended], sizeof(unsigned int) * moved);
+    memmove(&libSeats->reserveName[base], &libSeats->reserveName[base + ended], sizeof(*libSeats->reserveName) * moved);
+    libSeats->reserveCount[location] = (unsigned char)moved;
+
+    if (moved == 0)
+    {
+        __atomic_fetch_and(&libSeats->reservedMap[location / BITMAP_WORD_BITS], ~(1ULL << (location % BITMAP_WORD_BITS)), __ATOMIC_RELEASE);
+    }
+
+    return;
+}
+
+
+/*
+* findOpenSeat 함수
+* 기능 : 열람실의 빈 좌석 중 start부터 end까지 예약이 없는 좌석을 찾는다.
+*        예약이 없는 좌석은 빈 좌석 비트맵과 예약 좌석 비트맵만으로 워드 단위로 찾으므로, 예약이 많아도 먼저 확인하는 좌석의 수는 늘지 않는다.
+*        예약이 없는 빈 좌석이 없는 경우에만, 예약이 있는 빈 좌석의 예약을 이진 탐색으로 확인한다.
+* 입력값 : 좌석 정보 구조체 포인터 *libSeats, 열람실 구조체 포인터 *room, start, end(기간의 시작, 끝 - Unix 초)
+* 반환값 : 좌석번호(0부터 시작), 해당하는 좌석이 없는 경우 -1을 반환함.
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+int findOpenSeat(SeatsData* libSeats, RoomData* room, long long int start, long long int end)
+{
+    int first = room->firstSeat, last = room->firstSeat + room->seatCount;
+    int location = -1;
+    unsigned long long int word = 0;
+
+    // 빈 좌석이 없는 경우 비트맵을 확인하지 않는다.
+    if (__atomic_load_n(&libSeats->header->freeCount, __ATOMIC_RELAXED) == 0) { return -1; }
+
+    // 예약이 없는 빈 좌석 중 번호가 가장 작은 좌석을 찾는다.
+    for (int i = first / BITMAP_WORD_BITS; i <= (last - 1) / BITMAP_WORD_BITS; i++)
+    {
+        word = __atomic_load_n(&libSeats->freeMap[i], __ATOMIC_ACQUIRE) & ~__atomic_load_n(&libSeats->reservedMap[i], __ATOMIC_ACQUIRE) & rangeMask(i, first, last);
+        if (word)
+        {
+            return i * BITMAP_WORD_BITS + __builtin_ctzll(word);
+        }
+    }
+
+    // 예약이 있는 빈 좌석 중 주어진 기간에 예약이 없는 좌석을 찾는다. 예약 열은 잠금 없이 읽으므로, 배정할 때 좌석 잠금 안에서 다시 확인한다.
+    for (int i = first / BITMAP_WORD_BITS; i <= (last - 1) / BITMAP_WORD_BITS; i++)
+    {
+        word = __atomic_load_n(&libSeats->freeMap[i], __ATOMIC_ACQUIRE) & __atomic_load_n(&libSeats->reservedMap[i], __ATOMIC_ACQUIRE) & rangeMask(i, first, last);
+        while (word)
+        {
+            location = i * BITMAP_WORD_BITS + __builtin_ctzll(word);
+            if (!isReserved(location, start, end, libSeats))
+            {
+                return location;
+            }
+            word &= word - 1;
+        }
+    }
+
+    return -1;
+}
+
+
+/*
+* joinWaitList 함수
+* 기능 : 이용자를 우선순위의 대기열 맨 뒤에 등록한다. 이미 기다리는 이용자인 경우 다시 등록하지 않고, 알릴 연결만 바꾼다.
+*        알릴 연결이 없는 등록(대화형 모드, 명령 파일)은 이미 등록된 연결을 그대로 두며, 새 연결로 바꾼 경우 이전 연결에는 만석으로 마지막 응답을 보낸다.
+*        대기열이 가득 찬 경우, 차례가 되기 전에 빠진 칸을 정리한 후 다시 확인한다. 알릴 연결은 좌석을 넘겨받거나 대기열에서 빠질 때까지 응답을 미뤄 둔다.
+* 입력값 : *name(이용자명), room(기다리는 열람실 번호, 0이면 모든 열람실), priority(우선순위, 0부터 WAIT_CLASSES - 1), fd(알릴 좌석 서비스 연결, 없으면 -1), 좌석 정보 구조체 포인터 *libSeats
+* 반환값 : 대기 순번(1부터 시작). 대기열이 가득 찬 경우(응답을 미뤄 둘 수 없는 경우 포함) 0을 반환함.
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+int joinWaitList(const char* name, int room, int priority, int fd, SeatsData* libSeats)
+{
+    WaitList* waitList = &libSeats->header->waitList;
+    WaitEntry* queue = waitList->entries[priority];
+    WaitEntry* entry = NULL;
+    int position = 0, kept = 0, replaced = -1, oldFd = -1;
+
+    spinLock(&waitList->lock);
+
+    // 이미 기다리는 이용자인 경우, 알릴 연결만 바꾼다. 알릴 연결이 없는 등록은 순번만 확인한다.
+    position = waitPosition(name, waitList);
+    if (position)
+    {
+        if (fd >= 0 && !parkWaiter(fd, libSeats))
+        {
+            spinUnlock(&waitList->lock);
+            return 0;
+        }
+        for (int i = 0; i < WAIT_CLASSES && fd >= 0; i++)
+        {
+            for (int j = 0; j < waitList->count[i]; j++)
+            {
+                entry = &waitList->entries[i][(waitList->head[i] + j) % WAITLIST_SIZE];
+                if (!strcmp(entry->name, name))
+                {
+                    if ((oldFd = releaseWaiter(entry, libSeats)) >= 0)
+                    {
+                        replaced = oldFd;
+                    }
+                    entry->notifyFd = fd;
+                    entry->notifyPid = (int)getpid();
+                }
+            }
+        }
+        spinUnlock(&waitList->lock);
+
+        if (replaced >= 0)
+        {
+            finishWait(replaced, RESULT_FULL, libSeats);
+        }
+        return position;
+    }
+
+    // 대기열이 가득 찬 경우, 빠진 칸을 지우고 남은 칸을 앞으로 모은다.
+    if (waitList->count[priority] == WAITLIST_SIZE)
+    {
+        for (int i = 0; i < WAITLIST_SIZE; i++)
+        {
+            entry = &queue[(waitList->head[priority] + i) % WAITLIST_SIZE];
+            if (entry->name[0])
+            {
+                queue[(waitList->head[priority] + kept) % WAITLIST_SIZE] = *entry;
+                kept++;
+            }
+        }
+        waitList->count[priority] = kept;
+    }
+    if (waitList->count[priority] == WAITLIST_SIZE || (fd >= 0 && !parkWaiter(fd, libSeats)))
+    {
+        spinUnlock(&waitList->lock);
+        return 0;
+    }
+
+    // 맨 뒤에 등록한다.
+    entry = &queue[(waitList->head[priority] + waitList->count[priority]) % WAITLIST_SIZE];
+    memset(entry, 0, sizeof(WaitEntry));
+    strncpy(entry->name, name, MAX_NAME_LENGTH - 1);
+    entry->room = room;
+    entry->location = -1;
+    entry->notifyFd = fd;
+    entry->notifyPid = (int)getpid();
+    waitList->count[priority]++;
+    waitList->waiting++;
+    position = waitPosition(name, waitList);
+
+    spinUnlock(&waitList->lock);
+
+    return position;
+}
+
+
+/*
+* waitPosition 함수
+* 기능 : 이용자의 대기 순번을 계산한다. 높은 우선순위의 이용자와 같은 우선순위에서 먼저 등록한 이용자가 앞에 있다. 대기열 잠금을 얻은 후 호출해야 한다.
+* 입력값 : *name(이용자명), 대기열 구조체 포인터 *waitList
+* 반환값 : 대기 순번(1부터 시작). 기다리는 이용자가 아닌 경우 0을 반환함.
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+int waitPosition(const char* name, WaitList* waitList)
+{
+    WaitEntry* entry = NULL;
+    int ahead = 0;
+
+    for (int i = WAIT_CLASSES - 1; i >= 0; i--)
+    {
+        for (int j = 0; j < waitList->count[i]; j++)
+        {
+            entry = &waitList->entries[i][(waitList->head[i] + j) % WAITLIST_SIZE];
+            if (!entry->name[0])
+            {
+                continue;
+            }
+            if (!strcmp(entry->name, name))
+            {
+                return ahead + 1;
+            }
+            ahead++;
+        }
+    }
+
+    return 0;
+}
+
+
+/*
+* takeWaiter 함수
+* 기능 : 열람실의 좌석을 넘겨받을 이용자를 대기열에서 꺼낸다. 높은 우선순위부터, 같은 우선순위에서는 먼저 등록한 이용자부터 고른다.
+*        맨 앞의 이용자가 다른 열람실을 기다리는 경우에만 뒤를 확인하며, 중간에서 꺼낸 칸은 빈 칸으로 남겨 맨 앞에 올 때 지운다. 대기열 잠금을 얻은 후 호출해야 한다.
+* 입력값 : room(좌석이 속한 열람실 번호, 1번부터 시작), 꺼낸 이용자를 저장할 구조체 포인터 *entry, 대기열 구조체 포인터 *waitList
+* 반환값 : 꺼낸 경우 1, 해당 열람실을 기다리는 이용자가 없는 경우 0을 반환함.
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+int takeWaiter(int room, WaitEntry* entry, WaitList* waitList)
+{
+    WaitEntry* queue = NULL;
+
+    for (int i = WAIT_CLASSES - 1; i >= 0; i--)
+    {
+        queue = waitList->entries[i];
+        for (int j = 0; j < waitList->count[i]; j++)
+        {
+            *entry = queue[(waitList->head[i] + j) % WAITLIST_SIZE];
+            if (!entry->name[0] || (entry->room != 0 && entry->room != room))
+            {
+                continue;
+            }
+
+            // 꺼낸 칸을 비운 후, 맨 앞의 빈 칸을 지운다.
+            queue[(waitList->head[i] + j) % WAITLIST_SIZE].name[0] = '\0';
+            while (waitList->count[i] > 0 && !queue[waitList->head[i]].name[0])
+            {
+                waitList->head[i] = (waitList->head[i] + 1) % WAITLIST_SIZE;
+                waitList->count[i]--;
+            }
+            waitList->waiting--;
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+
+/*
+* dropWaiters 함수
+* 기능 : 열람실을 기다리는 이용자를 대기열에서 뺀다. 운영시간이 끝나 좌석을 넘겨줄 수 없는 열람실의 대기열을 비울 때 이용한다.
+*        뺀 이용자가 이 좌석 서비스의 연결에서 기다리는 경우, 대기열 잠금을 푼 후 운영시간이 아님(RESULT_CLOSED)으로 마지막 응답을 보낸다.
+* 입력값 : room(열람실 번호, 1번부터 시작. 0이면 모든 이용자를 뺀다), 좌석 정보 구조체 포인터 *libSeats
+* 반환값 없음
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+void dropWaiters(int room, SeatsData* libSeats)
+{
+    WaitList* waitList = &libSeats->header->waitList;
+    WaitEntry* entry = NULL;
+    int closed[WAIT_CLASSES * WAITLIST_SIZE];
+    int closedCount = 0, fd = -1;
+
+    spinLock(&waitList->lock);
+    for (int i = 0; i < WAIT_CLASSES; i++)
+    {
+        for (int j = 0; j < waitList->count[i]; j++)
+        {
+            entry = &waitList->entries[i][(waitList->head[i] + j) % WAITLIST_SIZE];
+            if (entry->name[0] && (room == 0 || entry->room == room))
+            {
+                if ((fd = releaseWaiter(entry, libSeats)) >= 0)
+                {
+                    closed[closedCount++] = fd;
+                }
+                entry->name[0] = '\0';
+                waitList->waiting--;
+            }
+        }
+        while (waitList->count[i] > 0 && !waitList->entries[i][waitList->head[i]].name[0])
+        {
+            waitList->head[i] = (waitList->head[i] + 1) % WAITLIST_SIZE;
+            waitList->count[i]--;
+        }
+    }
+    spinUnlock(&waitList->lock);
+
+    for (int i = 0; i < closedCount; i++)
+    {
+        finishWait(closed[i], RESULT_CLOSED, libSeats);
+    }
+
+    return;
+}
+
+
+/*
+* handOffSeat 함수
+* 기능 : 빈 좌석을 대기열의 차례인 이용자에게 WAIT_CLAIM_TIME분 동안 맡긴다. 맡긴 좌석은 그 이용자의 예약이 되므로, 그 이용자만 배정받을 수 있다.
+*        맡기는 시간은 폐장시각과 다음 예약 시작시각을 넘지 않는다. 퇴실, 시간 만료, 이용불가 해제로 좌석이 빈 직후 호출하며, 좌석 잠금을 얻은 후 호출해야 한다.
+*        맡긴 좌석 목록은 배정받아야 하는 시각 순으로 유지한다. 폐장시각이나 다음 예약 때문에 기한이 짧아진 칸은 앞쪽에 끼워 넣는다.
+*        맡긴 좌석 목록이 가득 차 버리는 칸의 이용자가 이 좌석 서비스의 연결에서 기다리는 경우, 만석으로 마지막 응답을 보낸다.
+* 입력값 : location(0번부터 시작하는 좌석번호), 좌석 정보 구조체 포인터 *libSeats
+* 반환값 : 맡긴 경우 1, 기다리는 이용자가 없거나 맡길 수 없는 경우 0을 반환함.
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+int handOffSeat(int location, SeatsData* libSeats)
+{
+    WaitList* waitList = &libSeats->header->waitList;
+    RoomData* room = roomOf(libSeats, location);
+    WaitEntry entry;
+    WaitEntry* previous = NULL;
+    ClockContext clock;
+    long long int deadline = 0, reserveStart = -1;
+    int evicted = -1, slot = 0;
+
+    // 기다리는 이용자가 없는 경우 바로 끝낸다.
+    if (__atomic_load_n(&waitList->waiting, __ATOMIC_RELAXED) == 0 || libSeats->seatState[location] != SEAT_EMPTY)
+    {
+        return 0;
+    }
+
+    // 운영시간인 열람실의 좌석만 맡긴다. 진행중인 예약이 있거나 예약 칸이 없는 좌석은 맡기지 않는다.
+    captureClock(&clock, libSeats, room);
+    if (!isOperationTime(&clock))
+    {
+        return 0;
+    }
+    deadline = clock.now + WAIT_CLAIM_TIME * 60LL;
+    if (!clock.isAllDay && deadline > clock.closeTime)
+    {
+        deadline = clock.closeTime;
+    }
+    if (libSeats->reserveCount[location] > 0)
+    {
+        pruneReservations(location, clock.now, libSeats);
+        reserveStart = nextReservation(location, clock.now, libSeats);
+    }
+    if (reserveStart != -1 && deadline > reserveStart)
+    {
+        deadline = reserveStart;
+    }
+    if (deadline <= clock.now || libSeats->reserveCount[location] == libSeats->reserveSlots)
+    {
+        return 0;
+    }
+
+    // 차례인 이용자를 꺼내 맡긴 좌석 목록에 기한 순으로 추가한다. 목록이 가득 찬 경우 기한이 가장 이른 칸을 버린다.
+    spinLock(&waitList->lock);
+    if (!takeWaiter((int)(room - libSeats->header->rooms) + 1, &entry, waitList))
+    {
+        spinUnlock(&waitList->lock);
+        return 0;
+    }
+    if (waitList->claimCount == WAITLIST_SIZE)
+    {
+        if (waitList->claims[waitList->claimHead].notifyFd >= 0)
+        {
+            waitList->notifyCount--;
+            evicted = releaseWaiter(&waitList->claims[waitList->claimHead], libSeats);
+        }
+        waitList->claimHead = (waitList->claimHead + 1) % WAITLIST_SIZE;
+        waitList->claimCount--;
+    }
+    entry.location = location;
+    entry.deadline = deadline;
+
+    // 뒤에서부터 기한이 더 늦은 칸(과 배정받은 칸)을 한 칸씩 뒤로 옮긴 후 그 자리에 넣는다.
+    slot = waitList->claimCount;
+    while (slot > 0)
+    {
+        previous = &waitList->claims[(waitList->claimHead + slot - 1) % WAITLIST_SIZE];
+        if (previous->deadline != 0 && previous->deadline <= deadline)
+        {
+            break;
+        }
+        waitList->claims[(waitList->claimHead + slot) % WAITLIST_SIZE] = *previous;
+        slot--;
+    }
+    waitList->claims[(waitList->claimHead + slot) % WAITLIST_SIZE] = entry;
+    waitList->claimCount++;
+    if (entry.notifyFd >= 0)
+    {
+        waitList->notifyCount++;
+    }
+    spinUnlock(&waitList->lock);
+
+    if (evicted >= 0)
+    {
+        finishWait(evicted, RESULT_FULL, libSeats);
+    }
+
+    // 맡긴 시간 동안 좌석을 이용자의 예약으로 둔다.
+    insertReservation(entry.name, location, clock.now, deadline, libSeats);
+
+    return 1;
+}
+
+
+/*
+* takeClaim 함수
+* 기능 : 이용자에게 맡긴 좌석을 배정받음으로 표시한다. 맡긴 좌석을 배정받는 경우 예약 종료시각이 아닌 최대 이용 가능 시간까지 이용하므로, 예약과 구분할 때 이용한다.
+*        다른 연결로 배정받아 아직 알리지 않은 이 좌석 서비스의 대기 연결이 남은 경우, 이미 배정받음(RESULT_ALREADY_SEATED)으로 마지막 응답을 보낸다.
+* 입력값 : location(0번부터 시작하는 좌석번호), *name(이용자명), 좌석 정보 구조체 포인터 *libSeats
+* 반환값 : 이용자에게 맡긴 좌석인 경우 1, 그렇지 않은 경우 0을 반환함.
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+int takeClaim(int location, const char* name, SeatsData* libSeats)
+{
+    WaitList* waitList = &libSeats->header->waitList;
+    WaitEntry* claim = NULL;
+    int result = 0, fd = -1;
+
+    if (__atomic_load_n(&waitList->claimCount, __ATOMIC_RELAXED) == 0)
+    {
+        return 0;
+    }
+
+    spinLock(&waitList->lock);
+    for (int i = 0; i < waitList->claimCount; i++)
+    {
+        claim = &waitList->claims[(waitList->claimHead + i) % WAITLIST_SIZE];
+        if (claim->location == location && claim->deadline && !strcmp(claim->name, name))
+        {
+            if (claim->notifyFd >= 0)
+            {
+                fd = releaseWaiter(claim, libSeats);
+                claim->notifyFd = -1;
+                waitList->notifyCount--;
+            }
+            claim->deadline = 0;
+            result = 1;
+            break;
+        }
+    }
+    spinUnlock(&waitList->lock);
+
+    if (fd >= 0)
+    {
+        finishWait(fd, RESULT_ALREADY_SEATED, libSeats);
+    }
+
+    return result;
+}
+
+
+/*
+* findClaim 함수
+* 기능 : 이용자에게 맡겨 두었고 아직 배정받지 않은 좌석을 찾는다.
+* 입력값 : *name(이용자명), now(현재 시각 - Unix 초), 맡긴 좌석번호를 저장할 포인터 *location, 좌석 정보 구조체 포인터 *libSeats
+* 반환값 : 맡긴 좌석을 배정받아야 하는 시각(Unix 시간). 맡긴 좌석이 없는 경우 0을 반환함.
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+long long int findClaim(const char* name, long long int now, int* location, SeatsData* libSeats)
+{
+    WaitList* waitList = &libSeats->header->waitList;
+    WaitEntry* claim = NULL;
+    long long int deadline = 0;
+
+    if (__atomic_load_n(&waitList->claimCount, __ATOMIC_RELAXED) == 0)
+    {
+        return 0;
+    }
+
+    spinLock(&waitList->lock);
+    for (int i = 0; i < waitList->claimCount; i++)
+    {
+        claim = &waitList->claims[(waitList->claimHead + i) % WAITLIST_SIZE];
+        if (claim->deadline > now && !strcmp(claim->name, name))
+        {
+            *location = claim->location;
+            deadline = claim->deadline;
+            break;
+        }
+    }
+    spinUnlock(&waitList->lock);
+
+    return deadline;
+}
+
+
+/*
+* serveWaitList 함수
+* 기능 : 배정받아야 하는 시각이 지난 맡긴 좌석을 다음 이용자에게 넘기고, 운영시간이 끝난 열람실의 대기열을 비운다.
+*        또한 관리자 초기화 등으로 좌석이 한꺼번에 빈 경우, 기다리는 이용자에게 빈 좌석을 차례로 맡긴다. 기다리는 이용자와 맡긴 좌석이 없으면 아무것도 하지 않는다.
+*        꺼낸 좌석을 아직 알리지 못한 이 좌석 서비스의 연결에는 마지막 응답(시간이 지난 경우 만석, 다른 연결로 배정받은 경우 이미 배정받음)을 보낸다.
+* 입력값 : 좌석 정보 구조체 포인터 *libSeats, 현재 시각 정보 구조체 포인터 *clock
+* 반환값 없음
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+void serveWaitList(SeatsData* libSeats, ClockContext* clock)
+{
+    WaitList* waitList = &libSeats->header->waitList;
+    RoomData* rooms = libSeats->header->rooms;
+    ClockContext roomClock = *clock;
+    WaitEntry claim;
+    int location = -1, isOpen = 0, isHanded = 0, fd = -1;
+
+    if (__atomic_load_n(&waitList->waiting, __ATOMIC_RELAXED) == 0 && __atomic_load_n(&waitList->claimCount, __ATOMIC_RELAXED) == 0)
+    {
+        return;
+    }
+
+    // 맡긴 좌석 목록의 맨 앞부터, 배정받아야 하는 시각이 지난 좌석을 꺼내 다음 이용자에게 맡긴다. 배정받은 좌석(시각이 0)은 지우기만 한다.
+    // 잠금 순서(좌석 -> 대기열)를 지키기 위해, 좌석 잠금을 얻기 전에 대기열 잠금을 푼다.
+    while (1)
+    {
+        spinLock(&waitList->lock);
+        if (waitList->claimCount == 0 || waitList->claims[waitList->claimHead].deadline > clock->now)
+        {
+            spinUnlock(&waitList->lock);
+            break;
+        }
+        claim = waitList->claims[waitList->claimHead];
+        fd = -1;
+        if (claim.notifyFd >= 0)
+        {
+            waitList->notifyCount--;
+            fd = releaseWaiter(&claim, libSeats);
+        }
+        waitList->claimHead = (waitList->claimHead + 1) % WAITLIST_SIZE;
+        waitList->claimCount--;
+        spinUnlock(&waitList->lock);
+
+        if (fd >= 0)
+        {
+            finishWait(fd, claim.deadline ? RESULT_FULL : RESULT_ALREADY_SEATED, libSeats);
+        }
+
+        if (claim.deadline)
+        {
+            spinLock(&libSeats->seatLock[claim.location]);
+            handOffSeat(claim.location, libSeats);
+            spinUnlock(&libSeats->seatLock[claim.location]);
+        }
+    }
+
+    // 열람실마다, 운영시간이 끝난 경우 대기열에서 빼고, 운영중인 경우 남은 빈 좌석을 맡긴다.
+    for (int i = 0; i < libSeats->header->roomCount && __atomic_load_n(&waitList->waiting, __ATOMIC_RELAXED) > 0; i++)
+    {
+        setRoomClock(&roomClock, libSeats, &rooms[i]);
+        if (!isOperationTime(&roomClock))
+        {
+            dropWaiters(i + 1, libSeats);
+            continue;
+        }
+        isOpen = 1;
+
+        // 맡기지 못한 경우(해당 열람실을 기다리는 이용자가 없는 경우 등) 다음 열람실로 넘어간다.
+        isHanded = 1;
+        while (isHanded && __atomic_load_n(&waitList->waiting, __ATOMIC_RELAXED) > 0
+            && (location = findOpenSeat(libSeats, &rooms[i], roomClock.now, roomClock.now + 1)) != -1)
+        {
+            spinLock(&libSeats->seatLock[location]);
+            isHanded = handOffSeat(location, libSeats);
+            spinUnlock(&libSeats->seatLock[location]);
+        }
+    }
+
+    // 운영중인 열람실이 없는 경우, 모든 열람실을 기다리는 이용자도 대기열에서 뺀다.
+    if (!isOpen && __atomic_load_n(&waitList->waiting, __ATOMIC_RELAXED) > 0)
+    {
+        dropWaiters(0, libSeats);
+    }
+
+    return;
+}
+
+
+/*
+* detectSimdLevel 함수
+* 기능 : 현재 CPU에서 이용 가능한 가장 높은 벡터 연산 수준을 확인한다. x86이 아닌 경우 항상 벡터 명령을 이용하지 않는다.
+* 입력값 없음
+* 반환값 : SIMD_AVX2, SIMD_SSE42, SIMD_SCALAR 중 하나
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+int detectSimdLevel(void)
+{
+#ifdef SIMD_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+    {
+        return SIMD_AVX2;
+    }
+    if (__builtin_cpu_supports("sse4.2"))
+    {
+        return SIMD_SSE42;
+    }
+#endif
+
+    return SIMD_SCALAR;
+}
+
+
+/*
+* clampColumn 함수
+* 기능 : 32비트 부호 없는 정수 열에서 limit보다 큰 값을 모두 limit으로 바꾼다. 벡터 연산 수준에 맞는 구현을 호출한다.
+*        이용종료시각 열에 이용하면, 이용중이 아닌 좌석(0)은 바뀌지 않으므로 좌석 상태 열을 확인할 필요가 없다.
+* 입력값 : 열 column, count(값의 수), limit(최댓값), simdLevel(벡터 연산 수준)
+* 반환값 없음
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+void clampColumn(unsigned int* column, int count, unsigned int limit, int simdLevel)
+{
+#ifdef SIMD_X86
+    if (simdLevel == SIMD_AVX2)
+    {
+        clampColumnAvx2(column, count, limit);
+        return;
+    }
+    if (simdLevel == SIMD_SSE42)
+    {
+        clampColumnSse42(column, count, limit);
+        return;
+    }
+#else
+    (void)simdLevel;
+#endif
+
+    // 벡터 명령을 이용하지 않는 경우. 바뀌는 값만 써서, 바뀌지 않는 캐시 라인(공유 파일의 페이지)은 더럽히지 않는다.
+    for (int i = 0; i < count; i++)
+    {
+        if (column[i] > limit)
+        {
+            column[i] = limit;
+        }
+    }
+
+    return;
+}
+
+
+/*
+* releaseUsedSeats 함수
+* 기능 : 좌석 상태 열에서 이용중(SEAT_USED)인 좌석을 모두 빈 좌석(SEAT_EMPTY)으로 바꾼다. 벡터 연산 수준에 맞는 구현을 호출한다.
+*        비트맵, 이용자명 표, 색인, 힙은 바꾸지 않으므로 호출한 쪽(resetSeats)에서 다시 만든다.
+* 입력값 : 좌석 상태 열 state, count(좌석 수), simdLevel(벡터 연산 수준)
+* 반환값 : 빈 좌석으로 바꾼 좌석 수
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+int releaseUsedSeats(unsigned char* state, int count, int simdLevel)
+{
+    int released = 0;
+
+#ifdef SIMD_X86
+    if (simdLevel == SIMD_AVX2)
+    {
+        return releaseUsedAvx2(state, count);
+    }
+    if (simdLevel == SIMD_SSE42)
+    {
+        return releaseUsedSse42(state, count);
+    }
+#else
+    (void)simdLevel;
+#endif
+
+    // 벡터 명령을 이용하지 않는 경우
+    for (int i = 0; i < count; i++)
+    {
+        if (state[i] == SEAT_USED)
+        {
+            state[i] = SEAT_EMPTY;
+            released++;
+        }
+    }
+
+    return released;
+}
+
+
+#ifdef SIMD_X86
+/*
+* clampColumnSse42 함수
+* 기능 : clampColumn의 SSE4.2 구현. 값 4개의 최솟값을 한 번에 구하고(pminud), 바뀐 값이 있는 경우에만 저장한다.
+* 입력값 : 열 column, count(값의 수), limit(최댓값)
+* 반환값 없음
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+__attribute__((target("sse4.2")))
+void clampColumnSse42(unsigned int* column, int count, unsigned int limit)
+{
+    __m128i limits = _mm_set1_epi32((int)limit);
+    int i = 0;
+
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128i values = _mm_loadu_si128((const __m128i*)(column + i));
+        __m128i clamped = _mm_min_epu32(values, limits);
+
+        if (_mm_movemask_epi8(_mm_cmpeq_epi32(clamped, values)) != 0xFFFF)
+        {
+            _mm_storeu_si128((__m128i*)(column + i), clamped);
+        }
+    }
+
+    // 남은 값 처리
+    for (; i < count; i++)
+    {
+        if (column[i] > limit)
+        {
+            column[i] = limit;
+        }
+    }
+
+    return;
+}
+
+
+/*
+* clampColumnAvx2 함수
+* 기능 : clampColumn의 AVX2 구현. 값 8개를 한 번에 비교하고, limit보다 큰 값의 자리에만 limit을 저장(마스크 저장)한다.
+* 입력값 : 열 column, count(값의 수), limit(최댓값)
+* 반환값 없음
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+__attribute__((target("avx2")))
+void clampColumnAvx2(unsigned int* column, int count, unsigned int limit)
+{
+    __m256i limits = _mm256_set1_epi32((int)limit);
+    __m256i ones = _mm256_set1_epi32(-1);
+    int i = 0;
+
+    for (; i + 8 <= count; i += 8)
+    {
+        __m256i values = _mm256_loadu_si256((const __m256i*)(column + i));
+
+        // 부호 없는 비교 명령이 없으므로, 최솟값이 원래 값과 다른 자리를 limit보다 큰 자리로 본다.
+        __m256i over = _mm256_xor_si256(_mm256_cmpeq_epi32(_mm256_min_epu32(values, limits), values), ones);
+
+        if (!_mm256_testz_si256(over, over))
+        {
+            _mm256_maskstore_epi32((int*)(column + i), over, limits);
+        }
+    }
+
+    // 남은 값 처리
+    for (; i < count; i++)
+    {
+        if (column[i] > limit)
+        {
+            column[i] = limit;
+        }
+    }
+
+    return;
+}
+
+
+/*
+* releaseUsedSse42 함수
+* 기능 : releaseUsedSeats의 SSE4.2 구현. 좌석 16개의 상태를 한 번에 비교하여, 이용중인 좌석의 자리만 SEAT_EMPTY(0)로 지운다.
+*        이용중인 좌석이 있는 경우에만 상태를 저장한다.
+* 입력값 : 좌석 상태 열 state, count(좌석 수)
+* 반환값 : 빈 좌석으로 바꾼 좌석 수
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+__attribute__((target("sse4.2")))
+int releaseUsedSse42(unsigned char* state, int count)
+{
+    __m128i used = _mm_set1_epi8(SEAT_USED);
+    unsigned int mask = 0;
+    int i = 0, released = 0;
+
+    for (; i + 16 <= count; i += 16)
+    {
+        __m128i states = _mm_loadu_si128((const __m128i*)(state + i));
+        __m128i isUsed = _mm_cmpeq_epi8(states, used);
+
+        mask = (unsigned int)_mm_movemask_epi8(isUsed);
+        if (mask)
+        {
+            // SEAT_EMPTY는 0이므로, 이용중인 자리의 바이트를 0으로 지우면 빈 좌석이 된다.
+            _mm_storeu_si128((__m128i*)(state + i), _mm_andnot_si128(isUsed, states));
+            released += __builtin_popcount(mask);
+        }
+    }
+
+    // 남은 좌석 처리
+    for (; i < count; i++)
+    {
+        if (state[i] == SEAT_USED)
+        {
+            state[i] = SEAT_EMPTY;
+            released++;
+        }
+    }
+
+    return released;
+}
+
+
+/*
+* releaseUsedAvx2 함수
+* 기능 : releaseUsedSeats의 AVX2 구현. 좌석 32개의 상태를 한 번에 비교하는 것 외에는 releaseUsedSse42와 같다.
+* 입력값 : 좌석 상태 열 state, count(좌석 수)
+* 반환값 : 빈 좌석으로 바꾼 좌석 수
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+__attribute__((target("avx2")))
+int releaseUsedAvx2(unsigned char* state, int count)
+{
+    __m256i used = _mm256_set1_epi8(SEAT_USED);
+    unsigned int mask = 0;
+    int i = 0, released = 0;
+
+    for (; i + 32 <= count; i += 32)
+    {
+        __m256i states = _mm256_loadu_si256((const __m256i*)(state + i));
+        __m256i isUsed = _mm256_cmpeq_epi8(states, used);
+
+        mask = (unsigned int)_mm256_movemask_epi8(isUsed);
+        if (mask)
+        {
+            _mm256_storeu_si256((__m256i*)(state + i), _mm256_andnot_si256(isUsed, states));
+            released += __builtin_popcount(mask);
+        }
+    }
+
+    // 남은 좌석 처리
+    for (; i < count; i++)
+    {
+        if (state[i] == SEAT_USED)
+        {
+            state[i] = SEAT_EMPTY;
+            released++;
+        }
+    }
+
+    return released;
+}
+#endif
+
+
+/*
+* hashName 함수
+* 기능 : 이용자명의 해시값을 계산한다. (FNV-1a 32비트)
+* 입력값 : *name(이용자명)
+* 반환값 : 이용자명의 해시값
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+unsigned int hashName(const char* name)
+{
+    unsigned int hash = 2166136261u;
+
+    // 이용자명의 각 바이트에 대해 반복
+    while (*name)
+    {
+        hash ^= (unsigned char)*name++;
+        hash *= 16777619u;
+    }
+
+    return hash;
+}
+
+
+/*
+* indexInsert 함수
+* 기능 : 이용자명 색인에 이용자를 추가한다. 색인 잠금을 얻은 후 호출해야 한다.
+* 입력값 : user(이용자 번호, 이용자명 표에 이용자명과 해시값이 기록되어 있어야 함), 좌석 정보 구조체 포인터 *libSeats
+* 반환값 없음
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+void indexInsert(unsigned int user, SeatsData* libSeats)
+{
+    // 이용자명 해시값에 해당하는 칸부터 빈 칸을 찾는다. (선형 탐사)
+    unsigned int slot = libSeats->userHash[user] & libSeats->indexMask;
+
+    // 색인의 크기는 좌석 수의 2배 이상이고 이용자 수는 좌석 수 이하이므로, 빈 칸은 항상 존재한다.
+    while (libSeats->userIndex[slot] != INDEX_EMPTY)
+    {
+        slot = (slot + 1) & libSeats->indexMask;
+    }
+
+    libSeats->userIndex[slot] = (int)user;
+
+    return;
+}
+
+
+/*
+* indexRemove 함수
+* 기능 : 이용자명 색인에서 이용자를 삭제한다. 삭제한 칸 뒤의 항목을 앞으로 당겨 탐사가 끊기지 않도록 한다. 색인 잠금을 얻은 후 호출해야 한다.
+* 입력값 : user(이용자 번호), 좌석 정보 구조체 포인터 *libSeats
+* 반환값 없음
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+void indexRemove(unsigned int user, SeatsData* libSeats)
+{
+    unsigned int mask = libSeats->indexMask;
+    unsigned int slot = libSeats->userHash[user] & mask;
+    unsigned int next = 0, home = 0;
+
+    // 삭제할 이용자가 저장된 칸을 찾는다.
+    while (libSeats->userIndex[slot] != (int)user)
+    {
+        // 색인에 없는 이용자인 경우 함수 종료
+        if (libSeats->userIndex[slot] == INDEX_EMPTY) { return; }
+
+        slot = (slot + 1) & mask;
+    }
+
+    // 빈 칸이 나올 때까지, 현재 빈 칸으로 옮겨도 되는 항목을 앞으로 당긴다.
+    next = (slot + 1) & mask;
+    while (libSeats->userIndex[next] != INDEX_EMPTY)
+    {
+        // 다음 항목의 원래 위치(해시값에 해당하는 칸)
+        home = libSeats->userHash[libSeats->userIndex[next]] & mask;
+
+        // 원래 위치에서 다음 항목까지의 거리가 원래 위치에서 빈 칸까지의 거리 이상인 경우, 빈 칸으로 옮길 수 있다.
+        if (((next - home) & mask) >= ((slot - home) & mask))
+        {
+            libSeats->userIndex[slot] = libSeats->userIndex[next];
+            slot = next;
+        }
+
+        next = (next + 1) & mask;
+    }
+
+    libSeats->userIndex[slot] = INDEX_EMPTY;
+
+    return;
+}
+
+
+/*
+* indexFind 함수
+* 기능 : 이용자명 색인에서 주어진 이름의 이용자 번호를 찾는다. 색인 잠금을 얻은 후 호출해야 한다.
+* 입력값 : *name(이용자명), 좌석 정보 구조체 포인터 *libSeats
+* 반환값 : 이용자 번호, 해당 이용자가 없으면 NO_USER
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+unsigned int indexFind(const char* name, SeatsData* libSeats)
+{
+    // 이용자명의 해시값에 해당하는 칸부터 색인을 탐색한다.
+    unsigned int hash = hashName(name);
+    unsigned int slot = hash & libSeats->indexMask;
+    int user = 0;
+
+    // 빈 칸을 만날 때까지 반복
+    while ((user = libSeats->userIndex[slot]) != INDEX_EMPTY)
+    {
+        // 해시값이 같은 경우에만 이용자명 표의 이름을 비교하며, 주어진 이름의 이용자가 발견된 경우 이용자 번호 반환
+        if (libSeats->userHash[user] == hash && !strcmp(libSeats->userName[user], name))
+        {
+            return (unsigned int)user;
+        }
+
+        slot = (slot + 1) & libSeats->indexMask;
+    }
+
+    // 해당 이용자가 없으면 NO_USER 반환
+    return NO_USER;
+}
+
+
+/*
+* internUser 함수
+* 기능 : 쓰이지 않는 이용자 번호를 하나 꺼내 이용자명 표에 이용자명, 해시값, 좌석번호를 기록하고 색인에 추가한다. 색인 잠금을 얻은 후 호출해야 한다.
+*        이용자 한 명은 좌석 하나만 이용하므로, 이용자 번호는 좌석 수만큼만 있으면 모자라지 않는다.
+* 입력값 : *name(이용자명), location(0번부터 시작하는 좌석번호), 좌석 정보 구조체 포인터 *libSeats
+* 반환값 : 새 이용자 번호
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+unsigned int internUser(const char* name, int location, SeatsData* libSeats)
+{
+    unsigned int user = libSeats->freeUsers[--libSeats->header->freeUserCount];
+
+    strncpy(libSeats->userName[user], name, MAX_NAME_LENGTH - 1);
+    libSeats->userName[user][MAX_NAME_LENGTH - 1] = '\0';
+    libSeats->userHash[user] = hashName(libSeats->userName[user]);
+    libSeats->userSeat[user] = location;
+    indexInsert(user, libSeats);
+
+    return user;
+}
+
+
+/*
+* releaseUser 함수
+* 기능 : 이용자를 색인에서 삭제하고, 이용자명을 지운 후 이용자 번호를 되돌려 놓는다. 색인 잠금을 얻은 후 호출해야 한다.
+* 입력값 : user(이용자 번호), 좌석 정보 구조체 포인터 *libSeats
+* 반환값 없음
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+void releaseUser(unsigned int user, SeatsData* libSeats)
+{
+    // 이용자가 없는 경우 함수 종료
+    if (user == NO_USER) { return; }
+
+    indexRemove(user, libSeats);
+    libSeats->userName[user][0] = '\0';
+    libSeats->freeUsers[libSeats->header->freeUserCount++] = user;
+
+    return;
+}
+
+
+/*
+* resetUsers 함수
+* 기능 : 이용자명 색인을 비우고, 모든 이용자 번호를 쓰이지 않는 상태로 되돌린다. 색인 잠금을 얻은 후 호출해야 한다.
+* 입력값 : 좌석 정보 구조체 포인터 *libSeats
+* 반환값 없음
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+void resetUsers(SeatsData* libSeats)
+{
+    // INDEX_EMPTY(-1)는 모든 바이트가 0xFF이므로, 색인은 한번에 비운다.
+    memset(libSeats->userIndex, 0xFF, sizeof(int) * (libSeats->indexMask + 1));
+
+    // 작은 번호부터 꺼내도록, 스택의 위쪽에 작은 번호를 둔다.
+    for (int i = 0; i < libSeats->seatCount; i++)
+    {
+        libSeats->freeUsers[i] = (unsigned int)(libSeats->seatCount - i);
+    }
+    libSeats->header->freeUserCount = libSeats->seatCount;
+
+    return;
+}
+
+
+/*
+* quotaConfigure 함수
+* 기능 : 이용 한도를 정한다. 하루 한도는 이용 한도 표가 있는 경우에만 적용하며, 없는 경우(한도 없이 만든 공유 좌석 파일 등) 경고를 출력한다.
+*        기록을 복구하는 동안에는 사용량을 더하지 않아야 하므로, 복구가 끝난 후 호출한다.
+* 입력값 : 좌석 정보 구조체 포인터 *libSeats, dailyQuota(하루 이용 한도, 분), maxRenewals(이용 한 번의 최대 연장 횟수), dailyRenewals(하루 최대 연장 횟수) - 0이면 제한 없음
+* 반환값 없음
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+void quotaConfigure(SeatsData* libSeats, int dailyQuota, int maxRenewals, int dailyRenewals)
+{
+    if ((dailyQuota > 0 || dailyRenewals > 0) && libSeats->quotaMask == 0)
+    {
+        printf("경고 : 좌석 저장소에 이용 한도 표가 없어 하루 이용 한도를 적용하지 않습니다.\n");
+        dailyQuota = 0;
+        dailyRenewals = 0;
+    }
+
+    libSeats->dailyQuota = dailyQuota * 60;
+    libSeats->maxRenewals = maxRenewals;
+    libSeats->dailyRenewals = dailyRenewals;
+
+    return;
+}
+
+
+/*
+* quotaDay 함수
+* 기능 : 주어진 날 0시(지역 시각)의 날짜 번호(1970/1/1부터의 일수)를 계산한다. 날짜마다 다른 수이며 날짜 순으로 커진다.
+*        이용 한도 표의 칸은 사용량을 센 날짜 번호를 가지므로, 날짜 번호가 오늘과 다른 칸은 비우지 않고도 사용량이 0인 것으로 본다.
+*        0시에 반나절을 더한 시각으로 나누므로, 시간대나 일광 절약 시간으로 0시가 몇 시간 어긋나도 같은 날의 번호는 같다.
+*        현재 시각 구조체의 오늘 0시로 계산하므로, 배정이나 연장마다 지역 시각을 다시 계산하지 않는다.
+* 입력값 : midnight(그 날 0시, Unix 초)
+* 반환값 : 날짜 번호(1 이상)
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+unsigned short quotaDay(long long int midnight)
+{
+    return (unsigned short)((midnight + 12 * 60 * 60) / (24 * 60 * 60));
+}
+
+
+/*
+* quotaToday 함수
+* 기능 : 주어진 시각(지역 시각)의 날짜 번호를 계산한다. 현재 시각 구조체가 없는 경우(퇴실, 좌석 초기화, 기록 복구)에 이용한다.
+* 입력값 : now(시각, Unix 초)
+* 반환값 : 날짜 번호(1 이상)
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+unsigned short quotaToday(long long int now)
+{
+    time_t Time = (time_t)now;
+    struct tm tmTime;
+    localtime_r(&Time, &tmTime);
+
+    return quotaDay(now - (tmTime.tm_hour * 60 * 60 + tmTime.tm_min * 60 + tmTime.tm_sec));
+}
+
+
+/*
+* quotaSegment 함수
+* 기능 : 이용자명 해시값으로 이용자의 칸이 있는 이용 한도 표 구역을 계산한다. 구역 안의 칸은 해시값의 아래 비트로 정하므로, 구역은 위 비트로 정한다.
+*        구역마다 잠금이 따로 있으므로, 다른 구역의 이용자는 서로 기다리지 않고 사용량을 읽고 바꾼다.
+* 입력값 : hash(이용자명 해시값), 좌석 정보 구조체 포인터 *libSeats
+* 반환값 : 구역 번호(0부터 시작). 구역의 첫 칸은 구역 번호 * 구역 크기이다.
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+unsigned int quotaSegment(unsigned int hash, SeatsData* libSeats)
+{
+    unsigned int segmentCount = libSeats->quotaMask / (libSeats->quotaSegmentMask + 1) + 1;
+
+    return (hash >> 26) & (segmentCount - 1);
+}
+
+
+/*
+* quotaFind 함수
+* 기능 : 이용 한도 표에서 이용자의 칸을 찾는다. 칸의 날짜 번호가 오늘이 아닌 경우 오늘의 빈 사용량으로 바꾼다.
+*        표에 없는 이용자를 추가하는 경우, 찾는 도중 지나친 칸 중 오늘 쓰이지 않은 첫 칸을 다시 쓰고, 그런 칸이 없으면 빈 칸을 쓴다.
+*        다시 쓰는 칸은 찾는 경로 위에 있으므로 다른 이용자를 찾는 경로를 끊지 않는다. 따라서 칸을 지우지 않고도 표의 크기는 하루 동안의 이용자 수만큼이면 된다.
+*        칸은 이용자의 구역(quotaSegment) 안에서만 찾으며, 그 구역의 잠금을 가진 상태에서 호출해야 한다.
+* 입력값 : *name(이용자명), hash(이용자명 해시값), day(오늘의 날짜 번호), isCreate(표에 없는 경우 추가하면 1), 좌석 정보 구조체 포인터 *libSeats
+* 반환값 : 이용자의 칸 번호. 표에 없는 경우(추가하는 경우 구역이 가득 찬 경우) -1을 반환함.
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+int quotaFind(const char* name, unsigned int hash, unsigned short day, int isCreate, SeatsData* libSeats)
+{
+    unsigned int base = quotaSegment(hash, libSeats) * (libSeats->quotaSegmentMask + 1);
+    unsigned int slot = base + (hash & libSeats->quotaSegmentMask);
+    int reuse = -1;
+
+    // 같은 이용자의 칸이나 빈 칸이 나올 때까지 구역 안의 다음 칸으로 이동한다.
+    for (unsigned int probe = 0; probe <= libSeats->quotaSegmentMask && libSeats->quotaName[slot][0] != '\0'; probe++)
+    {
+        if (libSeats->quotaHash[slot] == hash && !strcmp(libSeats->quotaName[slot], name))
+        {
+            if (libSeats->quotaCounter[slot].day != day)
+            {
+                libSeats->quotaCounter[slot] = (QuotaCounter){ day, 0, 0 };
+            }
+            return (int)slot;
+        }
+        if (reuse < 0 && libSeats->quotaCounter[slot].day != day)
+        {
+            reuse = (int)slot;
+        }
+        slot = base + ((slot - base + 1) & libSeats->quotaSegmentMask);
+    }
+
+    // 표에 없는 경우, 오늘 쓰이지 않은 칸이나 빈 칸에 추가한다. 구역의 모든 칸이 오늘 쓰인 경우 추가하지 않는다.
+    if (!isCreate || (reuse < 0 && libSeats->quotaName[slot][0] != '\0'))
+    {
+        return -1;
+    }
+    if (reuse < 0)
+    {
+        reuse = (int)slot;
+    }
+    strncpy(libSeats->quotaName[reuse], name, MAX_NAME_LENGTH - 1);
+    libSeats->quotaName[reuse][MAX_NAME_LENGTH - 1] = '\0';
+    libSeats->quotaHash[reuse] = hash;
+    libSeats->quotaCounter[reuse] = (QuotaCounter){ day, 0, 0 };
+
+    return reuse;
+}
+
+
+/*
+* quotaUsage 함수
+* 기능 : 이용자의 오늘 사용량(끝난 이용의 시간 합과 연장 횟수)을 읽는다. 표에 없는 이용자의 사용량은 0이다.
+* 입력값 : *name(이용자명), day(오늘의 날짜 번호), 사용량을 저장할 포인터 *usage, 좌석 정보 구조체 포인터 *libSeats
+* 반환값 없음
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+void quotaUsage(const char* name, unsigned short day, QuotaCounter* usage, SeatsData* libSeats)
+{
+    unsigned char* lock = NULL;
+    unsigned int hash = 0;
+    int slot = -1;
+
+    memset(usage, 0, sizeof(QuotaCounter));
+    if (libSeats->quotaMask == 0)
+    {
+        return;
+    }
+
+    // 해시값은 잠금 밖에서 계산한 후, 이용자의 구역 잠금만 얻는다.
+    hash = hashName(name);
+    lock = &libSeats->header->quotaLocks[quotaSegment(hash, libSeats)];
+    spinLock(lock);
+    slot = quotaFind(name, hash, day, 0, libSeats);
+    if (slot >= 0)
+    {
+        *usage = libSeats->quotaCounter[slot];
+    }
+    spinUnlock(lock);
+
+    return;
+}
+
+
+/*
+* quotaLeft 함수
+* 기능 : 이용자의 오늘 남은 이용 한도를 계산한다. 이용중인 이용은 끝날 때 사용량에 더하므로, 좌석이 없는 이용자에게 배정할 수 있는 시간이다.
+* 입력값 : *name(이용자명), 현재 시각 정보 구조체 포인터 *clock, 좌석 정보 구조체 포인터 *libSeats
+* 반환값 : 남은 이용 한도(초). 한도를 모두 쓴 경우 0, 하루 이용 한도가 없는 경우 QUOTA_UNLIMITED를 반환함.
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+int quotaLeft(const char* name, ClockContext* clock, SeatsData* libSeats)
+{
+    QuotaCounter usage;
+
+    if (libSeats->dailyQuota == 0)
+    {
+        return QUOTA_UNLIMITED;
+    }
+
+    quotaUsage(name, quotaDay(clock->midnight), &usage, libSeats);
+
+    return usage.usedSeconds < (unsigned int)libSeats->dailyQuota ? libSeats->dailyQuota - (int)usage.usedSeconds : 0;
+}
+
+
+/*
+* quotaRenewable 함수
+* 기능 : 연장 횟수와 하루 이용 한도로 좌석을 연장할 수 있는지 확인한다.
+*        이번 이용의 연장 횟수가 최대 연장 횟수에 이르렀거나, 오늘의 연장 횟수가 하루 최대 연장 횟수에 이르렀거나,
+*        이번 이용에 이미 남은 이용 한도만큼 배정한 경우 연장할 수 없다. 좌석 잠금을 가진 상태에서 호출해야 한다.
+* 입력값 : location(이용중인 좌석번호), 현재 시각 정보 구조체 포인터 *clock, 좌석 정보 구조체 포인터 *libSeats
+* 반환값 : 연장할 수 있는 경우 1, 없는 경우 0
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+int quotaRenewable(int location, ClockContext* clock, SeatsData* libSeats)
+{
+    QuotaCounter usage;
+
+    if (libSeats->maxRenewals > 0 && libSeats->renewCount[location] >= libSeats->maxRenewals)
+    {
+        return 0;
+    }
+    if (libSeats->dailyQuota == 0 && libSeats->dailyRenewals == 0)
+    {
+        return 1;
+    }
+
+    quotaUsage(libSeats->userName[libSeats->seatUser[location]], quotaDay(clock->midnight), &usage, libSeats);
+    if (libSeats->dailyRenewals > 0 && usage.renewals >= libSeats->dailyRenewals)
+    {
+        return 0;
+    }
+
+    return libSeats->dailyQuota == 0
+        || unpackEndTime(libSeats->endTime[location]) - unpackEndTime(libSeats->sessionStart[location]) < (long long int)libSeats->dailyQuota - usage.usedSeconds;
+}
+
+
+/*
+* quotaCharge 함수
+* 기능 : 이용자의 오늘 사용량에 이용 시간과 연장 횟수를 더하고, 바뀐 사용량을 기록한다. 하루 한도가 없으면 아무것도 하지 않는다.
+*        표가 가득 차 이용자를 추가할 수 없는 경우 더하지 않는다. (이 이용자에게는 오늘 한도를 적용하지 않음)
+* 입력값 : *name(이용자명), day(오늘의 날짜 번호), seconds(더할 이용 시간, 초), renewals(더할 연장 횟수), 좌석 정보 구조체 포인터 *libSeats
+* 반환값 없음
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+void quotaCharge(const char* name, unsigned short day, long long int seconds, int renewals, SeatsData* libSeats)
+{
+    char savedName[MAX_NAME_LENGTH] = "";
+    QuotaCounter counter;
+    unsigned char* lock = NULL;
+    unsigned int hash = 0;
+    int slot = -1;
+
+    if ((libSeats->dailyQuota == 0 && libSeats->dailyRenewals == 0) || (seconds <= 0 && renewals <= 0))
+    {
+        return;
+    }
+
+    hash = hashName(name);
+    lock = &libSeats->header->quotaLocks[quotaSegment(hash, libSeats)];
+    spinLock(lock);
+    slot = quotaFind(name, hash, day, 1, libSeats);
+    if (slot >= 0)
+    {
+        // 사용량은 최댓값에서 멈춘다.
+        counter = libSeats->quotaCounter[slot];
+        counter.usedSeconds = seconds > 0 && counter.usedSeconds + seconds < 0xFFFFFFFFLL ? counter.usedSeconds + (unsigned int)seconds : (seconds > 0 ? 0xFFFFFFFFU : counter.usedSeconds);
+        counter.renewals = counter.renewals + renewals < 65535 ? (unsigned short)(counter.renewals + renewals) : 65535;
+        libSeats->quotaCounter[slot] = counter;
+        memcpy(savedName, libSeats->quotaName[slot], MAX_NAME_LENGTH);
+    }
+    spinUnlock(lock);
+
+    // 이용 한도 표 잠금을 푼 후, 바뀐 사용량을 기록한다. (스냅샷 작성은 기록 잠금 -> 이용 한도 표 잠금 순서로 얻는다)
+    if (slot >= 0)
+    {
+        walAppend(libSeats, WAL_QUOTA, 0, counter.renewals, 0, ((long long int)counter.day << 32) | counter.usedSeconds, savedName);
+    }
+
+    return;
+}
+
+
+/*
+* quotaSession 함수
+* 기능 : 끝나는 이용의 시간(배정 시각부터 현재 시각과 이용종료시각 중 이른 시각까지)을 이용자의 오늘 사용량에 더한다.
+*        이용자와 이용종료시각을 지우기 전에 호출해야 하며, 하루 이용 한도가 없으면 아무것도 하지 않는다.
+* 입력값 : location(끝나는 이용의 좌석번호), now(현재 시각), day(오늘의 날짜 번호), 좌석 정보 구조체 포인터 *libSeats
+* 반환값 없음
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+void quotaSession(int location, long long int now, unsigned short day, SeatsData* libSeats)
+{
+    long long int endTime = unpackEndTime(libSeats->endTime[location]);
+
+    if (libSeats->dailyQuota == 0)
+    {
+        return;
+    }
+
+    quotaCharge(libSeats->userName[libSeats->seatUser[location]], day, (endTime < now ? endTime : now) - unpackEndTime(libSeats->sessionStart[location]), 0, libSeats);
+
+    return;
+}
+
+
+/*
+* applyQuota 함수
+* 기능 : 사용량 기록을 적용한다. 기록에는 바뀐 후의 사용량이 있으므로 그대로 저장하며, 오늘이 아닌 날의 기록은 건너뛴다.
+* 입력값 : 기록 구조체 포인터 *record, 좌석 정보 구조체 포인터 *libSeats
+* 반환값 없음
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+void applyQuota(const WalRecord* record, SeatsData* libSeats)
+{
+    char name[MAX_NAME_LENGTH];
+    unsigned short day = (unsigned short)(record->time >> 32);
+    unsigned int hash = 0;
+    unsigned char* lock = NULL;
+    int slot = -1;
+
+    if (libSeats->quotaMask == 0 || day != quotaToday(readClock(libSeats)))
+    {
+        return;
+    }
+
+    memcpy(name, record->name, MAX_NAME_LENGTH);
+    name[MAX_NAME_LENGTH - 1] = '\0';
+
+    hash = hashName(name);
+    lock = &libSeats->header->quotaLocks[quotaSegment(hash, libSeats)];
+    spinLock(lock);
+    slot = quotaFind(name, hash, day, 1, libSeats);
+    if (slot >= 0)
+    {
+        libSeats->quotaCounter[slot].renewals = record->minutes;
+        libSeats->quotaCounter[slot].usedSeconds = (unsigned int)(record->time & 0xFFFFFFFFLL);
+    }
+    spinUnlock(lock);
+
+    return;
+}
+
+
+/*
+* findUser 함수
+* 기능 : 주어진 이름의 이용자가 이용하는 좌석번호(0부터 시작)을 반환함.
+*        반환한 뒤에는 다른 단말기가 좌석을 바꿀 수 있으므로, 좌석을 바꾸는 경우 좌석 잠금을 얻은 후 이용자를 다시 확인한다.
+* 입력값 : *tmpName(찾을 이름이 저장된 문자열의 주소), 좌석 정보 구조체 포인터 *libSeats
+* 반환값 : 해당 이름을 가진 이용자의 좌석번호(0부터 시작). 해당 이용자가 좌석을 배정받지 않은 경우 -1을 반환함.
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+int findUser(char* tmpName, SeatsData* libSeats)
+{
+    int location = -1;
+    unsigned int user = NO_USER;
+
+    // 색인 잠금을 얻은 후 색인을 탐색하고, 이용자가 있는 경우 이용자의 좌석번호를 읽는다.
+    spinLock(&libSeats->header->indexLock);
+    user = indexFind(tmpName, libSeats);
+    if (user != NO_USER)
+    {
+        location = libSeats->userSeat[user];
+    }
+    spinUnlock(&libSeats->header->indexLock);
+
+    return location;
+}
+
+
+/*
+* isFull 함수
+* 기능 : 열람실의 좌석이 이용불가좌석을 제외한 좌석이 만석인지 확인해서 반환함.
+* 입력값 : 좌석 정보 구조체 포인터 *libSeats
+* 반환값 : 열람실이 만석인 경우 1을 반환함. 자리가 있는 경우 0을 반환함.
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+int isFull(SeatsData* libSeats)
+{
+    // 빈 좌석 수가 0인 경우 1, 아닌 경우 0을 반환한다.
+    return __atomic_load_n(&libSeats->header->freeCount, __ATOMIC_RELAXED) == 0;
+}
+
+
+/*
+* leftSeconds 함수
+* 기능 : 열람실의 폐장시각까지 몇 초가 남았는지 찾아서 반환함. 운영 달력에서 여러 날 이어지는 운영 구간은 그 구간의 끝까지 남은 시간이다.
+* 입력값 : 현재 시각 정보 구조체 포인터 *clock
+* 반환값 : 열람실의 폐장시각까지 남은 시간(초)
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+int leftSeconds(ClockContext* clock)
+{
+    if (clock->isAllDay) { return 86401; } // 24시간 운영인 경우, 1일보다 1초 추가된 86401초 반환.
+
+    // 폐장시각까지 남은 초는 현재 운영 구간의 폐장시각(Unix 초) - 현재시각(Unix 초)이다.
+    return (int)(clock->closeTime - clock->now);
+}
+
+
+/*
+* setSeat 함수
+* 기능 : 주어진 좌석번호의 좌석에 주어진 이용자명의 이용자를 배정함. 좌석 잠금을 얻은 후 배정한다.
+*        지금 진행중인 예약이 있는 좌석은 예약한 이용자만 배정받으며(입실), 이용종료시각은 예약 종료시각이다. 입실한 예약은 삭제한다.
+*        그 외의 이용자는 다음 예약의 시작시각까지만 이용할 수 있다. 대기열에서 맡긴 좌석을 배정받는 경우에는 최대 이용 가능 시간까지 이용한다.
+* 입력값 : *tmpName(찾을 이름이 저장된 문자열의 주소), location(0번부터 시작하는 좌석번호), 좌석 정보 구조체 포인터 *libSeats, 시설 정보 구조체 포인터 *libData, 현재 시각 정보 구조체 포인터 *clock
+* 반환값 : 배정한 경우 1, 다른 단말기에서 좌석이 먼저 배정되었거나, 다른 이용자가 예약한 좌석이거나, 이용자가 이미 다른 좌석을 배정받은 경우 0을 반환함.
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+int setSeat(char* tmpName, int location, SeatsData* libSeats, LibraryData* libData, ClockContext* clock)
+{
+    // 폐장시각까지의 남은 시간 계산
+    int leftTime = leftSeconds(clock);
+    int result = 0, isCheckIn = 0;
+    long long int endTime = 0, reserveStart = -1;
+    size_t base = (size_t)location * libSeats->reserveSlots;
+
+    // 오늘의 이용 한도를 모두 쓴 이용자는 배정하지 않는다. 사용량은 이용이 끝날 때 더하므로 좌석 잠금 밖에서 확인한다.
+    int quota = quotaLeft(tmpName, clock, libSeats);
+    if (quota == 0)
+    {
+        return 0;
+    }
+
+    // 좌석 잠금을 얻는다. 같은 좌석을 동시에 배정하려는 단말기 중 하나만 배정된다.
+    spinLock(&libSeats->seatLock[location]);
+
+    // 폐장시각까지의 남은 시간과 최대이용가능시간을 비교한다.
+    // 최대이용가능시간이 남은 시간보다 길면, 이용자에게 최대이용가능시간을 부여하고, 그렇지 않으면 폐장시각까지의 시간을 부여한다.
+    if ((libData->MAX_TIME * 60) > leftTime) // 최대이용가능시간이 남은 시간보다 짧은 경우
+    {
+        // 이용자에게 폐장시각까지의 시간을 부여한다. 종료시각은 현재시각 + 폐장시각까지의 남은 시간이다.
+        endTime = clock->now + leftTime;
+    }else{ // 최대이용가능시간이 남은 시간보다 긴 경우
+
+        // 이용자에게 최대이용가능시간을 부여한다. 최대이용가능시간은 분단위이고, 종료시각은 현재시각 + 최대이용가능시간이다.
+        // 종료시각은 초단위이므로, 분단위인 최대이용가능시각을 초단위로 조정한다.
+        endTime = clock->now + libData->MAX_TIME * 60;
+    }
+
+    // 예약이 있는 좌석인 경우, 끝난 예약을 정리한 후 첫 예약(진행중이거나 다음에 시작하는 예약)을 확인한다.
+    if (libSeats->reserveCount[location] > 0)
+    {
+        pruneReservations(location, clock->now, libSeats);
+        reserveStart = nextReservation(location, clock->now, libSeats);
+    }
+
+    if (reserveStart != -1 && reserveStart <= clock->now) // 진행중인 예약이 있는 경우
+    {
+        // 예약한 이용자만 입실할 수 있다. 이용종료시각은 예약 종료시각이며, 폐장시각을 넘지 않는다.
+        // 대기열에서 맡긴 좌석인 경우, 맡긴 시간이 아닌 최대 이용 가능 시간까지 이용하며, 다음 예약 시작시각을 넘지 않는다.
+        isCheckIn = !strcmp(libSeats->reserveName[base], tmpName);
+        if (isCheckIn && takeClaim(location, tmpName, libSeats))
+        {
+            if (libSeats->reserveCount[location] > 1 && endTime > unpackEndTime(libSeats->reserveStart[base + 1]))
+            {
+                endTime = unpackEndTime(libSeats->reserveStart[base + 1]);
+            }
+
+        }else if (isCheckIn && unpackEndTime(libSeats->reserveEnd[base]) < clock->now + leftTime){
+            endTime = unpackEndTime(libSeats->reserveEnd[base]);
+        }
+
+        // 예약 시작시각까지 이용한 좌석은 이용종료시각이 지나야 자동 퇴실되므로, 예약한 이용자가 입실하면 바로 퇴실 처리한다.
+        if (isCheckIn && libSeats->seatState[location] == SEAT_USED && unpackEndTime(libSeats->endTime[location]) <= clock->now)
+        {
+            checkOut(location, HISTORY_EXPIRED, libSeats);
+        }
+
+    }else if (reserveStart != -1 && endTime > reserveStart){ // 다음 예약이 이용 중에 시작하는 경우, 예약 시작시각까지만 이용할 수 있다.
+        endTime = reserveStart;
+    }
+
+    // 이용종료시각은 남은 이용 한도를 넘지 않는다.
+    if (endTime > clock->now + quota)
+    {
+        endTime = clock->now + quota;
+    }
+
+    if (reserveStart == -1 || reserveStart > clock->now || isCheckIn)
+    {
+        result = occupySeat(tmpName, location, clock->now, endTime, libSeats);
+    }
+
+    // 입실한 예약은 삭제한다.
+    if (result && isCheckIn)
+    {
+        removeReservation(location, 0, libSeats);
+    }
+
+    spinUnlock(&libSeats->seatLock[location]);
+
+    return result;
+}
+
+
+/*
+* occupySeat 함수
+* 기능 : 주어진 좌석번호의 좌석에 주어진 이용자명의 이용자를 주어진 이용종료시각까지 배정함. 좌석 배정과 기록 복구에 함께 이용됨.
+*        좌석 잠금을 얻은 후 호출해야 한다.
+* 입력값 : *name(이용자명), location(0번부터 시작하는 좌석번호), startTime(배정 시각, Unix 초), endTime(이용종료시각, Unix 초), 좌석 정보 구조체 포인터 *libSeats
+* 반환값 : 배정한 경우 1, 빈 좌석이 아니거나 이용자가 이미 다른 좌석을 배정받은 경우 0을 반환함.
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+int occupySeat(const char* name, int location, long long int startTime, long long int endTime, SeatsData* libSeats)
+{
+    RoomData* room = NULL;
+
+    // 다른 단말기에서 먼저 배정한 좌석이거나 이용불가 좌석인 경우 배정하지 않는다.
+    if (libSeats->seatState[location] != SEAT_EMPTY)
+    {
+        return 0;
+    }
+
+    // 같은 이용자가 다른 단말기에서 먼저 배정받은 경우 배정하지 않는다. 확인과 색인 추가는 한 번의 색인 잠금 안에서 진행한다.
+    spinLock(&libSeats->header->indexLock);
+    if (indexFind(name, libSeats) != NO_USER)
+    {
+        spinUnlock(&libSeats->header->indexLock);
+        return 0;
+    }
+
+    // 이용자명 표에 이용자를 추가하고, 지정된 좌석번호에 이용자 번호를 입력함으로써 좌석 배정한다.
+    libSeats->seatUser[location] = internUser(name, location, libSeats);
+    spinUnlock(&libSeats->header->indexLock);
+
+    setSeatState(location, SEAT_USED, libSeats);
+
+    // 이용종료시각을 기록하고, 열람실의 이용종료시각 힙에 좌석을 추가한다.
+    room = roomOf(libSeats, location);
+    spinLock(&room->heapLock);
+    libSeats->endTime[location] = packEndTime(endTime);
+    expiryInsert(location, room, libSeats);
+    spinUnlock(&room->heapLock);
+
+    // 이용 기록에 남길 배정 시각과 연장 횟수를 정한다.
+    libSeats->sessionStart[location] = packEndTime(startTime);
+    libSeats->renewCount[location] = 0;
+
+    // 좌석 배정을 기록한다. 복구할 때 배정 시각을 알 수 있도록 이용종료시각까지의 시간(분)을 함께 기록한다.
+    walAppend(libSeats, WAL_ASSIGN, 0, (unsigned short)((endTime - startTime) / 60 < 65535 ? (endTime - startTime) / 60 : 65535), location, endTime,
+        libSeats->userName[libSeats->seatUser[location]]);
+
+    return 1;
+}
+
+
+/*
+* autoAssign 함수
+* 기능 : 운영시간인 열람실의 빈 좌석 중 번호가 가장 작은 좌석을 이용자에게 배정한다. 열람실을 지정하지 않은 경우, 열람실을 차례대로 확인한다.
+*        열람실마다 최대 이용 가능 시간 동안 예약이 없는 좌석을 먼저 찾고, 없는 경우 지금 예약되지 않은 좌석(다음 예약 시작시각까지 이용)을 찾는다.
+*        찾은 좌석을 다른 단말기가 먼저 배정한 경우 다음 빈 좌석으로 다시 시도하며, 같은 이용자가 다른 단말기에서 먼저 배정받은 경우에는 다시 시도하지 않는다.
+* 입력값 : *name(이용자명), 좌석 정보 구조체 포인터 *libSeats, 열람실 구조체 포인터 *room(NULL이면 모든 열람실), 현재 시각 정보 구조체 포인터 *clock
+* 반환값 : 배정한 좌석번호(0부터 시작). 배정하지 못한 경우 -1을 반환함.
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+int autoAssign(char* name, SeatsData* libSeats, RoomData* room, ClockContext* clock)
+{
+    RoomData* rooms = libSeats->header->rooms;
+    ClockContext roomClock = *clock;
+    long long int until = 0;
+    int location = -1;
+
+    // 오늘의 이용 한도를 모두 쓴 이용자에게는 어느 좌석도 배정할 수 없으므로 찾지 않는다.
+    if (quotaLeft(name, clock, libSeats) == 0)
+    {
+        return -1;
+    }
+
+    for (int i = 0; i < libSeats->header->roomCount; i++)
+    {
+        // 지정한 열람실이 아니거나, 운영시간이 아닌 열람실은 건너뛴다.
+        if (room != NULL && room != &rooms[i])
+        {
+            continue;
+        }
+        setRoomClock(&roomClock, libSeats, &rooms[i]);
+        if (!isOperationTime(&roomClock))
+        {
+            continue;
+        }
+
+        // 배정하면 이용할 수 있는 기간(최대 이용 가능 시간, 폐장시각 이전)
+        until = roomClock.now + rooms[i].libData.MAX_TIME * 60LL;
+        if (!roomClock.isAllDay && until > roomClock.closeTime)
+        {
+            until = roomClock.closeTime;
+        }
+
+        for (int pass = 0; pass < 2; pass++)
+        {
+            while ((location = findOpenSeat(libSeats, &rooms[i], roomClock.now, pass == 0 ? until : roomClock.now + 1)) != -1)
+            {
+                if (setSeat(name, location, libSeats, &rooms[i].libData, &roomClock))
+                {
+                    return location;
+                }
+                if (findUser(name, libSeats) != -1)
+                {
+                    return -1;
+                }
+            }
+        }
+    }
+
+    return -1;
+}
+
+
+/*
+* isRenewable 함수
+* 기능 : 좌석이 연장 가능한지 확인하여 그 결과를 반환한다.
+* 입력값 : location(0번부터 시작하는 좌석번호), 좌석 정보 구조체 포인터 *libSeats, 시설 정보 구조체 포인터 *libData, 현재 시각 정보 구조체 포인터 *clock
+* 반환값 : 연장 가능하면 1을 반환하고, 그렇지 않으면 0을 반환한다.
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+int isRenewable(int location, SeatsData* libSeats, LibraryData* libData, ClockContext* clock)
+{
+    long long int reserveStart = -1;
+
+    // 종료시각이 현재 운영일의 폐장시각 이후인 경우(이미 폐장시각까지 이용하는 경우), 연장이 불가능하다.
+    // 24시간제의 경우, 폐장시각으로 인해 연장 불가능한 경우가 없다.
+    if (!clock->isAllDay && unpackEndTime(libSeats->endTime[location]) >= clock->closeTime)
+    {
+        return 0;
+    }
+
+    // 이용종료시각에 다음 예약이 시작하는 경우, 연장이 불가능하다.
+    reserveStart = nextReservation(location, clock->now, libSeats);
+    if (reserveStart != -1 && unpackEndTime(libSeats->endTime[location]) >= reserveStart)
+    {
+        return 0;
+    }
+
+    // 종료시각까지의 남은 시간이 초 단위로 환산한 연장가능시간 이하이고, 연장 횟수와 이용 한도가 남은 경우에는 연장이 가능함을 반환한다.
+    // 연장가능시간은 종료시각에서 현재시각까지의 차이가 어느 정도 미만이어야 연장이 가능한지를 나타내는 시간이다.
+    return unpackEndTime(libSeats->endTime[location]) - clock->now <= libData->MAX_RENEWABLE_TIME * 60
+        && quotaRenewable(location, clock, libSeats);
+}
+
+
+/*
+* renewSeat 함수
+* 기능 : 주어진 좌석번호의 좌석의 이용시간을 연장함. 연장 가능 여부의 경우, 본 함수 호출 전 확인한다고 가정함. 좌석 잠금을 얻은 후 호출해야 한다.
+*        다음 예약이 있는 경우 예약 시작시각까지만, 하루 이용 한도가 있는 경우 남은 이용 한도까지만 연장한다.
+* 입력값 : location(0번부터 시작하는 좌석번호), 좌석 정보 구조체 포인터 *libSeats, 시설 정보 구조체 포인터 *libData, 현재 시각 정보 구조체 포인터 *clock
+* 반환값 없음
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+void renewSeat(int location, SeatsData* libSeats, LibraryData* libData, ClockContext* clock)
+{
+    // 현재 시각 기준 폐장까지 남은 시간을 저장하는 변수 선언 및 남은 시간을 저장
+    int leftTime = leftSeconds(clock);
+    long long int endTime = 0;
+    long long int reserveStart = nextReservation(location, clock->now, libSeats);
+    RoomData* room = roomOf(libSeats, location);
+    const char* userName = libSeats->userName[libSeats->seatUser[location]];
+
+    // 이번 이용은 배정 시각부터 남은 이용 한도만큼까지 이용할 수 있다. 이용 한도 표 잠금은 힙 잠금 밖에서 얻는다.
+    long long int quotaEnd = unpackEndTime(libSeats->sessionStart[location]) + quotaLeft(userName, clock, libSeats);
+
+    // 이용종료시각 열은 열람실의 힙 잠금으로 보호된다.
+    spinLock(&room->heapLock);
+    endTime = unpackEndTime(libSeats->endTime[location]);
+
+    // 개인별 종료 시각(Unix 초) - 현재 시각(Unix 초) + 연장 시간(초) > 남은 시간(초) 인 경우, 폐장시각까지의 시간을 부여
+    if ((endTime - clock->now + (libData->MAX_TIME * 60)) > leftTime)
+    {
+        // 이용자에게 폐장시각까지의 시간을 부여
+        endTime = clock->now + leftTime;
+
+    }else{
+        // 이용자에게 기존 이용시간에 기본 이용시간을 추가하여 시간 부여
+        // 최대이용시간은 분단위 시간이지만, 종료시각은 초단위 시각을 저장하므로, 분단위 시간을 초단위 시간으로 변경하여 저장
+        // 이용종료시각 열에는 기준 시각부터의 초를 저장하므로 날짜가 바뀌어서 생기는 문제는 없음
+        endTime += libData->MAX_TIME * 60;
+    }
+
+    // 다음 예약이 연장한 이용 중에 시작하는 경우, 예약 시작시각까지만 연장한다. 배정과 예약이 겹치지 않으므로 기존 이용종료시각보다 앞당겨지지는 않는다.
+    if (reserveStart != -1 && endTime > reserveStart)
+    {
+        endTime = reserveStart;
+    }
+
+    // 연장한 이용종료시각은 남은 이용 한도를 넘지 않는다.
+    if (endTime > quotaEnd)
+    {
+        endTime = quotaEnd;
+    }
+
+    // 바뀐 이용종료시각에 맞게 힙 안에서의 위치를 조정한다.
+    libSeats->endTime[location] = packEndTime(endTime);
+    expiryUpdate(location, room, libSeats);
+    spinUnlock(&room->heapLock);
+
+    // 연장 횟수를 늘리고, 좌석 연장을 기록한다.
+    libSeats->renewCount[location] += libSeats->renewCount[location] < 255;
+    walLog(libSeats, WAL_RENEW, 0, location, endTime, NULL);
+
+    // 오늘의 연장 횟수를 늘린다.
+    quotaCharge(userName, quotaDay(clock->midnight), 0, 1, libSeats);
+
+    return;
+}
+
+
+/*
+* checkOut 함수
+* 기능 : 주어진 좌석번호의 좌석을 퇴실 처리함. 이용 기록을 남기는 경우 끝난 이용을 남긴다. 좌석 잠금을 얻은 후 호출해야 한다.
+* 입력값 : location(0번부터 시작하는 좌석번호), reason(이용 기록에 남길 종료 사유, HISTORY_CHECKOUT 등), 좌석 정보 구조체 포인터 *libSeats
+* 반환값 없음
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+void checkOut(int location, int reason, SeatsData* libSeats)
+{
+    RoomData* room = roomOf(libSeats, location);
+
+    // 이용 기록을 남기는 경우, 이용자와 이용종료시각을 지우기 전에 끝나는 이용을 남긴다.
+    if (libSeats->history != NULL)
+    {
+        historyRecord(location, reason, readClock(libSeats), libSeats);
+    }
+
+    // 하루 이용 한도가 있는 경우, 끝나는 이용의 시간을 이용자의 오늘 사용량에 더한다.
+    if (libSeats->dailyQuota > 0)
+    {
+        long long int now = readClock(libSeats);
+        quotaSession(location, now, quotaToday(now), libSeats);
+    }
+
+    // 이용자명 표와 색인에서 이용자를 삭제한 후, 주어진 좌석의 이용자 번호를 초기화함
+    spinLock(&libSeats->header->indexLock);
+    releaseUser(libSeats->seatUser[location], libSeats);
+    libSeats->seatUser[location] = NO_USER;
+    spinUnlock(&libSeats->header->indexLock);
+
+    // 열람실의 이용종료시각 힙에서 좌석을 삭제한 후, 주어진 좌석의 종료시각을 초기화함
+    spinLock(&room->heapLock);
+    expiryRemove(location, room, libSeats);
+    libSeats->endTime[location] = 0;
+    spinUnlock(&room->heapLock);
+
+    // 정리가 끝난 후 좌석 상태를 이용가능상태로 바꾼다. 이 시점부터 다른 단말기가 좌석을 배정할 수 있다.
+    setSeatState(location, SEAT_EMPTY, libSeats);
+
+    // 퇴실을 기록한다.
+    walLog(libSeats, WAL_CHECKOUT, 0, location, 0, NULL);
+
+    return;
+}
+
+
+/*
+* seatSelector 함수
+* 기능 : 좌석 배정 시스템을 실행함. 좌석의 배정, 연장은 좌석이 속한 열람실의 운영정보와 운영시간을 따른다.
+* 입력값 : *tmpName(찾을 이름이 저장된 문자열의 주소), 좌석 정보 구조체 포인터 *libSeats, 현재 시각 정보 구조체 포인터 *clock, 운영 지표 구조체 포인터 *metrics(모으지 않는 경우 NULL)
+* 반환값 없음
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+void seatSelector(char* tmpName, SeatsData* libSeats, ClockContext* clock, MetricsData* metrics)
+{
+    /*
+    * 변수 선언
+    * 
+    * tmpSeatNo : 수정할 좌석 번호를 임시로 저장함
+    * isRenewableRes : 연장 가능 여부를 임시로 저장함
+    * tmpMenu : 연장, 퇴실, 취소 메뉴 선택값을 임시로 저장함
+    * room, roomClock : 좌석이 속한 열람실과, 그 열람실의 운영시간으로 계산한 현재 시각 정보
+    * position, deadline : 대기 순번과, 대기열에서 맡긴 좌석을 배정받아야 하는 시각
+    * minInput : 좌석번호 입력값(0부터 시작하는 좌석번호로 바꾼 값)의 최솟값. 좌석 배치가 있으면 좌석 추천(-3)까지 받는다.
+    */
+    int tmpSeatNo = -1, isRenewableRes = 0, tmpMenu = 0, position = 0;
+    int minInput = libSeats->layout != NULL ? -3 : -2;
+    long long int deadline = 0;
+    RoomData* room = NULL;
+    ClockContext roomClock = *clock;
+
+    // location 변수를 선언하고, 주어진 이용자명의 이용자가 사용하는 좌석번호를 가져옴.
+    int location = findUser(tmpName, libSeats);
+
+    // 새로운 이용자와 기존 이용자를 구분함
+    if (location == -1) // 이용자 좌석의 위치가 -1, 즉 새로운 이용자인 경우
+    {
+        // 대기열에서 이용자에게 맡겨 둔 좌석이 있는 경우, 좌석과 배정받아야 하는 시각을 알린다.
+        deadline = findClaim(tmpName, clock->now, &tmpSeatNo, libSeats);
+        if (deadline)
+        {
+            deadline = (deadline - clock->midnight) % (24 * 60 * 60);
+            printf("대기 차례가 되어 %d번 좌석을 %d시 %d분 %d초까지 맡겨 두었습니다. 해당 좌석을 선택해주세요.\n", tmpSeatNo + 1,
+                (int)(deadline / 3600), (int)((deadline % 3600) / 60), (int)(deadline % 60));
+        }
+
+        // 오늘의 이용 한도를 모두 쓴 경우, 배정하지 않고 함수를 종료함.
+        if (quotaLeft(tmpName, clock, libSeats) == 0)
+        {
+            printf("오늘의 이용 한도(%d분)를 모두 사용하였습니다.\n", libSeats->dailyQuota / 60);
+            return;
+        }
+
+        // 좌석이 만석인 경우, 대기열 등록 여부를 물은 후 함수를 종료함.
+        if (isFull(libSeats))
+        {
+            metricCount(metrics, METRIC_FULL, 1);
+            printf("만석입니다.\n대기열에 등록하시겠습니까? (1 : 등록, 그 외 : 취소) : ");
+            if (scanf("%d", &tmpMenu) == 1 && tmpMenu == 1)
+            {
+                position = joinWaitList(tmpName, 0, 0, -1, libSeats);
+                if (position)
+                {
+                    printf("대기 순번 %d번으로 등록되었습니다. 차례가 되면 좌석을 %d분 동안 맡겨 둡니다.\n", position, WAIT_CLAIM_TIME);
+                }else{
+                    printf("대기열이 가득 찼습니다.\n");
+                }
+            }
+            return;
+        }
+
+        // 좌석이 있는 경우, 열람실이 여러 개이면 열람실 목록을 출력한 후 이용자용 좌석 상태 목록(또는 격자)을 출력함
+        if (libSeats->header->roomCount > 1)
+        {
+            printRooms(libSeats, clock);
+        }
+        printSeatMap(libSeats, 0);
+        
+        // 무한 루프. 이용가능한 좌석이 입력될때까지 반복한다.
+        while (1)
+        {
+            do {
+                // 1부터 시작하는 좌석번호를 입력받는다. 좌석 배치가 있는 경우 좌석 추천을 함께 안내한다.
+                if (libSeats->layout != NULL)
+                {
+                    printf("좌석 번호 선택(취소 : 0, 자동 배정 : -1, 좌석 추천 : -2) : ");
+                }else{
+                    printf("좌석 번호 선택(취소 : 0, 자동 배정 : -1) : ");
+                }
+                scanf("%d", &tmpSeatNo);
+
+                // 입력받은 1부터 시작하는 좌석번호를 0부터 시작하는 좌석번호로 바꾼다.
+                tmpSeatNo--;
+
+                // 입력받은 좌석번호가 -1(자동 배정)(좌석 배치가 있는 경우 -2(좌석 추천))과 좌석 수(가장 마지막 좌석 번호) 범위를 벗어난 경우, 잘못된 값을 입력받았다고 출력한다.
+                if (tmpSeatNo < minInput || tmpSeatNo >= libSeats->seatCount)
+                {
+                    printf("잘못된 값을 입력하였습니다.\n");
+                }
+
+            } while (tmpSeatNo < minInput || tmpSeatNo >= libSeats->seatCount); // 옳은 입력값을 입력받을때까지 반복
+
+            if (tmpSeatNo == -3) // -2를 입력받은 경우(-2 - 1 = -3), 조건에 맞는 가까운 빈 좌석을 추천한 후 다시 좌석번호를 입력받는다.
+            {
+                printSuggestions(libSeats, clock);
+                continue;
+            }
+
+            if (tmpSeatNo == -1) // 0을 입력받은 경우(0 - 1 = -1), 좌석 배정 과정을 취소한다.
+            {
+                printf("좌석 선택을 취소하였습니다.\n");
+                return;
+            }
+
+            if (tmpSeatNo == -2) // -1을 입력받은 경우(-1 - 1 = -2), 운영시간인 열람실의 빈 좌석 중 번호가 가장 작은 좌석을 배정한다.
+            {
+                tmpSeatNo = autoAssign(tmpName, libSeats, NULL, clock);
+
+                if (tmpSeatNo == -1)
+                {
+                    printf("좌석을 배정하지 못했습니다.\n");
+                    return;
+                }
+
+                metricCount(metrics, METRIC_ASSIGN, 1);
+                printf("%d번 좌석이 자동 배정되었습니다.\n", tmpSeatNo + 1);
+                break;
+            }
+
+            // 선택한 좌석이 속한 열람실의 운영시간으로 현재 시각 정보를 다시 계산한다.
+            room = roomOf(libSeats, tmpSeatNo);
+            setRoomClock(&roomClock, libSeats, room);
+
+            // 운영시간이 아닌 열람실의 좌석이거나, 이용중인 좌석이거나 이용불가 좌석인지 좌석 상태 열을 통해 확인한다.
+            if (!isOperationTime(&roomClock)) // 운영시간인 열람실의 좌석인지 확인한다.
+            {
+                printf("운영시간이 아닌 열람실의 좌석입니다.\n다른 좌석을 선택해주세요.\n");
+
+            }else if (libSeats->seatState[tmpSeatNo] == SEAT_USED){ // 이용중인 좌석인지 확인한다.
+                printf("이미 이용중인 좌석입니다.\n다른 좌석을 선택해주세요.\n");
+
+            }else if (libSeats->seatState[tmpSeatNo] == SEAT_UNAVAILABLE){ // 이용불가 좌석인지 확인한다.
+                printf("이용불가 좌석입니다.\n다른 좌석을 선택하세요.\n");
+
+            }else if (setSeat(tmpName, tmpSeatNo, libSeats, &room->libData, &roomClock)){ // 이용가능 좌석의 경우, 선택한 좌석을 이용자에게 배정한 후 해당 무한루프를 빠져나간다.
+                metricCount(metrics, METRIC_ASSIGN, 1);
+                break;
+
+            }else if (findUser(tmpName, libSeats) != -1){ // 같은 이용자가 다른 단말기에서 먼저 배정받은 경우
+                printf("이미 좌석을 배정받은 이용자입니다.\n");
+                return;
+
+            }else if (isReserved(tmpSeatNo, roomClock.now, roomClock.now + 1, libSeats)){ // 다른 이용자가 예약한 시간인 경우
+                printf("예약된 좌석입니다.\n다른 좌석을 선택해주세요.\n");
+
+            }else{ // 다른 단말기에서 좌석이 먼저 배정된 경우
+                printf("방금 다른 이용자에게 배정된 좌석입니다.\n다른 좌석을 선택해주세요.\n");
+            }
+        }
+
+        // 배정한 좌석이 속한 열람실의 운영정보로 연장가능시각과 이용종료시각을 출력한다.
+        room = roomOf(libSeats, tmpSeatNo);
+        setRoomClock(&roomClock, libSeats, room);
+        printRenewTime(tmpSeatNo, libSeats, &room->libData, &roomClock);
+        printEndTime(tmpSeatNo, libSeats, &roomClock);
+
+    }else{ // 이용자 좌석의 위치가 -1이 아님. 즉 기존 이용자인 경우
+
+        // 이용자의 좌석이 속한 열람실의 운영시간으로 현재 시각 정보를 다시 계산한다.
+        room = roomOf(libSeats, location);
+        setRoomClock(&roomClock, libSeats, room);
+
+        // 연장 가능여부를 isRenewableRes 변수에 저장한다.
+        isRenewableRes = isRenewable(location, libSeats, &room->libData, &roomClock);
+
+        // 좌석번호와 연장가능시각, 이용종료시각을 출력한다.
+        printf("%d번 좌석\n", location + 1);
+        printRenewTime(location, libSeats, &room->libData, &roomClock);
+        printEndTime(location, libSeats, &roomClock);
+
+        // 무한 루프, 옳은 입력값이 입력될때까지 반복한다.
+        while (1)
+        {
+            // 연장이 가능한 경우, 연장 메뉴를 활성화한다.
+            if (isRenewableRes)
+            {
+                printf("연장 : 1, ");
+            }
+
+            // 퇴실 및 취소 메뉴를 출력하며, 입력값을 입력받아 tmpMenu 변수에 저장한다.
+            printf("퇴실 : 2, 취소 : 3. : ");
+            scanf("%d", &tmpMenu);
+
+            // 옳은 입력값이 입력된 경우, 무한루프를 빠져나간다. 그렇지 않으면, 다시 입력해 달라는 내용을 출력한다.
+            // 좌석 연장 메뉴의 경우, 좌석 연장이 가능한 상태에서만 옳은 입력값으로 인정된다.
+            if ((tmpMenu == 1 && isRenewableRes) || tmpMenu == 2 || tmpMenu == 3) // 옳은 입력값이 입력된 경우
+            {
+                // 무한루프를 빠져나간다.
+                break;
+
+            }else{ // 옳지 않은 입력값이 입력된 경우
+
+                // 다시 입력해달라는 내용을 출력한다.
+                printf("다시 입력해 주세요.\n");
+            }
+        }
+
+        // 이용자의 좌석정보를 tmpSeatNo 변수에 저장한다. 좌석정보는 위에서 이미 찾았으므로, 다시 찾지 않는다.
+        tmpSeatNo = location;
+
+        // 취소 명령인 경우, 함수를 종료한다.
+        if (tmpMenu == 3)
+        {
+            return;
+        }
+
+        // 메뉴를 고르는 동안 다른 단말기에서 퇴실 처리되었을 수 있으므로, 좌석 잠금을 얻은 후 이용자를 다시 확인한다.
+        spinLock(&libSeats->seatLock[tmpSeatNo]);
+        if (libSeats->seatState[tmpSeatNo] != SEAT_USED || strcmp(libSeats->userName[libSeats->seatUser[tmpSeatNo]], tmpName))
+        {
+            spinUnlock(&libSeats->seatLock[tmpSeatNo]);
+            printf("이미 퇴실 처리된 좌석입니다.\n");
+            return;
+        }
+
+        // tmpMenu의 입력값에 따라 연장, 퇴실 명령을 수행한다.
+        switch (tmpMenu)
+        {
+            // 연장
+        case 1:
+            // 그 사이 다른 단말기에서 먼저 연장한 경우가 아니라면, 이용자의 좌석번호에 대한 좌석연장을 처리한다.
+            if (isRenewable(tmpSeatNo, libSeats, &room->libData, &roomClock))
+            {
+                renewSeat(tmpSeatNo, libSeats, &room->libData, &roomClock);
+                metricCount(metrics, METRIC_RENEW, 1);
+            }
+
+            break;
+
+            // 반납
+        case 2:
+            // 이용자의 좌석번호에 대한 좌석반납을 처리한 후, 빈 좌석을 대기열의 차례인 이용자에게 맡긴다.
+            checkOut(tmpSeatNo, HISTORY_CHECKOUT, libSeats);
+            handOffSeat(tmpSeatNo, libSeats);
+            metricCount(metrics, METRIC_CHECKOUT, 1);
+
+            break;
+        }
+        spinUnlock(&libSeats->seatLock[tmpSeatNo]);
+
+        // 연장한 경우, 변경된 좌석의 연장가능시각, 종료시각를 출력한다.
+        if (tmpMenu == 1)
+        {
+            printRenewTime(tmpSeatNo, libSeats, &room->libData, &roomClock);
+            printEndTime(tmpSeatNo, libSeats, &roomClock);
+        }
+    }
+    return;
+}
+
+
+/*
+* seatInvalidCheck 함수
+* 기능 : 열람실의 좌석이 만료된 경우, 좌석 지정을 해제함. 해제한 좌석은 대기열의 차례인 이용자에게 맡긴다.
+* 입력값 : 좌석 정보 구조체 포인터 *libSeats, 열람실 구조체 포인터 *room, 현재 시각 정보 구조체 포인터 *clock
+* 반환값 : 퇴실 처리한 좌석 수
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+int seatInvalidCheck(SeatsData* libSeats, RoomData* room, ClockContext* clock)
+{
+    int* heap = libSeats->expiryHeap + room->firstSeat;
+    int location = 0, expired = 0;
+    unsigned int now = packEndTime(clock->now); // 이용종료시각 열과 비교할 현재 시각
+
+    // 열람실 이용종료시각 힙의 루트는 가장 먼저 끝나는 좌석이므로, 루트의 종료시각이 현재시각 이전인 동안만 반복함
+    // 따라서 만료된 좌석이 없으면 좌석을 하나도 순회하지 않음
+    // Unix 시간 기준이므로, 다음날 구분은 자동으로 가능함
+    while (1)
+    {
+        // 힙 잠금을 얻은 후 루트를 확인한다. 잠금 순서(좌석 -> 힙)를 지키기 위해, 좌석 잠금을 얻기 전에 힙 잠금을 푼다.
+        spinLock(&room->heapLock);
+        if (room->heapSize == 0 || libSeats->endTime[heap[0]] >= now)
+        {
+            spinUnlock(&room->heapLock);
+            break;
+        }
+        location = heap[0];
+        spinUnlock(&room->heapLock);
+
+        // 해당 좌석을 퇴실 처리함. 퇴실 처리 시 힙에서 삭제되므로, 다음으로 끝나는 좌석이 루트가 됨
+        // 그 사이 다른 단말기가 먼저 퇴실 처리하거나 연장한 경우에는 퇴실 처리하지 않는다.
+        spinLock(&libSeats->seatLock[location]);
+        if (libSeats->seatState[location] == SEAT_USED && libSeats->endTime[location] < now)
+        {
+            checkOut(location, HISTORY_EXPIRED, libSeats);
+            handOffSeat(location, libSeats);
+            expired++;
+        }
+        spinUnlock(&libSeats->seatLock[location]);
+    }
+
+    return expired;
+}
+
+
+/*
+* expireSeats 함수
+* 기능 : 열람실마다 이용종료시각이 지난 좌석을 퇴실 처리하고, 열람실의 폐장시각이 지난 경우 그 열람실의 이용불가 좌석을 제외한 모든 좌석을 초기화한다.
+*        요청을 처리하기 전에 호출하여, 요청이 최신 정보를 이용하게 한다. 각 열람실은 자신의 힙과 좌석 범위만 확인한다.
+*        마지막으로 대기열을 확인하여, 배정받지 않은 맡긴 좌석을 다음 이용자에게 넘긴다.
+* 입력값 : 좌석 정보 구조체 포인터 *libSeats, 현재 시각 정보 구조체 포인터 *clock(어느 열람실의 것이어도 됨), 운영 지표 구조체 포인터 *metrics(모으지 않는 경우 NULL)
+* 반환값 없음
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+void expireSeats(SeatsData* libSeats, ClockContext* clock, MetricsData* metrics)
+{
+    long long int start = metricsNow(metrics);
+    ClockContext roomClock = *clock;
+    RoomData* room = NULL;
+
+    for (int i = 0; i < libSeats->header->roomCount; i++)
+    {
+        // 열람실의 운영시간으로 현재 시각 정보를 다시 계산한다.
+        room = &libSeats->header->rooms[i];
+        setRoomClock(&roomClock, libSeats, room);
+
+        // 시간 만료되면 자동 퇴실 처리한다.
+        metricCount(metrics, METRIC_EXPIRE, seatInvalidCheck(libSeats, room, &roomClock));
+
+        // 폐장시각이 지난 경우, 열람실의 좌석을 초기화한다. 이용불가 좌석에 대해서는 초기화를 진행하지 않는다.
+        // 24시간제의 경우, 해당사항이 없으므로 자동 퇴실 처리를 진행하지 않는다.
+        // 초기화는 열람실 모든 좌석의 잠금을 얻으므로, 이용중인 좌석이 남아있는 경우에만 진행한다.
+        if (!roomClock.isAllDay && !isOperationTime(&roomClock) && __atomic_load_n(&room->heapSize, __ATOMIC_RELAXED) > 0)
+        {
+            metricCount(metrics, METRIC_CLOSING_SEATS, resetSeats(libSeats, room, 0, HISTORY_CLOSED));
+            metricCount(metrics, METRIC_CLOSING_RESET, 1);
+        }
+    }
+
+    // 시작시각이나 종료시각이 된 이용불가 시간대를 처리한다. 예약된 시간대가 없으면 바로 끝난다.
+    runBlackouts(libSeats, clock->now);
+
+    // 대기열을 확인한다. 기다리는 이용자와 맡긴 좌석이 없으면 바로 끝난다.
+    serveWaitList(libSeats, clock);
+
+    metricLatency(metrics, METRIC_OP_EXPIRE, start);
+
+    return;
+}
+
+
+/*
+* isOperationTime 함수
+* 기능 : 현재시각이 운영시간 내인지의 여부를 반환한다. 시각 정보를 만들 때 현재 운영 구간을 이미 찾았으므로, 구간과 비교만 한다.
+* 입력값 : 현재 시각 정보 구조체 포인터 *clock
+* 반환값 : 운영시간 내인 경우 1을, 아닌 경우 0을 반환한다.
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+int isOperationTime(ClockContext* clock)
+{
+    // 24시간 운영이거나, 현재시각이 현재 운영 구간의 개장시각 이후이면서 폐장시각 이전인 경우 운영시간 내에 해당한다.
+    return clock->isAllDay || (clock->openTime <= clock->now && clock->now < clock->closeTime);
+}
+
+/*
+* recordChecksum 함수
+* 기능 : 기록의 검사합(checksum 필드를 제외한 나머지 바이트의 FNV-1a 해시값)을 계산한다.
+* 입력값 : 기록 구조체 포인터 *record
+* 반환값 : 검사합
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+unsigned int recordChecksum(const WalRecord* record)
+{
+    const unsigned char* bytes = (const unsigned char*)record;
+    unsigned int hash = 2166136261u;
+
+    // checksum 필드 다음 바이트부터 끝까지 반복
+    for (size_t i = sizeof(record->checksum); i < sizeof(WalRecord); i++)
+    {
+        hash ^= bytes[i];
+        hash *= 16777619u;
+    }
+
+    return hash;
+}
+
+
+/*
+* walLog 함수
+* 기능 : 좌석 상태 변경 기록을 버퍼에 추가한다. 예약 시간이 없는 기록은 모두 이 함수로 추가한다.
+* 입력값 : 좌석 정보 구조체 포인터 *libSeats, type(기록 종류), state(좌석 상태 또는 최초 실행 여부), location(좌석번호), time(시각), *name(이용자명 영역에 저장할 값, 없으면 NULL)
+* 반환값 없음
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+void walLog(SeatsData* libSeats, unsigned char type, unsigned char state, int location, long long int time, const char* name)
+{
+    walAppend(libSeats, type, state, 0, location, time, name);
+
+    return;
+}
+
+
+/*
+* walAppend 함수
+* 기능 : 기록 하나를 버퍼에 추가한다. 버퍼가 가득 찬 경우 파일에 쓴다. 기록하지 않는 경우 아무것도 하지 않는다.
+*        시각(초)이 바뀐 후의 첫 기록 앞에는 시각 표시(WAL_MARK)를 남기므로, 기록마다 시각을 저장하지 않아도 지난 시각의 좌석 정보를 복원할 수 있다.
+* 입력값 : 좌석 정보 구조체 포인터 *libSeats, type(기록 종류), state(좌석 상태 또는 최초 실행 여부), minutes(예약 시간(분), 없으면 0), location(좌석번호), time(시각),
+*          *name(이용자명 영역에 저장할 값, 없으면 NULL)
+* 반환값 없음
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+void walAppend(SeatsData* libSeats, unsigned char type, unsigned char state, unsigned short minutes, int location, long long int time, const char* name)
+{
+    WalData* wal = libSeats->wal;
+    WalRecord* record = NULL;
+    long long int now = 0;
+
+    // 기록하지 않는 경우(기록 복구 중 포함) 함수 종료
+    if (wal == NULL) { return; }
+
+    pthread_mutex_lock(&wal->lock);
+
+    // 시각이 바뀐 경우, 먼저 시각 표시를 남긴다. 잠금 안에서 시각을 읽으므로 시각 표시는 파일 안에서 시간순이다.
+    if (type != WAL_MARK)
+    {
+        now = readClock(libSeats);
+        if (now != wal->lastMark)
+        {
+            wal->lastMark = now;
+            walAppend(libSeats, WAL_MARK, 0, 0, 0, now, NULL);
+        }
+    }
+
+    // 버퍼가 가득 찬 경우, 먼저 파일에 쓴다.
+    if (wal->bufferCount == WAL_BUFFER_RECORDS)
+    {
+        walFlush(wal);
+    }
+
+    // 버퍼의 다음 칸에 기록을 작성한다. 이용자명 영역은 운영정보를 담기도 하므로 그대로 복사한다.
+    record = &wal->buffer[wal->bufferCount++];
+    memset(record, 0, sizeof(WalRecord));
+    record->type = type;
+    record->state = state;
+    record->minutes = minutes;
+    record->location = location;
+    record->time = time;
+    if (name != NULL)
+    {
+        memcpy(record->name, name, MAX_NAME_LENGTH);
+    }
+    record->checksum = recordChecksum(record);
+    wal->sinceSnapshot++;
+
+    pthread_mutex_unlock(&wal->lock);
+
+    return;
+}
+
+
+/*
+* walLogLibrary 함수
+* 기능 : 열람실 운영정보 변경 기록을 추가한다. 운영정보 4개(16바이트)는 기록의 이용자명 영역(20바이트)에, 열람실 번호는 좌석번호 자리에 저장한다.
+* 입력값 : 좌석 정보 구조체 포인터 *libSeats, 열람실 구조체 포인터 *room
+* 반환값 없음
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+void walLogLibrary(SeatsData* libSeats, RoomData* room)
+{
+    char data[MAX_NAME_LENGTH] = "";
+
+    memcpy(data, &room->libData, sizeof(LibraryData));
+    walLog(libSeats, WAL_LIBRARY, 0, (int)(room - libSeats->header->rooms), 0, data);
+
+    return;
+}
+
+
+/*
+* walFlush 함수
+* 기능 : 버퍼에 모인 기록을 기록 파일의 끝에 쓴다. 디스크 확정(fsync)은 하지 않는다.
+* 입력값 : 기록 파일 정보 구조체 포인터 *wal
+* 반환값 : 성공한 경우 1, 실패한 경우 0을 반환함.
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+int walFlush(WalData* wal)
+{
+    const char* data = (const char*)wal->buffer;
+    size_t left = sizeof(WalRecord) * wal->bufferCount;
+    ssize_t written = 0;
+
+    // 모든 기록을 쓸 때까지 반복
+    while (left > 0)
+    {
+        written = write(wal->fd, data, left);
+        if (written < 0)
+        {
+            // 쓰지 못한 기록은 버린다. 버퍼를 비우지 않으면 이후의 기록을 담을 수 없다.
+            printf("기록 파일 %s에 쓸 수 없습니다.\n", wal->walPath);
+            wal->bufferCount = 0;
+            return 0;
+        }
+        data += written;
+        left -= written;
+        wal->needSync = 1;
+    }
+
+    wal->bufferCount = 0;
+
+    return 1;
+}
+
+
+/*
+* walCommit 함수
+* 기능 : 지금까지의 기록을 파일에 쓰고 디스크에 확정(fsync)한다. 기록이 많이 쌓였거나 마지막 스냅샷 후 CHECKPOINT_INTERVAL이 지난 경우 스냅샷을 만든다.
+*        여러 작업 스레드가 동시에 호출한 경우, 먼저 잠금을 얻은 스레드가 다른 스레드의 기록까지 한 번에 확정하므로 나머지 스레드는 바로 끝난다.
+* 입력값 : 좌석 정보 구조체 포인터 *libSeats
+* 반환값 없음
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+void walCommit(SeatsData* libSeats)
+{
+    WalData* wal = libSeats->wal;
+
+    // 기록하지 않는 경우 함수 종료
+    if (wal == NULL) { return; }
+
+    pthread_mutex_lock(&wal->lock);
+
+    // 버퍼의 기록을 쓰고, 디스크에 확정한다. 다른 스레드가 이미 확정한 경우에는 확정할 기록이 없다.
+    if (wal->bufferCount > 0)
+    {
+        walFlush(wal);
+    }
+    if (wal->needSync)
+    {
+        fsync(wal->fd);
+        wal->needSync = 0;
+    }
+
+    // 기록이 많이 쌓인 경우, 스냅샷을 만들어 복구 시 적용할 기록의 수를 줄인다.
+    // 기록이 적더라도 일정 시간마다 스냅샷을 만들어, 지난 시각의 복원이 하루 전체의 기록을 적용하지 않도록 한다.
+    if (wal->sinceSnapshot >= SNAPSHOT_RECORDS || (wal->sinceSnapshot > 0 && wal->lastMark - wal->snapshotTime >= CHECKPOINT_INTERVAL))
+    {
+        writeSnapshot(libSeats);
+    }
+
+    pthread_mutex_unlock(&wal->lock);
+
+    return;
+}
+
+
+/*
+* walApply 함수
+* 기능 : 기록 하나를 좌석 정보와 열람실 운영정보에 적용한다. 기록 복구 시 이용되며, 이때 libSeats->wal은 NULL이어야 한다.
+* 입력값 : 기록 구조체 포인터 *record, 좌석 정보 구조체 포인터 *libSeats
+* 반환값 없음
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+void walApply(const WalRecord* record, SeatsData* libSeats)
+{
+    int location = record->location;
+    RoomData* room = NULL;
+
+    // 좌석 하나에 대한 기록은 좌석번호를, 열람실에 대한 기록은 열람실 번호를 저장한다.
+    int isSeatRecord = (record->type >= WAL_ASSIGN && record->type <= WAL_SEAT_STATE) || record->type == WAL_RESERVE || record->type == WAL_CANCEL;
+    int slot = 0;
+
+    // 좌석 수나 열람실 수가 줄어든 경우, 없는 좌석이나 열람실에 대한 기록은 건너뛴다.
+    if (location < 0 || location >= (isSeatRecord ? libSeats->seatCount : libSeats->header->roomCount)) { return; }
+    room = isSeatRecord ? roomOf(libSeats, location) : &libSeats->header->rooms[location];
+
+    // 좌석 하나에 대한 기록은 해당 좌석의 잠금을 얻은 후 적용한다.
+    if (isSeatRecord)
+    {
+        spinLock(&libSeats->seatLock[location]);
+    }
+
+    switch (record->type)
+    {
+    case WAL_ASSIGN: // 좌석 배정. 기존 이용자가 있는 경우 먼저 퇴실 처리한다. 배정 시각은 분 단위로 기록되어 있다.
+        if (libSeats->seatState[location] == SEAT_USED)
+        {
+            checkOut(location, HISTORY_CHECKOUT, libSeats);
+        }
+        if (occupySeat(record->name, location, record->time - record->minutes * 60LL, record->time, libSeats))
+        {
+            libSeats->renewCount[location] = record->state;
+        }
+        break;
+
+    case WAL_RENEW: // 좌석 연장
+        if (libSeats->seatState[location] == SEAT_USED)
+        {
+            spinLock(&room->heapLock);
+            libSeats->endTime[location] = packEndTime(record->time);
+            expiryUpdate(location, room, libSeats);
+            spinUnlock(&room->heapLock);
+            libSeats->renewCount[location] += libSeats->renewCount[location] < 255;
+        }
+        break;
+
+    case WAL_CHECKOUT: // 퇴실
+        if (libSeats->seatState[location] == SEAT_USED)
+        {
+            checkOut(location, HISTORY_CHECKOUT, libSeats);
+        }
+        break;
+
+    case WAL_SEAT_STATE: // 이용불가 설정 변경
+        if (libSeats->seatState[location] == SEAT_USED)
+        {
+            checkOut(location, HISTORY_UNAVAILABLE, libSeats);
+        }
+        setSeatState(location, record->state, libSeats);
+        if (record->state == SEAT_UNAVAILABLE && record->minutes)
+        {
+            __atomic_fetch_or(&libSeats->blackoutMap[location / BITMAP_WORD_BITS], 1ULL << (location % BITMAP_WORD_BITS), __ATOMIC_RELAXED);
+        }else{
+            __atomic_fetch_and(&libSeats->blackoutMap[location / BITMAP_WORD_BITS], ~(1ULL << (location % BITMAP_WORD_BITS)), __ATOMIC_RELAXED);
+        }
+        break;
+
+    case WAL_RESET: // 열람실의 모든 좌석 초기화
+        resetSeats(libSeats, room, record->state, HISTORY_RESET);
+        break;
+
+    case WAL_CLAMP: // 열람실의 이용종료시각 조정
+        clampSeatEndTime(libSeats, room, record->time);
+        break;
+
+    case WAL_LIBRARY: // 열람실 운영정보 변경
+        memcpy(&room->libData, record->name, sizeof(LibraryData));
+        break;
+
+    case WAL_MARK: // 시각 표시. 지난 시각의 복원(replayUntil)만 이용한다.
+        break;
+
+    case WAL_BLACKOUT: // 이용불가 시간대의 추가, 시작, 끝
+        applyBlackout(record, libSeats);
+        break;
+
+    case WAL_QUOTA: // 이용자의 오늘 사용량
+        applyQuota(record, libSeats);
+        break;
+
+    case WAL_RESERVE: // 좌석 예약. 이미 있는 예약과 겹치는 경우(같은 기록을 다시 적용한 경우 포함) 건너뛴다.
+        // 기록하지 않고 정리한 끝난 예약이 다시 생겼을 수 있으므로, 예약 칸이 가득 찬 경우 현재 시각 기준으로 끝난 예약을 정리한다.
+        if (libSeats->reserveCount[location] == libSeats->reserveSlots)
+        {
+            pruneReservations(location, readClock(libSeats), libSeats);
+        }
+        if (libSeats->reserveCount[location] < libSeats->reserveSlots && !isReserved(location, record->time, record->time + record->minutes * 60LL, libSeats))
+        {
+            insertReservation(record->name, location, record->time, record->time + record->minutes * 60LL, libSeats);
+        }
+        break;
+
+    case WAL_CANCEL: // 예약 취소
+        slot = findReservation(location, record->time, libSeats);
+        if (slot < libSeats->reserveCount[location] && libSeats->reserveStart[(size_t)location * libSeats->reserveSlots + slot] == packEndTime(record->time))
+        {
+            removeReservation(location, slot, libSeats);
+        }
+        break;
+    }
+
+    if (isSeatRecord)
+    {
+        spinUnlock(&libSeats->seatLock[location]);
+    }
+
+    return;
+}
+
+
+/*
+* walReplay 함수
+* 기능 : 기록 파일 또는 스냅샷 파일의 기록을 처음부터 차례대로 적용한다. 검사합이 맞지 않는 기록(쓰는 도중 끊긴 기록)을 만나면 멈춘다.
+* 입력값 : *path(파일 경로), *magic(파일 종류 표시), generation(적용할 세대 번호, 0이면 세대 번호와 관계없이 적용),
+*          파일 머리 부분을 저장할 구조체 포인터 *header, 좌석 정보 구조체 포인터 *libSeats
+* 반환값 : 올바른 기록이 끝나는 파일 위치(바이트). 파일이 없거나, 종류 또는 세대 번호가 다른 경우 기록을 적용하지 않고 -1을 반환함.
+*          종류는 같지만 형식 번호(표시의 마지막 글자)가 다른 경우, 기록의 뜻이 다를 수 있으므로 적용하지 않고 -2를 반환함.
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+long long int walReplay(const char* path, const char* magic, unsigned int generation, WalHeader* header, SeatsData* libSeats)
+{
+    // 한 번에 읽을 기록 수
+    enum { REPLAY_CHUNK = 4096 };
+
+    FILE* fp = fopen(path, "rb");
+    WalRecord* chunk = NULL;
+    long long int validEnd = sizeof(WalHeader);
+    size_t count = 0;
+
+    // 파일이 없거나 머리 부분이 올바르지 않은 경우
+    if (fp == NULL) { return -1; }
+    if (fread(header, sizeof(WalHeader), 1, fp) != 1)
+    {
+        fclose(fp);
+        return -1;
+    }
+    if (memcmp(header->magic, magic, sizeof(header->magic)) || (generation != 0 && header->generation != generation))
+    {
+        fclose(fp);
+        return (memcmp(header->magic, magic, sizeof(header->magic) - 1) == 0 && header->magic[7] != magic[7]) ? -2 : -1;
+    }
+
+    chunk = malloc(sizeof(WalRecord) * REPLAY_CHUNK);
+    if (chunk == NULL)
+    {
+        fclose(fp);
+        return -1;
+    }
+
+    // 기록을 묶음 단위로 읽어 차례대로 적용한다.
+    while ((count = fread(chunk, sizeof(WalRecord), REPLAY_CHUNK, fp)) > 0)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            // 쓰는 도중 끊긴 기록을 만난 경우, 그 이후는 적용하지 않는다.
+            if (chunk[i].checksum != recordChecksum(&chunk[i]))
+            {
+                free(chunk);
+                fclose(fp);
+                return validEnd;
+            }
+
+            walApply(&chunk[i], libSeats);
+            validEnd += sizeof(WalRecord);
+        }
+    }
+
+    free(chunk);
+    fclose(fp);
+
+    return validEnd;
+}
+
+
+/*
+* writeSnapshot 함수
+* 기능 : 현재 좌석 정보와 열람실별 운영정보를 스냅샷 파일로 만들고, 새 세대의 빈 기록 파일을 시작한다.
+*        스냅샷과 새 기록 파일을 모두 임시 파일로 만든 후 스냅샷, 기록 파일 순으로 이름을 바꾸므로, 도중에 중단되어도 이전 세대로 복구할 수 있다.
+*        새 기록 파일로 바꾸지 못한 경우 이전 스냅샷을 되돌려 놓으므로, 이전 세대의 기록 파일에 계속 기록해도 복구 시 적용된다.
+* 입력값 : 좌석 정보 구조체 포인터 *libSeats
+* 반환값 : 성공한 경우 1, 실패한 경우(이전 세대의 스냅샷과 기록 파일을 계속 이용함) 0을 반환함.
+* 설명 최종 수정 일자 : 2026/10/17
+*
+* 스냅샷에는 이용중인 좌석(WAL_ASSIGN)과 이용불가 좌석(WAL_SEAT_STATE), 운영정보(WAL_LIBRARY), 이용불가 시간대(WAL_BLACKOUT)와 오늘의 사용량(WAL_QUOTA)만 기록 형식으로 저장한다.
+* 스냅샷의 세대 번호는 새 기록 파일과 같으며, 복구 시 세대 번호가 다른(이전) 기록 파일은 무시한다.
+* 스냅샷은 만든 시각의 시각 표시(WAL_MARK)로 시작한다. 보관 일수가 0이 아닌 경우, 새 스냅샷과 이전 세대의 기록 파일을 세대 번호를 붙인 이름으로도 남겨
+* 지난 시각의 복원에 체크포인트로 이용한다.
+* 기록 잠금을 얻은 후 호출해야 한다. 다른 작업 스레드가 좌석을 바꾸는 도중에 만든 스냅샷에는 바뀌는 중인 좌석이 덜 반영될 수 있으나,
+* 해당 변경의 기록은 기록 잠금을 기다린 후 새 기록 파일에 쓰이고, 모든 기록은 변경 후의 값을 저장하므로 복구 시 바로잡힌다.
+*/
+int writeSnapshot(SeatsData* libSeats)
+{
+    WalData* wal = libSeats->wal;
+    char tmpPath[MAX_PATH_LENGTH + 32], walTmpPath[MAX_PATH_LENGTH + 32], prevPath[MAX_PATH_LENGTH + 32], archivePath[MAX_PATH_LENGTH + 32];
+    WalHeader header;
+    FILE* fp = NULL;
+    int fd = -1, hasPrev = 0;
+
+    // 버퍼에 남은 기록을 먼저 파일에 확정한다.
+    if (walFlush(wal) && wal->needSync)
+    {
+        fsync(wal->fd);
+        wal->needSync = 0;
+    }
+
+    // 스냅샷 머리 부분 작성. 세대 번호는 다음 기록 파일의 것이다.
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+    header.generation = wal->generation + 1;
+    header.seatCount = libSeats->seatCount;
+
+    // 임시 파일에 스냅샷을 쓴다.
+    snprintf(tmpPath, sizeof(tmpPath), "%s.tmp", wal->snapshotPath);
+    fp = fopen(tmpPath, "wb");
+    if (fp == NULL)
+    {
+        printf("스냅샷 파일 %s을 만들 수 없습니다.\n", tmpPath);
+        return 0;
+    }
+    fwrite(&header, sizeof(header), 1, fp);
+
+    // 스냅샷 기록은 기록 버퍼를 빌려 작성한다. 버퍼는 위에서 비웠으므로, 다 쓴 후 다시 비운다.
+    // 시각 표시를 다시 남기도록 하여, 스냅샷의 첫 기록이 스냅샷을 만든 시각이 되게 한다.
+    wal->lastMark = 0;
+    // 열람실 수(MAX_ROOMS)와 이용불가 시간대 수(MAX_BLACKOUTS)의 합은 버퍼의 크기보다 작으므로, 운영정보와 이용불가 시간대 기록은 한 번에 버퍼에 들어간다.
+    for (int i = 0; i < libSeats->header->roomCount; i++)
+    {
+        walLogLibrary(libSeats, &libSeats->header->rooms[i]);
+    }
+
+    // 이용불가 시간대는 진행중인 경우 시작으로, 아닌 경우 추가로 기록한다. (기록 잠금 -> 이용불가 시간대 잠금 순서)
+    spinLock(&libSeats->header->blackoutLock);
+    for (int i = 0; i < libSeats->header->blackoutCount; i++)
+    {
+        logBlackout(libSeats, &libSeats->header->blackouts[i], libSeats->header->blackouts[i].isActive ? BLACKOUT_STARTED : BLACKOUT_ADDED);
+    }
+    spinUnlock(&libSeats->header->blackoutLock);
+    for (int i = 0; i < libSeats->seatCount; i++)
+    {
+        if (libSeats->seatState[i] == SEAT_USED)
+        {
+            long long int minutes = (long long int)(libSeats->endTime[i] - libSeats->sessionStart[i]) / 60;
+            walAppend(libSeats, WAL_ASSIGN, libSeats->renewCount[i], (unsigned short)(minutes < 65535 ? minutes : 65535), i,
+                unpackEndTime(libSeats->endTime[i]), libSeats->userName[libSeats->seatUser[i]]);
+        }else if (libSeats->seatState[i] == SEAT_UNAVAILABLE){
+            walAppend(libSeats, WAL_SEAT_STATE, SEAT_UNAVAILABLE, (unsigned short)(libSeats->blackoutMap[i / BITMAP_WORD_BITS] >> (i % BITMAP_WORD_BITS) & 1), i, 0, NULL);
+        }
+
+        // 좌석의 예약을 기록한다.
+        for (int slot = 0; slot < libSeats->reserveCount[i]; slot++)
+        {
+            size_t index = (size_t)i * libSeats->reserveSlots + slot;
+            walAppend(libSeats, WAL_RESERVE, 0, (unsigned short)((libSeats->reserveEnd[index] - libSeats->reserveStart[index]) / 60), i,
+                unpackEndTime(libSeats->reserveStart[index]), libSeats->reserveName[index]);
+        }
+
+        // 다음 좌석의 기록(좌석 하나와 예약 칸 수만큼, 그리고 도중에 시각이 바뀐 경우의 시각 표시 하나)이 들어가지 않을 수 있는 경우, 스냅샷 파일에 쓴다.
+        if (wal->bufferCount > WAL_BUFFER_RECORDS - 2 - libSeats->reserveSlots)
+        {
+            fwrite(wal->buffer, sizeof(WalRecord), wal->bufferCount, fp);
+            wal->bufferCount = 0;
+        }
+    }
+
+    // 이용 한도 표에서 오늘 쓰인 칸의 사용량을 기록한다. (기록 잠금 -> 이용 한도 표 잠금 순서)
+    // 구역 잠금은 칸을 QUOTA_SNAPSHOT_CHUNK개씩 복사하는 동안만 가지며, 기록과 파일 쓰기는 잠금을 푼 후 한다.
+    if (libSeats->quotaMask != 0)
+    {
+        unsigned short today = quotaToday(readClock(libSeats));
+        char chunkName[QUOTA_SNAPSHOT_CHUNK][MAX_NAME_LENGTH];
+        QuotaCounter chunkCounter[QUOTA_SNAPSHOT_CHUNK];
+        unsigned int chunkEnd = 0;
+        for (unsigned int slot = 0; slot <= libSeats->quotaMask; slot = chunkEnd)
+        {
+            // 한 번에 복사하는 칸은 한 구역 안에 있어야 한다.
+            unsigned int segmentEnd = (slot | libSeats->quotaSegmentMask) + 1;
+            unsigned char* lock = &libSeats->header->quotaLocks[slot / (libSeats->quotaSegmentMask + 1)];
+            int chunkCount = 0;
+
+            chunkEnd = slot + QUOTA_SNAPSHOT_CHUNK < segmentEnd ? slot + QUOTA_SNAPSHOT_CHUNK : segmentEnd;
+            spinLock(lock);
+            for (unsigned int i = slot; i < chunkEnd; i++)
+            {
+                if (libSeats->quotaName[i][0] != '\0' && libSeats->quotaCounter[i].day == today)
+                {
+                    memcpy(chunkName[chunkCount], libSeats->quotaName[i], MAX_NAME_LENGTH);
+                    chunkCounter[chunkCount++] = libSeats->quotaCounter[i];
+                }
+            }
+            spinUnlock(lock);
+
+            for (int i = 0; i < chunkCount; i++)
+            {
+                walAppend(libSeats, WAL_QUOTA, 0, chunkCounter[i].renewals, 0, ((long long int)today << 32) | chunkCounter[i].usedSeconds, chunkName[i]);
+                if (wal->bufferCount > WAL_BUFFER_RECORDS - 2)
+                {
+                    fwrite(wal->buffer, sizeof(WalRecord), wal->bufferCount, fp);
+                    wal->bufferCount = 0;
+                }
+            }
+        }
+    }
+    fwrite(wal->buffer, sizeof(WalRecord), wal->bufferCount, fp);
+    wal->bufferCount = 0;
+
+    // 스냅샷을 디스크에 확정한다.
+    if (fflush(fp) != 0 || fsync(fileno(fp)) != 0 || fclose(fp) != 0)
+    {
+        printf("스냅샷 파일 %s을 저장할 수 없습니다.\n", wal->snapshotPath);
+        unlink(tmpPath);
+        return 0;
+    }
+
+    // 새 세대의 빈 기록 파일도 임시 파일로 먼저 만든다. 만들 수 없는 경우 아무것도 바꾸지 않았으므로, 이전 세대의 기록 파일에 계속 기록한다.
+    memcpy(header.magic, WAL_MAGIC, sizeof(header.magic));
+    header.seatCount = 0;
+    snprintf(walTmpPath, sizeof(walTmpPath), "%s.tmp", wal->walPath);
+    fd = open(walTmpPath, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0 || write(fd, &header, sizeof(header)) != sizeof(header) || fsync(fd) != 0)
+    {
+        printf("기록 파일 %s을 새로 만들 수 없습니다.\n", wal->walPath);
+        if (fd >= 0) { close(fd); }
+        unlink(walTmpPath);
+        unlink(tmpPath);
+        return 0;
+    }
+
+    // 새 기록 파일로 바꾸지 못한 경우 되돌릴 수 있도록, 기존 스냅샷을 다른 이름으로도 남긴다. 기존 스냅샷이 없는 경우(첫 세대)에는 새 스냅샷을 지우면 된다.
+    snprintf(prevPath, sizeof(prevPath), "%s.prev", wal->snapshotPath);
+    unlink(prevPath);
+    hasPrev = (link(wal->snapshotPath, prevPath) == 0);
+    if (!hasPrev && errno != ENOENT)
+    {
+        printf("스냅샷 파일 %s을 저장할 수 없습니다.\n", wal->snapshotPath);
+        close(fd);
+        unlink(walTmpPath);
+        unlink(tmpPath);
+        return 0;
+    }
+
+    // 이름을 바꿔 기존 스냅샷을 대체한다. 새 스냅샷에는 기존 기록 파일의 모든 기록이 반영되어 있으므로, 이 때 중단되어도 새 스냅샷만으로 복구된다.
+    // 보관하는 경우 이름을 바꾸기 전에 세대 번호를 붙인 이름으로도 남기므로, 이후 스냅샷이 대체해도 이 스냅샷은 남는다.
+    walArchive(wal, tmpPath, SNAPSHOT_FILE_NAME, header.generation);
+    if (rename(tmpPath, wal->snapshotPath) != 0)
+    {
+        printf("스냅샷 파일 %s을 저장할 수 없습니다.\n", wal->snapshotPath);
+        close(fd);
+        unlink(walTmpPath);
+        unlink(tmpPath);
+        unlink(prevPath);
+        snprintf(archivePath, sizeof(archivePath), "%s/%s.%u", wal->dataDir, SNAPSHOT_FILE_NAME, header.generation);
+        unlink(archivePath);
+        return 0;
+    }
+
+    // 이름을 바꿔 기존 기록 파일을 대체한다. 보관하는 경우 기존 기록 파일을 먼저 남긴다.
+    walArchive(wal, wal->walPath, WAL_FILE_NAME, wal->generation);
+    if (rename(walTmpPath, wal->walPath) != 0)
+    {
+        // 새 스냅샷과 이전 세대의 기록 파일은 세대 번호가 달라, 이후의 기록이 복구 시 무시된다. 이전 스냅샷을 되돌려 놓고 이전 세대로 계속 기록한다.
+        printf("기록 파일 %s을 새로 만들 수 없습니다. 이전 세대의 스냅샷과 기록 파일을 계속 이용합니다.\n", wal->walPath);
+        close(fd);
+        unlink(walTmpPath);
+        if (hasPrev ? rename(prevPath, wal->snapshotPath) != 0 : unlink(wal->snapshotPath) != 0)
+        {
+            printf("스냅샷 파일 %s을 되돌릴 수 없습니다. 이후의 변경은 복구되지 않을 수 있습니다.\n", wal->snapshotPath);
+        }
+        snprintf(archivePath, sizeof(archivePath), "%s/%s.%u", wal->dataDir, SNAPSHOT_FILE_NAME, header.generation);
+        unlink(archivePath);
+        return 0;
+    }
+    unlink(prevPath);
+
+    // 새 기록 파일로 바꾼다. 새 파일은 머리 부분 뒤에 이어서 쓴다.
+    close(wal->fd);
+    lseek(fd, 0, SEEK_END);
+    wal->fd = fd;
+    wal->generation = header.generation;
+    wal->sinceSnapshot = 0;
+    wal->lastMark = 0;
+    wal->snapshotTime = readClock(libSeats);
+
+    // 보관 기간이 지난 세대의 파일을 지운다.
+    walPruneArchive(wal, wal->snapshotTime);
+
+    return 1;
+}
+
+
+/*
+* walInitLock 함수
+* 기능 : 기록 잠금을 재진입 가능한 잠금으로 초기화한다. 스냅샷 작성(writeSnapshot)은 기록 잠금을 가진 채 기록 버퍼를 빌려 쓰기 때문이다.
+* 입력값 : 기록 파일 정보 구조체 포인터 *wal
+* 반환값 없음
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+void walInitLock(WalData* wal)
+{
+    pthread_mutexattr_t attr;
+
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutex_init(&wal->lock, &attr);
+    pthread_mutexattr_destroy(&attr);
+
+    return;
+}
+
+
+/*
+* walOpen 함수
+* 기능 : 기록 디렉터리의 스냅샷을 불러오고 그 이후의 기록을 적용하여 좌석 정보와 운영정보를 복구한 후, 이후의 변경을 기록하기 시작한다.
+* 입력값 : *dataDir(기록 디렉터리), archiveDays(지난 세대의 스냅샷과 기록 파일을 보관하는 일수, 0이면 보관하지 않음), 좌석 정보 구조체 포인터 *libSeats(초기화되어 있어야 함)
+* 반환값 : 성공한 경우 1, 실패한 경우 0을 반환함.
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+int walOpen(const char* dataDir, int archiveDays, SeatsData* libSeats)
+{
+    WalData* wal = malloc(sizeof(WalData));
+    WalHeader header;
+    long long int validEnd = 0;
+    unsigned int generation = 0;
+
+    if (wal == NULL) { return 0; }
+    memset(wal, 0, sizeof(WalData));
+    walInitLock(wal);
+    snprintf(wal->walPath, sizeof(wal->walPath), "%s/%s", dataDir, WAL_FILE_NAME);
+    snprintf(wal->snapshotPath, sizeof(wal->snapshotPath), "%s/%s", dataDir, SNAPSHOT_FILE_NAME);
+    snprintf(wal->dataDir, sizeof(wal->dataDir), "%s", dataDir);
+    wal->archiveDays = archiveDays;
+
+    // 복구 중에는 기록하지 않는다. (libSeats->wal == NULL)
+    libSeats->wal = NULL;
+
+    // 스냅샷이 있는 경우 먼저 불러온다.
+    validEnd = walReplay(wal->snapshotPath, SNAPSHOT_MAGIC, 0, &header, libSeats);
+    if (validEnd >= 0)
+    {
+        generation = header.generation;
+        if (header.seatCount != libSeats->seatCount)
+        {
+            printf("경고 : 저장된 좌석 수(%d)와 설정된 좌석 수(%d)가 다릅니다. 없는 좌석의 정보는 무시됩니다.\n", header.seatCount, libSeats->seatCount);
+        }
+    }
+
+    // 스냅샷과 같은 세대의 기록 파일이 있는 경우, 스냅샷 이후의 기록을 적용한다. 스냅샷이 없는 경우 세대 번호와 관계없이 적용한다.
+    // 세대 번호가 다른 기록 파일은 스냅샷을 만든 직후 중단된 경우의 이전 세대 기록 파일로, 이미 스냅샷에 반영되어 있다.
+    if (validEnd != -2)
+    {
+        validEnd = walReplay(wal->walPath, WAL_MAGIC, generation, &header, libSeats);
+    }
+
+    // 다른 형식의 파일은 기록의 뜻이 다를 수 있으므로 적용하지 않는다. 새 파일로 덮어쓰면 저장된 좌석 정보를 잃으므로, 시작하지 않는다.
+    if (validEnd == -2)
+    {
+        printf("기록 디렉터리 %s의 스냅샷 또는 기록 파일이 다른 형식으로 저장되어 있습니다. 이 버전에서 복구할 수 없습니다.\n", dataDir);
+        pthread_mutex_destroy(&wal->lock);
+        free(wal);
+        return 0;
+    }
+    if (validEnd >= 0)
+    {
+        generation = header.generation;
+    }else if (generation == 0){
+        generation = 1;
+    }
+
+    if (validEnd < 0) // 기록 파일이 없거나 이전 세대인 경우, 새 기록 파일을 만든다.
+    {
+        memset(&header, 0, sizeof(header));
+        memcpy(header.magic, WAL_MAGIC, sizeof(header.magic));
+        header.generation = generation;
+        // 이전 세대의 기록 파일은 보관한 파일과 같은 파일일 수 있으므로, 내용을 지우지 않고 새 파일로 만든다.
+        unlink(wal->walPath);
+        wal->fd = open(wal->walPath, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (wal->fd < 0 || write(wal->fd, &header, sizeof(header)) != sizeof(header) || fsync(wal->fd) != 0)
+        {
+            printf("기록 파일 %s을 만들 수 없습니다.\n", wal->walPath);
+            if (wal->fd >= 0) { close(wal->fd); }
+            pthread_mutex_destroy(&wal->lock);
+            free(wal);
+            return 0;
+        }
+
+    }else{ // 기록 파일의 끝이 쓰는 도중 끊긴 경우, 끊긴 부분을 잘라낸 후 이어서 기록한다.
+        wal->fd = open(wal->walPath, O_WRONLY);
+        if (wal->fd < 0 || ftruncate(wal->fd, (off_t)validEnd) != 0)
+        {
+            printf("기록 파일 %s을 열 수 없습니다.\n", wal->walPath);
+            if (wal->fd >= 0) { close(wal->fd); }
+            pthread_mutex_destroy(&wal->lock);
+            free(wal);
+            return 0;
+        }
+        lseek(wal->fd, 0, SEEK_END);
+        wal->sinceSnapshot = (int)((validEnd - (long long int)sizeof(WalHeader)) / (long long int)sizeof(WalRecord));
+    }
+
+    // 이후의 변경을 기록한다. 다음 체크포인트는 지금부터 CHECKPOINT_INTERVAL 후이다.
+    wal->generation = generation;
+    wal->snapshotTime = readClock(libSeats);
+    libSeats->wal = wal;
+
+    return 1;
+}
+
+
+/*
+* walClose 함수
+* 기능 : 프로그램 종료 시 마지막 스냅샷을 만들고 기록 파일을 닫는다.
+* 입력값 : 좌석 정보 구조체 포인터 *libSeats
+* 반환값 없음
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+void walClose(SeatsData* libSeats)
+{
+    if (libSeats->wal == NULL) { return; }
+
+    pthread_mutex_lock(&libSeats->wal->lock);
+    writeSnapshot(libSeats);
+    pthread_mutex_unlock(&libSeats->wal->lock);
+
+    pthread_mutex_destroy(&libSeats->wal->lock);
+    close(libSeats->wal->fd);
+    free(libSeats->wal);
+    libSeats->wal = NULL;
+
+    return;
+}
+
+
+/*
+* walArchive 함수
+* 기능 : 지난 세대의 스냅샷 또는 기록 파일을 세대 번호를 붙인 이름(seats.snap.12 등)으로 기록 디렉터리에 남긴다. 보관 일수가 0이면 아무것도 하지 않는다.
+*        파일을 복사하지 않고 하드 링크를 만들므로, 원래 이름을 새 파일이 대체해도 남긴 파일의 내용은 그대로이다.
+* 입력값 : 기록 구조체 포인터 *wal, *path(남길 파일 경로), *name(보관 파일명의 앞부분, SNAPSHOT_FILE_NAME 또는 WAL_FILE_NAME), generation(파일의 세대 번호)
+* 반환값 없음
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+void walArchive(WalData* wal, const char* path, const char* name, unsigned int generation)
+{
+    char archivePath[MAX_PATH_LENGTH + 32];
+
+    if (wal->archiveDays == 0)
+    {
+        return;
+    }
+
+    // 같은 세대의 파일이 이미 있는 경우(스냅샷을 만든 직후 중단된 후 다시 만든 경우) 새 파일로 바꾼다.
+    snprintf(archivePath, sizeof(archivePath), "%s/%s.%u", wal->dataDir, name, generation);
+    unlink(archivePath);
+    if (link(path, archivePath) != 0)
+    {
+        printf("지난 세대 파일 %s을 남길 수 없습니다.\n", archivePath);
+    }
+
+    return;
+}
+
+
+/*
+* walPruneArchive 함수
+* 기능 : 기록 디렉터리에 남긴 지난 세대의 스냅샷과 기록 파일 중, 마지막으로 바뀐 지 보관 일수가 지난 파일을 지운다.
+*        스냅샷은 같은 세대의 기록 파일보다 먼저 바뀌지 않으므로, 먼저 지워진다. 따라서 남은 스냅샷부터는 항상 이어지는 기록 파일이 있다.
+* 입력값 : 기록 구조체 포인터 *wal, now(현재 시각, Unix 초)
+* 반환값 없음
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+void walPruneArchive(WalData* wal, long long int now)
+{
+    char path[MAX_PATH_LENGTH + 300];
+    DIR* dir = NULL;
+    struct dirent* entry = NULL;
+    struct stat fileStat;
+    unsigned int generation = 0;
+    int length = 0;
+
+    if (wal->archiveDays == 0 || (dir = opendir(wal->dataDir)) == NULL)
+    {
+        return;
+    }
+
+    while ((entry = readdir(dir)) != NULL)
+    {
+        // 세대 번호를 붙인 스냅샷과 기록 파일만 확인한다.
+        length = 0;
+        if ((sscanf(entry->d_name, SNAPSHOT_FILE_NAME ".%u%n", &generation, &length) != 1 || entry->d_name[length] != '\0')
+            && (sscanf(entry->d_name, WAL_FILE_NAME ".%u%n", &generation, &length) != 1 || entry->d_name[length] != '\0'))
+        {
+            continue;
+        }
+
+        snprintf(path, sizeof(path), "%s/%s", wal->dataDir, entry->d_name);
+        if (stat(path, &fileStat) == 0 && (long long int)fileStat.st_mtime < now - wal->archiveDays * 86400LL)
+        {
+            unlink(path);
+        }
+    }
+    closedir(dir);
+
+    return;
+}
+
+
+/*
+* checkpointTime 함수
+* 기능 : 스냅샷 파일의 머리 부분과 첫 기록(시각 표시)을 읽어, 스냅샷의 세대 번호와 스냅샷을 만든 시각을 구한다.
+* 입력값 : *path(스냅샷 파일 경로), *generation(세대 번호를 저장할 변수)
+* 반환값 : 스냅샷을 만든 시각(Unix 초). 파일이 없거나, 올바르지 않거나, 시각 표시가 없는 이전 형식의 스냅샷인 경우 -1을 반환함.
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+long long int checkpointTime(const char* path, unsigned int* generation)
+{
+    FILE* fp = fopen(path, "rb");
+    WalHeader header;
+    WalRecord record;
+    long long int time = -1;
+
+    if (fp == NULL)
+    {
+        return -1;
+    }
+
+    if (fread(&header, sizeof(header), 1, fp) == 1 && !memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic))
+        && fread(&record, sizeof(record), 1, fp) == 1 && record.checksum == recordChecksum(&record) && record.type == WAL_MARK)
+    {
+        *generation = header.generation;
+        time = record.time;
+    }
+    fclose(fp);
+
+    return time;
+}
+
+
+/*
+* replayUntil 함수
+* 기능 : 기록 파일의 기록을 차례대로 적용하다가, 주어진 시각보다 나중의 시각 표시를 만나면 멈춘다.
+*        시각 표시를 만날 때마다 가상 시계를 그 시각으로 옮기므로, 현재 시각을 이용하는 기록(끝난 예약의 정리)도 그 당시와 같이 적용된다.
+* 입력값 : *path(기록 파일 경로), generation(기대하는 세대 번호), target(복원할 시각, Unix 초), 가상 시계 구조체 포인터 *clock,
+*          좌석 정보 구조체 포인터 *libSeats(clockSource가 clock이어야 함), *applied(적용한 기록 수를 더할 변수)
+* 반환값 : 주어진 시각에서 멈춘 경우 1, 파일 끝(또는 쓰는 도중 끊긴 기록)까지 적용한 경우 0, 파일이 없거나 세대 번호가 다른 경우 -1을 반환함.
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+int replayUntil(const char* path, unsigned int generation, long long int target, ClockSource* clock, SeatsData* libSeats, long long int* applied)
+{
+    // 한 번에 읽을 기록 수
+    enum { REPLAY_CHUNK = 4096 };
+
+    FILE* fp = fopen(path, "rb");
+    WalRecord* chunk = NULL;
+    WalHeader header;
+    size_t count = 0;
+    int result = 0;
+
+    if (fp == NULL) { return -1; }
+    chunk = malloc(sizeof(WalRecord) * REPLAY_CHUNK);
+    if (chunk == NULL || fread(&header, sizeof(header), 1, fp) != 1 || memcmp(header.magic, WAL_MAGIC, sizeof(header.magic)) || header.generation != generation)
+    {
+        free(chunk);
+        fclose(fp);
+        return -1;
+    }
+
+    // 기록을 묶음 단위로 읽어 차례대로 적용한다.
+    while (result == 0 && (count = fread(chunk, sizeof(WalRecord), REPLAY_CHUNK, fp)) > 0)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            // 쓰는 도중 끊긴 기록을 만난 경우, 그 이후는 적용하지 않는다.
+            if (chunk[i].checksum != recordChecksum(&chunk[i]))
+            {
+                count = 0;
+                break;
+            }
+
+            // 복원할 시각보다 나중의 시각 표시를 만난 경우, 그 이후의 기록은 그 시각 이후에 일어난 것이다.
+            if (chunk[i].type == WAL_MARK)
+            {
+                if (chunk[i].time > target)
+                {
+                    result = 1;
+                    break;
+                }
+                clock->now = chunk[i].time;
+                continue;
+            }
+
+            walApply(&chunk[i], libSeats);
+            (*applied)++;
+        }
+        if (count < REPLAY_CHUNK)
+        {
+            break;
+        }
+    }
+
+    free(chunk);
+    fclose(fp);
+
+    return result;
+}
+
+
+/*
+* rebuildSeatsAt 함수
+* 기능 : 기록 디렉터리의 스냅샷(체크포인트)과 기록 파일로 주어진 시각의 좌석 정보와 열람실별 운영정보를 복원한다.
+*        주어진 시각 이전의 가장 최근 체크포인트를 불러온 후, 그 세대부터의 기록 파일을 차례대로 주어진 시각까지만 적용한다.
+*        체크포인트는 CHECKPOINT_INTERVAL마다 만들어지므로, 적용하는 기록은 보통 한 시간 안의 것이다.
+* 입력값 : *dataDir(기록 디렉터리), target(복원할 시각, Unix 초), 좌석 정보 구조체 포인터 *libSeats(초기화된 빈 좌석 저장소),
+*          *checkpoint(불러온 체크포인트의 세대 번호를 저장할 변수, 체크포인트 없이 처음부터 적용한 경우 0), *checkpointAt(체크포인트를 만든 시각을 저장할 변수)
+* 반환값 : 체크포인트 이후 적용한 기록 수. 주어진 시각을 복원할 체크포인트와 기록 파일이 없는 경우 -1을 반환함.
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+long long int rebuildSeatsAt(const char* dataDir, long long int target, SeatsData* libSeats, unsigned int* checkpoint, long long int* checkpointAt)
+{
+    char path[MAX_PATH_LENGTH + 300];
+    char bestPath[MAX_PATH_LENGTH + 300] = "";
+    ClockSource clock = { readVirtualClock, 0 };
+    WalHeader header;
+    DIR* dir = NULL;
+    struct dirent* entry = NULL;
+    unsigned int generation = 0, best = 0;
+    long long int time = 0, bestTime = 0, applied = 0;
+    int length = 0, result = 0;
+
+    // 현재 스냅샷과 남겨 둔 지난 세대의 스냅샷 중, 주어진 시각 이전에 만든 가장 최근(세대 번호가 가장 큰) 것을 찾는다.
+    snprintf(path, sizeof(path), "%s/%s", dataDir, SNAPSHOT_FILE_NAME);
+    time = checkpointTime(path, &generation);
+    if (time >= 0 && time <= target)
+    {
+        best = generation;
+        bestTime = time;
+        snprintf(bestPath, sizeof(bestPath), "%s", path);
+    }
+    dir = opendir(dataDir);
+    while (dir != NULL && (entry = readdir(dir)) != NULL)
+    {
+        length = 0;
+        if (sscanf(entry->d_name, SNAPSHOT_FILE_NAME ".%u%n", &generation, &length) != 1 || entry->d_name[length] != '\0' || generation <= best)
+        {
+            continue;
+        }
+        snprintf(path, sizeof(path), "%s/%s", dataDir, entry->d_name);
+        time = checkpointTime(path, &generation);
+        if (time >= 0 && time <= target && generation > best)
+        {
+            best = generation;
+            bestTime = time;
+            snprintf(bestPath, sizeof(bestPath), "%s", path);
+        }
+    }
+    if (dir != NULL)
+    {
+        closedir(dir);
+    }
+
+    // 복원 중에는 가상 시계를 기록의 시각 표시에 맞춰 옮긴다.
+    libSeats->clockSource = &clock;
+    clock.now = bestTime;
+
+    // 체크포인트를 불러온다. 체크포인트가 없는 경우 첫 세대의 기록 파일부터 빈 좌석 저장소에 적용한다.
+    if (best > 0 && walReplay(bestPath, SNAPSHOT_MAGIC, best, &header, libSeats) < 0)
+    {
+        best = 0;
+    }
+    *checkpoint = best;
+    *checkpointAt = bestTime;
+
+    // 체크포인트의 세대부터 기록 파일을 차례대로 적용한다. 지난 세대는 남겨 둔 파일을, 현재 세대는 현재 기록 파일을 이용한다.
+    for (generation = best > 0 ? best : 1; ; generation++)
+    {
+        snprintf(path, sizeof(path), "%s/%s.%u", dataDir, WAL_FILE_NAME, generation);
+        result = replayUntil(path, generation, target, &clock, libSeats, &applied);
+        if (result < 0)
+        {
+            snprintf(path, sizeof(path), "%s/%s", dataDir, WAL_FILE_NAME);
+            result = replayUntil(path, generation, target, &clock, libSeats, &applied);
+        }
+
+        // 다음 세대의 기록 파일이 없으면 마지막 기록까지 적용한 것이다. 체크포인트도 첫 세대의 기록 파일도 없으면 복원할 수 없다.
+        if (result < 0 && best == 0 && generation == 1)
+        {
+            applied = -1;
+        }
+        if (result != 0)
+        {
+            break;
+        }
+    }
+
+    libSeats->clockSource = NULL;
+
+    return applied;
+}
+
+
+/*
+* runPointInTime 함수
+* 기능 : 주어진 지난 시각의 좌석 정보와 열람실별 운영정보를 복원하여, CSV 형식으로 표준 출력에 쓴다.
+*        이용중인 좌석과 이용불가 좌석, 남아 있는 예약만 출력하며, 첫 줄에는 복원에 이용한 체크포인트와 적용한 기록 수, 걸린 시간을 주석(#)으로 쓴다.
+* 입력값 : *dataDir(기록 디렉터리), *when(복원할 시각, "[YYYY-MM-DD] HH:MM" 지역 시각), 좌석 정보 구조체 포인터 *libSeats(초기화된 빈 좌석 저장소)
+* 반환값 : 복원한 경우 1, 기록 디렉터리가 없거나 시각이 잘못되었거나 복원할 기록이 없는 경우 0을 반환함.
+* 설명 최종 수정 일자 : 2026/10/17
+*
+* 출력 형식
+* room,name,first_seat,seats,open,close,max_time,max_renewable_time : 열람실마다 한 줄
+* seat,room,state,name,start,end,renewals                          : 이용중(used) 또는 이용불가(unavailable) 좌석마다 한 줄
+* reserved_seat,name,start,end                                    : 예약마다 한 줄
+*/
+int runPointInTime(const char* dataDir, const char* when, SeatsData* libSeats)
+{
+    const char* cursor = when;
+    char timeText[3][32];
+    unsigned int checkpoint = 0;
+    long long int target = 0, checkpointAt = 0, applied = 0, started = 0;
+    RoomData* room = NULL;
+
+    if (!dataDir[0])
+    {
+        printf("지난 시각의 좌석 정보를 복원하려면 기록 디렉터리(DATA_DIR)가 필요합니다.\n");
+        return 0;
+    }
+    if (!parseDateTime(&cursor, when + strlen(when), readSystemClock(NULL), &target))
+    {
+        printf("복원할 시각은 [YYYY-MM-DD] HH:MM 형식입니다.\n");
+        return 0;
+    }
+
+    started = benchNow();
+    applied = rebuildSeatsAt(dataDir, target, libSeats, &checkpoint, &checkpointAt);
+    if (applied < 0)
+    {
+        printf("%s에 그 시각의 좌석 정보를 복원할 체크포인트나 기록이 없습니다.\n", dataDir);
+        return 0;
+    }
+
+    formatDateTime(target, timeText[0], sizeof(timeText[0]));
+    formatDateTime(checkpointAt, timeText[1], sizeof(timeText[1]));
+    printf("# %s 기준 (체크포인트 : %s, 적용한 기록 %lld개, %.1f ms)\n", timeText[0], checkpoint > 0 ? timeText[1] : "없음", applied,
+        (benchNow() - started) / 1000000.0);
+
+    // 열람실별 운영정보
+    printf("room,name,first_seat,seats,open,close,max_time,max_renewable_time\n");
+    for (int r = 0; r < libSeats->header->roomCount; r++)
+    {
+        room = &libSeats->header->rooms[r];
+        printf("%d,%s,%d,%d,%02d:%02d,%02d:%02d,%d,%d\n", r + 1, room->name, room->firstSeat + 1, room->seatCount,
+            room->libData.OPEN_TIME / 60, room->libData.OPEN_TIME % 60, room->libData.CLOSE_TIME / 60, room->libData.CLOSE_TIME % 60,
+            room->libData.MAX_TIME, room->libData.MAX_RENEWABLE_TIME);
+    }
+
+    // 이용중인 좌석과 이용불가 좌석
+    printf("seat,room,state,name,start,end,renewals\n");
+    for (int i = 0; i < libSeats->seatCount; i++)
+    {
+        if (libSeats->seatState[i] == SEAT_USED)
+        {
+            formatDateTime(unpackEndTime(libSeats->sessionStart[i]), timeText[1], sizeof(timeText[1]));
+            formatDateTime(unpackEndTime(libSeats->endTime[i]), timeText[2], sizeof(timeText[2]));
+            printf("%d,%d,used,%s,%s,%s,%d\n", i + 1, (int)(roomOf(libSeats, i) - libSeats->header->rooms) + 1,
+                libSeats->userName[libSeats->seatUser[i]], timeText[1], timeText[2], libSeats->renewCount[i]);
+        }else if (libSeats->seatState[i] == SEAT_UNAVAILABLE){
+            printf("%d,%d,unavailable,,,,\n", i + 1, (int)(roomOf(libSeats, i) - libSeats->header->rooms) + 1);
+        }
+    }
+
+    // 남아 있는 예약
+    printf("reserved_seat,name,start,end\n");
+    for (int i = 0; i < libSeats->seatCount; i++)
+    {
+        for (int slot = 0; slot < libSeats->reserveCount[i]; slot++)
+        {
+            size_t index = (size_t)i * libSeats->reserveSlots + slot;
+            formatDateTime(unpackEndTime(libSeats->reserveStart[index]), timeText[1], sizeof(timeText[1]));
+            formatDateTime(unpackEndTime(libSeats->reserveEnd[index]), timeText[2], sizeof(timeText[2]));
+            printf("%d,%s,%s,%s\n", i + 1, libSeats->reserveName[index], timeText[1], timeText[2]);
+        }
+    }
+
+    return 1;
+}
+
+
+/*
+* formatDateTime 함수
+* 기능 : 시각을 지역 시각의 YYYY-MM-DD HH:MM:SS 형식 문자열로 쓴다.
+* 입력값 : time(시각, Unix 초), *buffer(문자열을 쓸 버퍼), size(버퍼 크기)
+* 반환값 없음
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+void formatDateTime(long long int time, char* buffer, size_t size)
+{
+    time_t Time = (time_t)time;
+    struct tm tmTime;
+
+    localtime_r(&Time, &tmTime);
+    strftime(buffer, size, "%Y-%m-%d %H:%M:%S", &tmTime);
+
+    return;
+}
+
+
+/*
+* metricsOpen 함수
+* 기능 : 운영 지표를 모으기 시작한다. 스레드별 운영 지표를 만들고, 지표 파일을 한 번 써서 쓸 수 있는지 확인한다.
+* 입력값 : 지표 파일 경로 path, interval(지표 파일을 다시 쓰는 간격, 초), 좌석 정보 구조체 포인터 *libSeats
+* 반환값 : 성공한 경우 1, 메모리가 부족하거나 지표 파일을 쓸 수 없는 경우 0
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+int metricsOpen(const char* path, int interval, SeatsData* libSeats)
+{
+    MetricsRegistry* registry = malloc(sizeof(MetricsRegistry));
+    if (registry == NULL)
+    {
+        return 0;
+    }
+
+    // 스레드별 운영 지표는 캐시 라인 단위로 정렬된 하나의 배열로 만든다.
+    registry->threads = aligned_alloc(CACHE_LINE_SIZE, sizeof(MetricsData) * METRIC_THREADS);
+    if (registry->threads == NULL)
+    {
+        free(registry);
+        return 0;
+    }
+    memset(registry->threads, 0, sizeof(MetricsData) * METRIC_THREADS);
+    registry->nextThread = 0;
+    registry->interval = interval;
+    registry->lastExport = 0;
+    registry->exportLock = 0;
+    snprintf(registry->path, sizeof(registry->path), "%s", path);
+    libSeats->metrics = registry;
+
+    if (!metricsExport(libSeats, 1))
+    {
+        printf("운영 지표 파일 %s을 쓸 수 없습니다.\n", path);
+        libSeats->metrics = NULL;
+        free(registry->threads);
+        free(registry);
+        return 0;
+    }
+
+    return 1;
+}
+
+
+/*
+* metricsThread 함수
+* 기능 : 호출한 스레드가 혼자 이용할 운영 지표를 하나 나누어 준다. 스레드가 시작할 때 한 번 호출한다.
+* 입력값 : 좌석 정보 구조체 포인터 *libSeats
+* 반환값 : 운영 지표 구조체 포인터, 운영 지표를 모으지 않거나 남은 운영 지표가 없는 경우 NULL
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+MetricsData* metricsThread(SeatsData* libSeats)
+{
+    int index = 0;
+
+    if (libSeats->metrics == NULL)
+    {
+        return NULL;
+    }
+
+    index = __atomic_fetch_add(&libSeats->metrics->nextThread, 1, __ATOMIC_RELAXED);
+
+    return index < METRIC_THREADS ? &libSeats->metrics->threads[index] : NULL;
+}
+
+
+/*
+* metricCount 함수
+* 기능 : 스레드의 운영 지표 카운터에 값을 더한다. 카운터는 이 스레드만 바꾸므로, 지표 파일을 쓰는 스레드가 읽을 수 있도록 원자적으로 저장만 한다.
+* 입력값 : 운영 지표 구조체 포인터 *metrics(NULL이면 아무것도 하지 않음), counter(카운터 종류, METRIC_ASSIGN 등), amount(더할 값)
+* 반환값 없음
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+void metricCount(MetricsData* metrics, int counter, int amount)
+{
+    if (metrics == NULL || amount == 0)
+    {
+        return;
+    }
+
+    __atomic_store_n(&metrics->counters[counter], metrics->counters[counter] + (unsigned long long int)amount, __ATOMIC_RELAXED);
+
+    return;
+}
+
+
+/*
+* metricsNow 함수
+* 기능 : 지연시간 측정을 시작하는 시각을 읽는다. 운영 지표를 모으지 않는 경우 시각을 읽지 않는다.
+* 입력값 : 운영 지표 구조체 포인터 *metrics
+* 반환값 : 시각(ns), 운영 지표를 모으지 않는 경우 0
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+long long int metricsNow(MetricsData* metrics)
+{
+    return metrics != NULL ? benchNow() : 0;
+}
+
+
+/*
+* metricBucketBound 함수
+* 기능 : 지연시간 히스토그램 칸의 상한을 구한다. 칸은 1us부터 10ms까지 고정되어 있으며, 마지막 칸은 상한이 없다.
+* 입력값 : bucket(칸 번호, 0 ~ METRIC_BUCKETS - 1)
+* 반환값 : 칸의 상한(ns), 마지막 칸인 경우 -1
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+long long int metricBucketBound(int bucket)
+{
+    static const long long int bounds[METRIC_BUCKETS - 1] = { 1000, 2000, 5000, 10000, 20000, 50000, 100000, 200000, 500000, 1000000, 10000000 };
+
+    return bucket < METRIC_BUCKETS - 1 ? bounds[bucket] : -1;
+}
+
+
+/*
+* metricLatency 함수
+* 기능 : 작업 하나의 지연시간을 스레드의 운영 지표 히스토그램에 기록한다.
+* 입력값 : 운영 지표 구조체 포인터 *metrics(NULL이면 아무것도 하지 않음), operation(작업 종류, METRIC_OP_ASSIGN 등), start(metricsNow로 읽은 시작 시각)
+* 반환값 없음
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+void metricLatency(MetricsData* metrics, int operation, long long int start)
+{
+    long long int elapsed = 0;
+    int bucket = 0;
+
+    if (metrics == NULL)
+    {
+        return;
+    }
+
+    // 지연시간이 들어가는 칸을 찾는다.
+    elapsed = benchNow() - start;
+    while (bucket < METRIC_BUCKETS - 1 && elapsed > metricBucketBound(bucket))
+    {
+        bucket++;
+    }
+
+    __atomic_store_n(&metrics->buckets[operation][bucket], metrics->buckets[operation][bucket] + 1, __ATOMIC_RELAXED);
+    __atomic_store_n(&metrics->latencySum[operation], metrics->latencySum[operation] + (unsigned long long int)elapsed, __ATOMIC_RELAXED);
+
+    return;
+}
+
+
+/*
+* metricsExport 함수
+* 기능 : 모든 스레드의 운영 지표를 합쳐 Prometheus 텍스트 형식으로 지표 파일에 쓴다. 임시 파일에 쓴 후 이름을 바꾸므로, 읽는 쪽은 항상 완성된 파일을 읽는다.
+*        지표 파일을 다시 쓸 간격이 지나지 않았거나, 다른 스레드가 쓰고 있는 경우에는 쓰지 않는다.
+* 입력값 : 좌석 정보 구조체 포인터 *libSeats, isForced(1인 경우 간격과 관계없이 쓴다)
+* 반환값 : 썼거나 쓸 필요가 없는 경우 1, 지표 파일을 쓸 수 없는 경우 0
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+int metricsExport(SeatsData* libSeats, int isForced)
+{
+    // 카운터와 작업의 이름, 설명 (METRIC_ASSIGN, METRIC_OP_ASSIGN 등의 순서)
+    static const char* const counterNames[METRIC_COUNTERS] = { "lss_assignments_total", "lss_renewals_total", "lss_checkouts_total", "lss_expirations_total",
+        "lss_closing_resets_total", "lss_closing_released_seats_total", "lss_full_rejections_total", "lss_closed_rejections_total" };
+    static const char* const counterHelps[METRIC_COUNTERS] = { "Seats assigned.", "Seats renewed.", "Seats checked out by users.", "Seats released after their end time.",
+        "Resets after closing time.", "Seats released by resets after closing time.", "Assignments refused because the room was full.", "Requests refused outside opening hours." };
+    static const char* const operationNames[METRIC_OPERATIONS] = { "assign", "renew", "checkout", "status", "admin", "expire" };
+
+    MetricsRegistry* registry = libSeats->metrics;
+    unsigned long long int counters[METRIC_COUNTERS] = { 0 };
+    unsigned long long int buckets[METRIC_OPERATIONS][METRIC_BUCKETS] = { { 0 } };
+    unsigned long long int latencySum[METRIC_OPERATIONS] = { 0 };
+    unsigned long long int cumulative = 0;
+    long long int now = (long long int)time(NULL);
+    int threadCount = 0, used = 0, freeCount = 0, isWritten = 0;
+    char tmpPath[MAX_PATH_LENGTH + 16];
+    FILE* fp = NULL;
+
+    if (registry == NULL)
+    {
+        return 1;
+    }
+
+    // 간격이 지나지 않았거나 다른 스레드가 쓰고 있는 경우 쓰지 않는다. 강제로 쓰는 경우에는 잠금을 기다린다.
+    if (!isForced && now - __atomic_load_n(&registry->lastExport, __ATOMIC_RELAXED) < registry->interval)
+    {
+        return 1;
+    }
+    if (isForced)
+    {
+        spinLock(&registry->exportLock);
+    }else if (__atomic_exchange_n(&registry->exportLock, 1, __ATOMIC_ACQUIRE)){
+        return 1;
+    }
+    __atomic_store_n(&registry->lastExport, now, __ATOMIC_RELAXED);
+
+    // 나누어 준 모든 스레드의 운영 지표를 합친다.
+    threadCount = __atomic_load_n(&registry->nextThread, __ATOMIC_RELAXED);
+    if (threadCount > METRIC_THREADS)
+    {
+        threadCount = METRIC_THREADS;
+    }
+    for (int t = 0; t < threadCount; t++)
+    {
+        for (int i = 0; i < METRIC_COUNTERS; i++)
+        {
+            counters[i] += __atomic_load_n(&registry->threads[t].counters[i], __ATOMIC_RELAXED);
+        }
+        for (int i = 0; i < METRIC_OPERATIONS; i++)
+        {
+            for (int b = 0; b < METRIC_BUCKETS; b++)
+            {
+                buckets[i][b] += __atomic_load_n(&registry->threads[t].buckets[i][b], __ATOMIC_RELAXED);
+            }
+            latencySum[i] += __atomic_load_n(&registry->threads[t].latencySum[i], __ATOMIC_RELAXED);
+        }
+    }
+
+    // 이용중인 좌석은 열람실별 이용종료시각 힙의 크기를 합한 것과 같다.
+    used = 0;
+    for (int i = 0; i < libSeats->header->roomCount; i++)
+    {
+        used += __atomic_load_n(&libSeats->header->rooms[i].heapSize, __ATOMIC_RELAXED);
+    }
+    freeCount = __atomic_load_n(&libSeats->header->freeCount, __ATOMIC_RELAXED);
+
+    snprintf(tmpPath, sizeof(tmpPath), "%s.%d.tmp", registry->path, (int)getpid());
+    fp = fopen(tmpPath, "w");
+    if (fp != NULL)
+    {
+        // 카운터
+        for (int i = 0; i < METRIC_COUNTERS; i++)
+        {
+            fprintf(fp, "# HELP %s %s\n# TYPE %s counter\n%s %llu\n", counterNames[i], counterHelps[i], counterNames[i], counterNames[i], counters[i]);
+        }
+
+        // 좌석 상태별 좌석 수와 이용률
+        fprintf(fp, "# HELP lss_seats Seats by state.\n# TYPE lss_seats gauge\n");
+        fprintf(fp, "lss_seats{state=\"used\"} %d\nlss_seats{state=\"free\"} %d\nlss_seats{state=\"unavailable\"} %d\n",
+            used, freeCount, libSeats->seatCount - used - freeCount);
+        fprintf(fp, "# HELP lss_occupancy_ratio Used seats over seats that are not unavailable.\n# TYPE lss_occupancy_ratio gauge\n");
+        fprintf(fp, "lss_occupancy_ratio %.6f\n", used + freeCount > 0 ? (double)used / (used + freeCount) : 0.0);
+
+        // 작업별 지연시간 히스토그램. 칸의 값은 상한 이하인 횟수의 누적이다.
+        fprintf(fp, "# HELP lss_operation_duration_seconds Time spent handling requests and housekeeping.\n# TYPE lss_operation_duration_seconds histogram\n");
+        for (int i = 0; i < METRIC_OPERATIONS; i++)
+        {
+            cumulative = 0;
+            for (int b = 0; b < METRIC_BUCKETS; b++)
+            {
+                cumulative += buckets[i][b];
+                if (b < METRIC_BUCKETS - 1)
+                {
+                    fprintf(fp, "lss_operation_duration_seconds_bucket{operation=\"%s\",le=\"%g\"} %llu\n", operationNames[i], metricBucketBound(b) / 1e9, cumulative);
+                }else{
+                    fprintf(fp, "lss_operation_duration_seconds_bucket{operation=\"%s\",le=\"+Inf\"} %llu\n", operationNames[i], cumulative);
+                }
+            }
+            fprintf(fp, "lss_operation_duration_seconds_sum{operation=\"%s\"} %.9f\n", operationNames[i], latencySum[i] / 1e9);
+            fprintf(fp, "lss_operation_duration_seconds_count{operation=\"%s\"} %llu\n", operationNames[i], cumulative);
+        }
+
+        isWritten = (fclose(fp) == 0 && rename(tmpPath, registry->path) == 0);
+        if (!isWritten)
+        {
+            unlink(tmpPath);
+        }
+    }
+
+    spinUnlock(&registry->exportLock);
+
+    return isWritten;
+}
+
+
+/*
+* metricsClose 함수
+* 기능 : 마지막 운영 지표를 지표 파일에 쓰고 운영 지표를 해제한다. 모든 작업 스레드가 끝난 후 호출한다.
+* 입력값 : 좌석 정보 구조체 포인터 *libSeats
+* 반환값 없음
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+void metricsClose(SeatsData* libSeats)
+{
+    if (libSeats->metrics == NULL)
+    {
+        return;
+    }
+
+    metricsExport(libSeats, 1);
+    free(libSeats->metrics->threads);
+    free(libSeats->metrics);
+    libSeats->metrics = NULL;
+
+    return;
+}
+
+
+/*
+* historyOpen 함수
+* 기능 : 이용 기록 파일을 열고, 끝난 이용을 모을 버퍼를 만든다. 파일이 없는 경우 새로 만들며, 있는 경우 끝에 이어서 쓴다.
+*        기록 복구 중의 퇴실은 이미 남긴 이용이므로, 기록 복구(walOpen)가 끝난 후 호출한다.
+* 입력값 : *path(이용 기록 파일 경로), 좌석 정보 구조체 포인터 *libSeats
+* 반환값 : 시작한 경우 1, 파일을 열 수 없거나 메모리가 부족한 경우 0을 반환함.
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+int historyOpen(const char* path, SeatsData* libSeats)
+{
+    HistoryData* history = malloc(sizeof(HistoryData));
+    if (history == NULL)
+    {
+        printf("이용 기록 버퍼를 만들 수 없습니다.\n");
+        return 0;
+    }
+
+    history->output = malloc(sizeof(HistoryHeader) + (size_t)HISTORY_BLOCK_SESSIONS * HISTORY_SESSION_SPACE);
+    history->sessions = malloc(sizeof(HistorySession) * HISTORY_BLOCK_SESSIONS);
+    history->spare = malloc(sizeof(HistorySession) * HISTORY_BLOCK_SESSIONS);
+    history->fd = open(path, O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+    if (history->output == NULL || history->sessions == NULL || history->spare == NULL || history->fd < 0)
+    {
+        printf("이용 기록 파일 %s을 열 수 없습니다.\n", path);
+        if (history->fd >= 0) { close(history->fd); }
+        free(history->output);
+        free(history->sessions);
+        free(history->spare);
+        free(history);
+        return 0;
+    }
+
+    pthread_mutex_init(&history->lock, NULL);
+    pthread_mutex_init(&history->writeLock, NULL);
+    history->count = 0;
+    history->capacity = HISTORY_BLOCK_SESSIONS;
+    history->spareCapacity = HISTORY_BLOCK_SESSIONS;
+    snprintf(history->path, sizeof(history->path), "%s", path);
+    libSeats->history = history;
+
+    return 1;
+}
+
+
+/*
+* historyClose 함수
+* 기능 : 버퍼에 남은 이용을 묶음으로 쓴 후 이용 기록을 해제한다. 아직 이용중인 좌석은 끝나지 않았으므로 남기지 않는다.
+* 입력값 : 좌석 정보 구조체 포인터 *libSeats
+* 반환값 없음
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+void historyClose(SeatsData* libSeats)
+{
+    HistoryData* history = libSeats->history;
+    if (history == NULL)
+    {
+        return;
+    }
+
+    historyCommit(libSeats, 1);
+    libSeats->history = NULL;
+    close(history->fd);
+    pthread_mutex_destroy(&history->lock);
+    pthread_mutex_destroy(&history->writeLock);
+    free(history->output);
+    free(history->sessions);
+    free(history->spare);
+    free(history);
+
+    return;
+}
+
+
+/*
+* historyRecord 함수
+* 기능 : 끝나는 이용 하나(좌석, 이용자, 배정 시각, 종료시각, 연장 횟수, 종료 사유)를 버퍼에 추가한다. 파일에는 쓰지 않으며, 버퍼가 가득 차면 버퍼를 늘린다.
+*        좌석 잠금을 얻은 상태에서, 좌석의 이용자와 이용종료시각을 지우기 전에 호출한다. 모은 이용은 잠금을 푼 후 historyCommit으로 쓴다.
+* 입력값 : location(0번부터 시작하는 좌석번호), reason(종료 사유, HISTORY_CHECKOUT 등), now(현재 시각, Unix 초), 좌석 정보 구조체 포인터 *libSeats
+* 반환값 없음
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+void historyRecord(int location, int reason, long long int now, SeatsData* libSeats)
+{
+    HistoryData* history = libSeats->history;
+    HistorySession* session = NULL;
+    long long int endTime = unpackEndTime(libSeats->endTime[location]);
+
+    pthread_mutex_lock(&history->lock);
+
+    // 버퍼가 가득 찬 경우 두 배로 늘린다. 폐장 후 초기화처럼 한 번에 많은 이용이 끝나는 경우에도, 잠금을 가진 채 파일에 쓰지 않는다.
+    if (history->count == history->capacity)
+    {
+        HistorySession* grown = realloc(history->sessions, sizeof(HistorySession) * (size_t)history->capacity * 2);
+        if (grown == NULL)
+        {
+            printf("이용 기록 버퍼를 늘릴 수 없습니다. 끝난 이용 하나를 남기지 못했습니다.\n");
+            pthread_mutex_unlock(&history->lock);
+            return;
+        }
+        history->sessions = grown;
+        history->capacity *= 2;
+    }
+
+    session = &history->sessions[history->count];
+    session->start = unpackEndTime(libSeats->sessionStart[location]);
+    session->end = endTime < now ? endTime : now; // 시간 만료는 이용종료시각에, 그 외에는 지금 끝난다.
+    session->end = session->end > session->start ? session->end : session->start;
+    session->location = location;
+    session->renewCount = libSeats->renewCount[location];
+    session->reason = (unsigned char)reason;
+    memcpy(session->name, libSeats->userName[libSeats->seatUser[location]], MAX_NAME_LENGTH);
+    __atomic_store_n(&history->count, history->count + 1, __ATOMIC_RELAXED);
+
+    pthread_mutex_unlock(&history->lock);
+
+    return;
+}
+
+
+/*
+* historyCommit 함수
+* 기능 : 버퍼에 모인 이용을 HISTORY_BLOCK_SESSIONS개씩 묶음으로 이용 기록 파일에 쓴다. 좌석 잠금을 가지지 않은 상태(요청 처리가 끝난 후)에서 호출한다.
+*        버퍼를 예비 버퍼와 맞바꾼 후 쓰므로, 파일에 쓰는 동안에도 다른 스레드는 이용을 모을 수 있다.
+* 입력값 : 좌석 정보 구조체 포인터 *libSeats, isForced(1이면 모인 이용이 적어도 쓰고, 0이면 HISTORY_BLOCK_SESSIONS개 이상 모인 경우에만 씀)
+* 반환값 없음
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+void historyCommit(SeatsData* libSeats, int isForced)
+{
+    HistoryData* history = libSeats->history;
+    HistorySession* sessions = NULL;
+    int count = 0, capacity = 0;
+
+    // 이용 기록을 남기지 않거나, 묶음 하나를 채울 만큼 모이지 않은 경우 함수 종료
+    if (history == NULL || (!isForced && __atomic_load_n(&history->count, __ATOMIC_RELAXED) < HISTORY_BLOCK_SESSIONS))
+    {
+        return;
+    }
+
+    // 모인 이용을 예비 버퍼와 맞바꿔 가져온다. (쓰기 잠금 -> 이용 기록 잠금 순서)
+    pthread_mutex_lock(&history->writeLock);
+    pthread_mutex_lock(&history->lock);
+    sessions = history->sessions;
+    capacity = history->capacity;
+    count = history->count;
+    history->sessions = history->spare;
+    history->capacity = history->spareCapacity;
+    __atomic_store_n(&history->count, 0, __ATOMIC_RELAXED);
+    pthread_mutex_unlock(&history->lock);
+
+    // 이용 기록 잠금을 푼 후 묶음으로 나누어 쓴다.
+    for (int i = 0; i < count; i += HISTORY_BLOCK_SESSIONS)
+    {
+        historyFlush(history, sessions + i, count - i < HISTORY_BLOCK_SESSIONS ? count - i : HISTORY_BLOCK_SESSIONS);
+    }
+    history->spare = sessions;
+    history->spareCapacity = capacity;
+    pthread_mutex_unlock(&history->writeLock);
+
+    return;
+}
+
+
+/*
+* historyFlush 함수
+* 기능 : 이용들을 열 단위의 묶음 하나로 바꾸어 이용 기록 파일 끝에 한 번에 쓴다. 이용 기록의 쓰기 잠금(writeLock)을 얻은 상태에서 호출한다.
+*        시작시각은 앞 이용과의 차이를, 이용자명은 묶음 안에서 처음 나온 순서대로 번호를 매긴 사전의 번호를 저장한다.
+* 입력값 : 이용 기록 구조체 포인터 *history, 쓸 이용 배열 sessions, count(이용 수, HISTORY_BLOCK_SESSIONS 이하)
+* 반환값 : 쓴 경우(쓸 이용이 없는 경우 포함) 1, 쓰지 못한 경우 0을 반환함. 쓰지 못한 이용은 버린다.
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+int historyFlush(HistoryData* history, const HistorySession* sessions, int count)
+{
+    HistoryHeader header;
+    unsigned char* data = history->output + sizeof(HistoryHeader);
+    unsigned char* column = data;
+    unsigned int slot = 0;
+    long long int previous = 0, delta = 0;
+    size_t length = 0, nameLength = 0;
+    int isWritten = 0;
+
+    if (count == 0)
+    {
+        return 1;
+    }
+
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, HISTORY_MAGIC, sizeof(header.magic));
+    header.sessionCount = (unsigned int)count;
+    header.minStart = sessions[0].start;
+    header.maxEnd = sessions[0].end;
+    for (int i = 1; i < count; i++)
+    {
+        header.minStart = sessions[i].start < header.minStart ? sessions[i].start : header.minStart;
+        header.maxEnd = sessions[i].end > header.maxEnd ? sessions[i].end : header.maxEnd;
+    }
+
+    // 시작시각 열 : 앞 이용(첫 이용은 가장 이른 시작시각)과의 차이를 지그재그 부호화하여 음수도 작은 수로 저장한다.
+    previous = header.minStart;
+    for (int i = 0; i < count; i++)
+    {
+        delta = sessions[i].start - previous;
+        column += putVarint(column, ((unsigned long long int)delta << 1) ^ (unsigned long long int)(delta >> 63));
+        previous = sessions[i].start;
+    }
+    header.columnSize[0] = (unsigned int)(column - data);
+
+    // 이용 시간 열과 좌석번호 열
+    data = column;
+    for (int i = 0; i < count; i++)
+    {
+        column += putVarint(column, (unsigned long long int)(sessions[i].end - sessions[i].start));
+    }
+    header.columnSize[1] = (unsigned int)(column - data);
+    data = column;
+    for (int i = 0; i < count; i++)
+    {
+        column += putVarint(column, (unsigned long long int)sessions[i].location);
+        header.maxLocation = sessions[i].location > header.maxLocation ? sessions[i].location : header.maxLocation;
+    }
+    header.columnSize[2] = (unsigned int)(column - data);
+
+    // 이용자 열 : 이용자명을 해시 테이블로 찾아, 처음 나온 이름이면 사전에 새 번호를 매긴다.
+    memset(history->dictSession, 0, sizeof(history->dictSession));
+    data = column;
+    for (int i = 0; i < count; i++)
+    {
+        slot = hashName(sessions[i].name) & (HISTORY_DICT_SIZE - 1);
+        while (history->dictSession[slot] != 0 && strncmp(sessions[history->dictSession[slot] - 1].name, sessions[i].name, MAX_NAME_LENGTH) != 0)
+        {
+            slot = (slot + 1) & (HISTORY_DICT_SIZE - 1);
+        }
+        if (history->dictSession[slot] == 0)
+        {
+            history->dictSession[slot] = (unsigned short)(i + 1);
+            history->dictIndex[slot] = (unsigned short)header.nameCount++;
+        }
+        column += putVarint(column, history->dictIndex[slot]);
+    }
+    header.columnSize[3] = (unsigned int)(column - data);
+
+    // 연장 횟수 열과 종료 사유 열
+    for (int i = 0; i < count; i++)
+    {
+        column[i] = sessions[i].renewCount;
+        column[count + i] = sessions[i].reason;
+    }
+    header.columnSize[4] = header.columnSize[5] = (unsigned int)count;
+    column += 2 * count;
+
+    // 이용자명 사전 : 사전 번호 순서(처음 나온 순서)는 이용 순서와 같으므로, 이용 순서대로 처음 나온 이름만 쓴다.
+    data = column;
+    for (int i = 0; i < count; i++)
+    {
+        slot = hashName(sessions[i].name) & (HISTORY_DICT_SIZE - 1);
+        while (history->dictSession[slot] - 1 != i && strncmp(sessions[history->dictSession[slot] - 1].name, sessions[i].name, MAX_NAME_LENGTH) != 0)
+        {
+            slot = (slot + 1) & (HISTORY_DICT_SIZE - 1);
+        }
+        if (history->dictSession[slot] - 1 == i)
+        {
+            nameLength = strnlen(sessions[i].name, MAX_NAME_LENGTH - 1);
+            *column++ = (unsigned char)nameLength;
+            memcpy(column, sessions[i].name, nameLength);
+            column += nameLength;
+        }
+    }
+    header.dictionarySize = (unsigned int)(column - data);
+
+    // 머리 부분을 채워 묶음 전체를 한 번에 쓴다. O_APPEND이므로 다른 단말기의 묶음과 섞이지 않는다.
+    length = (size_t)(column - history->output);
+    header.checksum = historyChecksum(history->output + sizeof(HistoryHeader), length - sizeof(HistoryHeader));
+    memcpy(history->output, &header, sizeof(header));
+    isWritten = write(history->fd, history->output, length) == (ssize_t)length;
+    if (!isWritten)
+    {
+        printf("이용 기록 파일 %s에 쓸 수 없습니다.\n", history->path);
+    }
+
+    return isWritten;
+}
+
+
+/*
+* putVarint 함수
+* 기능 : 부호 없는 정수를 가변 길이 정수(7비트씩, 이어지는 바이트가 있으면 최상위 비트가 1)로 쓴다.
+* 입력값 : *output(쓸 위치, 10바이트 이상), value(쓸 값)
+* 반환값 : 쓴 크기(바이트)
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+size_t putVarint(unsigned char* output, unsigned long long int value)
+{
+    size_t length = 0;
+
+    while (value >= 0x80)
+    {
+        output[length++] = (unsigned char)(value | 0x80);
+        value >>= 7;
+    }
+    output[length++] = (unsigned char)value;
+
+    return length;
+}
+
+
+/*
+* getVarint 함수
+* 기능 : 가변 길이 정수 하나를 읽고, 읽을 위치를 다음 값으로 옮긴다.
+* 입력값 : **cursor(읽을 위치), *end(열의 끝), *value(읽은 값을 저장할 변수)
+* 반환값 : 읽은 경우 1, 열의 끝을 넘거나 10바이트를 넘는 경우 0을 반환함.
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+int getVarint(const unsigned char** cursor, const unsigned char* end, unsigned long long int* value)
+{
+    const unsigned char* pos = *cursor;
+    unsigned long long int result = 0;
+
+    for (int shift = 0; pos < end && shift < 64; shift += 7)
+    {
+        result |= (unsigned long long int)(*pos & 0x7F) << shift;
+        if (!(*pos++ & 0x80))
+        {
+            *cursor = pos;
+            *value = result;
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+
+/*
+* historyChecksum 함수
+* 기능 : 묶음 자료의 검사합을 계산한다. 기록 파일과 같은 FNV-1a 해시를 이용한다.
+* 입력값 : *data(자료), length(자료 크기, 바이트)
+* 반환값 : 검사합
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+unsigned int historyChecksum(const unsigned char* data, size_t length)
+{
+    unsigned int hash = 2166136261u;
+
+    for (size_t i = 0; i < length; i++)
+    {
+        hash ^= data[i];
+        hash *= 16777619u;
+    }
+
+    return hash;
+}
+
+
+/*
+* runHistoryQuery 함수
+* 기능 : 이용 기록 파일을 읽어 시간대(hour), 요일(weekday) 또는 좌석(seat)별로 집계하고, 결과를 CSV 형식으로 표준 출력에 쓴다.
+*        묶음마다 집계에 필요한 열만 풀어 배열로 만든 후 이어서 훑는다. 시간대와 요일 집계는 기간 안의 1시간 구간마다 이용 시간(초)을 모으는데,
+*        이용 하나는 처음과 마지막 구간에만 직접 더하고 그 사이의 구간은 차이 배열에 표시하므로, 이용이 길어도 일정한 시간이 걸린다.
+* 입력값 : *path(이용 기록 파일 경로), *group(집계 기준 : "hour", "weekday", "seat"), *range(집계 기간 "YYYYMMDD,YYYYMMDD", NULL이면 전체 기간)
+* 반환값 : 집계한 경우 1, 파일을 읽을 수 없거나 인자가 잘못된 경우 0을 반환함.
+* 설명 최종 수정 일자 : 2026/10/17
+*
+* 출력 형식
+* hour, weekday : 구간(0~23시 또는 Sun~Sat), 그 구간에 시작한 이용 수, 이용 좌석 시간의 합, 평균 이용 좌석 수, 1시간 평균 이용 좌석 수의 최댓값
+* seat          : 좌석번호, 이용 수, 이용 좌석 시간의 합, 연장 횟수의 합, 시간 만료로 끝난 이용 수
+*/
+int runHistoryQuery(const char* path, const char* group, const char* range)
+{
+    static const char* const weekdayNames[7] = { "Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat" };
+    int isSeat = !strcmp(group, "seat"), isWeekday = !strcmp(group, "weekday");
+    int fd = -1, blockNo = 0, groupCount = isWeekday ? 7 : 24, seatCount = 0, first = 0, last = 0, isOk = 1;
+    long long int from = 0, to = 0, base = 0, hourCount = 0, start = 0, end = 0, fullHours = 0;
+    size_t fileSize = 0, offset = 0, blockSize = 0;
+    unsigned long long int value = 0;
+    const unsigned char* file = NULL;
+    const unsigned char* cursor = NULL;
+    const unsigned char* columnEnd = NULL;
+    HistoryHeader header;
+    struct stat fileStat;
+    struct tm date;
+
+    // 이용 하나를 푼 열 (묶음 하나 크기)
+    long long int* starts = NULL;
+    long long int* durations = NULL;
+    int* locations = NULL;
+    const unsigned char* renewals = NULL;
+    const unsigned char* reasons = NULL;
+
+    // 집계 결과. 시간대, 요일 집계는 1시간 구간별, 좌석 집계는 좌석별로 모은다.
+    long long int* seconds = NULL;
+    int* started = NULL;
+    int* full = NULL;
+    long long int* seatSessions = NULL;
+    long long int* seatRenewals = NULL;
+    long long int* seatExpired = NULL;
+    long long int groupSessions[24] = { 0 }, groupSeconds[24] = { 0 }, groupPeak[24] = { 0 }, groupHours[24] = { 0 };
+
+    if (!isSeat && !isWeekday && strcmp(group, "hour") != 0)
+    {
+        printf("집계 기준은 hour, weekday, seat 중 하나입니다.\n");
+        return 0;
+    }
+
+    // 집계 기간을 읽는다. 끝 날짜는 그날 자정 전까지 포함한다.
+    from = 0;
+    to = (long long int)1 << 62;
+    if (range != NULL)
+    {
+        memset(&date, 0, sizeof(date));
+        if (sscanf(range, "%4d%2d%2d,%4d%2d%2d", &date.tm_year, &date.tm_mon, &date.tm_mday, &first, &last, &seatCount) != 6)
+        {
+            printf("집계 기간은 YYYYMMDD,YYYYMMDD 형식입니다.\n");
+            return 0;
+        }
+        date.tm_year -= 1900;
+        date.tm_mon -= 1;
+        date.tm_isdst = -1;
+        from = (long long int)mktime(&date);
+        memset(&date, 0, sizeof(date));
+        date.tm_year = first - 1900;
+        date.tm_mon = last - 1;
+        date.tm_mday = seatCount + 1;
+        date.tm_isdst = -1;
+        to = (long long int)mktime(&date);
+        seatCount = 0;
+    }
+
+    // 이용 기록 파일 전체를 읽기 전용으로 대응한다.
+    fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0 || fstat(fd, &fileStat) != 0)
+    {
+        printf("이용 기록 파일 %s을 열 수 없습니다.\n", path);
+        if (fd >= 0) { close(fd); }
+        return 0;
+    }
+    fileSize = (size_t)fileStat.st_size;
+    if (fileSize > 0)
+    {
+        file = mmap(NULL, fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    close(fd);
+    if (fileSize > 0 && file == MAP_FAILED)
+    {
+        printf("이용 기록 파일 %s을 읽을 수 없습니다.\n", path);
+        return 0;
+    }
+
+    // 1단계 : 묶음의 머리 부분과 검사합을 확인하여, 집계 기간 안의 시각 범위와 가장 큰 좌석번호를 구한다. 손상된 묶음부터는 읽지 않는다.
+    base = to;
+    end = from;
+    for (offset = 0; offset < fileSize; offset += blockSize, blockNo++)
+    {
+        if (fileSize - offset < sizeof(HistoryHeader))
+        {
+            break;
+        }
+        memcpy(&header, file + offset, sizeof(header));
+        blockSize = sizeof(HistoryHeader) + header.dictionarySize;
+        for (int c = 0; c < HISTORY_COLUMNS; c++)
+        {
+            blockSize += header.columnSize[c];
+        }
+        if (memcmp(header.magic, HISTORY_MAGIC, sizeof(header.magic)) != 0 || header.sessionCount == 0 || header.sessionCount > HISTORY_BLOCK_SESSIONS
+            || header.columnSize[4] != header.sessionCount || header.columnSize[5] != header.sessionCount || blockSize > fileSize - offset
+            || header.maxLocation < 0 || header.maxLocation >= MAX_SEATS
+            || historyChecksum(file + offset + sizeof(HistoryHeader), blockSize - sizeof(HistoryHeader)) != header.checksum)
+        {
+            break;
+        }
+        if (header.maxEnd > from && header.minStart < to)
+        {
+            base = header.minStart < base ? header.minStart : base;
+            end = header.maxEnd > end ? header.maxEnd : end;
+            seatCount = header.maxLocation + 1 > seatCount ? header.maxLocation + 1 : seatCount;
+        }
+    }
+    if (offset < fileSize)
+    {
+        printf("이용 기록 파일 %s의 %d번째 묶음부터 손상되어 읽지 않습니다.\n", path, blockNo + 1);
+        fileSize = offset;
+    }
+
+    // 기간을 집계 기간으로 자르고, 1시간 단위로 맞춘다.
+    base = base > from ? base : from;
+    end = end < to ? end : to;
+    base -= ((base % 3600) + 3600) % 3600;
+    hourCount = end > base ? (end - base + 3599) / 3600 : 0;
+
+    starts = malloc(sizeof(long long int) * HISTORY_BLOCK_SESSIONS);
+    durations = malloc(sizeof(long long int) * HISTORY_BLOCK_SESSIONS);
+    locations = malloc(sizeof(int) * HISTORY_BLOCK_SESSIONS);
+    if (isSeat)
+    {
+        seconds = calloc((size_t)seatCount + 1, sizeof(long long int));
+        seatSessions = calloc((size_t)seatCount + 1, sizeof(long long int));
+        seatRenewals = calloc((size_t)seatCount + 1, sizeof(long long int));
+        seatExpired = calloc((size_t)seatCount + 1, sizeof(long long int));
+        isOk = seconds != NULL && seatSessions != NULL && seatRenewals != NULL && seatExpired != NULL;
+    }else{
+        seconds = calloc((size_t)hourCount + 1, sizeof(long long int));
+        started = calloc((size_t)hourCount + 1, sizeof(int));
+        full = calloc((size_t)hourCount + 2, sizeof(int));
+        isOk = seconds != NULL && started != NULL && full != NULL;
+    }
+    if (!isOk || starts == NULL || durations == NULL || locations == NULL)
+    {
+        printf("집계에 필요한 메모리가 부족합니다.\n");
+        isOk = 0;
+        fileSize = 0;
+    }
+
+    // 2단계 : 집계 기간과 겹치는 묶음마다 필요한 열만 풀어 집계한다.
+    for (offset = 0; offset < fileSize; offset += blockSize)
+    {
+        memcpy(&header, file + offset, sizeof(header));
+        blockSize = sizeof(HistoryHeader) + header.dictionarySize;
+        for (int c = 0; c < HISTORY_COLUMNS; c++)
+        {
+            blockSize += header.columnSize[c];
+        }
+        if (header.maxEnd <= from || header.minStart >= to)
+        {
+            continue;
+        }
+
+        // 시작시각 열과 이용 시간 열을 푼다. 좌석 집계는 좌석번호, 연장 횟수, 종료 사유 열도 이용하며, 이용자 열과 사전은 읽지 않는다.
+        cursor = file + offset + sizeof(HistoryHeader);
+        columnEnd = cursor + header.columnSize[0];
+        start = header.minStart;
+        for (unsigned int i = 0; i < header.sessionCount && getVarint(&cursor, columnEnd, &value); i++)
+        {
+            start += (long long int)(value >> 1) ^ -(long long int)(value & 1);
+            starts[i] = start;
+        }
+        cursor = columnEnd;
+        columnEnd = cursor + header.columnSize[1];
+        for (unsigned int i = 0; i < header.sessionCount; i++)
+        {
+            durations[i] = getVarint(&cursor, columnEnd, &value) ? (long long int)value : 0;
+        }
+        cursor = columnEnd;
+        columnEnd = cursor + header.columnSize[2];
+        for (unsigned int i = 0; i < header.sessionCount; i++)
+        {
+            locations[i] = getVarint(&cursor, columnEnd, &value) && value <= (unsigned long long int)header.maxLocation ? (int)value : 0;
+        }
+        renewals = columnEnd + header.columnSize[3];
+        reasons = renewals + header.sessionCount;
+
+        for (unsigned int i = 0; i < header.sessionCount; i++)
+        {
+            // 이용을 집계 기간으로 자른다. 기간 밖의 이용은 건너뛴다.
+            start = starts[i] > from ? starts[i] : from;
+            end = starts[i] + durations[i] < to ? starts[i] + durations[i] : to;
+            if (start >= end && !(durations[i] == 0 && starts[i] >= from && starts[i] < to))
+            {
+                continue;
+            }
+
+            if (isSeat)
+            {
+                seatSessions[locations[i]]++;
+                seconds[locations[i]] += end - start;
+                seatRenewals[locations[i]] += renewals[i];
+                seatExpired[locations[i]] += reasons[i] == HISTORY_EXPIRED;
+                continue;
+            }
+
+            // 처음과 마지막 구간에는 걸친 시간만큼 더하고, 그 사이의 구간은 차이 배열에 표시해 나중에 한 번에 3600초씩 더한다.
+            first = (int)((start - base) / 3600);
+            last = (int)((end - 1 - base) / 3600);
+            if (starts[i] >= from)
+            {
+                started[first]++;
+            }
+            if (end <= start)
+            {
+                continue;
+            }
+            if (first == last)
+            {
+                seconds[first] += end - start;
+            }else{
+                seconds[first] += base + (first + 1) * 3600LL - start;
+                seconds[last] += end - (base + last * 3600LL);
+                full[first + 1]++;
+                full[last]--;
+            }
+        }
+    }
+
+    if (isOk && isSeat)
+    {
+        printf("seat,sessions,seat_hours,renewals,expired\n");
+        for (int s = 0; s < seatCount; s++)
+        {
+            if (seatSessions[s] > 0)
+            {
+                printf("%d,%lld,%.2f,%lld,%lld\n", s + 1, seatSessions[s], seconds[s] / 3600.0, seatRenewals[s], seatExpired[s]);
+            }
+        }
+
+    }else if (isOk){
+
+        // 차이 배열을 누적하여 구간마다 통째로 이용한 좌석 수를 구하고, 3600초씩 더한다.
+        fullHours = 0;
+        for (long long int h = 0; h < hourCount; h++)
+        {
+            fullHours += full[h];
+            seconds[h] += fullHours * 3600;
+        }
+
+        // 1시간 구간마다 현지 시각의 시간대(또는 요일)를 구해 모은다.
+        for (long long int h = 0; h < hourCount; h++)
+        {
+            time_t hourStart = (time_t)(base + h * 3600);
+            localtime_r(&hourStart, &date);
+            first = isWeekday ? date.tm_wday : date.tm_hour;
+            groupSessions[first] += started[h];
+            groupSeconds[first] += seconds[h];
+            groupPeak[first] = seconds[h] > groupPeak[first] ? seconds[h] : groupPeak[first];
+            groupHours[first]++;
+        }
+
+        printf("%s,sessions,seat_hours,avg_occupied,peak_occupied\n", isWeekday ? "weekday" : "hour");
+        for (int g = 0; g < groupCount; g++)
+        {
+            if (isWeekday)
+            {
+                printf("%s,", weekdayNames[g]);
+            }else{
+                printf("%d,", g);
+            }
+            printf("%lld,%.2f,%.2f,%.2f\n", groupSessions[g], groupSeconds[g] / 3600.0,
+                groupHours[g] > 0 ? groupSeconds[g] / (groupHours[g] * 3600.0) : 0.0, groupPeak[g] / 3600.0);
+        }
+    }
+
+    free(starts);
+    free(durations);
+    free(locations);
+    free(seconds);
+    free(started);
+    free(full);
+    free(seatSessions);
+    free(seatRenewals);
+    free(seatExpired);
+    if (file != NULL)
+    {
+        munmap((void*)file, (size_t)fileStat.st_size);
+    }
+
+    return isOk;
+}
+
+
+/*
+* fillSeatResponse 함수
+* 기능 : 주어진 좌석의 상태, 열람실, 이용종료시각과 연장 가능 여부를 응답에 저장한다.
+* 입력값 : location(0번부터 시작하는 좌석번호), 응답 구조체 포인터 *response, 좌석 정보 구조체 포인터 *libSeats, 현재 시각 정보 구조체 포인터 *clock
+* 반환값 없음
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+void fillSeatResponse(int location, SeatResponse* response, SeatsData* libSeats, ClockContext* clock)
+{
+    RoomData* room = roomOf(libSeats, location);
+    ClockContext roomClock = *clock;
+
+    response->location = location;
+    response->state = libSeats->seatState[location];
+    response->room = (unsigned char)(room - libSeats->header->rooms + 1);
+
+    // 이용중인 좌석인 경우에만 이용종료시각과 연장 가능 여부를 저장한다. 연장 가능 여부는 좌석이 속한 열람실의 운영정보로 판단한다.
+    if (response->state == SEAT_USED)
+    {
+        setRoomClock(&roomClock, libSeats, room);
+        response->endTime = unpackEndTime(libSeats->endTime[location]);
+        response->renewable = (unsigned char)isRenewable(location, libSeats, &room->libData, &roomClock);
+    }
+
+    return;
+}
+
+
+/*
+* adminCommand 함수
+* 기능 : 좌석 서비스의 관리자 명령을 실행한다. 명령 번호와 값의 범위는 관리자 모드의 메뉴와 같다.
+*        요청의 열람실 번호(room)가 0이면 모든 열람실에, 그렇지 않으면 해당 열람실에만 적용한다.
+* 입력값 : 요청 구조체 포인터 *request, 좌석 정보 구조체 포인터 *libSeats
+* 반환값 : 응답 결과 (RESULT_OK 또는 RESULT_BAD_REQUEST)
+* 설명 최종 수정 일자 : 2026/10/17
+*
+* 1 : 좌석 초기화, 2 : 최대 이용 가능 시간(value, 분), 3 : 연장 가능 시간(value, 분), 4 : 개장시각(value, 0시 기준 분), 5 : 폐장시각(value, 0시 기준 분),
+* 7 : 좌석(location) 이용불가 설정 변경
+*/
+int adminCommand(const SeatRequest* request, SeatsData* libSeats)
+{
+    RoomData* rooms = libSeats->header->rooms;
+    int first = request->room - 1;
+    int last = request->room - 1;
+
+    if (request->command == 7) // 좌석 이용불가 설정
+    {
+        if (request->location < 0 || request->location >= libSeats->seatCount)
+        {
+            return RESULT_BAD_REQUEST;
+        }
+        toggleSeatState(request->location, libSeats);
+        return RESULT_OK;
+    }
+
+    if (request->room > libSeats->header->roomCount || request->command < 1 || request->command > 5)
+    {
+        return RESULT_BAD_REQUEST;
+    }
+    if (request->room == 0) // 모든 열람실
+    {
+        first = 0;
+        last = libSeats->header->roomCount - 1;
+    }
+
+    if (request->command == 1) // 좌석 초기화
+    {
+        for (int i = first; i <= last; i++)
+        {
+            resetSeats(libSeats, &rooms[i], 0, HISTORY_RESET);
+        }
+        return RESULT_OK;
+    }
+
+    // 연장 가능 시간은 열람실마다 최대 이용 가능 시간이 다르므로, 일부 열람실에만 반영되지 않도록 모든 열람실의 값을 먼저 확인한다.
+    if (request->command == 3)
+    {
+        for (int i = first; i <= last; i++)
+        {
+            if (request->value > __atomic_load_n(&rooms[i].libData.MAX_TIME, __ATOMIC_RELAXED))
+            {
+                return RESULT_BAD_REQUEST;
+            }
+        }
+    }
+
+    for (int i = first; i <= last; i++)
+    {
+        if (!roomCommand(request->command, request->value, libSeats, &rooms[i]))
+        {
+            return RESULT_BAD_REQUEST;
+        }
+    }
+
+    return RESULT_OK;
+}
+
+
+/*
+* roomCommand 함수
+* 기능 : 열람실 하나의 운영정보를 바꾸는 관리자 명령(2~5)을 실행한다. 운영정보 잠금을 얻은 후 복사본을 바꾸고, 올바른 값인 경우에만 반영한다.
+* 입력값 : command(명령 번호), value(명령 값), 좌석 정보 구조체 포인터 *libSeats, 열람실 구조체 포인터 *room
+* 반환값 : 반영한 경우 1, 잘못된 명령이나 값인 경우 0을 반환함.
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+int roomCommand(int command, int value, SeatsData* libSeats, RoomData* room)
+{
+    LibraryData newData;
+
+    spinLock(&room->configLock);
+    newData = room->libData;
+
+    switch (command)
+    {
+    case 2: // 최대 이용 가능 시간 수정. 연장 가능 시간을 초과하는 경우 연장 가능 시간도 함께 줄인다.
+        if (value <= 0 || value > 24 * 60) { break; }
+        newData.MAX_TIME = value;
+        if (newData.MAX_TIME < newData.MAX_RENEWABLE_TIME)
+        {
+            newData.MAX_RENEWABLE_TIME = newData.MAX_TIME;
+        }
+        updateLibraryData(libSeats, room, &newData);
+        spinUnlock(&room->configLock);
+        return 1;
+
+    case 3: // 연장 가능 시간 수정. 최대 이용 가능 시간을 초과할 수 없다.
+        if (value < 0 || value > 24 * 60 || value > newData.MAX_TIME) { break; }
+        newData.MAX_RENEWABLE_TIME = value;
+        updateLibraryData(libSeats, room, &newData);
+        spinUnlock(&room->configLock);
+        return 1;
+
+    case 4: // 개장시각 수정
+    case 5: // 폐장시각 수정. 운영 달력을 이용하는 경우, 운영시간은 달력 파일을 따르므로 바꿀 수 없다.
+        if (value < 0 || value >= 24 * 60 || libSeats->calendar != NULL) { break; }
+        if (command == 4)
+        {
+            newData.OPEN_TIME = value;
+        }else{
+            newData.CLOSE_TIME = value;
+        }
+        updateLibraryData(libSeats, room, &newData);
+        spinUnlock(&room->configLock);
+        return 1;
+    }
+
+    // 알 수 없는 명령이거나 잘못된 값인 경우
+    spinUnlock(&room->configLock);
+
+    return 0;
+}
+
+
+/*
+* handleRequest 함수
+* 기능 : 좌석 서비스 요청 하나를 처리하고 응답을 작성한다. 요청마다 현재 시각 정보를 한 번 생성하고, 만료된 좌석을 먼저 퇴실 처리한다.
+*        대화형 모드(seatSelector)와 같은 함수(setSeat, renewSeat, checkOut, isRenewable)를 이용하며, 좌석을 바꾸기 전에는 좌석 잠금을 얻은 후 이용자를 다시 확인한다.
+*        기록은 확정하지 않으므로, 호출한 쪽에서 결과를 알리기 전에 walCommit을 호출해야 한다.
+*        좌석을 지정하지 않은 배정 요청은 열람실 번호(room)가 있으면 해당 열람실에서, 없으면 운영중인 모든 열람실에서 빈 좌석을 찾는다.
+*        대기 요청은 배정할 좌석이 없는 경우 대기열에 등록하고 RESULT_WAITING으로 응답한다. 좌석을 맡기면 fd의 연결에 알린다.
+* 입력값 : 요청 구조체 포인터 *request, 응답 구조체 포인터 *response, 좌석 정보 구조체 포인터 *libSeats,
+*          운영 지표 구조체 포인터 *metrics(요청을 처리하는 스레드의 운영 지표, 모으지 않는 경우 NULL), fd(요청이 온 좌석 서비스 연결, 없으면 -1)
+* 반환값 없음
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+void handleRequest(const SeatRequest* request, SeatResponse* response, SeatsData* libSeats, MetricsData* metrics, int fd)
+{
+    long long int start = metricsNow(metrics);
+    ClockContext clock;
+    ClockContext roomClock;
+    RoomData* room = NULL;
+    char name[MAX_NAME_LENGTH];
+    int location = -1;
+    long long int deadline = 0;
+
+    // 이용자명은 끝에 '\0'이 없을 수 있으므로, 복사한 후 마지막 글자를 '\0'으로 바꾼다.
+    memcpy(name, request->name, MAX_NAME_LENGTH);
+    name[MAX_NAME_LENGTH - 1] = '\0';
+
+    memset(response, 0, sizeof(SeatResponse));
+    response->location = -1;
+
+    // 현재 시각 정보를 생성하고, 시간 만료 및 폐장시각이 지난 좌석을 퇴실 처리한다.
+    captureClock(&clock, libSeats, &libSeats->header->rooms[0]);
+    expireSeats(libSeats, &clock, metrics);
+
+    switch (request->type)
+    {
+    case REQUEST_ASSIGN: // 좌석 배정
+    case REQUEST_WAIT: // 자동 배정, 배정할 좌석이 없으면 대기열 등록
+        if (name[0] == '\0' || request->location < -1 || request->location >= libSeats->seatCount || request->room > libSeats->header->roomCount
+            || (request->type == REQUEST_WAIT && (request->location != -1 || request->value < 0 || request->value >= WAIT_CLASSES)))
+        {
+            response->result = RESULT_BAD_REQUEST;
+            break;
+        }
+
+        // 좌석을 지정한 경우 좌석이 속한 열람실을, 그렇지 않은 경우 요청한 열람실(없으면 NULL)을 이용한다.
+        if (request->location != -1)
+        {
+            room = roomOf(libSeats, request->location);
+            if (request->room && room != &libSeats->header->rooms[request->room - 1])
+            {
+                response->result = RESULT_BAD_REQUEST;
+                break;
+            }
+        }else if (request->room){
+            room = &libSeats->header->rooms[request->room - 1];
+        }
+
+        // 열람실을 정한 경우 해당 열람실의 운영시간을, 그렇지 않은 경우 운영중인 열람실이 있는지 확인한다.
+        roomClock = clock;
+        if (room != NULL)
+        {
+            setRoomClock(&roomClock, libSeats, room);
+        }
+        if (room != NULL ? !isOperationTime(&roomClock) : !isAnyRoomOpen(libSeats, &clock))
+        {
+            response->result = RESULT_CLOSED;
+            break;
+        }
+
+        if (request->location == -1) // 자동 배정
+        {
+            // 대기 요청인 경우, 대기열에서 이용자에게 맡겨 둔 좌석이 있으면 그 좌석을 먼저 배정한다.
+            if (request->type == REQUEST_WAIT && findClaim(name, clock.now, &location, libSeats))
+            {
+                roomClock = clock;
+                setRoomClock(&roomClock, libSeats, roomOf(libSeats, location));
+                location = setSeat(name, location, libSeats, &roomOf(libSeats, location)->libData, &roomClock) ? location : -1;
+            }
+            if (location == -1)
+            {
+                location = autoAssign(name, libSeats, room, &clock);
+            }
+        }else{ // 좌석 지정 배정
+            location = setSeat(name, request->location, libSeats, &room->libData, &roomClock) ? request->location : -1;
+        }
+
+        if (location != -1) // 배정한 경우
+        {
+            fillSeatResponse(location, response, libSeats, &clock);
+            break;
+        }
+
+        // 배정하지 못한 경우, 이미 좌석을 배정받은 이용자인지 확인하여 결과를 구분한다.
+        location = findUser(name, libSeats);
+        if (location != -1)
+        {
+            response->result = RESULT_ALREADY_SEATED;
+            fillSeatResponse(location, response, libSeats, &clock);
+
+        }else if (quotaLeft(name, &clock, libSeats) == 0){ // 오늘의 이용 한도를 모두 쓴 경우, 대기열에도 등록하지 않는다.
+            response->result = RESULT_QUOTA;
+
+        }else if (request->type == REQUEST_WAIT){ // 대기열에 등록한다. 대기열이 가득 찬 경우 만석으로 응답한다.
+            response->position = joinWaitList(name, request->room, request->value, fd, libSeats);
+            response->result = response->position ? RESULT_WAITING : RESULT_FULL;
+
+        }else if (request->location == -1){
+            response->result = RESULT_FULL;
+
+        }else{
+            response->result = RESULT_SEAT_TAKEN;
+            fillSeatResponse(request->location, response, libSeats, &clock);
+        }
+        break;
+
+    case REQUEST_RENEW: // 좌석 연장
+    case REQUEST_CHECKOUT: // 퇴실
+        location = findUser(name, libSeats);
+        if (location == -1)
+        {
+            response->result = RESULT_NO_SEAT;
+            break;
+        }
+
+        // 연장 가능 여부는 좌석이 속한 열람실의 운영정보로 판단한다.
+        room = roomOf(libSeats, location);
+        roomClock = clock;
+        setRoomClock(&roomClock, libSeats, room);
+
+        // 다른 연결에서 먼저 퇴실 처리했을 수 있으므로, 좌석 잠금을 얻은 후 이용자를 다시 확인한다.
+        spinLock(&libSeats->seatLock[location]);
+        if (libSeats->seatState[location] != SEAT_USED || strcmp(libSeats->userName[libSeats->seatUser[location]], name))
+        {
+            response->result = RESULT_NO_SEAT;
+
+        }else if (request->type == REQUEST_CHECKOUT){
+            checkOut(location, HISTORY_CHECKOUT, libSeats);
+            handOffSeat(location, libSeats);
+
+        }else if (isRenewable(location, libSeats, &room->libData, &roomClock)){
+            renewSeat(location, libSeats, &room->libData, &roomClock);
+
+        }else{
+            response->result = RESULT_NOT_RENEWABLE;
+        }
+        spinUnlock(&libSeats->seatLock[location]);
+
+        if (response->result != RESULT_NO_SEAT)
+        {
+            fillSeatResponse(location, response, libSeats, &clock);
+        }
+        break;
+
+    case REQUEST_STATUS: // 이용자명이 있으면 이용자의 좌석, 없으면 지정한 좌석의 상태 확인
+        location = name[0] ? findUser(name, libSeats) : request->location;
+        if (name[0] && location == -1 && (deadline = findClaim(name, clock.now, &location, libSeats)) != 0) // 대기열에서 좌석을 맡겨 둔 이용자인 경우
+        {
+            response->result = RESULT_WAITING;
+            fillSeatResponse(location, response, libSeats, &clock);
+            response->endTime = deadline;
+
+        }else if (name[0] && location == -1){ // 기다리는 이용자인 경우 대기 순번을 함께 응답한다.
+            spinLock(&libSeats->header->waitList.lock);
+            response->position = waitPosition(name, &libSeats->header->waitList);
+            spinUnlock(&libSeats->header->waitList.lock);
+            response->result = response->position ? RESULT_WAITING : RESULT_NO_SEAT;
+
+        }else if (location < 0 || location >= libSeats->seatCount){
+            response->result = RESULT_BAD_REQUEST;
+        }else{
+            fillSeatResponse(location, response, libSeats, &clock);
+        }
+        break;
+
+    case REQUEST_ADMIN: // 관리자 명령
+        response->result = (unsigned char)adminCommand(request, libSeats);
+        break;
+
+    case REQUEST_RESERVE: // 좌석 예약
+    case REQUEST_CANCEL: // 예약 취소
+        if (name[0] == '\0' || request->location < 0 || request->location >= libSeats->seatCount || request->room > libSeats->header->roomCount)
+        {
+            response->result = RESULT_BAD_REQUEST;
+            break;
+        }
+
+        // 열람실을 함께 지정한 경우, 좌석이 속한 열람실과 같아야 한다.
+        room = roomOf(libSeats, request->location);
+        if (request->room && room != &libSeats->header->rooms[request->room - 1])
+        {
+            response->result = RESULT_BAD_REQUEST;
+            break;
+        }
+
+        if (request->type == REQUEST_CANCEL)
+        {
+            response->result = cancelReservation(name, request->location, request->time, libSeats, &clock) ? RESULT_OK : RESULT_NO_SEAT;
+            fillSeatResponse(request->location, response, libSeats, &clock);
+            break;
+        }
+
+        // 예약 시간은 좌석이 속한 열람실의 운영정보로 확인한다.
+        if (request->value <= 0)
+        {
+            response->result = RESULT_BAD_REQUEST;
+            break;
+        }
+        response->result = (unsigned char)checkReservation(request->time, request->time + request->value * 60LL, libSeats, room, &clock);
+        if (response->result == RESULT_OK)
+        {
+            response->result = (unsigned char)reserveSeat(name, request->location, request->time, request->time + request->value * 60LL, libSeats, &clock);
+        }
+
+        // 예약한 경우, 좌석 정보와 함께 예약 종료시각을 응답한다.
+        fillSeatResponse(request->location, response, libSeats, &clock);
+        if (response->result == RESULT_OK)
+        {
+            response->endTime = request->time + request->value * 60LL;
+        }
+        break;
+
+    default: // 알 수 없는 요청
+        response->result = RESULT_BAD_REQUEST;
+    }
+
+    response->freeCount = __atomic_load_n(&libSeats->header->freeCount, __ATOMIC_RELAXED);
+
+    // 처리 결과를 운영 지표에 센다. 좌석 배정, 연장, 퇴실 요청의 성공은 요청 종류별로 센다.
+    if (response->result == RESULT_OK && (request->type == REQUEST_ASSIGN || request->type == REQUEST_WAIT))
+    {
+        metricCount(metrics, METRIC_ASSIGN, 1);
+    }else if (response->result == RESULT_OK && request->type == REQUEST_RENEW){
+        metricCount(metrics, METRIC_RENEW, 1);
+    }else if (response->result == RESULT_OK && request->type == REQUEST_CHECKOUT){
+        metricCount(metrics, METRIC_CHECKOUT, 1);
+    }else if (response->result == RESULT_FULL){
+        metricCount(metrics, METRIC_FULL, 1);
+    }else if (response->result == RESULT_CLOSED){
+        metricCount(metrics, METRIC_CLOSED, 1);
+    }
+    if (request->type >= REQUEST_ASSIGN && request->type <= REQUEST_ADMIN)
+    {
+        metricLatency(metrics, request->type - REQUEST_ASSIGN, start);
+    }
+
+    return;
+}
+
+
+/*
+* serveConnection 함수
+* 기능 : 읽을 요청이 있는 연결에서 요청을 읽어 처리하고 응답을 보낸다. 한 번에 최대 SERVICE_BATCH개의 요청을 이어서 처리한 후, 연결을 다시 감시 대상으로 등록한다.
+*        연결은 SOCK_SEQPACKET이므로, 한 번 읽으면 요청 하나가 온전히 읽힌다.
+* 입력값 : fd(연결), 좌석 서비스 정보 구조체 포인터 *service, 운영 지표 구조체 포인터 *metrics(작업 스레드의 운영 지표, 모으지 않는 경우 NULL)
+* 반환값 없음
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+void serveConnection(int fd, ServiceData* service, MetricsData* metrics)
+{
+    // 요청보다 큰 메시지를 찾을 수 있도록, 요청보다 1바이트 큰 버퍼에 읽는다.
+    union { SeatRequest request; char raw[sizeof(SeatRequest) + 1]; } buffer;
+    SeatResponse response;
+    struct epoll_event event;
+    ssize_t length = 0;
+
+    for (int i = 0; i < SERVICE_BATCH; i++)
+    {
+        // 이전 형식의 요청에는 예약 시작시각이 없으므로, 읽기 전에 0으로 둔다.
+        buffer.request.time = 0;
+        length = recv(fd, buffer.raw, sizeof(buffer.raw), MSG_DONTWAIT);
+
+        // 더 읽을 요청이 없는 경우, 연결을 다시 감시 대상으로 등록한다.
+        if (length < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+        {
+            break;
+        }
+
+        // 연결이 끊어진 경우 연결을 닫는다. 닫은 연결은 감시 대상에서 자동으로 빠진다.
+        if (length <= 0)
+        {
+            close(fd);
+            return;
+        }
+
+        // 요청을 처리한다. 이전 형식(예약 시작시각 앞까지)의 요청도 받으며, 크기가 다른 메시지는 잘못된 요청으로 응답한다.
+        if (length == (ssize_t)sizeof(SeatRequest) || length == (ssize_t)offsetof(SeatRequest, time))
+        {
+            handleRequest(&buffer.request, &response, service->libSeats, metrics, fd);
+
+            // 응답을 보내기 전에, 이번 요청에서 생긴 기록을 디스크에 확정한다.
+            walCommit(service->libSeats);
+            historyCommit(service->libSeats, 0);
+
+            // 이번 요청으로 좌석을 넘겨받은 대기 연결이 있으면 알린다. 다른 프로세스가 대기열에서 뺀 연결에는 마지막 응답을 보낸다.
+            notifyWaiters(service->libSeats);
+            sweepWaiters(service->libSeats);
+
+            // 대기열에 등록한 경우, 좌석을 넘겨받을 때 응답하므로 지금은 응답하지 않는다. 연결은 등록할 때 끊어짐만 감시하도록 바꾸었다.
+            if (buffer.request.type == REQUEST_WAIT && response.result == RESULT_WAITING)
+            {
+                return;
+            }
+        }else{
+            memset(&response, 0, sizeof(response));
+            response.result = RESULT_BAD_REQUEST;
+            response.location = -1;
+        }
+
+        // 응답을 보내지 못한 경우(상대가 연결을 닫은 경우 등) 연결을 닫는다.
+        if (send(fd, &response, sizeof(response), MSG_NOSIGNAL) != (ssize_t)sizeof(response))
+        {
+            close(fd);
+            return;
+        }
+    }
+
+    // 한 번에 하나의 작업 스레드만 연결을 처리하도록, 연결은 EPOLLONESHOT으로 등록한다.
+    event.events = EPOLLIN | EPOLLONESHOT;
+    event.data.fd = fd;
+    epoll_ctl(service->epollFd, EPOLL_CTL_MOD, fd, &event);
+
+    return;
+}
+
+
+/*
+* notifyWaiters 함수
+* 기능 : 대기열에서 좌석을 맡긴 이용자 중 이 좌석 서비스의 연결에서 기다리는 이용자에게 응답을 보내고, 연결을 다시 감시 대상으로 등록한다.
+*        응답은 RESULT_WAITING이며, 맡긴 좌석번호와 배정받아야 하는 시각(endTime)을 담는다. 다른 프로세스의 연결은 그 프로세스가 알린다.
+* 입력값 : 좌석 정보 구조체 포인터 *libSeats
+* 반환값 없음
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+void notifyWaiters(SeatsData* libSeats)
+{
+    WaitList* waitList = &libSeats->header->waitList;
+    WaitEntry notices[WAIT_NOTIFY_BATCH];
+    WaitEntry* claim = NULL;
+    SeatResponse response;
+    ClockContext clock;
+    int count = 0, pid = (int)getpid();
+
+    // 좌석 서비스가 아니거나 알릴 연결이 없으면 대기열 잠금을 얻지 않는다.
+    if (libSeats->service == NULL || __atomic_load_n(&waitList->notifyCount, __ATOMIC_RELAXED) == 0)
+    {
+        return;
+    }
+
+    // 알릴 연결을 모은 후 대기열 잠금을 풀고 응답을 보낸다. 응답을 미뤄 둔 연결 목록에서 뺀 연결만 알린다. (끊어진 연결은 이미 빠졌다)
+    spinLock(&waitList->lock);
+    for (int i = 0; i < waitList->claimCount && count < WAIT_NOTIFY_BATCH; i++)
+    {
+        claim = &waitList->claims[(waitList->claimHead + i) % WAITLIST_SIZE];
+        if (claim->notifyFd >= 0 && claim->notifyPid == pid)
+        {
+            notices[count] = *claim;
+            count += releaseWaiter(claim, libSeats) >= 0;
+            claim->notifyFd = -1;
+            waitList->notifyCount--;
+        }
+    }
+    spinUnlock(&waitList->lock);
+
+    captureClock(&clock, libSeats, &libSeats->header->rooms[0]);
+    for (int i = 0; i < count; i++)
+    {
+        memset(&response, 0, sizeof(response));
+        fillSeatResponse(notices[i].location, &response, libSeats, &clock);
+        response.result = RESULT_WAITING;
+        response.endTime = notices[i].deadline;
+        response.freeCount = __atomic_load_n(&libSeats->header->freeCount, __ATOMIC_RELAXED);
+        replyWaiter(notices[i].notifyFd, &response, libSeats);
+    }
+
+    return;
+}
+
+
+/*
+* parkWaiter 함수
+* 기능 : 대기열에 등록한 연결을 응답을 미뤄 둔 연결 목록에 넣고, 연결이 끊어지는 것만 감시하도록(EPOLLRDHUP) 바꾼다.
+*        목록에서 연결을 빼는 스레드(알림, 마지막 응답, 끊어진 연결 정리)만 연결에 응답하거나 연결을 닫으므로, 같은 연결을 두 번 닫지 않는다. 대기열 잠금을 얻은 후 호출해야 한다.
+* 입력값 : fd(대기 연결), 좌석 정보 구조체 포인터 *libSeats
+* 반환값 : 넣은 경우 1, 목록이 가득 찬 경우 0을 반환함.
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+int parkWaiter(int fd, SeatsData* libSeats)
+{
+    ServiceData* service = libSeats->service;
+    struct epoll_event event;
+
+    if (service == NULL || service->waitFdCount == WAIT_PARKED_FDS)
+    {
+        return 0;
+    }
+
+    service->waitFds[service->waitFdCount++] = fd;
+    event.events = EPOLLRDHUP | EPOLLONESHOT;
+    event.data.fd = fd;
+    epoll_ctl(service->epollFd, EPOLL_CTL_MOD, fd, &event);
+
+    return 1;
+}
+
+
+/*
+* releaseWaiter 함수
+* 기능 : 대기열이나 맡긴 좌석 목록에서 빠지거나 다른 연결로 바뀌는 칸의 대기 연결을 응답을 미뤄 둔 연결 목록에서 빼고 넘겨받는다.
+*        다른 프로세스의 연결은 넘겨받을 수 없으므로, 대기열의 orphanCount를 올려 그 프로세스가 sweepWaiters로 마지막 응답을 보내게 한다. 대기열 잠금을 얻은 후 호출해야 한다.
+* 입력값 : 대기열 칸 구조체 포인터 *entry, 좌석 정보 구조체 포인터 *libSeats
+* 반환값 : 넘겨받은 연결. 호출한 쪽이 잠금을 푼 후 응답을 보내거나 닫아야 한다. 알릴 연결이 없거나 넘겨받지 못한 경우 -1을 반환함.
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+int releaseWaiter(const WaitEntry* entry, SeatsData* libSeats)
+{
+    ServiceData* service = libSeats->service;
+
+    if (entry->notifyFd < 0)
+    {
+        return -1;
+    }
+    if (entry->notifyPid != (int)getpid())
+    {
+        libSeats->header->waitList.orphanCount++;
+        return -1;
+    }
+    if (service == NULL)
+    {
+        return -1;
+    }
+
+    for (int i = 0; i < service->waitFdCount; i++)
+    {
+        if (service->waitFds[i] == entry->notifyFd)
+        {
+            service->waitFds[i] = service->waitFds[--service->waitFdCount];
+            return entry->notifyFd;
+        }
+    }
+
+    return -1;
+}
+
+
+/*
+* finishWait 함수
+* 기능 : 좌석을 넘겨받지 못한 채 대기열에서 빠진 연결에 마지막 응답(좌석번호 없음)을 보낸다. 대기열 잠금을 푼 후 호출한다.
+* 입력값 : fd(releaseWaiter 등으로 넘겨받은 대기 연결), result(응답 결과, RESULT_CLOSED 등), 좌석 정보 구조체 포인터 *libSeats
+* 반환값 없음
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+void finishWait(int fd, unsigned char result, SeatsData* libSeats)
+{
+    SeatResponse response;
+
+    memset(&response, 0, sizeof(response));
+    response.result = result;
+    response.location = -1;
+    response.freeCount = __atomic_load_n(&libSeats->header->freeCount, __ATOMIC_RELAXED);
+    replyWaiter(fd, &response, libSeats);
+
+    return;
+}
+
+
+/*
+* replyWaiter 함수
+* 기능 : 넘겨받은 대기 연결에 응답을 보내고, 다음 요청을 읽도록 연결을 다시 감시 대상으로 등록한다.
+*        응답을 보내지 못한 경우(기다리던 이용자가 연결을 닫은 경우 등) 연결을 닫는다.
+* 입력값 : fd(넘겨받은 대기 연결), 응답 구조체 포인터 *response, 좌석 정보 구조체 포인터 *libSeats
+* 반환값 없음
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+void replyWaiter(int fd, const SeatResponse* response, SeatsData* libSeats)
+{
+    struct epoll_event event;
+
+    if (send(fd, response, sizeof(*response), MSG_NOSIGNAL | MSG_DONTWAIT) != (ssize_t)sizeof(*response))
+    {
+        close(fd);
+        return;
+    }
+    event.events = EPOLLIN | EPOLLONESHOT;
+    event.data.fd = fd;
+    epoll_ctl(libSeats->service->epollFd, EPOLL_CTL_MOD, fd, &event);
+
+    return;
+}
+
+
+/*
+* hangUpWaiter 함수
+* 기능 : 응답을 미뤄 둔 연결이 끊어진 경우, 그 연결에서 기다리던 이용자를 대기열에서 빼고 맡긴 좌석의 알림을 지운 후 연결을 닫는다.
+*        맡긴 좌석은 배정받아야 하는 시각까지 그대로 두므로, 이용자는 다른 연결로 배정받을 수 있다.
+* 입력값 : fd(끊어진 연결), 좌석 정보 구조체 포인터 *libSeats
+* 반환값 : 닫은 경우 1, 응답을 미뤄 둔 연결이 아닌 경우(다른 스레드가 이미 넘겨받은 경우 포함) 0을 반환함.
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+int hangUpWaiter(int fd, SeatsData* libSeats)
+{
+    ServiceData* service = libSeats->service;
+    WaitList* waitList = &libSeats->header->waitList;
+    WaitEntry* entry = NULL;
+    int found = 0, pid = (int)getpid();
+
+    spinLock(&waitList->lock);
+    for (int i = 0; i < service->waitFdCount && !found; i++)
+    {
+        if (service->waitFds[i] == fd)
+        {
+            service->waitFds[i] = service->waitFds[--service->waitFdCount];
+            found = 1;
+        }
+    }
+    for (int i = 0; i < WAIT_CLASSES && found; i++)
+    {
+        for (int j = 0; j < waitList->count[i]; j++)
+        {
+            entry = &waitList->entries[i][(waitList->head[i] + j) % WAITLIST_SIZE];
+            if (entry->name[0] && entry->notifyFd == fd && entry->notifyPid == pid)
             {
-                // 경고문 출력
-                printf("경고 : 개장 시각과 폐장 시각이 달라지는 경우, 폐장 시각 이후로 지정된 모든 이용자의 퇴실 시각은 폐장 시각으로 일괄 변경됩니다.\n");
+                entry->name[0] = '\0';
+                waitList->waiting--;
             }
+        }
+        while (waitList->count[i] > 0 && !waitList->entries[i][waitList->head[i]].name[0])
+        {
+            waitList->head[i] = (waitList->head[i] + 1) % WAITLIST_SIZE;
+            waitList->count[i]--;
+        }
+    }
+    for (int i = 0; i < waitList->claimCount && found; i++)
+    {
+        entry = &waitList->claims[(waitList->claimHead + i) % WAITLIST_SIZE];
+        if (entry->notifyFd == fd && entry->notifyPid == pid)
+        {
+            entry->notifyFd = -1;
+            waitList->notifyCount--;
+        }
+    }
+    spinUnlock(&waitList->lock);
 
-            do {
-                // 기존 개장시각 복원. 이는 잘못된 값을 입력받았을 때 복원하는 용도로 이용된다.
-                libData->OPEN_TIME = oldData;
+    if (found)
+    {
+        close(fd);
+    }
 
-                // 기존값 출력 및 신규값 입력
-                printf("현재 개장 시각 : %d시 %d분, 현재 폐장 시각 : %d시 %d분\n", libData->OPEN_TIME / 60, libData->OPEN_TIME % 60, libData->CLOSE_TIME / 60, libData->CLOSE_TIME % 60);
-                printf("개장 시각 수정(폐장 시각과 동일하면 24시간) 시간 : ");
-                scanf("%d", &tmpTime); // 시간 단위 입력
-                libData->OPEN_TIME = tmpTime * 60; // 시간 단위를 분단위로 환산 후 저장
-                printf("분 : ");
-                scanf("%d", &tmpTime); // 분단위 입력
-                libData->OPEN_TIME += tmpTime; // 저장된 시간 단위 입력값에 분단위 입력값 추가
+    return found;
+}
 
-                // 잘못된 값인지 확인
-                if (libData->OPEN_TIME < 0 || libData->OPEN_TIME >= 24 * 60)
-                {
-                    printf("개장 시각은 0시 0분부터 23시 59분까지로 설정 가능합니다.\n");
-                }
-            } while ((libData->OPEN_TIME < 0 || libData->OPEN_TIME >= 24 * 60)); // 옳은 입력값이 입력될때까지 반복
 
-            // 폐장 시각을 초과하는 퇴실 시각을 조정함. 24시간제인 경우, 해당 함수가 작동하지 않음.
-            renewSeatEndTime(libSeats, libData);
-            break;
+/*
+* sweepWaiters 함수
+* 기능 : 다른 프로세스가 이 좌석 서비스의 대기 연결이 있는 칸을 빼거나 바꾼 경우(orphanCount가 바뀐 경우), 대기열과 맡긴 좌석 목록 어디에도 없는 연결을 찾아 만석으로 마지막 응답을 보낸다.
+*        orphanCount가 그대로이면 대기열 잠금을 얻지 않는다.
+* 입력값 : 좌석 정보 구조체 포인터 *libSeats
+* 반환값 없음
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+void sweepWaiters(SeatsData* libSeats)
+{
+    ServiceData* service = libSeats->service;
+    WaitList* waitList = &libSeats->header->waitList;
+    WaitEntry* entry = NULL;
+    int orphans[WAIT_PARKED_FDS];
+    int orphanCount = 0, isListed = 0, pid = (int)getpid();
 
-        case 5: // 폐장시각 수정
+    if (service == NULL || __atomic_load_n(&waitList->orphanCount, __ATOMIC_RELAXED) == service->orphanSeen)
+    {
+        return;
+    }
 
-            // 경고문 출력
-            printf("경고 : 폐장 시각 단축 시, 폐장 시각 이후로 지정된 모든 이용자의 퇴실 시각은 폐장 시각으로 일괄 변경됩니다.\n");
+    spinLock(&waitList->lock);
+    service->orphanSeen = waitList->orphanCount;
+    for (int k = 0; k < service->waitFdCount; k++)
+    {
+        isListed = 0;
+        for (int i = 0; i < WAIT_CLASSES && !isListed; i++)
+        {
+            for (int j = 0; j < waitList->count[i] && !isListed; j++)
+            {
+                entry = &waitList->entries[i][(waitList->head[i] + j) % WAITLIST_SIZE];
+                isListed = entry->name[0] && entry->notifyFd == service->waitFds[k] && entry->notifyPid == pid;
+            }
+        }
+        for (int i = 0; i < waitList->claimCount && !isListed; i++)
+        {
+            entry = &waitList->claims[(waitList->claimHead + i) % WAITLIST_SIZE];
+            isListed = entry->notifyFd == service->waitFds[k] && entry->notifyPid == pid;
+        }
+        if (!isListed)
+        {
+            orphans[orphanCount++] = service->waitFds[k];
+            service->waitFds[k--] = service->waitFds[--service->waitFdCount];
+        }
+    }
+    spinUnlock(&waitList->lock);
 
-            // 기존 폐장시각 저장
-            oldData = libData->CLOSE_TIME;
+    for (int i = 0; i < orphanCount; i++)
+    {
+        finishWait(orphans[i], RESULT_FULL, libSeats);
+    }
 
-            do {
-                // 기존 폐장시각 복원. 이는 잘못된 값을 입력받았을 때 복원하는 용도로 이용된다.
-                libData->CLOSE_TIME = oldData;
+    return;
+}
 
-                // 기존값 출력 및 신규값 입력
-                printf("현재 개장 시각 : %d시 %d분, 현재 폐장 시각 : %d시 %d분\n", libData->OPEN_TIME / 60, libData->OPEN_TIME % 60, libData->CLOSE_TIME / 60, libData->CLOSE_TIME % 60);
-                printf("폐장 시각 수정(개장 시각과 동일하면 24시간) 시간 : ");
-                scanf("%d", &tmpTime); // 시간 단위 입력
-                libData->CLOSE_TIME = tmpTime * 60; // 시간 단위를 분단위로 환산 후 저장
-                printf("분 : ");
-                scanf("%d", &tmpTime); // 분단위 입력
-                libData->CLOSE_TIME += tmpTime; // 저장된 시간 단위 입력값에 분단위 입력값 추가
 
-                // 잘못된 값인지 확인.
-                if (libData->CLOSE_TIME < 0 || libData->CLOSE_TIME >= 24 * 60)
+/*
+* serviceWorker 함수
+* 기능 : 좌석 서비스의 작업 스레드. 모든 작업 스레드가 하나의 epoll을 함께 기다리며, 새 연결을 받거나 요청이 온 연결을 처리한다.
+*        종료 신호(stopFd)를 받으면 끝난다. 운영 지표를 모으는 경우, 요청이 없어도 지표 파일을 다시 쓸 간격마다 깨어난다.
+*        대기열에 기다리는 이용자나 맡긴 좌석, 응답을 미뤄 둔 연결이 있는 경우에는 1초마다 깨어나, 요청이 없어도 시간 만료와 맡긴 좌석을 처리하고 대기 연결에 알린다.
+*        응답을 미뤄 둔 연결은 끊어짐(EPOLLRDHUP)만 감시하므로, 읽을 요청(EPOLLIN) 없이 온 연결은 끊어진 대기 연결로 처리한다.
+* 입력값 : *arg(좌석 서비스 정보 구조체 포인터)
+* 반환값 : NULL
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+void* serviceWorker(void* arg)
+{
+    ServiceData* service = (ServiceData*)arg;
+    MetricsData* metrics = metricsThread(service->libSeats);
+    WaitList* waitList = &service->libSeats->header->waitList;
+    ClockContext clock;
+    struct epoll_event event;
+    int fd = 0, isWaiting = 0;
+    int timeout = service->libSeats->metrics != NULL ? service->libSeats->metrics->interval * 1000 : -1;
+
+    while (1)
+    {
+        // 처리할 연결 하나를 기다린다. 기다리는 동안 지표 파일을 다시 쓸 때가 된 경우, 한 작업 스레드가 지표 파일을 쓴다.
+        isWaiting = __atomic_load_n(&waitList->waiting, __ATOMIC_RELAXED) > 0 || __atomic_load_n(&waitList->claimCount, __ATOMIC_RELAXED) > 0
+            || __atomic_load_n(&service->waitFdCount, __ATOMIC_RELAXED) > 0;
+        fd = epoll_wait(service->epollFd, &event, 1, (isWaiting && (timeout < 0 || timeout > 1000)) ? 1000 : timeout);
+        metricsExport(service->libSeats, 0);
+        if (fd == 0 && isWaiting) // 요청 없이 깨어난 경우, 대기열을 처리한다.
+        {
+            captureClock(&clock, service->libSeats, &service->libSeats->header->rooms[0]);
+            expireSeats(service->libSeats, &clock, metrics);
+            walCommit(service->libSeats);
+            historyCommit(service->libSeats, 0);
+            notifyWaiters(service->libSeats);
+            sweepWaiters(service->libSeats);
+        }
+        if (fd != 1)
+        {
+            continue;
+        }
+
+        if (event.data.fd == service->stopFd) // 종료 신호인 경우. 종료 신호는 읽지 않으므로 모든 작업 스레드가 받는다.
+        {
+            break;
+
+        }else if (event.data.fd == service->listenFd){ // 새 연결인 경우, 대기중인 연결을 모두 받아 감시 대상으로 등록한다.
+            while ((fd = accept(service->listenFd, NULL, NULL)) >= 0)
+            {
+                event.events = EPOLLIN | EPOLLONESHOT;
+                event.data.fd = fd;
+                if (epoll_ctl(service->epollFd, EPOLL_CTL_ADD, fd, &event) != 0)
                 {
-                    printf("폐장 시각은 0시 0분부터 23시 59분까지로 설정 가능합니다.\n");
+                    close(fd);
                 }
-            } while ((libData->CLOSE_TIME < 0 || libData->CLOSE_TIME >= 24 * 60)); // 옳은 입력값이 입력될때까지 반복
+            }
+
+            // 대기 소켓을 다시 감시 대상으로 등록한다.
+            event.events = EPOLLIN | EPOLLONESHOT;
+            event.data.fd = service->listenFd;
+            epoll_ctl(service->epollFd, EPOLL_CTL_MOD, service->listenFd, &event);
+
+        }else if (!(event.events & EPOLLIN)){ // 응답을 미뤄 둔 연결이 끊어진 경우. 다른 스레드가 이미 넘겨받은 연결은 그 스레드가 응답한다.
+            if (!hangUpWaiter(event.data.fd, service->libSeats) && !(event.events & EPOLLRDHUP))
+            {
+                serveConnection(event.data.fd, service, metrics);
+            }
+
+        }else{ // 요청이 온 연결인 경우
+            serveConnection(event.data.fd, service, metrics);
+        }
+    }
+
+    return NULL;
+}
 
-            // 폐장 시각을 초과하는 퇴실 시각을 조정함.
-            renewSeatEndTime(libSeats, libData);
+
+/*
+* runService 함수
+* 기능 : 좌석 서비스(데몬)를 실행한다. Unix 도메인 소켓으로 요청을 받아 작업 스레드들이 동시에 처리하며, SIGINT 또는 SIGTERM을 받으면 종료한다.
+* 입력값 : *socketPath(소켓 파일 경로), workerCount(작업 스레드 수), 좌석 정보 구조체 포인터 *libSeats
+* 반환값 : 정상 종료한 경우 1, 소켓을 만들 수 없는 경우 0을 반환함.
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+int runService(const char* socketPath, int workerCount, SeatsData* libSeats)
+{
+    // 좌석 서비스 관련 변수 선언
+    ServiceData service;
+    struct sockaddr_un address;
+    struct epoll_event event;
+    pthread_t workers[MAX_WORKERS];
+    sigset_t signals;
+    int stopPipe[2] = { -1, -1 }, probe = -1, signalNo = 0, started = 0;
+
+    // 소켓 주소 작성
+    if (strlen(socketPath) >= sizeof(address.sun_path))
+    {
+        printf("소켓 파일 경로가 너무 깁니다.\n");
+        return 0;
+    }
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    strcpy(address.sun_path, socketPath);
+
+    // 같은 소켓 파일로 실행중인 좌석 서비스가 있는지 확인한다. 접속할 수 없는 소켓 파일은 이전 실행에서 남은 것이므로 지운다.
+    probe = socket(AF_UNIX, SOCK_SEQPACKET, 0);
+    if (probe >= 0 && connect(probe, (struct sockaddr*)&address, sizeof(address)) == 0)
+    {
+        printf("소켓 %s에서 이미 좌석 서비스가 실행중입니다.\n", socketPath);
+        close(probe);
+        return 0;
+    }
+    if (probe >= 0) { close(probe); }
+    unlink(socketPath);
+
+    // 대기 소켓을 만든다. 여러 작업 스레드가 함께 받으므로, 받을 연결이 없는 경우 기다리지 않도록 한다.
+    memset(&service, 0, sizeof(service));
+    service.libSeats = libSeats;
+    service.orphanSeen = libSeats->header->waitList.orphanCount;
+    libSeats->service = &service;
+    service.listenFd = socket(AF_UNIX, SOCK_SEQPACKET, 0);
+    if (service.listenFd < 0 || bind(service.listenFd, (struct sockaddr*)&address, sizeof(address)) != 0
+        || listen(service.listenFd, SOMAXCONN) != 0 || fcntl(service.listenFd, F_SETFL, O_NONBLOCK) != 0
+        || (service.epollFd = epoll_create1(0)) < 0 || pipe(stopPipe) != 0)
+    {
+        printf("소켓 %s을 만들 수 없습니다.\n", socketPath);
+        if (service.listenFd >= 0) { close(service.listenFd); }
+        unlink(socketPath);
+        return 0;
+    }
+    service.stopFd = stopPipe[0];
+
+    // 대기 소켓과 종료 신호를 감시 대상으로 등록한다.
+    event.events = EPOLLIN | EPOLLONESHOT;
+    event.data.fd = service.listenFd;
+    epoll_ctl(service.epollFd, EPOLL_CTL_ADD, service.listenFd, &event);
+    event.events = EPOLLIN;
+    event.data.fd = service.stopFd;
+    epoll_ctl(service.epollFd, EPOLL_CTL_ADD, service.stopFd, &event);
+
+    // 종료 신호는 이 스레드만 받도록, 작업 스레드를 만들기 전에 막는다. (작업 스레드는 막힌 상태를 물려받는다.)
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &signals, NULL);
+
+    // 작업 스레드를 만든다.
+    for (started = 0; started < workerCount; started++)
+    {
+        if (pthread_create(&workers[started], NULL, serviceWorker, &service) != 0)
+        {
             break;
+        }
+    }
+    printf("좌석 서비스를 시작합니다. (소켓 : %s, 작업 스레드 : %d)\n", socketPath, started);
+    fflush(stdout);
 
-        case 6: // 모든 좌석 정보 보기
+    // 종료 신호를 기다린 후, 모든 작업 스레드에 종료를 알린다.
+    if (started > 0)
+    {
+        sigwait(&signals, &signalNo);
+    }
+    if (write(stopPipe[1], "", 1) != 1)
+    {
+        printf("작업 스레드에 종료를 알릴 수 없습니다.\n");
+    }
+    for (int i = 0; i < started; i++)
+    {
+        pthread_join(workers[i], NULL);
+    }
+    printf("좌석 서비스를 종료합니다.\n");
+
+    // 소켓과 감시 대상을 정리한다. 처리중이던 연결은 프로세스 종료 시 닫힌다.
+    close(service.epollFd);
+    close(service.listenFd);
+    close(stopPipe[0]);
+    close(stopPipe[1]);
+    unlink(socketPath);
+    pthread_sigmask(SIG_UNBLOCK, &signals, NULL);
+    libSeats->service = NULL;
+
+    return 1;
+}
+
+
+/*
+* housekeeperStart 함수
+* 기능 : 대화형 모드의 자동 정리 스레드를 시작한다. 자동 정리 스레드는 바로 한 번 정리한 후, 다음 정리 시각까지 기다린다.
+* 입력값 : 자동 정리 구조체 포인터 *keeper, 좌석 정보 구조체 포인터 *libSeats
+* 반환값 : 시작한 경우 1, timerfd나 스레드를 만들 수 없는 경우 0을 반환함.
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+int housekeeperStart(Housekeeper* keeper, SeatsData* libSeats)
+{
+    struct epoll_event event;
+
+    memset(keeper, 0, sizeof(Housekeeper));
+    keeper->libSeats = libSeats;
+    keeper->wakePipe[0] = keeper->wakePipe[1] = -1;
+
+    // 깨우기 파이프는 양쪽 모두 기다리지 않도록 한다. 이미 깨우기가 쌓여 있어 쓰지 못하는 경우는 무시해도 된다.
+    keeper->timerFd = timerfd_create(CLOCK_REALTIME, TFD_CLOEXEC);
+    keeper->epollFd = epoll_create1(0);
+    if (keeper->timerFd < 0 || keeper->epollFd < 0 || pipe(keeper->wakePipe) != 0
+        || fcntl(keeper->wakePipe[0], F_SETFL, O_NONBLOCK) != 0 || fcntl(keeper->wakePipe[1], F_SETFL, O_NONBLOCK) != 0)
+    {
+        printf("자동 정리 타이머를 만들 수 없습니다.\n");
+        if (keeper->timerFd >= 0) { close(keeper->timerFd); }
+        if (keeper->epollFd >= 0) { close(keeper->epollFd); }
+        if (keeper->wakePipe[0] >= 0) { close(keeper->wakePipe[0]); close(keeper->wakePipe[1]); }
+        return 0;
+    }
+
+    event.events = EPOLLIN;
+    event.data.fd = keeper->timerFd;
+    epoll_ctl(keeper->epollFd, EPOLL_CTL_ADD, keeper->timerFd, &event);
+    event.events = EPOLLIN;
+    event.data.fd = keeper->wakePipe[0];
+    epoll_ctl(keeper->epollFd, EPOLL_CTL_ADD, keeper->wakePipe[0], &event);
+
+    if (pthread_create(&keeper->thread, NULL, housekeeperThread, keeper) != 0)
+    {
+        printf("자동 정리 스레드를 만들 수 없습니다.\n");
+        close(keeper->timerFd);
+        close(keeper->epollFd);
+        close(keeper->wakePipe[0]);
+        close(keeper->wakePipe[1]);
+        return 0;
+    }
+
+    return 1;
+}
+
+
+/*
+* housekeeperWake 함수
+* 기능 : 자동 정리 스레드를 깨운다. 주 스레드가 요청을 처리한 후 호출하며, 자동 정리 스레드는 정리한 후 다음 정리 시각을 다시 계산한다.
+*        (새로 배정하거나 운영정보를 바꾸어 다음 정리 시각이 앞당겨질 수 있다.)
+* 입력값 : 자동 정리 구조체 포인터 *keeper
+* 반환값 없음
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+void housekeeperWake(Housekeeper* keeper)
+{
+    // 쓰지 못한 경우는 파이프에 깨우기가 이미 쌓여 있는 경우이므로 다시 쓰지 않는다.
+    ssize_t written = write(keeper->wakePipe[1], "", 1);
+    (void)written;
+
+    return;
+}
+
+
+/*
+* housekeeperStop 함수
+* 기능 : 자동 정리 스레드에 종료를 알리고, 끝날 때까지 기다린 후 timerfd와 파이프를 닫는다.
+* 입력값 : 자동 정리 구조체 포인터 *keeper
+* 반환값 없음
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+void housekeeperStop(Housekeeper* keeper)
+{
+    __atomic_store_n(&keeper->isStopping, 1, __ATOMIC_RELEASE);
+    housekeeperWake(keeper);
+    pthread_join(keeper->thread, NULL);
+
+    close(keeper->timerFd);
+    close(keeper->epollFd);
+    close(keeper->wakePipe[0]);
+    close(keeper->wakePipe[1]);
+
+    return;
+}
+
+
+/*
+* housekeeperThread 함수
+* 기능 : 자동 정리 스레드. 만료된 좌석과 폐장 후 좌석을 회수하고 기록을 확정한 후, 다음 정리 시각에 timerfd를 맞추고 기다리기를 반복한다.
+*        주 스레드는 요청마다 좌석을 정리하지 않으며, 요청을 처리한 후 이 스레드를 깨우기만 한다.
+* 입력값 : 자동 정리 구조체 포인터(arg)
+* 반환값 : NULL
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+void* housekeeperThread(void* arg)
+{
+    Housekeeper* keeper = (Housekeeper*)arg;
+    SeatsData* libSeats = keeper->libSeats;
+    MetricsData* metrics = metricsThread(libSeats);
+    ClockContext clock;
+    struct itimerspec timer;
+    struct epoll_event event;
+    unsigned long long int expirations = 0;
+    char drain[64];
+    ssize_t length = 0;
+
+    memset(&timer, 0, sizeof(timer));
+    while (!__atomic_load_n(&keeper->isStopping, __ATOMIC_ACQUIRE))
+    {
+        // 시간 만료 및 폐장시각이 지난 좌석을 자동 퇴실 처리하고, 생긴 기록을 한 번에 디스크에 확정한다.
+        captureClock(&clock, libSeats, &libSeats->header->rooms[0]);
+        expireSeats(libSeats, &clock, metrics);
+        walCommit(libSeats);
+        historyCommit(libSeats, 0);
+        metricsExport(libSeats, 0);
+
+        // 다음 정리 시각에 울리도록 timerfd를 맞춘다. 시스템 시계가 바뀐 경우 timerfd가 취소되어 깨어나므로, 바뀐 시각으로 다시 계산한다.
+        timer.it_value.tv_sec = (time_t)nextHousekeeping(libSeats, &clock);
+        timerfd_settime(keeper->timerFd, TFD_TIMER_ABSTIME | TFD_TIMER_CANCEL_ON_SET, &timer, NULL);
+
+        // timerfd가 울리거나 주 스레드가 깨울 때까지 기다린다. 깨우기 파이프는 쌓인 만큼 비운다.
+        if (epoll_wait(keeper->epollFd, &event, 1, -1) != 1)
+        {
+            continue;
+        }
+        if (event.data.fd == keeper->timerFd)
+        {
+            length = read(keeper->timerFd, &expirations, sizeof(expirations));
+        }else{
+            length = read(keeper->wakePipe[0], drain, sizeof(drain));
+        }
+        (void)length;
+    }
+
+    return NULL;
+}
+
+
+/*
+* nextHousekeeping 함수
+* 기능 : 다음으로 정리할 일이 생기는 시각을 계산한다. 열람실마다 가장 먼저 끝나는 좌석(이용종료시각 힙의 루트)이 만료되는 시각과, 이용중인 좌석이나 대기자가 있는 열람실의 폐장시각,
+*        맡긴 좌석의 기한, 지표 파일을 다시 쓸 시각 중 가장 이른 시각이며, HOUSEKEEPING_MAX_SLEEP초 뒤를 넘지 않는다.
+*        연장 가능 여부는 확인할 때마다 이용종료시각으로 계산하므로, 연장 가능 시각이 되어도 정리할 일은 없다.
+* 입력값 : 좌석 정보 구조체 포인터 *libSeats, 현재 시각 정보 구조체 포인터 *clock
+* 반환값 : 다음 정리 시각(Unix 시간)을 반환함. 방금 정리한 후 호출하므로, 이미 지난 시각인 경우 1초 뒤를 반환함.
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+long long int nextHousekeeping(SeatsData* libSeats, ClockContext* clock)
+{
+    WaitList* waitList = &libSeats->header->waitList;
+    RoomData* room = NULL;
+    ClockContext roomClock = *clock;
+    long long int next = clock->now + HOUSEKEEPING_MAX_SLEEP, due = 0;
+    int isWaiting = __atomic_load_n(&waitList->waiting, __ATOMIC_RELAXED) > 0;
+
+    for (int i = 0; i < libSeats->header->roomCount; i++)
+    {
+        room = &libSeats->header->rooms[i];
+        setRoomClock(&roomClock, libSeats, room);
+
+        // 이용종료시각이 현재 시각보다 앞선 좌석을 회수하므로, 루트 좌석은 이용종료시각 1초 뒤에 회수한다.
+        spinLock(&room->heapLock);
+        if (room->heapSize > 0)
+        {
+            due = unpackEndTime(libSeats->endTime[libSeats->expiryHeap[room->firstSeat]]) + 1;
+            next = due < next ? due : next;
+        }
+        spinUnlock(&room->heapLock);
+
+        // 폐장시각에는 이용중인 좌석을 초기화하고, 해당 열람실을 기다리는 이용자를 대기열에서 뺀다.
+        if (!roomClock.isAllDay && isOperationTime(&roomClock) && (__atomic_load_n(&room->heapSize, __ATOMIC_RELAXED) > 0 || isWaiting))
+        {
+            next = roomClock.closeTime < next ? roomClock.closeTime : next;
+        }
+    }
+
+    // 맡긴 좌석 목록은 기한 순이므로 맨 앞의 기한만 확인한다.
+    spinLock(&waitList->lock);
+    if (waitList->claimCount > 0)
+    {
+        due = waitList->claims[waitList->claimHead].deadline;
+        next = due < next ? due : next;
+    }
+    spinUnlock(&waitList->lock);
 
-            // 모든 좌석의 정보를 관리자 모드로 출력함.
-            printSeatInfo(libSeats, 1);
-            break;
+    // 이용불가 시간대는 진행중이면 종료시각에, 아니면 시작시각에 처리한다.
+    spinLock(&libSeats->header->blackoutLock);
+    for (int i = 0; i < libSeats->header->blackoutCount; i++)
+    {
+        due = libSeats->header->blackouts[i].isActive ? libSeats->header->blackouts[i].end : libSeats->header->blackouts[i].start;
+        next = due < next ? due : next;
+    }
+    spinUnlock(&libSeats->header->blackoutLock);
 
-        case 7: // 좌석 이용불가 설정
+    // 지표를 모으는 경우, 지표 파일을 다시 쓸 시각에도 깨어난다.
+    if (libSeats->metrics != NULL)
+    {
+        due = __atomic_load_n(&libSeats->metrics->lastExport, __ATOMIC_RELAXED) + libSeats->metrics->interval;
+        next = due < next ? due : next;
+    }
 
-            // 무한 반복, 좌석 이용불가 설정 종료(0 입력)시 break으로 설정 종료
-            while (1)
-            {
-                // 모든 좌석의 정보를 관리자 모드로 출력함.
-                printSeatInfo(libSeats, 1);
+    return next > clock->now ? next : clock->now + 1;
+}
 
-                // 이용불가 설정을 수정할 좌석 번호를 입력받을 변수를 -2로 초기화
-                tmpSeatNo = -2;
 
-                do {
-                    // 이용불가 설정을 수정할 좌석 번호를 입력받음.
-                    printf("이용불가 설정을 바꿀 좌석을 선택하세요.(종료 : 0) : ");
-                    scanf("%d", &tmpSeatNo);
+/*
+* outputText 함수
+* 기능 : 출력 버퍼에 문자열을 덧붙인다. 호출한 쪽에서 버퍼에 BATCH_LINE_SPACE 이상의 공간이 있음을 보장한다.
+* 입력값 : 일괄 처리 출력 구조체 포인터 *output, 문자열 text, length(문자열 길이)
+* 반환값 없음
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+void outputText(BatchOutput* output, const char* text, int length)
+{
+    memcpy(output->data + output->length, text, length);
+    output->length += length;
 
-                    // 입력받은 1부터 시작하는 좌석 번호를 0으로 시작하는 좌석 번호로 변환 
-                    tmpSeatNo--;
+    return;
+}
 
-                    // 잘못된 좌석 번호인 경우(1부터 시작하는 좌석번호 입력값 기준 0(종료)부터 SEATS(마지막 좌석번호)까지의 범위를 벗어난 경우)
-                    if (tmpSeatNo < -1 || tmpSeatNo >= SEATS)
-                    {
-                        printf("잘못된 값을 입력하였습니다.\n");
-                    }
-                } while (tmpSeatNo < -1 || tmpSeatNo >= SEATS); // 옳은 입력값이 입력될때까지 반복
 
-                // 0을 입력받은 경우 좌석 이용불가 설정을 종료 (0 - 1 = -1)
-                if (tmpSeatNo == -1)
-                {
-                   break;
-                }
+/*
+* outputNumber 함수
+* 기능 : 출력 버퍼에 정수를 10진수로 덧붙인다. 줄마다 printf를 호출하지 않도록 직접 변환한다.
+* 입력값 : 일괄 처리 출력 구조체 포인터 *output, value(정수)
+* 반환값 없음
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+void outputNumber(BatchOutput* output, long long int value)
+{
+    // 뒤에서부터 한 자리씩 채운다. 음수는 절댓값을 변환한 후 부호를 붙인다.
+    char digits[24];
+    int pos = sizeof(digits);
+    unsigned long long int number = value < 0 ? 0ULL - (unsigned long long int)value : (unsigned long long int)value;
 
-                // 이미 이용중인 좌석의 경우 좌석 초기화를 진행함
-                if (((libSeats + tmpSeatNo)->endTime) > 0) // 이미 이용중인 좌석(종료시각이 0 이상인 경우)
-                {
-                    // 좌석 이용자명 정보를 초기화함
-                    strncpy(((libSeats + tmpSeatNo)->seatsName), "", MAX_NAME_LENGTH);
+    do
+    {
+        digits[--pos] = (char)('0' + number % 10);
+        number /= 10;
+    } while (number);
 
-                    // 좌석 이용종료시각 정보를 초기화함
-                    ((libSeats + tmpSeatNo)->endTime) = 0;
-                }
+    if (value < 0)
+    {
+        digits[--pos] = '-';
+    }
 
-                // endTime이 0(이용가능)인 경우 -1(이용불가)로, -1(이용불가)인 경우 0(이용가능)으로 변경
-                ((libSeats + tmpSeatNo)->endTime) = -1 - ((libSeats + tmpSeatNo)->endTime);
-            }
+    outputText(output, digits + pos, (int)sizeof(digits) - pos);
 
-            break;
+    return;
+}
 
-        case 0: // 관리자 모드 나가기
-            return;
 
-        default: // 그 외의 값이 입력된 경우
-            printf("잘못된 값을 입력하였습니다.\n");
-        }
+/*
+* outputFlush 함수
+* 기능 : 출력 버퍼에 쌓인 결과를 표준 출력에 한 번에 쓰고 버퍼를 비운다.
+* 입력값 : 일괄 처리 출력 구조체 포인터 *output
+* 반환값 없음
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+void outputFlush(BatchOutput* output)
+{
+    if (output->length > 0)
+    {
+        fwrite(output->data, 1, output->length, stdout);
+        fflush(stdout);
+        output->length = 0;
     }
 
     return;
@@ -554,408 +10105,741 @@ void adminMode(SeatsData* libSeats, LibraryData *libData)
 
 
 /*
-* menuSelect 함수
-* 기능 : 메인 메뉴에서 이용자명 입력값을 받이 반환함
-* 입력값 : 이용자명을 반환할 문자열 포인터 *tmp
-* 반환값 : *tmp으로 입력받은 문자열 반환
-* 설명 최종 수정 일자 : 2024/05/01
+* nextToken 함수
+* 기능 : 명령 줄에서 공백으로 구분된 다음 낱말을 찾는다. 낱말을 복사하지 않고 입력 버퍼 안의 위치만 돌려준다.
+*        #으로 시작하는 낱말부터 줄 끝까지는 주석으로 보고 무시한다.
+* 입력값 : 현재 위치 포인터 **cursor(낱말 다음 위치로 이동), end(줄 끝), 낱말 시작 위치를 저장할 포인터 **token
+* 반환값 : 낱말의 길이. 더 이상 낱말이 없는 경우 0
+* 설명 최종 수정 일자 : 2026/10/17
 */
-void menuSelect(char* tmp)
+int nextToken(const char** cursor, const char* end, const char** token)
 {
-    // 이용자 정보를 입력받음
-    printf("이용자 정보를 입력하세요.(관리자 모드: 0) : ");
-    scanf("%s", tmp);
+    const char* pos = *cursor;
+    const char* start = NULL;
 
-    return;
+    // 공백(줄 끝의 '\r' 포함)을 건너뛴다.
+    while (pos < end && (*pos == ' ' || *pos == '\t' || *pos == '\r'))
+    {
+        pos++;
+    }
+
+    // 줄 끝이거나 주석인 경우
+    if (pos >= end || *pos == '#')
+    {
+        *cursor = end;
+        return 0;
+    }
+
+    // 다음 공백까지를 낱말로 한다.
+    start = pos;
+    while (pos < end && *pos != ' ' && *pos != '\t' && *pos != '\r')
+    {
+        pos++;
+    }
+
+    *cursor = pos;
+    *token = start;
+
+    return (int)(pos - start);
 }
 
 
 /*
-* init 함수
-* 기능 : 프로그램 최초 실행 시 실행되어 초기화 등을 진행함
-* 입력값 : 좌석 정보 구조체 포인터 *libSeats
-* 반환값 없음
-* 설명 최종 수정 일자 : 2024/05/01
+* isToken 함수
+* 기능 : 낱말이 주어진 명령어와 같은지 대소문자를 구분하지 않고 확인한다.
+* 입력값 : 낱말 token, length(낱말 길이), 대문자로 된 명령어 word
+* 반환값 : 같은 경우 1, 다른 경우 0
+* 설명 최종 수정 일자 : 2026/10/17
 */
-void init(SeatsData* libSeats)
+int isToken(const char* token, int length, const char* word)
 {
-    // 모든 좌석을 빈좌석으로 초기화함.
-    resetSeats(libSeats, 1);
+    for (int i = 0; i < length; i++)
+    {
+        char letter = token[i];
 
-    return;
+        if (letter >= 'a' && letter <= 'z')
+        {
+            letter = (char)(letter - 'a' + 'A');
+        }
+        if (word[i] != letter) // 명령어가 먼저 끝난 경우('\0')도 여기서 걸러진다.
+        {
+            return 0;
+        }
+    }
+
+    return word[length] == '\0';
 }
 
 
 /*
-* printRenewTime 함수
-* 기능 : 주어진 좌석번호의 연장가능시각을 출력함.
-* 입력값 : location(0번부터 시작하는 좌석번호), 좌석 정보 구조체 포인터 *libSeats, 시설 정보 구조체 포인터 *libData
-* 반환값 없음
-* 설명 최종 수정 일자 : 2024/05/01
+* parseNumber 함수
+* 기능 : 낱말을 10진수 정수로 변환한다. 앞에 '-'가 하나 올 수 있다.
+* 입력값 : 낱말 token, length(낱말 길이), 변환한 값을 저장할 포인터 *value
+* 반환값 : 정수인 경우 1, 정수가 아니거나 너무 큰 경우 0
+* 설명 최종 수정 일자 : 2026/10/17
 */
-void printRenewTime(int location, SeatsData* libSeats, LibraryData *libData)
+int parseNumber(const char* token, int length, int* value)
 {
-    // 현재 시간 관련 변수 선언
-    time_t Time;
-    struct tm* pTime;
-    Time = time(NULL);
-    pTime = localtime(&Time);
+    int isNegative = (length > 0 && token[0] == '-');
+    long long int number = 0;
 
-    // 익일 여부를 판단하기 위한 변수 선언
-    int isTomorrow = 0; // 1인 경우 익일이며, 0인 경우 익일이 아님.
+    if (length - isNegative <= 0 || length - isNegative > 9)
+    {
+        return 0;
+    }
 
-    // 빈자리의 경우 함수를 종료함.
-    if (!strlen((libSeats + location)->seatsName))
+    for (int i = isNegative; i < length; i++)
     {
-        return;
+        if (token[i] < '0' || token[i] > '9')
+        {
+            return 0;
+        }
+        number = number * 10 + (token[i] - '0');
     }
 
-    // 남은 시간 계산
-    // 종료 시각(Unix 초) - 현재 시각(Unix 초)의 방법으로 계산하며, 결괏값은 초 단위이다.
-    long long int remainSecondOrig = (libSeats + location)->endTime - ((long long int)Time);
-    int remainHour = remainSecondOrig / 3600;
-    int remainMinute = (remainSecondOrig % 3600) / 60;
-    int remainSecond = remainSecondOrig % 60;
+    *value = (int)(isNegative ? -number : number);
+
+    return 1;
+}
+
+
+/*
+* parseMinute 함수
+* 기능 : HH:MM 형식의 시각, 또는 0시 기준 분을 0시 기준 분으로 변환한다. 값의 범위는 관리자 명령에서 확인한다.
+* 입력값 : 낱말 token, length(낱말 길이), 변환한 값을 저장할 포인터 *value
+* 반환값 : 올바른 형식인 경우 1, 아닌 경우 0
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+int parseMinute(const char* token, int length, int* value)
+{
+    int hour = 0, minute = 0;
+
+    for (int i = 0; i < length; i++)
+    {
+        if (token[i] == ':') // HH:MM 형식인 경우
+        {
+            if (!parseNumber(token, i, &hour) || !parseNumber(token + i + 1, length - i - 1, &minute)
+                || hour < 0 || hour >= 24 || minute < 0 || minute >= 60)
+            {
+                return 0;
+            }
+            *value = hour * 60 + minute;
+            return 1;
+        }
+    }
 
-    // 현재 시각 가져오기
-    pTime = localtime(&Time);
-    int currHour = pTime->tm_hour;
-    int currMin = pTime->tm_min;
-    int currSecond = pTime->tm_sec;
+    return parseNumber(token, length, value);
+}
 
-    // 연장 시각 계산
-    // 현재 시각에 남은 시간을 더한 후, 연장가능시각을 뺀다.
-    // 종료시각에서부터 현재시각의 차이가 연장가능시각보다 작을 때 연장이 가능하다.
-    int computeSecond = remainSecond + currSecond;
-    int computeMinute = remainMinute + currMin - (libData->MAX_RENEWABLE_TIME % 60);
-    int computeHour = remainHour + currHour - (libData->MAX_RENEWABLE_TIME / 60);
 
-    // 개장시각과 폐장시각에 따라 구분
-    // 24시간제의 경우, 폐장시각으로 인해 연장 불가능한 경우가 없으으로 해당 조건문에서 구분하지 않음.
-    if (libData->OPEN_TIME < libData->CLOSE_TIME) // 개장시각이 폐장시각보다 앞에 있는 경우
+/*
+* parseBatchLine 함수
+* 기능 : 명령 한 줄을 좌석 서비스 요청으로 바꾼다. 명령어는 대소문자를 구분하지 않으며, 좌석번호는 1번부터 시작한다.
+* 입력값 : 줄 시작 line, 줄 끝 end('\n' 제외), now(날짜를 생략한 예약 시각의 기준이 되는 현재 시각), 요청 구조체 포인터 *request
+* 반환값 : 올바른 명령인 경우 1, 잘못된 명령인 경우 0, 빈 줄이나 주석인 경우 -1
+* 설명 최종 수정 일자 : 2026/10/17
+*
+* ASSIGN 이용자명 [좌석번호|AUTO], RENEW 이용자명, CHECKOUT 이용자명, STATUS 이용자명, SEAT 좌석번호,
+* RESET, TOGGLE 좌석번호, SET MAX_TIME 분, SET RENEWABLE_TIME 분, SET OPEN HH:MM, SET CLOSE HH:MM,
+* RESERVE 이용자명 좌석번호 [YYYY-MM-DD] HH:MM HH:MM (종료시각이 시작시각 이전이면 다음날), CANCEL 이용자명 좌석번호 [[YYYY-MM-DD] HH:MM],
+* QUEUE 이용자명 [PRIORITY] (자동 배정, 배정할 좌석이 없으면 대기열 등록. PRIORITY를 붙이면 우선 대기열)
+* 명령 뒤에 ROOM 열람실번호(1번부터 시작)를 붙이면 해당 열람실에서 자동 배정하거나, 해당 열람실에만 RESET, SET을 적용한다.
+*/
+int parseBatchLine(const char* line, const char* end, long long int now, SeatRequest* request)
+{
+    const char* cursor = line;
+    const char* peek = NULL;
+    const char* word = NULL;
+    const char* token = NULL;
+    const char* name = NULL;
+    int wordLength = 0, length = 0, nameLength = 0, value = 0;
+    long long int start = 0;
+    time_t Time = 0;
+    struct tm tmTime;
+
+    memset(request, 0, sizeof(SeatRequest));
+    request->location = -1;
+
+    // 명령어를 읽는다. 빈 줄이나 주석인 경우 처리하지 않는다.
+    wordLength = nextToken(&cursor, end, &word);
+    if (wordLength == 0)
     {
-        // 종료 시각(초) - 현재 시각(초) = 남은 시각(초) >= 폐장 시각(초) - 현재 시각(초) = 남은 시각(초) 인 경우, 좌석 연장이 불가능함
+        return -1;
+    }
 
-        // 종료시간이 임박하여 연장불가한 경우, 연장 불가능하다는 내용을 출력한 후, 함수를 종료함.
-        if (((libSeats + location)->endTime - ((long long int)Time)) >= ((libData->CLOSE_TIME * 60) - currHour * 60 * 60 - currMin * 60 - currSecond))
+    if (isToken(word, wordLength, "ASSIGN") || isToken(word, wordLength, "RENEW")
+        || isToken(word, wordLength, "CHECKOUT") || isToken(word, wordLength, "STATUS")) // 이용자명을 받는 명령
+    {
+        if (word[0] == 'A' || word[0] == 'a')
         {
-            printf("연장 불가\n");
-            return;
+            request->type = REQUEST_ASSIGN;
+        }else if (word[0] == 'R' || word[0] == 'r'){
+            request->type = REQUEST_RENEW;
+        }else if (word[0] == 'C' || word[0] == 'c'){
+            request->type = REQUEST_CHECKOUT;
+        }else{
+            request->type = REQUEST_STATUS;
         }
 
-    }else if (libData->OPEN_TIME > libData->CLOSE_TIME){ // 개장시각이 폐장시각보다 뒤에 있는 경우
+        // 이용자명은 '\0'을 포함해 MAX_NAME_LENGTH 이내여야 한다.
+        nameLength = nextToken(&cursor, end, &name);
+        if (nameLength == 0 || nameLength >= MAX_NAME_LENGTH)
+        {
+            return 0;
+        }
+        memcpy(request->name, name, nameLength);
 
-        if (((libData->OPEN_TIME * 60) - currHour * 60 * 60 - currMin * 60 - currSecond) >= 0) // 개장시각이 폐장시각보다 뒤에 있으며, 00시를 지난 경우 (개장 시각 이후)
+        // 좌석 배정의 경우, 좌석번호가 없거나 AUTO이면 자동 배정한다.
+        length = nextToken(&cursor, end, &token);
+        if (request->type == REQUEST_ASSIGN && length > 0 && !isToken(token, length, "AUTO") && !isToken(token, length, "ROOM"))
         {
-            // 종료 시각(초) - 현재 시각(초) = 남은 시각(초) >= 폐장 시각(초) - 현재 시각(초) = 남은 시각(초) 인 경우, 좌석 연장이 불가능함
-            
-            // 종료시간이 임박하여 연장불가한 경우, 연장 불가능하다는 내용을 출력한 후, 함수를 종료함.
-            if (((libSeats + location)->endTime - ((long long int)Time)) >= ((libData->CLOSE_TIME * 60) - currHour * 60 * 60 - currMin * 60 - currSecond))
+            if (!parseNumber(token, length, &value) || value <= 0)
             {
-                printf("연장 불가\n");
-                return;
+                return 0;
             }
+            request->location = value - 1;
+            length = nextToken(&cursor, end, &token);
+
+        }else if (request->type == REQUEST_ASSIGN && isToken(token, length, "AUTO")){
+            length = nextToken(&cursor, end, &token);
+        }
 
-        }else{ // 개장시각이 폐장시각보다 뒤에 있으며, 00시를 지나지 않은 경우 (개장 시각 이전)
+    }else if (isToken(word, wordLength, "RESERVE") || isToken(word, wordLength, "CANCEL")){ // 이용자명, 좌석번호와 예약 시각을 받는 명령
 
-            // 종료 시각(초) - 현재 시각(초) = 남은 시각(초) >= 폐장 시각(초) + 86400 - 현재 시각(초) = 남은 시각(초) 인 경우, 좌석 연장이 불가능함
+        request->type = (word[0] == 'R' || word[0] == 'r') ? REQUEST_RESERVE : REQUEST_CANCEL;
 
-            // 종료시간이 임박하여 연장불가한 경우, 연장 불가능하다는 내용을 출력한 후, 함수를 종료함.
-            if (((libSeats + location)->endTime - ((long long int)Time)) >= ((libData->CLOSE_TIME * 60) + 24 * 60 * 60 - currHour * 60 * 60 - currMin * 60 - currSecond))
+        nameLength = nextToken(&cursor, end, &name);
+        length = nextToken(&cursor, end, &token);
+        if (nameLength == 0 || nameLength >= MAX_NAME_LENGTH || !parseNumber(token, length, &value) || value <= 0)
+        {
+            return 0;
+        }
+        memcpy(request->name, name, nameLength);
+        request->location = value - 1;
+
+        // 예약 취소는 시작시각을 생략할 수 있다. 생략하면 가장 이른 예약을 취소한다.
+        peek = cursor;
+        length = nextToken(&peek, end, &token);
+        if (request->type == REQUEST_CANCEL && (length == 0 || isToken(token, length, "ROOM")))
+        {
+            cursor = peek;
+
+        }else{
+            if (!parseDateTime(&cursor, end, now, &request->time))
             {
-                printf("연장 불가\n");
-                return;
+                return 0;
             }
 
+            // 예약의 경우 종료시각(HH:MM)을 읽어 예약 시간(분)을 계산한다. 종료시각이 시작시각 이전이거나 같으면 다음날이다.
+            if (request->type == REQUEST_RESERVE)
+            {
+                length = nextToken(&cursor, end, &token);
+                if (!parseMinute(token, length, &value) || value < 0 || value >= 24 * 60)
+                {
+                    return 0;
+                }
+                Time = (time_t)request->time;
+                localtime_r(&Time, &tmTime);
+                start = tmTime.tm_hour * 60 + tmTime.tm_min;
+                request->value = (int)((value - start + 24 * 60 - 1) % (24 * 60) + 1);
+            }
+            length = nextToken(&cursor, end, &token);
         }
-        
-    }
-    
 
-    // 종료 시각의 초단위 값이 60 이상인 경우, 이를 조절한다.
-    if (computeSecond >= 60)
-    {
-        computeMinute += computeSecond / 60; // 종료 시각의 시단위 값이 24 이상인 경우, 이를 조절한다.
-        computeSecond %= 60; // 초단위 값은 60 미만의 값만을 처리한다.
-    }
+    }else if (isToken(word, wordLength, "QUEUE")){ // 자동 배정, 배정할 좌석이 없으면 대기열 등록
 
-    // 종료 시각의 분단위 값이 60 이상인 경우, 이를 조절한다.
-    if (computeMinute >= 60)
-    {
-        computeHour += computeMinute / 60; // 분단위 값 초과분 만큼 시단위 값을 증가시킨다.
-        computeMinute %= 60; // 분단위 값은 60 미만의 값만을 처리한다.
-    }
+        request->type = REQUEST_WAIT;
 
-    // 종료 시각의 시단위 값이 24 이상인 경우, 이를 조절한다.
-    if (computeHour >= 24)
-    {
-        computeHour %= 24; // 분단위 값은 60 미만의 값만을 처리한다.
-        isTomorrow = 1; // 이 경우 익일이므로, 익일임을 표시하는 변수에 익일임을 표시한다.
-    }
+        nameLength = nextToken(&cursor, end, &name);
+        if (nameLength == 0 || nameLength >= MAX_NAME_LENGTH)
+        {
+            return 0;
+        }
+        memcpy(request->name, name, nameLength);
+
+        // 우선 대기열은 가장 높은 우선순위이다.
+        length = nextToken(&cursor, end, &token);
+        if (isToken(token, length, "PRIORITY"))
+        {
+            request->value = WAIT_CLASSES - 1;
+            length = nextToken(&cursor, end, &token);
+        }
 
-    // 연장가능시각의 시, 분단위 값이 0 미만인 경우, 이를 조절한다. 초단위의 경우, 연장가능시각이 분단위이므로, 음수가 되지 않는다.
+    }else if (isToken(word, wordLength, "SEAT") || isToken(word, wordLength, "TOGGLE")){ // 좌석번호를 받는 명령
 
-    // 이를 분단위값과 시간 단위 값이 모두 0 이상일때까지 반복한다.
-    while (computeMinute < 0 || computeHour < 0)
-    {
-        // 연장가능시각의 분단위 값이 0 미만인 경우, 이를 조절한다.
-        if (computeMinute < 0)
+        request->type = (word[0] == 'S' || word[0] == 's') ? REQUEST_STATUS : REQUEST_ADMIN;
+        request->command = 7;
+
+        length = nextToken(&cursor, end, &token);
+        if (!parseNumber(token, length, &value) || value <= 0)
+        {
+            return 0;
+        }
+        request->location = value - 1;
+        length = nextToken(&cursor, end, &token);
+
+    }else if (isToken(word, wordLength, "RESET")){ // 모든 좌석 초기화
+
+        request->type = REQUEST_ADMIN;
+        request->command = 1;
+        length = nextToken(&cursor, end, &token);
+
+    }else if (isToken(word, wordLength, "SET")){ // 운영정보 변경. 설정 파일의 항목명도 받는다.
+
+        request->type = REQUEST_ADMIN;
+        length = nextToken(&cursor, end, &token);
+        if (isToken(token, length, "MAX_TIME"))
         {
-            computeHour--; // 분단위 값이 0 미만이므로 시간 단위 값을 1 감소시킨다.
-            computeMinute += 60; // 시간 단위 값을 1 감소시켰으므로, 분단위 값을 60 증가시킨다.
+            request->command = 2;
+        }else if (isToken(token, length, "RENEWABLE_TIME") || isToken(token, length, "MAX_RENEWABLE_TIME")){
+            request->command = 3;
+        }else if (isToken(token, length, "OPEN") || isToken(token, length, "OPEN_TIME")){
+            request->command = 4;
+        }else if (isToken(token, length, "CLOSE") || isToken(token, length, "CLOSE_TIME")){
+            request->command = 5;
+        }else{
+            return 0;
         }
 
-        // 연장가능시각의 분단위 값이 0 미만인 경우, 이를 조절한다.
-        if (computeHour < 0)
+        // 시간은 분 단위, 시각은 HH:MM 또는 0시 기준 분으로 받는다.
+        length = nextToken(&cursor, end, &token);
+        if (request->command <= 3 ? !parseNumber(token, length, &value) : !parseMinute(token, length, &value))
         {
-            computeHour += 24; // 시간 단위 값을 24 증가시킨다.
-            isTomorrow = 0; // 시간 단위 값을 24 증가시켰으므로, 더이상 익일이 아니다. 따라서, 익일임을 표시하는 변수에 익일이 아님을 표시한다.
+            return 0;
         }
-    }
+        request->value = value;
+        length = nextToken(&cursor, end, &token);
 
-    // 연장가능시각 문자를 출력한다.
-    printf("연장 가능 시각 : ");
+    }else{ // 알 수 없는 명령
+        return 0;
+    }
 
-    // 익일인 경우, 익일임을 출력한다.
-    if (isTomorrow)
+    // 열람실 번호를 읽는다.
+    if (length > 0 && isToken(token, length, "ROOM"))
     {
-        printf("익일 ");
+        length = nextToken(&cursor, end, &token);
+        if (!parseNumber(token, length, &value) || value <= 0 || value > MAX_ROOMS)
+        {
+            return 0;
+        }
+        request->room = (unsigned short)value;
+        length = nextToken(&cursor, end, &token);
     }
 
-    // 남은 연장가능시각의 정보를 출력한다.
-    printf("%d시 %d분 %d초\n", computeHour, computeMinute, computeSecond);
-
-    return;
+    // 명령 뒤에 남은 낱말이 있는 경우 잘못된 명령이다.
+    return length == 0;
 }
 
 
 /*
-* findUser 함수
-* 기능 : 주어진 이름의 이용자가 이용하는 좌석번호(0부터 시작)을 반환함.
-* 입력값 : *tmpName(찾을 이름이 저장된 문자열의 주소), 좌석 정보 구조체 포인터 *libSeats
-* 반환값 : 해당 이름을 가진 이용자의 좌석번호(0부터 시작). 해당 이용자가 좌석을 배정받지 않은 경우 -1을 반환함.
-* 설명 최종 수정 일자 : 2024/05/01
+* parseClockLine 함수
+* 기능 : 가상 시계를 옮기는 시뮬레이션 명령을 읽어 바뀐 시각을 계산한다. 시각은 거꾸로 옮길 수 없다.
+*        TIME [YYYY-MM-DD] HH:MM : 주어진 시각(지역 시각)으로 이동한다. 날짜를 생략하면 가상 시계의 오늘이다.
+*        WAIT 시간[m|h|d] : 주어진 시간만큼 이동한다. 단위를 생략하면 분이다.
+* 입력값 : 줄 시작 line, 줄 끝 end('\n' 제외), now(가상 시계의 현재 시각), 바뀐 시각을 저장할 포인터 *newTime
+* 반환값 : 올바른 시뮬레이션 명령인 경우 1, 잘못된 시뮬레이션 명령인 경우 0, 시뮬레이션 명령이 아닌 경우 -1
+* 설명 최종 수정 일자 : 2026/10/17
 */
-int findUser(char* tmpName, SeatsData* libSeats)
+int parseClockLine(const char* line, const char* end, long long int now, long long int* newTime)
 {
-    // 모든 좌석에 대해서 반복
-    for (int i = 0; i < SEATS; i++)
+    const char* cursor = line;
+    const char* word = NULL;
+    const char* token = NULL;
+    int wordLength = nextToken(&cursor, end, &word);
+    int length = 0, value = 0, unit = 60;
+
+    if (isToken(word, wordLength, "WAIT")) // 시간만큼 이동
     {
-        // 주어진 이름의 이용자명이 발견된 경우
-        if (!strcmp((libSeats+i)->seatsName, tmpName))
+        length = nextToken(&cursor, end, &token);
+
+        // 마지막 글자가 단위인 경우 단위를 바꾼다.
+        if (length > 0 && (token[length - 1] == 'm' || token[length - 1] == 'h' || token[length - 1] == 'd'))
+        {
+            unit = token[length - 1] == 'm' ? 60 : (token[length - 1] == 'h' ? 60 * 60 : 24 * 60 * 60);
+            length--;
+        }
+        if (!parseNumber(token, length, &value) || value < 0)
+        {
+            return 0;
+        }
+        *newTime = now + (long long int)value * unit;
+
+    }else if (isToken(word, wordLength, "TIME")){ // 주어진 시각으로 이동
+
+        if (!parseDateTime(&cursor, end, now, newTime) || *newTime < now)
         {
-            // 해당 좌석번호(0부터 시작) 반환
-            return i;
+            return 0;
         }
+
+    }else{ // 시뮬레이션 명령이 아닌 경우
+        return -1;
     }
 
-    // 해당 이용자가 없으면 -1 반환
-    return -1;
+    // 명령 뒤에 남은 낱말이 있는 경우 잘못된 명령이다.
+    return nextToken(&cursor, end, &token) == 0;
 }
 
 
 /*
-* isFull 함수
-* 기능 : 열람실의 좌석이 이용불가좌석을 제외한 좌석이 만석인지 확인해서 반환함.
-* 입력값 : 좌석 정보 구조체 포인터 *libSeats
-* 반환값 : 열람실이 만석인 경우 1을 반환함. 자리가 있는 경우 0을 반환함.
-* 설명 최종 수정 일자 : 2024/05/01
+* parseDateTime 함수
+* 기능 : [YYYY-MM-DD] HH:MM 형식의 지역 시각을 읽는다. 날짜를 생략하면 주어진 현재 시각의 날짜이다.
+* 입력값 : 읽을 위치 포인터 *cursor(읽은 낱말 뒤로 옮김), 줄 끝 end, now(현재 시각 - Unix 초), 읽은 시각을 저장할 포인터 *time
+* 반환값 : 올바른 시각인 경우 1, 그렇지 않은 경우 0을 반환함.
+* 설명 최종 수정 일자 : 2026/10/17
 */
-int isFull(SeatsData* libSeats)
+int parseDateTime(const char** cursor, const char* end, long long int now, long long int* time)
 {
-    // 모든 좌석에 대하여 반복
-    for (int i = 0; i < SEATS; i++)
+    const char* token = NULL;
+    int length = nextToken(cursor, end, &token);
+    int minute = 0, year = 0, month = 0, day = 0, first = -1, second = -1;
+    time_t Time = (time_t)now;
+    struct tm tmTime;
+
+    localtime_r(&Time, &tmTime);
+
+    // 날짜(YYYY-MM-DD)가 있는 경우, 두 '-'의 위치로 연, 월, 일을 나눈다.
+    for (int i = 0; i < length; i++)
     {
-        // 빈 좌석 발견 시
-        if (((libSeats + i)->endTime) == 0)
+        if (token[i] == '-' && first < 0)
+        {
+            first = i;
+        }else if (token[i] == '-'){
+            second = i;
+        }
+    }
+    if (first >= 0)
+    {
+        if (second < 0 || !parseNumber(token, first, &year) || !parseNumber(token + first + 1, second - first - 1, &month)
+            || !parseNumber(token + second + 1, length - second - 1, &day)
+            || year < 1970 || month < 1 || month > 12 || day < 1 || day > 31)
         {
-            // 빈 좌석이 있으므로, 0 반환 후 함수 종료
             return 0;
         }
+        tmTime.tm_year = year - 1900;
+        tmTime.tm_mon = month - 1;
+        tmTime.tm_mday = day;
+        length = nextToken(cursor, end, &token);
+    }
+
+    // 시각(HH:MM)을 읽는다.
+    if (!parseMinute(token, length, &minute) || minute < 0 || minute >= 24 * 60)
+    {
+        return 0;
     }
+    tmTime.tm_hour = minute / 60;
+    tmTime.tm_min = minute % 60;
+    tmTime.tm_sec = 0;
+    tmTime.tm_isdst = -1;
+    *time = (long long int)mktime(&tmTime);
 
-    // 빈 좌석이 없으므로, 1 반환 후 함수 종료
     return 1;
 }
 
 
 /*
-* leftSeconds 함수
-* 기능 : 열람실의 폐장시각까지 몇 초가 남았는지 찾아서 반환함.
-* 입력값 : 시설 정보 구조체 포인터 *libData
-* 반환값 : 열람실의 폐장시각까지 남은 시간(초)
-* 설명 최종 수정 일자 : 2024/05/01
+* batchLine 함수
+* 기능 : 명령 한 줄을 처리하고 결과 한 줄을 출력 버퍼에 쓴다. 좌석 서비스와 같은 handleRequest 함수로 처리한다.
+*        결과 형식은 "줄번호 결과 좌석번호 이용종료시각 빈좌석수"이며, 좌석번호는 1번부터(없는 경우 0), 이용종료시각은 Unix 시간(이용중이 아닌 경우 0)이다.
+*        가상 시계를 이용하는 경우(시뮬레이션)에는 TIME, WAIT 명령으로 가상 시계를 옮길 수 있다.
+* 입력값 : 줄 시작 line, 줄 끝 end('\n' 제외, NULL이면 입력 버퍼보다 긴 줄), 일괄 처리 출력 구조체 포인터 *output, 좌석 정보 구조체 포인터 *libSeats
+* 반환값 없음
+* 설명 최종 수정 일자 : 2026/10/17
 */
-int leftSeconds(LibraryData* libData)
+void batchLine(const char* line, const char* end, BatchOutput* output, SeatsData* libSeats)
 {
-    // 현재 시간 관련 변수 선언
-    time_t Time;
-    struct tm* pTime;
-    Time = time(NULL);
-    pTime = localtime(&Time);
-
-    // 현재 시각의 시, 분, 초 계산
-    int hour = pTime->tm_hour;
-    int minute = pTime->tm_min;
-    int second = pTime->tm_sec;
-
-    // 남은 초를 계산하는 변수를 선언
-    int leftSec = 0;
-
-    if (libData->CLOSE_TIME == libData->OPEN_TIME) { return 86401; } // 24시간 운영인 경우, 1일보다 1초 추가된 86401초 반환.
-
-    // 개장시각과 폐장시각에 따라 구분
-    if (libData->CLOSE_TIME < libData->OPEN_TIME) // 개장시각이 폐장시각보다 늦은 경우
+    // 응답 결과(RESULT_OK 등)의 이름
+    static const char* const resultNames[] = { "OK", "BAD_REQUEST", "NO_SEAT", "SEAT_TAKEN", "ALREADY_SEATED", "FULL", "CLOSED", "NOT_RENEWABLE", "WAITING", "QUOTA" };
+
+    SeatRequest request;
+    SeatResponse response;
+    ClockContext clock;
+    ClockSource* virtualClock = (libSeats->clockSource != NULL && libSeats->clockSource->read == readVirtualClock) ? libSeats->clockSource : NULL;
+    long long int newTime = 0;
+    int isClock = (end == NULL || virtualClock == NULL) ? -1 : parseClockLine(line, end, virtualClock->now, &newTime);
+    int isBulk = (end == NULL || isClock >= 0) ? -1 : batchBulkLine(line, end, libSeats);
+    int isValid = (end == NULL) ? 0 : (isClock >= 0 ? isClock : (isBulk >= 0 ? isBulk : parseBatchLine(line, end, readClock(libSeats), &request)));
+
+    output->lineNumber++;
+
+    // 빈 줄이나 주석인 경우
+    if (isValid < 0)
     {
-        if (hour * 60 * 60 + minute * 60 + second <= (libData->OPEN_TIME * 60)) // 다음날이 된 경우(다음날의 개장시간 이전)
-        {
-            // 폐장시각까지 남은 초는 폐장시각(초) - 현재시각(초)이다.
-            leftSec = libData->CLOSE_TIME * 60 - (hour * 60 * 60 + minute * 60 + second);
+        return;
+    }
 
-        }else{ // 아직 날짜 바뀌지 않은 경우
+    // 올바른 명령은 처리하고, 잘못된 명령은 잘못된 요청으로 응답한다.
+    // 가상 시계를 옮기는 명령은 시각을 바꾼 후 만료된 좌석을 처리하며, 이용종료시각 자리에 바뀐 현재 시각을 쓴다.
+    if (isValid && isClock > 0)
+    {
+        virtualClock->now = newTime;
+        captureClock(&clock, libSeats, &libSeats->header->rooms[0]);
+        expireSeats(libSeats, &clock, output->metrics);
+
+        memset(&response, 0, sizeof(response));
+        response.result = RESULT_OK;
+        response.location = -1;
+        response.endTime = virtualClock->now;
+        response.freeCount = __atomic_load_n(&libSeats->header->freeCount, __ATOMIC_RELAXED);
+
+    }else if (isValid && isBulk > 0){ // 좌석 일괄 설정 명령은 읽으면서 처리했으므로 결과만 쓴다.
+        memset(&response, 0, sizeof(response));
+        response.result = RESULT_OK;
+        response.location = -1;
+        response.freeCount = __atomic_load_n(&libSeats->header->freeCount, __ATOMIC_RELAXED);
+
+    }else if (isValid){
+        handleRequest(&request, &response, libSeats, output->metrics, -1);
+    }else{
+        memset(&response, 0, sizeof(response));
+        response.result = RESULT_BAD_REQUEST;
+        response.location = -1;
+        response.freeCount = __atomic_load_n(&libSeats->header->freeCount, __ATOMIC_RELAXED);
+    }
 
-            // 폐장시각까지 남은 초는 폐장시각(초) + 1일(86400초 = 60 * 60 * 24) - 현재시각(초)이다.
-            leftSec = libData->CLOSE_TIME * 60 + 60 * 60 * 24 - (hour * 60 * 60 + minute * 60 + second);
-        }
-    }else{ // 개장시각이 폐장시각보다 빠른 경우
+    output->commandCount++;
+    if (response.result != RESULT_OK)
+    {
+        output->failCount++;
+    }
 
-        // 폐장시각까지 남은 초는 폐장시각(초) - 현재시각(초)이다.
-        leftSec = libData->CLOSE_TIME * 60 - (hour * 60 * 60 + minute * 60 + second);
+    // 결과 한 줄을 출력 버퍼에 쓴다.
+    outputNumber(output, output->lineNumber);
+    outputText(output, " ", 1);
+    outputText(output, resultNames[response.result], (int)strlen(resultNames[response.result]));
+    outputText(output, " ", 1);
+    outputNumber(output, response.location + 1);
+    outputText(output, " ", 1);
+    outputNumber(output, response.endTime);
+    outputText(output, " ", 1);
+    outputNumber(output, response.freeCount);
+    outputText(output, "\n", 1);
+
+    // 출력 버퍼가 거의 찬 경우, 지금까지의 기록을 확정한 후 결과를 내보낸다.
+    if (output->length > BATCH_OUTPUT_SIZE - BATCH_LINE_SPACE)
+    {
+        walCommit(libSeats);
+        historyCommit(libSeats, 0);
+        outputFlush(output);
+        metricsExport(libSeats, 0);
     }
 
-    // 계산한 남은 초 반환
-    return leftSec;
+    return;
 }
 
 
 /*
-* setSeat 함수
-* 기능 : 주어진 좌석번호의 좌석에 주어진 이용자명의 이용자를 배정함
-* 입력값 : *tmpName(찾을 이름이 저장된 문자열의 주소), location(0번부터 시작하는 좌석번호), 좌석 정보 구조체 포인터 *libSeats, 시설 정보 구조체 포인터 *libData
-* 반환값 없음
-* 설명 최종 수정 일자 : 2024/05/01
+* batchBulkLine 함수
+* 기능 : 좌석 일괄 설정 명령 한 줄을 읽어 바로 처리한다. 좌석 선택 문자열의 형식은 parseSeatSelection과 같다.
+*        BLOCK 좌석선택 : 선택한 좌석을 이용불가로 바꾼다. 이용중인 좌석은 퇴실 처리한다.
+*        UNBLOCK 좌석선택 : 선택한 이용불가 좌석을 빈 좌석으로 되돌린다.
+*        BLACKOUT [YYYY-MM-DD] HH:MM [YYYY-MM-DD] HH:MM 좌석선택 : 선택한 좌석을 시작시각부터 종료시각까지 이용불가로 바꾸도록 예약한다.
+* 입력값 : 줄 시작 line, 줄 끝 end('\n' 제외), 좌석 정보 구조체 포인터 *libSeats
+* 반환값 : 처리한 경우 1, 잘못된 명령인 경우 0, 좌석 일괄 설정 명령이 아닌 경우 -1
+* 설명 최종 수정 일자 : 2026/10/17
 */
-void setSeat(char* tmpName, int location, SeatsData* libSeats, LibraryData* libData)
+int batchBulkLine(const char* line, const char* end, SeatsData* libSeats)
 {
-    // 현재 시각 관련 변수 선언
-    time_t Time;
-    Time = time(NULL);
-
-    // 지정된 좌석번호에 이용자명을 입력함으로써 좌석 배정
-    strncpy((libSeats + location)->seatsName, tmpName, MAX_NAME_LENGTH);
+    const char* cursor = line;
+    const char* word = NULL;
+    int wordLength = nextToken(&cursor, end, &word);
+    long long int now = 0, start = 0, finish = 0;
+    unsigned long long int* mask = NULL;
+    int isValid = 0;
+
+    if (!isToken(word, wordLength, "BLOCK") && !isToken(word, wordLength, "UNBLOCK") && !isToken(word, wordLength, "BLACKOUT"))
+    {
+        return -1;
+    }
 
-    // 폐장시각까지의 남은 시간 계산
-    int leftTime = leftSeconds(libData);
+    // 이용불가 시간대는 시작시각과 종료시각을 먼저 읽는다. 종료시각은 시작시각보다 뒤여야 한다.
+    now = readClock(libSeats);
+    if (isToken(word, wordLength, "BLACKOUT") && (!parseDateTime(&cursor, end, now, &start) || !parseDateTime(&cursor, end, now, &finish) || finish <= start))
+    {
+        return 0;
+    }
 
-    // 폐장시각까지의 남은 시간과 최대이용가능시간을 비교한다.
-    // 최대이용가능시간이 남은 시간보다 길면, 이용자에게 최대이용가능시간을 부여하고, 그렇지 않으면 폐장시각까지의 시간을 부여한다.
-    if ((libData->MAX_TIME * 60) > leftTime) // 최대이용가능시간이 남은 시간보다 짧은 경우
+    mask = malloc(sizeof(unsigned long long int) * libSeats->wordCount);
+    if (mask == NULL)
     {
-        // 이용자에게 폐장시각까지의 시간을 부여한다. 종료시각은 현재시각 + 폐장시각까지의 남은 시간이다.
-        (libSeats + location)->endTime = (long long int)(Time) + leftTime;
-    }else{ // 최대이용가능시간이 남은 시간보다 긴 경우
+        return 0;
+    }
 
-        // 이용자에게 최대이용가능시간을 부여한다. 최대이용가능시간은 분단위이고, 종료시각은 현재시각 + 최대이용가능시간이다.
-        // 종료시각은 초단위이므로, 분단위인 최대이용가능시각을 초단위로 조정한다.
-        (libSeats + location)->endTime = (long long int)(Time) + libData->MAX_TIME * 60;
+    if (parseSeatSelection(cursor, end, mask, libSeats) > 0)
+    {
+        isValid = 1;
+        if (isToken(word, wordLength, "BLOCK"))
+        {
+            setSeatsState(mask, 0, libSeats->seatCount, SEAT_UNAVAILABLE, 0, libSeats);
+        }else if (isToken(word, wordLength, "UNBLOCK")){
+            setSeatsState(mask, 0, libSeats->seatCount, SEAT_EMPTY, 0, libSeats);
+        }else if ((isValid = scheduleBlackout(mask, start, finish, libSeats) > 0)){
+            // 이미 시작된 시간대는 바로 처리한다.
+            runBlackouts(libSeats, now);
+        }
     }
 
-    return;
+    free(mask);
+
+    return isValid;
 }
 
 
 /*
-* isRenewable 함수
-* 기능 : 좌석이 연장 가능한지 확인하여 그 결과를 반환한다.
-* 입력값 : location(0번부터 시작하는 좌석번호), 좌석 정보 구조체 포인터 *libSeats, 시설 정보 구조체 포인터 *libData
-* 반환값 : 연장 가능하면 1을 반환하고, 그렇지 않으면 0을 반환한다.
-* 설명 최종 수정 일자 : 2024/05/01
+* runBatch 함수
+* 기능 : 명령 파일(또는 표준 입력)의 명령을 한 줄씩 처리하고, 결과를 표준 출력에 쓴다.
+*        입력은 큰 버퍼에 한 번에 읽어 버퍼 안에서 바로 나누며, 명령마다 메모리를 할당하지 않는다.
+*        기록은 출력 버퍼를 비울 때와 입력이 끝났을 때 모아서 확정하므로, 출력된 결과는 항상 디스크에 확정된 상태이다.
+* 입력값 : 명령 파일 경로 path("-"이면 표준 입력), 좌석 정보 구조체 포인터 *libSeats
+* 반환값 : 입력을 끝까지 처리한 경우 1, 파일을 열거나 읽을 수 없는 경우 0
+* 설명 최종 수정 일자 : 2026/10/17
 */
-int isRenewable(int location, SeatsData* libSeats, LibraryData* libData)
-{
-    // 현재 시각 관련 변수 선언
-    time_t Time;
-    struct tm* pTime;
-    Time = time(NULL);
-    pTime = localtime(&Time);
-
-    // 연장 가능한지에 대한 답을 저장할 변수를 선언. 기본값은 1(연장 가능) 
-    int answer = 1;
+int runBatch(const char* path, SeatsData* libSeats)
+{
+    // 입력 버퍼와 출력 버퍼는 크므로 정적 변수로 선언한다.
+    static char input[BATCH_INPUT_SIZE];
+    static BatchOutput output;
 
-    // 임시로 시간 정보를 저장하는 변수 선언. 이 변수의 최댓값은 86400(1일의 초 단위)임.
-    int tmpTime = (libSeats + location)->endTime - (long long int)(Time);
+    const char* start = NULL;
+    const char* end = NULL;
+    const char* newline = NULL;
+    ssize_t length = 0;
+    int fd = 0, used = 0, isSkipping = 0, isReadOk = 1;
 
-    // 개장시각과 폐장시각에 따라 구분
-    // 24시간제의 경우, 폐장시각으로 인해 연장 불가능한 경우가 없으으로 해당 조건문에서 구분하지 않음.
-    if (libData->OPEN_TIME < libData->CLOSE_TIME) // 개장시각이 폐장시각보다 앞에 있는 경우
+    if (strcmp(path, "-"))
     {
-        // 개인별 종료 시각(Unix 초) - 현재 시각(Unix 초) = 남은 시간(초) >= 폐장 시각(초) - 현재 시각(초) = 남은 시간(초) 인 경우, 연장이 불가능하다.
-        
-        // 좌석의 남은 시간이 폐장 시각까지의 남은 시간 이상인 경우
-        if (((libSeats + location)->endTime - ((long long int)Time)) >= ((libData->CLOSE_TIME * 60) - (pTime->tm_hour) * 60 * 60 - (pTime->tm_min) * 60 - (pTime->tm_sec)))
+        fd = open(path, O_RDONLY);
+        if (fd < 0)
         {
-            // 연장이 불가능함을 연장 가능하지에 대한 답을 저장하는 변수에 저장한다.
-            answer = 0;
+            printf("명령 파일 %s을 열 수 없습니다.\n", path);
+            return 0;
         }
+    }
 
-    }else if (libData->OPEN_TIME > libData->CLOSE_TIME){ // 개장시각이 폐장시각보다 뒤에 있는 경우
-        if (((libData->OPEN_TIME * 60) - (pTime->tm_hour) * 60 * 60 - (pTime->tm_min) * 60 - (pTime->tm_sec)) >= 0) // 개장시각이 폐장시각보다 뒤에 있으며, 00시를 지난 경우 (개장 시각 이후)
+    output.lineNumber = 0;
+    output.commandCount = 0;
+    output.failCount = 0;
+    output.length = 0;
+    output.metrics = metricsThread(libSeats);
+
+    while (1)
+    {
+        length = read(fd, input + used, BATCH_INPUT_SIZE - used);
+        if (length < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (length < 0)
         {
-            // 개인별 종료 시각(Unix 초) - 현재 시각(Unix 초) = 남은 시간(초) >= 폐장 시각(초) - 현재 시각(초) = 남은 시간(초) 인 경우, 연장이 불가능하다.
+            printf("명령을 읽을 수 없습니다.\n");
+            isReadOk = 0;
+            break;
+        }
 
-            // 좌석의 남은 시간이 폐장 시각까지의 남은 시간 이상인 경우
-            if (((libSeats + location)->endTime - ((long long int)Time)) >= ((libData->CLOSE_TIME * 60) - (pTime->tm_hour) * 60 * 60 - (pTime->tm_min) * 60 - (pTime->tm_sec))) // 종료시간이 임박하여 연장불가한 경우
+        // 버퍼 안의 완성된 줄을 모두 처리한다. 입력 버퍼보다 긴 줄의 나머지 부분은 건너뛴다.
+        used += (int)length;
+        start = input;
+        end = input + used;
+        while ((newline = memchr(start, '\n', end - start)) != NULL)
+        {
+            if (!isSkipping)
             {
-                // 연장이 불가능함을 연장 가능하지에 대한 답을 저장하는 변수에 저장한다.
-                answer = 0;
+                batchLine(start, newline, &output, libSeats);
             }
+            isSkipping = 0;
+            start = newline + 1;
+        }
+        used = (int)(end - start);
 
-        }else{ // 개장시각이 폐장시각보다 뒤에 있으며, 00시를 지나지 않은 경우 (개장 시각 이전)
-            // 개인별 종료 시각(Unix 초) - 현재 시각(Unix 초) = 남은 시간(초) >= 폐장 시각(초) + 86400 - 현재 시각(초) = 남은 시간(초) 인 경우, 연장이 불가능하다.
-
-            // 좌석의 남은 시간이 폐장 시각까지의 남은 시간 이상인 경우
-            if (((libSeats + location)->endTime - ((long long int)Time)) >= ((libData->CLOSE_TIME * 60) + 24 * 60 * 60 - (pTime->tm_hour) * 60 * 60 - (pTime->tm_min) * 60 - (pTime->tm_sec))) // 종료시간이 임박하여 연장불가한 경우
+        // 입력이 끝난 경우, '\n'으로 끝나지 않은 마지막 줄을 처리한다.
+        if (length == 0)
+        {
+            if (used > 0 && !isSkipping)
             {
-                // 연장이 불가능함을 연장 가능하지에 대한 답을 저장하는 변수에 저장한다.
-                answer = 0;
+                batchLine(start, end, &output, libSeats);
             }
+            break;
         }
 
+        if (used == BATCH_INPUT_SIZE) // 버퍼가 가득 찰 때까지 줄이 끝나지 않은 경우, 잘못된 명령으로 처리한다.
+        {
+            batchLine(input, NULL, &output, libSeats);
+            isSkipping = 1;
+            used = 0;
+        }else{ // 완성되지 않은 줄을 버퍼 앞으로 옮긴다.
+            memmove(input, start, used);
+        }
     }
 
-    // 반환값으로 종료시각까지의 남은 시간이 초 단위로 환산한 연장가능시간보다 작은 경우에는 연장이 가능함을 출력하며, 폐장시각보다 연장가능시각을 초과하는 경우 연장이 불가함을 반환한다.
-    // 연장가능시간은 종료시각에서 현재시각까지의 차이가 어느 정도 미만이어야 연장이 가능한지를 나타내는 시간이다.
-    return (tmpTime <= libData->MAX_RENEWABLE_TIME * 60) && answer;
+    if (fd != 0)
+    {
+        close(fd);
+    }
+
+    // 남은 기록을 확정한 후, 처리 결과를 요약해 내보낸다.
+    walCommit(libSeats);
+    historyCommit(libSeats, 0);
+    outputText(&output, "# ", 2);
+    outputNumber(&output, output.commandCount);
+    outputText(&output, " commands, ", 11);
+    outputNumber(&output, output.failCount);
+    outputText(&output, " failed\n", 8);
+    outputFlush(&output);
+
+    return isReadOk;
 }
 
 
 /*
-* renewSeat 함수
-* 기능 : 주어진 좌석번호의 좌석의 이용시간을 연장함. 연장 가능 여부의 경우, 본 함수 호출 전 확인한다고 가정함.
-* 입력값 : location(0번부터 시작하는 좌석번호), 좌석 정보 구조체 포인터 *libSeats, 시설 정보 구조체 포인터 *libData
-* 반환값 없음
-* 설명 최종 수정 일자 : 2024/05/01
+* benchNow 함수
+* 기능 : 지연시간 측정에 이용하는 단조 증가 시각을 읽는다.
+* 입력값 없음
+* 반환값 : 시각(ns)
+* 설명 최종 수정 일자 : 2026/10/17
 */
-void renewSeat(int location, SeatsData* libSeats, LibraryData* libData)
+long long int benchNow(void)
 {
-    // 현재 시각 관련 변수 선언
-    time_t Time;
-    Time = time(NULL);
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
 
-    // 현재 시각 기준 폐장까지 남은 시간을 저장하는 변수 선언 및 남은 시간을 저장
-    int leftTime = leftSeconds(libData);
+    return (long long int)now.tv_sec * 1000000000LL + now.tv_nsec;
+}
 
-    // 개인별 종료 시각(Unix 초) - 현재 시각(Unix 초) + 연장 시간(초) > 남은 시간(초) 인 경우, 폐장시각까지의 시간을 부여
-    if (((libSeats + location)->endTime - ((long long int)Time) + (libData->MAX_TIME * 60)) > leftTime)
+
+/*
+* benchRecord 함수
+* 기능 : 지연시간 하나를 측정 결과에 더한다. 지연시간은 2의 거듭제곱 구간마다 BENCH_SUB_BUCKETS칸으로 나눈 히스토그램에 기록하므로, 오차는 약 6% 이내이다.
+* 입력값 : 측정 결과 구조체 포인터 *stat, elapsed(지연시간, ns)
+* 반환값 없음
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+void benchRecord(BenchStat* stat, long long int elapsed)
+{
+    int bucket = 0, exponent = 0;
+
+    if (elapsed < 0)
     {
-        // 이용자에게 폐장시각까지의 시간을 부여
-        (libSeats + location)->endTime = ((long long int)(Time)) + leftTime;
+        elapsed = 0;
+    }
 
+    // BENCH_SUB_BUCKETS ns 미만은 1ns 단위로, 그 이상은 가장 높은 비트 아래 BENCH_SUB_BITS개의 비트로 칸을 정한다.
+    if (elapsed < BENCH_SUB_BUCKETS)
+    {
+        bucket = (int)elapsed;
     }else{
-        // 이용자에게 기존 이용시간에 기본 이용시간을 추가하여 시간 부여
-        // 최대이용시간은 분단위 시간이지만, 종료시각은 초단위 시각을 저장하므로, 분단위 시간을 초단위 시간으로 변경하여 저장
-        // (libSeats + i)->endTime에는 Unix 시간을 저장하므로 날짜가 바뀌어서 생기는 문제는 없음
-        (libSeats + location)->endTime += libData->MAX_TIME * 60;
+        exponent = 63 - __builtin_clzll((unsigned long long int)elapsed);
+        bucket = (exponent - BENCH_SUB_BITS + 1) * BENCH_SUB_BUCKETS + (int)((elapsed >> (exponent - BENCH_SUB_BITS)) & (BENCH_SUB_BUCKETS - 1));
+        if (bucket >= BENCH_BUCKETS)
+        {
+            bucket = BENCH_BUCKETS - 1;
+        }
+    }
+
+    stat->buckets[bucket]++;
+    stat->count++;
+    stat->totalTime += elapsed;
+    if (elapsed > stat->maxTime)
+    {
+        stat->maxTime = elapsed;
     }
 
     return;
@@ -963,310 +10847,575 @@ void renewSeat(int location, SeatsData* libSeats, LibraryData* libData)
 
 
 /*
-* checkOut 함수
-* 기능 : 주어진 좌석번호의 좌석을 퇴실 처리함
-* 입력값 : location(0번부터 시작하는 좌석번호), 좌석 정보 구조체 포인터 *libSeats
-* 반환값 없음
-* 설명 최종 수정 일자 : 2024/05/01
+* benchPercentile 함수
+* 기능 : 히스토그램에서 지연시간의 백분위수를 구한다. 해당 칸의 상한을 돌려주므로, 실제 값보다 작게 계산되지 않는다.
+* 입력값 : 측정 결과 구조체 포인터 *stat, fraction(0~1 사이의 비율, 0.99이면 99번째 백분위수)
+* 반환값 : 지연시간(ns), 측정 결과가 없는 경우 0
+* 설명 최종 수정 일자 : 2026/10/17
 */
-void checkOut(int location, SeatsData* libSeats)
+long long int benchPercentile(BenchStat* stat, double fraction)
 {
-    // 주어진 좌석의 이용자명을 초기화함
-    strncpy((libSeats + location)->seatsName, "", MAX_NAME_LENGTH);
+    long long int target = (long long int)(fraction * stat->count + 0.999999);
+    long long int seen = 0, upper = 0;
+    int exponent = 0;
 
-    // 주어진 좌석의 종료시각을 이용가능상태로 초기화함
-    (libSeats + location)->endTime = 0;
+    if (stat->count == 0) { return 0; }
+    if (target < 1) { target = 1; }
 
-    return;
+    for (int i = 0; i < BENCH_BUCKETS; i++)
+    {
+        seen += stat->buckets[i];
+        if (seen >= target)
+        {
+            // 칸의 상한을 계산한다. benchRecord에서 칸을 정하는 방법의 반대이다.
+            if (i < BENCH_SUB_BUCKETS)
+            {
+                upper = i;
+            }else{
+                exponent = i / BENCH_SUB_BUCKETS + BENCH_SUB_BITS - 1;
+                upper = ((long long int)(BENCH_SUB_BUCKETS + i % BENCH_SUB_BUCKETS + 1) << (exponent - BENCH_SUB_BITS)) - 1;
+            }
+            return upper < stat->maxTime ? upper : stat->maxTime;
+        }
+    }
+
+    return stat->maxTime;
 }
 
 
 /*
-* seatSelector 함수
-* 기능 : 좌석 배정 시스템을 실행함
-* 입력값 : *tmpName(찾을 이름이 저장된 문자열의 주소), 좌석 정보 구조체 포인터 *libSeats, 시설 정보 구조체 포인터 *libData
-* 반환값 없음
-* 설명 최종 수정 일자 : 2024/05/01
+* benchRandom 함수
+* 기능 : 성능 측정의 요청을 만드는 난수를 생성한다(xorshift64*). 같은 상태에서 시작하면 항상 같은 요청이 만들어진다.
+* 입력값 : 난수 상태 포인터 *state(0이 아니어야 함)
+* 반환값 : 32비트 난수
+* 설명 최종 수정 일자 : 2026/10/17
 */
-void seatSelector(char* tmpName, SeatsData* libSeats, LibraryData* libData)
+unsigned int benchRandom(unsigned long long int* state)
 {
-    /*
-    * 변수 선언
-    * 
-    * tmpSeatNo : 수정할 좌석 번호를 임시로 저장함
-    * isRenewableRes : 연장 가능 여부를 임시로 저장함
-    * tmpMenu : 연장, 퇴실, 취소 메뉴 선택값을 임시로 저장함
-    */
-    int tmpSeatNo = -1, isRenewableRes = 0, tmpMenu = 0;
+    *state ^= *state >> 12;
+    *state ^= *state << 25;
+    *state ^= *state >> 27;
 
-    // location 변수를 선언하고, 주어진 이용자명의 이용자가 사용하는 좌석번호를 가져옴.
-    int location = findUser(tmpName, libSeats);
+    return (unsigned int)((*state * 2685821657736338717ULL) >> 32);
+}
 
-    // 새로운 이용자와 기존 이용자를 구분함
-    if (location == -1) // 이용자 좌석의 위치가 -1, 즉 새로운 이용자인 경우
+
+/*
+* benchDay 함수
+* 기능 : 개장부터 폐장까지 하루 동안의 요청을 가상 시각에 맞추어 발생시키며, 좌석 관리 함수를 직접 호출하고 지연시간을 측정한다.
+*        아침 입실, 평상시, 점심시간, 연장이 몰리는 시간을 거친 후, 폐장시각에 남은 좌석이 한 번에 만료되고 모든 좌석을 초기화한다.
+*        요청마다 대화형 모드와 같은 순서(만료 좌석 처리, 이용자 확인, 만석 확인, 배정/연장/퇴실)로 호출한다.
+* 입력값 : 좌석 정보 구조체 포인터 *libSeats, 시설 정보 구조체 포인터 *libData(개장 9시, 폐장 22시), 측정 결과 배열 stats, 이용자명 열 names, userCount(이용자 수)
+* 반환값 : 발생시킨 요청 수
+* 설명 최종 수정 일자 : 2026/10/17
+*/
+long long int benchDay(SeatsData* libSeats, LibraryData* libData, BenchStat* stats, char (*names)[MAX_NAME_LENGTH], int userCount)
+{
+    // 하루의 구간. 최대 이용 가능 시간(240분)이 지나는 13시 전후와 17시 전후에 연장 요청이 몰린다.
+    static const BenchPhase phases[] = {
+        { 9 * 60, 10 * 60, 120, BENCH_RUSH },
+        { 10 * 60, 12 * 60, 100, BENCH_CHURN },
+        { 12 * 60, 12 * 60 + 30, 80, BENCH_LUNCH },
+        { 12 * 60 + 30, 13 * 60 + 30, 100, BENCH_RENEWAL },
+        { 13 * 60 + 30, 17 * 60, 150, BENCH_CHURN },
+        { 17 * 60, 18 * 60, 80, BENCH_RENEWAL },
+        { 18 * 60, 22 * 60, 100, BENCH_CHURN },
+    };
+
+    RoomData* room = &libSeats->header->rooms[0];
+    ClockContext clock;
+    unsigned long long int random = 0x9E3779B97F4A7C15ULL;
+    long long int midnight = 0, events = 0, total = 0, start = 0;
+    int location = -1, roll = 0, full = 0;
+    char* name = NULL;
+
+    // 오늘 0시를 기준으로 가상 시각을 만든다.
+    captureClock(&clock, libSeats, room);
+    midnight = clock.midnight;
+
+    for (int p = 0; p < (int)(sizeof(phases) / sizeof(phases[0])); p++)
     {
-        // 좌석이 만석인 경우, 좌석 배정 불가라는 내용을 출력한 후, 함수를 종료함.
-        if (isFull(libSeats))
+        events = (long long int)libSeats->seatCount * phases[p].eventsPercent / 100;
+        if (events < BENCH_MIN_EVENTS)
         {
-            printf("만석입니다.\n");
-            return;
+            events = BENCH_MIN_EVENTS;
         }
 
-        // 좌석이 있는 경우, 이용자용 좌석 상태 목록을 출력함
-        printSeatInfo(libSeats, 0);
-        
-        // 무한 루프. 이용가능한 좌석이 입력될때까지 반복한다.
-        while (1)
+        for (long long int e = 0; e < events; e++)
         {
-            do {
-                // 1부터 시작하는 좌석번호를 입력받는다.
-                printf("좌석 번호 선택(취소 : 0) : ");
-                scanf("%d", &tmpSeatNo);
-
-                // 입력받은 1부터 시작하는 좌석번호를 0부터 시작하는 좌석번호로 바꾼다.
-                tmpSeatNo--;
+            // 구간 안에서 요청을 고르게 나누어 가상 시각을 정한다.
+            setClock(&clock, libSeats, room, midnight + phases[p].startMinute * 60LL + (phases[p].endMinute - phases[p].startMinute) * 60LL * e / events);
+            name = names[benchRandom(&random) % (unsigned int)userCount];
+            roll = (int)(benchRandom(&random) % 100);
 
-                // 입력받은 좌석번호가 0(배정 취소)와 SEATS(가장 마지막 좌석 번호) 범위를 벗어난 경우, 잘못된 값을 입력받았다고 출력한다.
-                if (tmpSeatNo < -1 || tmpSeatNo >= SEATS)
-                {
-                    printf("잘못된 값을 입력하였습니다.\n");
-                }
+            // 요청마다 만료된 좌석을 먼저 퇴실 처리한다.
+            start = benchNow();
+            seatInvalidCheck(libSeats, room, &clock);
+            benchRecord(&stats[BENCH_INVALID_CHECK], benchNow() - start);
 
-            } while (tmpSeatNo < -1 || tmpSeatNo >= SEATS); // 옳은 입력값을 입력받을때까지 반복
+            start = benchNow();
+            location = findUser(name, libSeats);
+            benchRecord(&stats[BENCH_FIND_USER], benchNow() - start);
 
-            if (tmpSeatNo == -1) // 0을 입력받은 경우(0 - 1 = -1), 좌석 배정 과정을 취소한다.
+            if (location == -1) // 좌석이 없는 이용자. 아침 입실과 점심시간에는 모두, 평상시와 연장 구간에는 일부만 입실을 시도한다.
             {
-                printf("좌석 선택을 취소하였습니다.\n");
-                return;
-            }
+                if ((phases[p].kind == BENCH_CHURN && roll < 40) || (phases[p].kind == BENCH_RENEWAL && roll < 70))
+                {
+                    continue;
+                }
 
-            // 이용중인 좌석이거나 이용불가 좌석인지 확인한다.
-            // 빈 좌석의 경우, 좌석의 이용자명이 ""이며, 이용불가 좌석의 경우, endTime의 값이 -1이다.
+                start = benchNow();
+                full = isFull(libSeats);
+                benchRecord(&stats[BENCH_IS_FULL], benchNow() - start);
 
-            if (strlen((libSeats + tmpSeatNo)->seatsName)) // 이용중인 좌석인지 확인한다.
-            {
-                printf("이미 이용중인 좌석입니다.\n다른 좌석을 선택해주세요.\n");
+                if (!full)
+                {
+                    location = findFreeSeat(libSeats, room);
+                    start = benchNow();
+                    setSeat(name, location, libSeats, libData, &clock);
+                    benchRecord(&stats[BENCH_SET_SEAT], benchNow() - start);
+                }
 
-            }else if ((libSeats + tmpSeatNo)->endTime == -1){ // 이용중인 좌석인지 확인한다.
-                printf("이용불가 좌석입니다.\n다른 좌석을 선택하세요.\n");
+            }else{ // 좌석이 있는 이용자. 이용 형태에 따라 퇴실하거나, 연장 가능한 경우 연장한다.
 
-            }else{ // 이용가능 좌석의 경우, 해당 무한루프를 빠져나간다.
-                break;
+                spinLock(&libSeats->seatLock[location]);
+                if ((phases[p].kind == BENCH_CHURN && roll < 30) || (phases[p].kind == BENCH_LUNCH && roll < 60)
+                    || (phases[p].kind == BENCH_RENEWAL && roll >= 80))
+                {
+                    start = benchNow();
+                    checkOut(location, HISTORY_CHECKOUT, libSeats);
+                    benchRecord(&stats[BENCH_CHECK_OUT], benchNow() - start);
+
+                }else if (phases[p].kind != BENCH_RUSH && isRenewable(location, libSeats, libData, &clock)){
+                    start = benchNow();
+                    renewSeat(location, libSeats, libData, &clock);
+                    benchRecord(&stats[BENCH_RENEW_SEAT], benchNow() - start);
+                }
+                spinUnlock(&libSeats->seatLock[location]);
             }
         }
 
-        // 선택한 좌석을 이용자에게 배정한다.
-        setSeat(tmpName, tmpSeatNo, libSeats, libData);
+        total += events;
+    }
 
-        // 연장가능시각과 이용종료시각을 출력한다.
-        printRenewTime(tmpSeatNo, libSeats, libData);
-        printEndTime(tmpSeatNo, libSeats);
+    // 폐장시각 직후, 남은 좌석이 모두 한 번에 만료된다.
+    setClock(&clock, libSeats, room, midnight + libData->CLOSE_TIME * 60LL + 1);
+    start = benchNow();
+    seatInvalidCheck(libSeats, room, &clock);
+    benchRecord(&stats[BENCH_INVALID_CHECK], benchNow() - start);
 
-    }else{ // 이용자 좌석의 위치가 -1이 아님. 즉 기존 이용자인 경우
+    // 폐장 후 모든 좌석을 초기화한다.
+    start = benchNow();
+    resetSeats(libSeats, room, 0, HISTORY_CLOSED);
+    benchRecord(&stats[BENCH_RESET], benchNow() - start);
 
-        // 연장 가능여부를 isRenewableRes 변수에 저장한다.
-        isRenewableRes = isRenewable(findUser(tmpName, libSeats), libSeats, libData);
+    return total;
+}
 
-        // 좌석번호와 연장가능시각, 이용종료시각을 출력한다.
-        printf("%d번 좌석\n", location + 1);
-        printRenewTime(location, libSeats, libData);
-        printEndTime(location, libSeats);
 
-        // 무한 루프, 옳은 입력값이 입력될때까지 반복한다.
-        while (1)
-        {
-            // 연장이 가능한 경우, 연장 메뉴를 활성화한다.
-            if (isRenewableRes)
-            {
-                printf("연장 : 1, ");
-            }
+/*
+* runBenchmark 함수
+* 기능 : 주어진 좌석 수마다 새 좌석 저장소를 만들어 하루 동안의 요청을 발생시키고, 함수별 처리량과 지연시간을 CSV 형식으로 표준 출력에 쓴다.
+*        대화형 입력과 기록(WAL)을 거치지 않고 좌석 관리 함수를 직접 호출한다. 이용자 수는 좌석 수의 2배이다.
+* 입력값 : 쉼표로 구분한 좌석 수 목록 seatList (예 : 10,1000,100000,1000000)
+* 반환값 : 성공한 경우 1, 좌석 수 목록이 잘못되었거나 메모리가 부족한 경우 0
+* 설명 최종 수정 일자 : 2026/10/17
+*
+* 출력 열 : seats(좌석 수), operation(함수 이름, day는 하루 전체), count(호출 횟수), ops_per_sec(함수에 든 시간 기준 초당 처리량),
+*           mean_ns, p50_ns, p99_ns, p999_ns, max_ns(지연시간). day 행의 처리량은 실제 걸린 시간 기준의 초당 요청 수이다.
+*/
+int runBenchmark(const char* seatList)
+{
+    // 측정 대상 함수 이름 (BENCH_SET_SEAT 등의 순서)
+    static const char* const operationNames[BENCH_OPERATIONS] = { "setSeat", "renewSeat", "checkOut", "findUser", "isFull", "seatInvalidCheck", "resetSeats" };
 
-            // 퇴실 및 취소 메뉴를 출력하며, 입력값을 입력받아 tmpMenu 변수에 저장한다.
-            printf("퇴실 : 2, 취소 : 3. : ");
-            scanf("%d", &tmpMenu);
+    // 측정 결과는 히스토그램이 크므로 정적 변수로 선언한다.
+    static BenchStat stats[BENCH_OPERATIONS];
 
-            // 옳은 입력값이 입력된 경우, 무한루프를 빠져나간다. 그렇지 않으면, 다시 입력해 달라는 내용을 출력한다.
-            // 좌석 연장 메뉴의 경우, 좌석 연장이 가능한 상태에서만 옳은 입력값으로 인정된다.
-            if ((tmpMenu == 1 && isRenewableRes) || tmpMenu == 2 || tmpMenu == 3) // 옳은 입력값이 입력된 경우
-            {
-                // 무한루프를 빠져나간다.
-                break;
+    // 개장 9시, 폐장 22시, 최대 이용 가능 시간 240분, 연장 가능 시간 30분
+    RoomData room = { "", 0, 0, { 240, 30, 9 * 60, 22 * 60 }, 0, 0, 0 };
+    SeatsData libSeats;
+    char (*names)[MAX_NAME_LENGTH] = NULL;
+    const char* cursor = seatList;
+    char* next = NULL;
+    long int seatCount = 0;
+    long long int events = 0, start = 0, elapsed = 0;
+    int userCount = 0;
 
-            }else{ // 옳지 않은 입력값이 입력된 경우
+    printf("seats,operation,count,ops_per_sec,mean_ns,p50_ns,p99_ns,p999_ns,max_ns\n");
 
-                // 다시 입력해달라는 내용을 출력한다.
-                printf("다시 입력해 주세요.\n");
-            }
+    while (*cursor)
+    {
+        // 좌석 수를 하나 읽는다.
+        seatCount = strtol(cursor, &next, 10);
+        if (next == cursor || seatCount <= 0 || seatCount > MAX_SEATS || (*next != ',' && *next != '\0'))
+        {
+            printf("좌석 수 목록이 잘못되었습니다. (1~%d 사이의 수를 쉼표로 구분) : %s\n", MAX_SEATS, seatList);
+            return 0;
         }
+        cursor = (*next == ',') ? next + 1 : next;
 
-        // 이용자의 좌석정보를 불러와서 tmpSeatNo 변수에 저장한다.
-        tmpSeatNo = findUser(tmpName, libSeats);
-
-        // tmpMenu의 입력값에 따라 연장, 퇴실, 취소 명령을 수행한다.
-        switch (tmpMenu)
+        // 좌석 저장소와 이용자명을 준비한다.
+        userCount = (int)seatCount * 2;
+        names = malloc(sizeof(*names) * userCount);
+        room.seatCount = (int)seatCount;
+        if (names == NULL || !createSeats(&libSeats, &room, 1, DEFAULT_RESERVATIONS, 0))
         {
-            // 연장
-        case 1:
-            // 이용자의 좌석번호에 대한 좌석연장을 처리한다.
-            renewSeat(tmpSeatNo, libSeats, libData);
-
-            // 변경된 좌석의 연장가능시각, 종료시각를 출력한다.
-            printRenewTime(tmpSeatNo, libSeats, libData);
-            printEndTime(tmpSeatNo, libSeats);
-
-            break;
-
-            // 반납
-        case 2:
-            // 이용자의 좌석번호에 대한 좌석반납을 처리한다.
-            checkOut(tmpSeatNo, libSeats);
+            printf("좌석 저장소를 생성할 수 없습니다.\n");
+            free(names);
+            return 0;
+        }
+        init(&libSeats);
+        for (int i = 0; i < userCount; i++)
+        {
+            snprintf(names[i], MAX_NAME_LENGTH, "user%d", i);
+        }
 
-            break;
+        // 하루 동안의 요청을 발생시킨다.
+        memset(stats, 0, sizeof(stats));
+        start = benchNow();
+        events = benchDay(&libSeats, &libSeats.header->rooms[0].libData, stats, names, userCount);
+        elapsed = benchNow() - start;
 
-            // 취소
-        case 3:
-            // 취소 명령이므로, 함수를 종료한다.
-            return;
+        // 하루 전체의 결과와 함수별 결과를 출력한다.
+        printf("%ld,day,%lld,%.0f,%.1f,0,0,0,0\n", seatCount, events, events * 1e9 / (elapsed > 0 ? elapsed : 1), (double)elapsed / events);
+        for (int i = 0; i < BENCH_OPERATIONS; i++)
+        {
+            stats[i].name = operationNames[i];
+            printf("%ld,%s,%lld,%.0f,%.1f,%lld,%lld,%lld,%lld\n", seatCount, stats[i].name, stats[i].count,
+                stats[i].totalTime > 0 ? stats[i].count * 1e9 / stats[i].totalTime : 0.0,
+                stats[i].count > 0 ? (double)stats[i].totalTime / stats[i].count : 0.0,
+                benchPercentile(&stats[i], 0.5), benchPercentile(&stats[i], 0.99), benchPercentile(&stats[i], 0.999), stats[i].maxTime);
         }
+        fflush(stdout);
+
+        destroySeats(&libSeats);
+        free(names);
     }
-    return;
+
+    return 1;
 }
 
 
 /*
-* seatInvalidCheck 함수
-* 기능 : 좌석이 만료된 경우, 좌석 지정을 해제함
-* 입력값 : 좌석 정보 구조체 포인터 *libSeats
-* 반환값 없음
-* 설명 최종 수정 일자 : 2024/05/01
+* main 함수
+* 기능 : 열람실의 이용시간, 좌석 각각의 이용시간을 저장하고, 모든 기본 명령을 수행한다.
+* 입력값 : argc, argv(명령행 인자. -c 설정파일 로 설정 파일을 지정할 수 있으며, 지정하지 않으면 library.conf를 이용한다. -d 소켓파일 은 좌석 서비스, -b 명령파일 은 일괄 처리, -s 시나리오파일 은 시뮬레이션, -B 좌석수목록 은 성능 측정을 실행한다.)
+* 반환값 0 (정상 종료), 1 (설정 파일 오류 또는 메모리 부족)
+* 설명 최종 수정 일자 : 2026/10/17
 */
-void seatInvalidCheck(SeatsData* libSeats)
+int main(int argc, char* argv[])
 {
-    // 현재 시각 관련 변수 선언
-    time_t Time;
-    Time = time(NULL);
+    // 열람실의 운영시간을 관리하는 구조체 변수를 선언한다.
+    // 24시간 운영시 libData.OPEN_TIME == libData.CLOSE TIME이고 좌석 초기화는 없다.
+    // 순서대로 이용가능시간(분), 연장가능시간(분), 개장시각(분), 폐장시각(분)이다. 설정 파일에 값이 있는 경우 이를 덮어쓴다.
+    LibraryData LibData = { 240, 30, 24 * 60 - 1, 24 * 60 - 1 };
+
+    // 실제로 이용하는 운영정보는 좌석 저장소의 머리 부분에 열람실별로 있다. 공유 좌석 파일을 이용하는 경우 모든 단말기가 같은 운영정보를 이용한다.
+    // 설정 파일에 열람실(ROOM)이 없는 경우, 위의 운영정보와 좌석 수로 열람실 하나를 만든다.
+
+    // 이용자 데이터를 저장하는 좌석 저장소 변수를 선언한다. 좌석 수는 설정 파일에서 읽어온다.
+    SeatsData LibSeats;
+    SystemConfig Config = { DEFAULT_SEATS, "", "", DEFAULT_WORKERS, "", DEFAULT_METRICS_INTERVAL, 0, "", "", "", DEFAULT_RESERVATIONS, DEFAULT_ARCHIVE_DAYS, 0, 0, 0, DEFAULT_QUOTA_USERS, 0, { { "", 0, 0, { 0, 0, 0, 0 }, 0, 0, 0 } } };
+    const char* configPath = DEFAULT_CONFIG_FILE;
+    const char* socketPath = NULL;
+    const char* batchPath = NULL;
+    const char* benchList = NULL;
+    const char* simulationPath = NULL;
+    const char* historyPath = NULL;
+    const char* historyGroup = "hour";
+    const char* historyRange = NULL;
+    const char* pointInTime = NULL;
+
+    // 임시로 이용자명을 저장하는 변수 tmpTime을 선언한다.
+    char tmpName[MAX_NAME_LENGTH];
+
+    // 요청마다 한 번 생성하는 현재 시각 정보 변수를 선언한다.
+    ClockContext Clock;
+
+    // 대화형 모드에서 시간 만료와 폐장 후 좌석을 회수하는 자동 정리 스레드 변수를 선언한다.
+    Housekeeper Keeper;
 
-    // 모든 좌석에 대하여 반복함
-    for (int i = 0; i < SEATS; i++)
+    // 대화형 모드에서 이용하는 운영 지표 변수를 선언한다. 운영 지표를 모으지 않는 경우 NULL이다.
+    MetricsData* metrics = NULL;
+
+    // 명령행 인자를 확인한다.
+    for (int i = 1; i < argc; i++)
     {
-        // 해당 좌석의 종료시각이 현재시각 이후인 경우, 좌석을 초기화함
-        // Unix 시간 기준이므로, 다음날 구분은 자동으로 가능함
-        //(libSeats + i)->endTime=0(미배정)과 -1(이용불가)은 예외
-        if (((libSeats + i)->endTime < (int)Time) && (libSeats + i)->endTime > 0)
+        if (!strcmp(argv[i], "-c") && i + 1 < argc) // 설정 파일 지정
         {
-            // 해당 좌석을 퇴실 처리함
-            checkOut(i, libSeats);
+            configPath = argv[++i];
+        }else if (!strcmp(argv[i], "-d") && i + 1 < argc){ // 좌석 서비스(데몬) 실행
+            socketPath = argv[++i];
+        }else if (!strcmp(argv[i], "-b") && i + 1 < argc){ // 명령 파일 일괄 처리
+            batchPath = argv[++i];
+        }else if (!strcmp(argv[i], "-B") && i + 1 < argc){ // 성능 측정
+            benchList = argv[++i];
+        }else if (!strcmp(argv[i], "-s") && i + 1 < argc){ // 가상 시계로 시뮬레이션
+            simulationPath = argv[++i];
+        }else if (!strcmp(argv[i], "-T") && i + 1 < argc){ // 지난 시각의 좌석 정보 복원
+            pointInTime = argv[++i];
+        }else if (!strcmp(argv[i], "-H") && i + 1 < argc){ // 이용 기록 집계
+            historyPath = argv[++i];
+        }else if (!strcmp(argv[i], "-g") && i + 1 < argc){ // 이용 기록 집계 기준
+            historyGroup = argv[++i];
+        }else if (!strcmp(argv[i], "-r") && i + 1 < argc){ // 이용 기록 집계 기간
+            historyRange = argv[++i];
+        }else{
+            printf("사용법 : %s [-c 설정파일] [-d 소켓파일 | -b 명령파일 | -s 시나리오파일 | -T 시각 | -B 좌석수목록 | -H 이용기록파일 [-g hour|weekday|seat] [-r 시작일,종료일]]\n", argv[0]);
+            return 1;
         }
     }
 
-    return;
-}
+    // 성능 측정은 설정 파일과 관계없이 정해진 운영정보로 새 좌석 저장소를 만들어 실행한다.
+    if (benchList != NULL)
+    {
+        return runBenchmark(benchList) ? 0 : 1;
+    }
 
+    // 이용 기록 집계는 이용 기록 파일만 읽으므로, 설정 파일과 좌석 저장소 없이 실행한다.
+    if (historyPath != NULL)
+    {
+        return runHistoryQuery(historyPath, historyGroup, historyRange) ? 0 : 1;
+    }
 
-/*
-* isOperationTime 함수
-* 기능 : 현재시각이 운영시간 내인지의 여부를 반환한다
-* 입력값 : 시설 정보 구조체 포인터 *libData
-* 반환값 : 운영시간 내인 경우 1을, 아닌 경우 0을 반환한다.
-* 설명 최종 수정 일자 : 2024/05/01
-*/
-int isOperationTime(LibraryData *libData)
-{
-    // 현재 시각 관련 변수 선언
-    time_t Time;
-    struct tm* pTime;
-    Time = time(NULL);
+    // 설정 파일을 읽는다.
+    if (!loadConfig(configPath, &Config, &LibData) || !layoutRooms(&Config, &LibData))
+    {
+        return 1;
+    }
+
+    // 하루 한도(DAILY_QUOTA, DAILY_RENEWALS)가 없으면 이용자별 사용량을 셀 필요가 없으므로, 이용 한도 표를 두지 않는다.
+    if (Config.dailyQuota == 0 && Config.dailyRenewals == 0)
+    {
+        Config.quotaUsers = 0;
+    }
+
+    // 지난 시각의 복원은 기록 디렉터리의 파일을 읽기만 하므로, 실행 중인 좌석 서비스나 다른 단말기와 관계없이 새 좌석 저장소에서 실행한다.
+    if (pointInTime != NULL)
+    {
+        int isRebuildOk = 0;
 
-    // 현재시각 정보를 시, 분, 초로 환산하여 tmp_time 변수에 초단위 값을 저장한다.
-    pTime = localtime(&Time);
-    int tmp_time = (pTime->tm_hour * 60 * 60) + (pTime->tm_min * 60) + (pTime->tm_sec);
+        if (!createSeats(&LibSeats, Config.rooms, Config.roomCount, Config.reserveSlots, Config.quotaUsers))
+        {
+            printf("좌석 저장소를 생성할 수 없습니다.\n");
+            return 1;
+        }
+        init(&LibSeats);
 
+        isRebuildOk = runPointInTime(Config.dataDir, pointInTime, &LibSeats);
+        destroySeats(&LibSeats);
+        return isRebuildOk ? 0 : 1;
+    }
 
-    // 운영시간이 아닌 경우를 판단한다.
-    // 개장시각이 폐장시각보다 빠른 경우, 개장시각 이전이거나 폐장시각 이후인 경우에는 운영시간이 아니다.
-    // 폐장시각이 개장시각보다 빠른 경우, 개장시각 이전이면서 폐장시각 이후인 경우에는 운영시간이 아니다.
-    if ((libData->OPEN_TIME < libData->CLOSE_TIME) && (tmp_time >= libData->CLOSE_TIME * 60 || tmp_time < libData->OPEN_TIME * 60)) // 개장시각이 폐장시각보다 빠른 경우에 대해 판단한다.
+    // 시뮬레이션은 가상 시계를 이용하므로, 실제 좌석 정보를 바꾸지 않도록 공유 좌석 파일과 기록 디렉터리를 이용하지 않고 새 좌석 저장소에서 실행한다.
+    if (simulationPath != NULL)
     {
-        // 운영시간 내에 해당하지 않으므로, 0을 반환한다.
-        return 0;
+        ClockSource VirtualClock;
+        int isSimulationOk = 0;
 
-    }else if ((libData->OPEN_TIME > libData->CLOSE_TIME) && (tmp_time >= libData->CLOSE_TIME * 60 && tmp_time < libData->OPEN_TIME * 60)){ // 폐장시각이 개장시각보다 빠른 경우에 대해 판단한다.
+        if (!createSeats(&LibSeats, Config.rooms, Config.roomCount, Config.reserveSlots, Config.quotaUsers))
+        {
+            printf("좌석 저장소를 생성할 수 없습니다.\n");
+            return 1;
+        }
+        init(&LibSeats);
+        initVirtualClock(&VirtualClock);
+        LibSeats.clockSource = &VirtualClock;
+        quotaConfigure(&LibSeats, Config.dailyQuota, Config.maxRenewals, Config.dailyRenewals);
+
+        // 달력 파일이 설정된 경우, 가상 시계의 시작 시각을 기준으로 운영 달력을 만든다.
+        // 배치 파일이 설정된 경우, 좌석 특징으로 좌석을 고를 수 있도록 좌석의 위치와 특징을 먼저 읽는다.
+        isSimulationOk = (!Config.calendarFile[0] || calendarOpen(Config.calendarFile, &LibSeats))
+            && (!Config.layoutFile[0] || layoutOpen(Config.layoutFile, &LibSeats)) && runBatch(simulationPath, &LibSeats);
+        layoutClose(&LibSeats);
+        calendarClose(&LibSeats);
+        destroySeats(&LibSeats);
+        return isSimulationOk ? 0 : 1;
+    }
 
-        // 운영시간 내에 해당하지 않으므로, 0을 반환한다.
-        return 0;
+    if (Config.sharedFile[0]) // 공유 좌석 파일이 설정된 경우
+    {
+        // 공유 좌석 파일을 좌석 저장소로 이용한다. 파일이 없는 경우 초기화된 파일을 만든다.
+        // 좌석 정보는 파일 자체에 남으므로, 기록 디렉터리는 이용하지 않는다.
+        if (Config.dataDir[0])
+        {
+            printf("공유 좌석 파일을 이용하므로 DATA_DIR 설정은 무시됩니다.\n");
+        }
+        if (!mapSeats(Config.sharedFile, &LibSeats, Config.rooms, Config.roomCount, Config.reserveSlots, Config.quotaUsers))
+        {
+            return 1;
+        }
+
+    }else{ // 공유 좌석 파일이 설정되지 않은 경우
+
+        // 좌석 수만큼의 좌석 저장소를 생성한다.
+        if (!createSeats(&LibSeats, Config.rooms, Config.roomCount, Config.reserveSlots, Config.quotaUsers))
+        {
+            printf("좌석 저장소를 생성할 수 없습니다.\n");
+            return 1;
+        }
+
+        // 최초 실행시 좌석에 대한 초기화를 진행한다.
+        init(&LibSeats);
 
+        // 기록 디렉터리가 설정된 경우, 저장된 좌석 정보와 운영정보를 복구하고 이후의 변경을 기록한다.
+        if (Config.dataDir[0] && !walOpen(Config.dataDir, Config.archiveDays, &LibSeats))
+        {
+            destroySeats(&LibSeats);
+            return 1;
+        }
     }
 
-    // 운영시간 내에 해당하므로, 1을 반환한다.
-    return 1;
-}
+    // 이용 한도를 적용한다. 복구한 기록에는 사용량이 이미 들어 있으므로, 복구 중에 다시 더하지 않도록 복구가 끝난 후 정한다.
+    quotaConfigure(&LibSeats, Config.dailyQuota, Config.maxRenewals, Config.dailyRenewals);
 
-/*
-* main 함수
-* 기능 : 열람실의 이용시간, 좌석 각각의 이용시간을 저장하고, 모든 기본 명령을 수행한다.
-* 입력값 없음
-* 반환값 0 (정상 종료)
-* 설명 최종 수정 일자 : 2024/05/01
-*/
-int main()
-{
-    // 열람실의 운영시간을 관리하는 구조체 변수를 선언한다.
-    // 24시간 운영시 libData.OPEN_TIME == libData.CLOSE TIME이고 좌석 초기화는 없다.
-    // 순서대로 이용가능시간(분), 연장가능시간(분), 개장시각(분), 폐장시각(분)이다.
-    LibraryData LibData = { 240, 30, 24 * 60 - 1, 24 * 60 - 1 };
-    
-    // 이용자 데이터를 저장하는 구조체 변수를 좌석 수(SEATS) 만큼의 배열로 선언한다.
-    SeatsData LibSeats[SEATS];
+    // 달력 파일이 설정된 경우, 열람실 운영정보의 개장, 폐장시각 대신 운영 달력을 따른다. 복구한 운영정보를 기본 요일별 운영시간으로 이용하므로 복구 후에 읽는다.
+    if (Config.calendarFile[0] && !calendarOpen(Config.calendarFile, &LibSeats))
+    {
+        walClose(&LibSeats);
+        destroySeats(&LibSeats);
+        return 1;
+    }
 
-    // 임시로 이용자명을 저장하는 변수 tmpTime을 선언한다.
-    char tmpName[MAX_NAME_LENGTH];
+    // 운영 지표 파일이 설정된 경우, 운영 지표를 모으기 시작한다.
+    if (Config.metricsFile[0] && !metricsOpen(Config.metricsFile, Config.metricsInterval, &LibSeats))
+    {
+        calendarClose(&LibSeats);
+        walClose(&LibSeats);
+        destroySeats(&LibSeats);
+        return 1;
+    }
 
-    // 최초 실행시 좌석에 대한 초기화를 진행한다.
-    init(LibSeats);
+    // 이용 기록 파일이 설정된 경우, 이제부터 끝나는 이용을 남긴다. 기록 복구 중의 퇴실은 이미 남겼으므로 기록 복구 후에 시작한다.
+    if (Config.historyFile[0] && !historyOpen(Config.historyFile, &LibSeats))
+    {
+        metricsClose(&LibSeats);
+        calendarClose(&LibSeats);
+        walClose(&LibSeats);
+        destroySeats(&LibSeats);
+        return 1;
+    }
 
-    // 시스템은 무한루프롤 이용해 계속 반복 진행한다.
-    while (1)
+    // 좌석 서비스를 실행하는 경우, 대화형 입력 대신 소켓으로 요청을 받아 처리한다. 종료 신호를 받으면 아래의 정리 과정을 거쳐 종료한다.
+    if (socketPath != NULL)
+    {
+        int isServiceOk = runService(socketPath, Config.workerCount, &LibSeats);
+        historyClose(&LibSeats);
+        metricsClose(&LibSeats);
+        calendarClose(&LibSeats);
+        walClose(&LibSeats);
+        destroySeats(&LibSeats);
+        return isServiceOk ? 0 : 1;
+    }
+
+    // 명령 파일을 일괄 처리하는 경우, 모든 명령을 처리한 후 같은 정리 과정을 거쳐 종료한다.
+    if (batchPath != NULL)
     {
-        // 이용자명을 입력받는다. 0을 입력받은 경우, 관리자 모드에 진입한다.
-        menuSelect(tmpName);
+        // 배치 파일이 설정된 경우, 좌석 특징으로 좌석을 고를 수 있도록(BLOCK WINDOW 등) 좌석의 위치와 특징을 먼저 읽는다.
+        int isBatchOk = (!Config.layoutFile[0] || layoutOpen(Config.layoutFile, &LibSeats)) && runBatch(batchPath, &LibSeats);
+        layoutClose(&LibSeats);
+        historyClose(&LibSeats);
+        metricsClose(&LibSeats);
+        calendarClose(&LibSeats);
+        walClose(&LibSeats);
+        destroySeats(&LibSeats);
+        return isBatchOk ? 0 : 1;
+    }
 
-        // 시간 만료되면 자동 퇴실 처리한다. 이용자가 시스템 이용을 시도하는 즉시 실행되게 하여, 이를 통해 최신 정보를 불러올 수 있게 한다.
-        seatInvalidCheck(LibSeats);
+    // 대화형 모드는 주 스레드가 입력을 처리하고, 자동 정리 스레드가 시간 만료와 폐장 후 좌석을 제시각에 회수한다.
+    metrics = metricsThread(&LibSeats);
 
+    // 좌석 정보 화면을 바뀐 좌석만 다시 그릴 수 있도록 좌석 배치도를 만든다.
+    if (!seatMapOpen(&LibSeats, Config.seatMapGrid))
+    {
+        printf("좌석 배치도를 만들 수 없습니다.\n");
+        historyClose(&LibSeats);
+        metricsClose(&LibSeats);
+        calendarClose(&LibSeats);
+        walClose(&LibSeats);
+        destroySeats(&LibSeats);
+        return 1;
+    }
 
-        // 폐장시각이 지난 경우, 자동 퇴실 처리를 진행한다. 이용자가 시스템 이용을 시도하는 즉시 실행되게 하여, 이를 통해 최신 정보를 불러올 수 있게 한다.
-        // 24시간제의 경우, 해당사항이 없으므로 자동 퇴실 처리를 진행하지 않는다.
-        if (LibData.OPEN_TIME != LibData.CLOSE_TIME) // 24시간제가 아닌 경우
+    // 자동 정리 스레드를 시작한다. 시작하면서 먼저 한 번 정리하므로, 처음 출력하는 좌석 정보부터 최신 상태이다.
+    if (!housekeeperStart(&Keeper, &LibSeats))
+    {
+        seatMapClose(&LibSeats);
+        historyClose(&LibSeats);
+        metricsClose(&LibSeats);
+        calendarClose(&LibSeats);
+        walClose(&LibSeats);
+        destroySeats(&LibSeats);
+        return 1;
+    }
+
+    // 배치 파일이 설정된 경우, 좌석을 추천할 수 있도록 좌석의 위치와 특징을 읽는다.
+    if (Config.layoutFile[0] && !layoutOpen(Config.layoutFile, &LibSeats))
+    {
+        housekeeperStop(&Keeper);
+        seatMapClose(&LibSeats);
+        historyClose(&LibSeats);
+        metricsClose(&LibSeats);
+        calendarClose(&LibSeats);
+        walClose(&LibSeats);
+        destroySeats(&LibSeats);
+        return 1;
+    }
+
+    // 시스템은 무한루프롤 이용해 계속 반복 진행한다.
+    while (1)
+    {
+        // 이용자명을 입력받는다. 0을 입력받은 경우, 관리자 모드에 진입한다. 입력이 끝난 경우(EOF) 프로그램을 종료한다.
+        if (!menuSelect(tmpName))
         {
-            // 운영시간이 아닌 경우
-            if (!isOperationTime(&LibData))
-            {
-                // 좌석을 초기화한다. 이용불가 좌석에 대해서는 초기화를 진행하지 않는다.
-                resetSeats(LibSeats, 0);
-            }
+            break;
         }
 
+        // 현재 시각 정보를 생성한다. 이번 요청의 모든 시각 계산은 이 정보를 이용한다.
+        // 시간 만료 및 폐장시각이 지난 좌석은 자동 정리 스레드가 이미 회수했으므로, 요청마다 다시 확인하지 않는다.
+        captureClock(&Clock, &LibSeats, &LibSeats.header->rooms[0]);
+
 
         // 0이 입력되어 관리자 모드에 진입해야 하는 경우를 구분한다.
         if (tmpName[0] == '0' && strlen(tmpName) == 1) // 0이 입력된 경우
         {
             // 관리자 모드에 진입한다.
-            adminMode(LibSeats , &LibData);
+            adminMode(&LibSeats);
 
         }else{ // 0이 입력되지 않은 경우. 즉, 이용자명이 입력된 경우
 
-            if (isOperationTime(&LibData)) // 현재시각이 운영시간 내인 경우. 이 경우, 24시간제를 포함한다.
+            if (isAnyRoomOpen(&LibSeats, &Clock)) // 운영시간인 열람실이 있는 경우. 이 경우, 24시간제를 포함한다.
             {
                 // 입력받은 이용자명에 대해 좌석 선택을 시도한다.
-                seatSelector(tmpName, LibSeats, &LibData);
+                seatSelector(tmpName, &LibSeats, &Clock, metrics);
 
             }else{
                 // 운영시간이 아님을 출력한다.
+                metricCount(metrics, METRIC_CLOSED, 1);
                 printf("운영시간이 아닙니다.\n");
                 
             }
         }
+
+        // 이번 요청에서 생긴 기록을 한 번에 디스크에 확정한다. 지표 파일을 다시 쓸 때가 된 경우 지표 파일을 쓴다.
+        walCommit(&LibSeats);
+        historyCommit(&LibSeats, 0);
+        metricsExport(&LibSeats, 0);
+
+        // 이번 요청으로 다음 정리 시각이 앞당겨졌을 수 있으므로, 자동 정리 스레드가 다시 계산하도록 깨운다.
+        housekeeperWake(&Keeper);
     }
 
+    // 자동 정리 스레드를 멈추고, 남은 이용 기록과 마지막 지표 파일, 스냅샷을 쓴 후, 좌석 저장소를 해제한다.
+    housekeeperStop(&Keeper);
+    layoutClose(&LibSeats);
+    seatMapClose(&LibSeats);
+    historyClose(&LibSeats);
+    metricsClose(&LibSeats);
+    calendarClose(&LibSeats);
+    walClose(&LibSeats);
+    destroySeats(&LibSeats);
+
     return 0;
 }